@@ -0,0 +1,34 @@
+#include "AlarmLog.h"
+#include "AppData.h"
+
+static AlarmEvent ring[ALARM_LOG_SIZE];
+static uint8_t head = 0, count = 0;
+static uint16_t nextSeqNo = 0;
+static int16_t lastMask = -1;
+
+void alarmLogPoll(unsigned long now){
+  const uint8_t m = alarmMask();
+  if (m == lastMask) return;
+  lastMask = m;
+  ring[head] = {nextSeqNo++, (uint32_t)now, m};
+  head = (uint8_t)((head + 1) % ALARM_LOG_SIZE);
+  if (count < ALARM_LOG_SIZE) count++;
+}
+
+uint8_t alarmLogRead(uint16_t fromSeq, AlarmEvent* out, uint8_t max, uint16_t* nextSeq){
+  // Snapshot the indexes; the writer only runs in the UI task and an entry
+  // is fully written before head moves.
+  const uint8_t h = head, c = count;
+  const uint16_t newest = nextSeqNo;
+  uint8_t n = 0;
+  uint16_t resume = fromSeq;
+  for (uint8_t i = 0; i < c && n < max; i++) {
+    const AlarmEvent& e = ring[(h + ALARM_LOG_SIZE - c + i) % ALARM_LOG_SIZE];
+    if ((int16_t)(e.seq - fromSeq) < 0) continue;    // older than requested
+    out[n++] = e;
+    resume = (uint16_t)(e.seq + 1);
+  }
+  if (n == 0 && (int16_t)(newest - fromSeq) < 0) resume = newest;
+  if (nextSeq) *nextSeq = resume;
+  return n;
+}
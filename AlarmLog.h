@@ -0,0 +1,22 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Alarm event log =====
+// Fixed ring of alarm-mask transitions (see alarmMask()). Entries carry a
+// running sequence number so readers can page through with "since seq".
+#ifndef ALARM_LOG_SIZE
+#define ALARM_LOG_SIZE 32
+#endif
+
+struct AlarmEvent {
+  uint16_t seq;
+  uint32_t ms;        // millis() when the mask changed
+  uint8_t  mask;      // alarm bits after the change
+};
+
+// Record a new entry if alarmMask() changed since the last poll
+void alarmLogPoll(unsigned long now);
+
+// Copy up to max entries with seq >= fromSeq (oldest first).
+// Returns the count; *nextSeq is the seq to ask for next time.
+uint8_t alarmLogRead(uint16_t fromSeq, AlarmEvent* out, uint8_t max, uint16_t* nextSeq);
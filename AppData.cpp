@@ -1,4 +1,6 @@
 #include "AppData.h"
+#include "FanHealth.h"
+#include "Sensors.h"
 #include <string.h>
 
 // ===== Live status =====
@@ -9,13 +11,23 @@ float fan1Current_mA = 12.5;
 float fan2Current_mA = 12.5;
 float fan1Power_W = 12.5;
 float fan2Power_W = 12.5;
-float fan1Run_m = 12.5;
-float fan2Run_m = 12.5;
+float fan1Run_m = 0;
+float fan2Run_m = 0;
+float fan1Energy_kWh = 0;
+float fan2Energy_kWh = 0;
+float fan1Rpm = 0;
+float fan2Rpm = 0;
 bool Light_Condition = true;
 
 // Alarms (shown in menu; not actually committed as settings)
 bool alarmDoor=true, alarmWater=false, alarmSmoke=true, alarmTemp=false, alarmFanFault=true, alarmAviation = false;
 
+uint8_t alarmMask() {
+  return (uint8_t)((alarmDoor     ? ALARM_BIT_DOOR     : 0) | (alarmWater    ? ALARM_BIT_WATER    : 0) |
+                   (alarmSmoke    ? ALARM_BIT_SMOKE    : 0) | (alarmTemp     ? ALARM_BIT_TEMP     : 0) |
+                   (alarmFanFault ? ALARM_BIT_FANFAULT : 0) | (alarmAviation ? ALARM_BIT_AVIATION : 0));
+}
+
 // ===== Live settings defaults =====
 Settings gLive = {
   // Fan thresholds
@@ -40,9 +52,20 @@ Settings gLive = {
   .voltHighThrV = 15,
 
   .LDRThreshold = 100,
+
+  // power saving
+  .dimAfterS = 60,
+  .offAfterS = 300,
+  .dashRotateS = 0,
+  // calibration
+  .vinGainTrim = 0,
+  .vinOffsetMv = 0,
+  .ntcOffsetDc = 0,
   // modbus
   .baudrate = 115200,
-  .slaveID = 1
+  .slaveID = 1,
+  .modbusMaster = 0,
+  .modbusNodes = 4
 };
 
 // ===== Staged settings (what the menu edits) =====
@@ -59,14 +82,16 @@ void stageApply()   { gLive  = gStage; }
 void stageDiscard() { gStage = gLive;  }
 
 // ===== Demo arrays + timing =====
+#if !STATUS_SENSORS
 static float Temperature[] = {27.5,30.7,32.2};
 static float Voltage[]     = {27.5,30.7,32.2};
+#endif
+#if !FAN_HEALTH
 static float Fan1Current[] = {27.5,30.7,32.2};
 static float Fan2Current[] = {27.5,30.7,32.2};
+#endif
 static float Fan1Power[] = {27.5,30.7,32.2};
 static float Fan2Power[] = {27.5,30.7,32.2};
-static float Fan1Run[] = {27.5,30.7,32.2};
-static float Fan2Run[] = {27.5,30.7,32.2};
 static uint8_t demoIdx = 0;
 static unsigned long lastUpdate = 0;
 static const unsigned long UPDATE_MS = 5000; // 5s
@@ -80,23 +105,24 @@ void demoDataTick(unsigned long now) {
   if (now - lastUpdate < UPDATE_MS) return;
   lastUpdate = now;
 
+#if !STATUS_SENSORS
   statusTempC = Temperature[demoIdx];
   statusVinV  = Voltage[demoIdx];
+#endif
+#if !FAN_HEALTH
   fan1Current_mA = Fan1Current[demoIdx];
   fan2Current_mA = Fan2Current[demoIdx];
+#endif
   fan1Power_W = Fan1Power[demoIdx];
   fan2Power_W = Fan2Power[demoIdx];
-  fan1Run_m = Fan1Run[demoIdx];
-  fan2Run_m = Fan2Run[demoIdx];
 
   // Flip alarms each tick (visual demo)
   alarmDoor     = !alarmDoor;
   alarmWater    = !alarmWater;
   alarmSmoke    = !alarmSmoke;
   alarmTemp     = !alarmTemp;
-  alarmFanFault = !alarmFanFault;
-  alarmAviation = !alarmAviation;
-  Light_Condition = !Light_Condition;
+  // alarmFanFault belongs to FanTach, alarmAviation / Light_Condition to the
+  // aviation light task, run time and energy to FanCounters
 
   demoIdx = (uint8_t)((demoIdx + 1) % 3);
 }
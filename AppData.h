@@ -10,13 +10,24 @@ extern float fan1Current_mA;
 extern float fan2Current_mA;
 extern float fan1Power_W;
 extern float fan2Power_W;
-extern float fan1Run_m;
+extern float fan1Run_m;               // run minutes, persisted (FanCounters)
 extern float fan2Run_m;
-extern bool Light_Condition;
+extern float fan1Energy_kWh;          // persisted (FanCounters)
+extern float fan2Energy_kWh;
+extern float fan1Rpm;                 // tach speed (FanTach)
+extern float fan2Rpm;
+extern bool Light_Condition;          // daylight (AviationLight task)
 
 // Alarms (shown in menu but not committed; you can keep them read-only in logic)
 extern bool alarmDoor, alarmWater, alarmSmoke, alarmTemp, alarmFanFault, alarmAviation;
 
+// Alarm bits packed door..aviation (bit 0..5)
+enum {
+  ALARM_BIT_DOOR = 0x01, ALARM_BIT_WATER = 0x02, ALARM_BIT_SMOKE = 0x04,
+  ALARM_BIT_TEMP = 0x08, ALARM_BIT_FANFAULT = 0x10, ALARM_BIT_AVIATION = 0x20
+};
+uint8_t alarmMask();
+
 // ===== Settings schema =====
 enum { PROF_AUTO, PROF_NORMAL };
 enum { MODEL_KRUBO, MODEL_DELTA, MODEL_CUSTOM };
@@ -45,9 +56,23 @@ struct Settings {
 
   int16_t LDRThreshold;
 
+  // Power saving (0 = never)
+  uint16_t dimAfterS;
+  uint16_t offAfterS;
+
+  // Idle dashboard auto-rotate period (0 = manual paging only)
+  uint16_t dashRotateS;
+
+  // Per-unit sensor calibration (Sensors.h)
+  int16_t vinGainTrim;      // 0.01 % of the nominal divider gain
+  int16_t vinOffsetMv;
+  int16_t ntcOffsetDc;      // 0.1 C
+
   // Modbus
   long baudrate;
   uint8_t slaveID;
+  uint8_t modbusMaster;     // 1 = poll the units at slaveID+1.. (Modbus.h)
+  uint8_t modbusNodes;      // how many
 };
 
 // ===== Live settings (used by firmware logic) =====
@@ -62,6 +87,22 @@ bool settingsDirty();         // compare stage vs live
 void stageApply();            // copy stage -> live
 void stageDiscard();          // copy live -> stage (revert)
 
+// ===== Settings field access by id (remote protocol, persistence) =====
+// Ids are stable: append new fields, never renumber.
+enum SettingsField : uint8_t {
+  SF_TEMP_THR_L, SF_TEMP_THR_H, SF_TEMP_HIGH_THR, SF_TOGGLE_PERIOD,
+  SF_FAN_PROFILE, SF_FAN1_MODEL, SF_FAN2_MODEL, SF_FAN1_NOMINAL, SF_FAN2_NOMINAL,
+  SF_FAN_CURRENT_UNIT, SF_VOLT_L_THR, SF_VOLT_HIGH_THR, SF_LDR_THRESHOLD,
+  SF_DIM_AFTER, SF_OFF_AFTER, SF_BAUDRATE, SF_SLAVE_ID,
+  SF_DASH_ROTATE,
+  SF_VIN_GAIN, SF_VIN_OFFSET, SF_NTC_OFFSET,
+  SF_MB_MASTER, SF_MB_NODES,
+  SF_COUNT
+};
+bool settingsGetField(const Settings& s, uint8_t id, int32_t& out);
+bool settingsSetField(Settings& s, uint8_t id, int32_t value);   // false = bad id/range
+bool settingsFieldRange(uint8_t id, int32_t& lo, int32_t& hi);
+
 // ===== Demo data tick (your 5s updates for status + alarms) =====
 void demoDataInit();
 void demoDataTick(unsigned long now);
@@ -0,0 +1,67 @@
+#include "AviationLight.h"
+#include <STM32FreeRTOS.h>
+#include "AppData.h"
+#include "FanHealth.h"
+#include "HealthMonitor.h"
+#include "Pins.h"
+#include "Sensors.h"
+#include "StaticAlloc.h"
+#include "UiTrace.h"
+
+uint16_t diagAviLux = 0;
+uint16_t diagAviLampMa = 0;
+
+static TaskHandle_t aviHandle = nullptr;
+static const uint16_t AVI_STACK_WORDS = 256;        // + sensor blocks, LUT builds, fan block analysis
+static const UBaseType_t AVI_PRIORITY = tskIDLE_PRIORITY + 1;   // below UI
+TASK_MEM(avi, AVI_STACK_WORDS);
+
+static uint16_t readScaled(uint32_t pin, uint32_t full){
+  return (uint16_t)(((uint32_t)analogRead(pin) * full) >> AVI_ADC_BITS);
+}
+
+static void aviStep(){
+  const uint16_t lux = readScaled(AVI_LDR_PIN, AVI_LDR_FULL_LUX);
+  diagAviLampMa = readScaled(AVI_ISENSE_PIN, AVI_ISENSE_FULL_MA);
+  const int16_t thr = gLive.LDRThreshold;
+  const bool on = aviLogicStep(lux, diagAviLampMa, (uint16_t)(thr > 0 ? thr : 0), millis());
+  digitalWrite(AVI_LAMP_PIN, on ? HIGH : LOW);
+
+  sensorsSample(millis());                // the other ADC inputs, when due
+
+  const AviStatus& st = aviLogicStatus();
+  diagAviLux = st.filteredLux;
+  // A trace replay scripts these itself
+  if (!traceReplaying()) {
+    Light_Condition = st.mode != AVI_NIGHT;
+    alarmAviation = st.fault;
+  }
+}
+
+static void aviTask(void*){
+  const TickType_t period = pdMS_TO_TICKS(AVI_TASK_MS);
+  TickType_t wake = xTaskGetTickCount();
+  TickType_t lastStep = wake - period;
+  aviLogicReset(millis());
+  for (;;) {
+    if (wake - lastStep >= period) {
+      lastStep = wake;
+      aviStep();
+    }
+    // While a fan current block is open it takes a sample every tick
+    const bool sampling = fanHealthSample(millis());
+    vTaskDelayUntil(&wake, sampling ? 1 : lastStep + period - wake);
+  }
+}
+
+void aviationTestNow(){ aviLogicRequestTest(); }
+
+bool aviationStart(){
+  pinMode(AVI_LAMP_PIN, OUTPUT);
+  digitalWrite(AVI_LAMP_PIN, HIGH);        // lit until the first decision
+  analogReadResolution(AVI_ADC_BITS);
+  if (!TASK_START(aviTask, "AVI", avi, AVI_STACK_WORDS,
+                  AVI_PRIORITY, &aviHandle)) return false;
+  healthRegisterTask(aviHandle, AVI_STACK_WORDS);
+  return true;
+}
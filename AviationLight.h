@@ -0,0 +1,36 @@
+#pragma once
+#include <Arduino.h>
+#include "AviationLogic.h"
+
+// ===== Aviation obstruction light =====
+// A low-rate task samples the LDR and lamp current (Pins.h), runs the
+// decision logic in AviationLogic.h and drives the lamp. It owns
+// Light_Condition (true = daylight) and alarmAviation (lamp fault), and
+// as the only ADC user it also samples the status sensors (Sensors.h) and
+// the fan current blocks (FanHealth.h, every tick while one is open).
+//
+// ADC scaling is linear for now: full scale = AVI_LDR_FULL_LUX lux and
+// AVI_ISENSE_FULL_MA mA.
+
+#ifndef AVI_TASK_MS
+#define AVI_TASK_MS 100
+#endif
+#ifndef AVI_ADC_BITS
+#define AVI_ADC_BITS 12
+#endif
+#ifndef AVI_LDR_FULL_LUX
+#define AVI_LDR_FULL_LUX 2000UL
+#endif
+#ifndef AVI_ISENSE_FULL_MA
+#define AVI_ISENSE_FULL_MA 1000UL
+#endif
+
+// Diagnostics (read-only menu fields)
+extern uint16_t diagAviLux;         // filtered LDR reading
+extern uint16_t diagAviLampMa;      // last lamp current sample
+
+// Create the task; call before the scheduler starts
+bool aviationStart();
+
+// Pulse the lamp at the next daylight sample (menu / remote)
+void aviationTestNow();
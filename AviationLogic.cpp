@@ -0,0 +1,150 @@
+#include "AviationLogic.h"
+
+static AviStatus st;
+
+// Filter
+static uint16_t raw[3];
+static uint8_t rawN = 0, rawIdx = 0;
+static int32_t filtQ8 = 0;                 // lux * 256
+static uint32_t lastStepMs = 0;
+
+// Day/night decision
+static uint32_t modeSinceMs = 0;
+static uint32_t pendingSinceMs = 0;
+static bool pending = false;
+
+// Lamp check
+static bool lastCmd = false;
+static uint32_t cmdSinceMs = 0;
+static uint32_t mismatchSinceMs = 0;
+static bool mismatch = false;
+static bool onFault = false;               // no/odd current while on
+static bool leakFault = false;             // current while off (stuck relay)
+
+// Self-test
+static uint32_t lastTestMs = 0;
+static uint32_t testStartMs = 0;
+static bool testSawOk = false;
+static bool testRequested = false;
+
+void aviLogicReset(uint32_t now){
+  st = {};
+  rawN = rawIdx = 0;
+  pending = false;
+  mismatch = false;
+  onFault = leakFault = false;
+  testRequested = false;
+  lastCmd = false;
+  cmdSinceMs = now;
+  lastStepMs = now;
+  modeSinceMs = now;
+  // First test AVI_TEST_FIRST_MS from now
+  lastTestMs = now - (AVI_TEST_PERIOD_MS - AVI_TEST_FIRST_MS);
+}
+
+void aviLogicRequestTest(){ testRequested = true; }
+
+const AviStatus& aviLogicStatus(){ return st; }
+
+static uint16_t median3(uint16_t a, uint16_t b, uint16_t c){
+  if (a > b) { uint16_t t = a; a = b; b = t; }
+  if (b > c) b = c;
+  return a > b ? a : b;
+}
+
+static uint16_t filterLux(uint16_t lux, uint32_t now){
+  raw[rawIdx] = lux;
+  rawIdx = (uint8_t)((rawIdx + 1) % 3);
+  if (rawN < 3) rawN++;
+  const uint16_t m = rawN < 3 ? lux : median3(raw[0], raw[1], raw[2]);
+  if (rawN == 1) {
+    filtQ8 = (int32_t)m << 8;              // seed: no start-up lag
+  } else {
+    uint32_t dt = now - lastStepMs;
+    if (dt > AVI_FILTER_TAU_MS) dt = AVI_FILTER_TAU_MS;
+    filtQ8 += (int32_t)(((int64_t)(((int32_t)m << 8) - filtQ8) * dt) / (int32_t)AVI_FILTER_TAU_MS);
+  }
+  lastStepMs = now;
+  return (uint16_t)((filtQ8 + 128) >> 8);
+}
+
+static void enterMode(AviMode m, uint32_t now){
+  if ((m == AVI_NIGHT) != (st.mode == AVI_NIGHT)) {
+    st.switches++;
+    modeSinceMs = now;
+  }
+  st.mode = m;
+}
+
+static bool lampOk(bool on, uint16_t ma){
+  return on ? (ma >= AVI_LAMP_MIN_MA && ma <= AVI_LAMP_MAX_MA) : ma <= AVI_LAMP_LEAK_MA;
+}
+
+bool aviLogicStep(uint16_t lux, uint16_t lampMa, uint16_t thresholdLux, uint32_t now){
+  const bool first = rawN == 0;
+  st.filteredLux = filterLux(lux, now);
+
+  // ----- Day / night with hysteresis and dwell -----
+  uint32_t hyst = (uint32_t)thresholdLux * AVI_HYST_PCT / 100;
+  if (hyst < AVI_HYST_MIN_LUX) hyst = AVI_HYST_MIN_LUX;
+  const bool night = st.mode == AVI_NIGHT;
+  const bool wantNight = night ? st.filteredLux <= thresholdLux + hyst
+                               : st.filteredLux < thresholdLux;
+  if (first) {
+    st.mode = wantNight ? AVI_NIGHT : AVI_DAY;
+  } else if (wantNight != night) {
+    if (!pending) { pending = true; pendingSinceMs = now; }
+    if (now - pendingSinceMs >= AVI_CONFIRM_MS && now - modeSinceMs >= AVI_MIN_DWELL_MS) {
+      if (st.mode == AVI_TEST) st.mode = AVI_DAY;   // dusk ends a test without a verdict
+      enterMode(wantNight ? AVI_NIGHT : AVI_DAY, now);
+      pending = false;
+    }
+  } else {
+    pending = false;
+  }
+
+  // ----- Daylight self-test -----
+  if (st.mode == AVI_DAY && !pending &&
+      (testRequested || now - lastTestMs >= AVI_TEST_PERIOD_MS)) {
+    st.mode = AVI_TEST;
+    testRequested = false;
+    testStartMs = now;
+    testSawOk = false;
+  }
+
+  // ----- Lamp output and current check -----
+  const bool cmd = st.mode != AVI_DAY;
+  if (cmd != lastCmd) {
+    lastCmd = cmd;
+    cmdSinceMs = now;
+    mismatch = false;
+  }
+  if (now - cmdSinceMs >= AVI_LAMP_SETTLE_MS) {
+    // An off lamp says nothing about a burnt-out one: each command state
+    // only confirms or clears its own fault
+    const bool ok = lampOk(cmd, lampMa);
+    bool& f = cmd ? onFault : leakFault;
+    if (st.mode == AVI_TEST) {
+      if (ok) testSawOk = true;
+    } else if (ok == f) {                  // reading disagrees with the flag
+      if (!mismatch) { mismatch = true; mismatchSinceMs = now; }
+      if (now - mismatchSinceMs >= AVI_FAULT_CONFIRM_MS) {
+        f = !ok;
+        mismatch = false;
+      }
+    } else {
+      mismatch = false;
+    }
+  }
+
+  if (st.mode == AVI_TEST && now - testStartMs >= AVI_TEST_MS) {
+    onFault = !testSawOk;                  // the test is authoritative
+    if (testSawOk) st.testsPassed++; else st.testsFailed++;
+    lastTestMs = now;
+    st.mode = AVI_DAY;
+  }
+
+  st.fault = onFault || leakFault;
+  st.lampOn = cmd;
+  return cmd;
+}
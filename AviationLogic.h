@@ -0,0 +1,80 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Aviation light decision logic =====
+// Hardware-free core of the aviation light controller (AviationLight.h runs
+// it in a task; tools/avi_sim.cpp replays lux curves through it on a host).
+//
+// LDR lux -> median-of-3 (drops headlight / lightning spikes) -> EMA with
+// AVI_FILTER_TAU_MS. The light goes ON below the threshold and OFF above
+// threshold + AVI_HYST_PCT; a change must hold for AVI_CONFIRM_MS and the
+// current state must have lasted AVI_MIN_DWELL_MS. Lamp current is checked
+// against a window while commanded on (and for leakage while off); a mismatch
+// lasting AVI_FAULT_CONFIRM_MS raises the fault. In daylight the lamp is
+// pulsed for AVI_TEST_MS every AVI_TEST_PERIOD_MS as a self-test.
+//
+// Timing is in ms and wrap-safe; call aviLogicStep() at a steady rate.
+
+#ifndef AVI_FILTER_TAU_MS
+#define AVI_FILTER_TAU_MS 10000UL
+#endif
+#ifndef AVI_HYST_PCT
+#define AVI_HYST_PCT 50                 // OFF threshold = ON threshold * 1.5
+#endif
+#ifndef AVI_HYST_MIN_LUX
+#define AVI_HYST_MIN_LUX 5
+#endif
+#ifndef AVI_CONFIRM_MS
+#define AVI_CONFIRM_MS 30000UL          // condition must hold this long
+#endif
+#ifndef AVI_MIN_DWELL_MS
+#define AVI_MIN_DWELL_MS 600000UL       // no switching back within 10 min
+#endif
+#ifndef AVI_LAMP_SETTLE_MS
+#define AVI_LAMP_SETTLE_MS 500          // ignore current right after a switch
+#endif
+#ifndef AVI_LAMP_MIN_MA
+#define AVI_LAMP_MIN_MA 40
+#endif
+#ifndef AVI_LAMP_MAX_MA
+#define AVI_LAMP_MAX_MA 400
+#endif
+#ifndef AVI_LAMP_LEAK_MA
+#define AVI_LAMP_LEAK_MA 15             // more than this while off = stuck on
+#endif
+#ifndef AVI_FAULT_CONFIRM_MS
+#define AVI_FAULT_CONFIRM_MS 2000
+#endif
+#ifndef AVI_TEST_PERIOD_MS
+#define AVI_TEST_PERIOD_MS 86400000UL   // daylight self-test once a day
+#endif
+#ifndef AVI_TEST_FIRST_MS
+#define AVI_TEST_FIRST_MS 60000UL       // first one soon after boot
+#endif
+#ifndef AVI_TEST_MS
+#define AVI_TEST_MS 3000
+#endif
+
+enum AviMode : uint8_t { AVI_DAY, AVI_NIGHT, AVI_TEST };
+
+struct AviStatus {
+  AviMode  mode;
+  bool     lampOn;          // commanded output
+  bool     fault;           // lamp current wrong (drives alarmAviation)
+  uint16_t filteredLux;
+  uint32_t switches;        // day/night changes since reset
+  uint16_t testsPassed;
+  uint16_t testsFailed;
+};
+
+// Start over; the first step seeds the filter and picks day/night at once
+void aviLogicReset(uint32_t now);
+
+// One sample. thresholdLux is the ON level (gLive.LDRThreshold).
+// Returns the lamp command.
+bool aviLogicStep(uint16_t lux, uint16_t lampMa, uint16_t thresholdLux, uint32_t now);
+
+// Run a self-test at the next daylight step
+void aviLogicRequestTest();
+
+const AviStatus& aviLogicStatus();
@@ -0,0 +1,83 @@
+#include "Boot.h"
+#include <STM32FreeRTOS.h>
+#include "StaticAlloc.h"
+
+static uint32_t stepStartUs[BOOT_STEP_COUNT];
+static uint32_t stepDurUs[BOOT_STEP_COUNT];
+static uint32_t firstFrameUs = 0, interactiveUs = 0, doneUs = 0;
+static volatile bool done = false;
+
+static TaskHandle_t deferredHandle = nullptr;
+static const uint16_t DEFERRED_STACK_WORDS = 384;   // password hash + Serial
+static const UBaseType_t DEFERRED_PRIORITY = tskIDLE_PRIORITY + 1;   // below UI
+TASK_MEM(boot, DEFERRED_STACK_WORDS);
+
+#define BOOT_STEP_FN(id, ctx, est) bootStep_##id,
+static void (*const STEP_FN[BOOT_STEP_COUNT])() = { BOOT_STEPS(BOOT_STEP_FN) };
+#undef BOOT_STEP_FN
+
+static void report(){
+#if BOOT_LOG
+  for (uint8_t i = 0; i < BOOT_STEP_COUNT; i++) {
+    Serial.print("BOOT ");
+    Serial.print(BOOT_STEP_INFO_TABLE[i].name);
+    Serial.print(" ctx=");
+    Serial.print(bootCtxName(BOOT_STEP_INFO_TABLE[i].ctx));
+    Serial.print(" start_us=");
+    Serial.print(stepStartUs[i]);
+    Serial.print(" dur_us=");
+    Serial.println(stepDurUs[i]);
+  }
+  Serial.print("BOOT first_frame_us=");
+  Serial.print(firstFrameUs);
+  Serial.print(" interactive_us=");
+  Serial.print(interactiveUs);
+  Serial.print(" done_us=");
+  Serial.println(doneUs);
+#endif
+}
+
+static void runSteps(BootCtx ctx){
+  for (uint8_t i = 0; i < BOOT_STEP_COUNT; i++) {
+    if (BOOT_STEP_INFO_TABLE[i].ctx != ctx) continue;
+    stepStartUs[i] = micros();
+    STEP_FN[i]();
+    stepDurUs[i] = micros() - stepStartUs[i];
+  }
+}
+
+static void runDeferred(){
+  runSteps(BOOT_CTX_DEFERRED);
+  // Critical section as a barrier: the step results are visible before done
+  taskENTER_CRITICAL();
+  doneUs = micros();
+  done = true;
+  taskEXIT_CRITICAL();
+  report();
+}
+
+static void deferredTask(void*){
+  runDeferred();
+  vTaskDelete(nullptr);
+}
+
+void bootRun(BootCtx ctx){
+#if BOOT_SERIAL_WAIT_MS
+  if (ctx == BOOT_CTX_SETUP) {
+    while (!Serial && millis() < BOOT_SERIAL_WAIT_MS) { }
+  }
+#endif
+  runSteps(ctx);
+  if (ctx == BOOT_CTX_SETUP &&
+      !TASK_START(deferredTask, "BOOT", boot, DEFERRED_STACK_WORDS,
+                  DEFERRED_PRIORITY, &deferredHandle)) {
+    Serial.println("WARN: boot task not started, deferred init runs inline");
+    runDeferred();
+  }
+}
+
+void bootFirstFrame(){ if (!firstFrameUs) firstFrameUs = micros(); }
+void bootInteractive(){ if (!interactiveUs) interactiveUs = micros(); }
+bool bootDone(){ return done; }
+
+uint32_t bootStepUs(BootStep s){ return s < BOOT_STEP_COUNT ? stepDurUs[s] : 0; }
@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+#include "BootPlan.h"
+
+// ===== Staged boot =====
+// Runs the BootPlan.h steps: setup() calls bootRun(BOOT_CTX_SETUP), which
+// ends by creating the one-shot deferred task; the UI task calls
+// bootRun(BOOT_CTX_UI) and bootInteractive() before its first loop. Each
+// step is a bootStep_<id>() function the sketch provides.
+//
+// Every step is timestamped (micros since reset); with BOOT_LOG the
+// deferred task prints them when it is done:
+//   BOOT <step> ctx=<ctx> start_us=<t> dur_us=<d>
+//   BOOT first_frame_us=<t> interactive_us=<t> done_us=<t>
+
+#ifndef BOOT_LOG
+#define BOOT_LOG 1
+#endif
+// Wait this long for a USB serial host before booting (0 = never wait: a
+// unit without USB must not hang)
+#ifndef BOOT_SERIAL_WAIT_MS
+#define BOOT_SERIAL_WAIT_MS 0
+#endif
+
+#define BOOT_STEP_DECL(id, ctx, est) void bootStep_##id();
+BOOT_STEPS(BOOT_STEP_DECL)
+#undef BOOT_STEP_DECL
+
+// Run ctx's steps in order
+void bootRun(BootCtx ctx);
+
+// Milestones: the splash is on the panel / the UI loop is about to run
+void bootFirstFrame();
+void bootInteractive();
+
+// The deferred steps have finished (stored code, counters, link are up)
+bool bootDone();
+
+uint32_t bootStepUs(BootStep s);      // measured duration, 0 before it ran
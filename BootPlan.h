@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Boot plan =====
+// Hardware-free list of the boot steps (Boot.h runs it; tools/boot_sim.cpp
+// models it). Steps run in list order within their context:
+//   SETUP     setup(), before the scheduler: only what the first frame
+//             needs, then task creation
+//   UI        the UI task, before its first loop (time-to-interactive)
+//   DEFERRED  a one-shot task below the UI priority, in the UI's idle time
+//
+// estUs is the expected cost on the target at 400 kHz I2C, for the model;
+// the firmware logs the measured ones ("BOOT ..." lines).
+//
+// BOOT_STEP(id, ctx, estUs)
+#define BOOT_STEPS(BOOT_STEP) \
+  BOOT_STEP(I2C,      BOOT_CTX_SETUP,      300)  /* Wire, bus task */                  \
+  BOOT_STEP(SPLASH,   BOOT_CTX_SETUP,    27000)  /* panel init, splash frame */        \
+  BOOT_STEP(TASKS,    BOOT_CTX_SETUP,     1500)  /* UI, health, aviation, tach */      \
+  BOOT_STEP(UI,       BOOT_CTX_UI,        3000)  /* buttons, menu, fan frames, door */ \
+  BOOT_STEP(STORAGE,  BOOT_CTX_DEFERRED,   300)  /* emulated EEPROM into RAM */        \
+  BOOT_STEP(COUNTERS, BOOT_CTX_DEFERRED,   300)  /* fan totals, brown-out detector */  \
+  BOOT_STEP(PASSWORD, BOOT_CTX_DEFERRED,  6000)  /* stored or default code hash */     \
+  BOOT_STEP(REMOTE,   BOOT_CTX_DEFERRED,   500)  /* telemetry / settings link */      \
+  BOOT_STEP(MODBUS,   BOOT_CTX_DEFERRED,   400)  /* RS-485 slave / site master */
+
+enum BootCtx : uint8_t { BOOT_CTX_SETUP, BOOT_CTX_UI, BOOT_CTX_DEFERRED, BOOT_CTX_COUNT };
+
+#define BOOT_STEP_ENUM(id, ctx, est) BOOT_##id,
+enum BootStep : uint8_t { BOOT_STEPS(BOOT_STEP_ENUM) BOOT_STEP_COUNT };
+#undef BOOT_STEP_ENUM
+
+struct BootStepInfo {
+  const char* name;
+  BootCtx ctx;
+  uint32_t estUs;
+};
+
+#define BOOT_STEP_INFO(id, ctx, est) { #id, ctx, est },
+static const BootStepInfo BOOT_STEP_INFO_TABLE[BOOT_STEP_COUNT] = { BOOT_STEPS(BOOT_STEP_INFO) };
+#undef BOOT_STEP_INFO
+
+inline const char* bootCtxName(BootCtx c){
+  return c == BOOT_CTX_SETUP ? "setup" : c == BOOT_CTX_UI ? "ui" : "deferred";
+}
@@ -0,0 +1,66 @@
+#include "CalibLogic.h"
+#include <math.h>
+
+static const float FULL = (float)(1UL << CAL_ADC_BITS);
+
+void calLutConvert(const CalLut& lut, const uint16_t* raw, int32_t* out, uint16_t n){
+  for (uint16_t i = 0; i < n; i++) out[i] = calLutEval(lut, raw[i]);
+}
+
+int32_t calLutMean(const CalLut& lut, const uint16_t* raw, uint16_t n){
+  if (!n) return 0;
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < n; i++) sum += calLutEval(lut, raw[i]);
+  return sum >= 0 ? (sum + n / 2) / n : -((-sum + n / 2) / n);
+}
+
+float calNtcCelsius(float raw){
+  // Half a code from either rail: a shorted or open NTC stays finite
+  float ratio = raw / FULL;
+  const float edge = 0.5f / FULL;
+  if (ratio < edge) ratio = edge;
+  if (ratio > 1.0f - edge) ratio = 1.0f - edge;
+  const float lnR = logf(CAL_NTC_SERIES_OHM * ratio / (1.0f - ratio));
+  return 1.0f / (CAL_NTC_SH_A + CAL_NTC_SH_B * lnR + CAL_NTC_SH_C * lnR * lnR * lnR) - 273.15f;
+}
+
+static int32_t clampCc(int32_t v){
+  return v < CAL_NTC_MIN_CC ? CAL_NTC_MIN_CC : v > CAL_NTC_MAX_CC ? CAL_NTC_MAX_CC : v;
+}
+
+static bool inSpan(float c){
+  return c * 100.0f >= CAL_NTC_MIN_CC && c * 100.0f <= CAL_NTC_MAX_CC;
+}
+
+CalLut calBuildNtc(int32_t* y, uint16_t capacity, int32_t offsetCc, uint8_t shift){
+  if (shift < 1) shift = 1;
+  while (shift < CAL_ADC_BITS && ((1UL << CAL_ADC_BITS) >> shift) + 1 > capacity) shift++;
+  const uint16_t count = (uint16_t)(((1UL << CAL_ADC_BITS) >> shift) + 1);
+
+  // Points on the curve leave the whole chord error (the curve sags away
+  // mid-segment); moving each point by half the mean sag of its two
+  // segments splits that error between the ends and the middle
+  // (segments running into the clamp are left alone)
+  const float half = (float)(1UL << (shift - 1));
+  float prevSag = 0;
+  float c0 = calNtcCelsius(0);
+  for (uint16_t i = 0; i < count; i++) {
+    const float x = (float)((uint32_t)i << shift);
+    float sag = 0, c1 = c0;
+    if (i + 1 < count) {
+      c1 = calNtcCelsius(x + 2 * half);
+      if (inSpan(c0) && inSpan(c1)) sag = calNtcCelsius(x + half) - (c0 + c1) * 0.5f;
+    }
+    const float adj = (i == 0 ? sag : i + 1 == count ? prevSag : (sag + prevSag) * 0.5f) * 0.5f;
+    y[i] = clampCc((int32_t)lroundf((c0 + adj) * 100.0f) + offsetCc);
+    prevSag = sag;
+    c0 = c1;
+  }
+  return CalLut{y, count, shift};
+}
+
+CalLut calBuildLinear(int32_t* y, int32_t atZero, int32_t atFull){
+  y[0] = atZero;
+  y[1] = atFull;
+  return CalLut{y, 2, CAL_ADC_BITS};
+}
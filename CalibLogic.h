@@ -0,0 +1,73 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Sensor linearization =====
+// Hardware-free part of the status sensors (Sensors.h samples the ADC and
+// publishes; tools/calib_bench.cpp checks speed and error on a host).
+//
+// A CalLut maps a raw ADC code to engineering units through points spaced
+// 2^shift codes apart, so a lookup is a shift, a mask and one multiply -
+// no search, no float. Curves are built once (at boot and when the trims
+// change) from the exact formula; the per-sample path never calls log().
+//
+// NTC: thermistor from the ADC input to ground, CAL_NTC_SERIES_OHM from
+// the input to the ADC reference; Steinhart-Hart coefficients of the part.
+// Output in centi-degrees C. Divider: linear, output in mV.
+
+#ifndef CAL_ADC_BITS
+#define CAL_ADC_BITS 12
+#endif
+#ifndef CAL_LUT_SHIFT
+#define CAL_LUT_SHIFT 5                 // 32 codes per segment: 129 points at 12 bits
+#endif
+#define CAL_LUT_POINTS (((1UL << CAL_ADC_BITS) >> CAL_LUT_SHIFT) + 1)
+
+#ifndef CAL_NTC_SERIES_OHM
+#define CAL_NTC_SERIES_OHM 10000.0f
+#endif
+#ifndef CAL_NTC_SH_A                    // 10k B3950 type
+#define CAL_NTC_SH_A 1.009249522e-3f
+#endif
+#ifndef CAL_NTC_SH_B
+#define CAL_NTC_SH_B 2.378405444e-4f
+#endif
+#ifndef CAL_NTC_SH_C
+#define CAL_NTC_SH_C 2.019202697e-7f
+#endif
+#ifndef CAL_NTC_MIN_CC
+#define CAL_NTC_MIN_CC (-5500L)         // clamp, centi-degrees (open / shorted NTC)
+#endif
+#ifndef CAL_NTC_MAX_CC
+#define CAL_NTC_MAX_CC 15000L
+#endif
+
+// A view of points the owner stores (CAL_LUT_POINTS for a curve, 2 for a line)
+struct CalLut {
+  const int32_t* y;
+  uint16_t count;                 // points
+  uint8_t shift;                  // log2 of the codes per segment
+};
+
+// Engineering value for one raw code
+inline int32_t calLutEval(const CalLut& lut, uint16_t raw){
+  const uint16_t i = (uint16_t)(raw >> lut.shift);
+  if (i + 1 >= lut.count) return lut.y[lut.count - 1];
+  const int32_t frac = raw & ((1L << lut.shift) - 1);
+  const int32_t d = lut.y[i + 1] - lut.y[i];
+  return lut.y[i] + ((d * frac + (1L << (lut.shift - 1))) >> lut.shift);
+}
+
+// A block of samples at once; out may not alias raw
+void calLutConvert(const CalLut& lut, const uint16_t* raw, int32_t* out, uint16_t n);
+// Mean of a converted block, rounded
+int32_t calLutMean(const CalLut& lut, const uint16_t* raw, uint16_t n);
+
+// Exact Steinhart-Hart temperature (deg C) at a raw code; the LUT builder
+// and the host reference use it
+float calNtcCelsius(float raw);
+
+// NTC curve plus a trim, in centi-degrees, into y[capacity]; spacing
+// grows past shift if the points do not fit
+CalLut calBuildNtc(int32_t* y, uint16_t capacity, int32_t offsetCc, uint8_t shift = CAL_LUT_SHIFT);
+// Straight line into y[2]: atZero at code 0, atFull at code 2^CAL_ADC_BITS
+CalLut calBuildLinear(int32_t* y, int32_t atZero, int32_t atFull);
@@ -0,0 +1,35 @@
+#include "Crc.h"
+
+uint16_t crc16Ccitt(const uint8_t* p, size_t n, uint16_t crc){
+  while (n--) {
+    crc ^= (uint16_t)(*p++) << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+uint16_t crc16Modbus(const uint8_t* p, size_t n, uint16_t crc){
+  while (n--) {
+    crc ^= *p++;
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+  }
+  return crc;
+}
+
+uint32_t crc32(const uint8_t* p, size_t n){
+  // Nibble table: 64 bytes of flash instead of 1 KB
+  static const uint32_t T[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+    0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+  uint32_t c = 0xFFFFFFFF;
+  while (n--) {
+    c ^= *p++;
+    c = (c >> 4) ^ T[c & 0x0F];
+    c = (c >> 4) ^ T[c & 0x0F];
+  }
+  return ~c;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) - remote link frames
+uint16_t crc16Ccitt(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF);
+
+// CRC-16/MODBUS (poly 0xA001 reflected, init 0xFFFF) - RTU frames, sent low byte first
+uint16_t crc16Modbus(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF);
+
+// CRC-32 (IEEE, reflected) - frame hashes
+uint32_t crc32(const uint8_t* p, size_t n);
@@ -0,0 +1,179 @@
+#include "Dashboard.h"
+#include "AppData.h"
+#include "Modbus.h"
+#include "Strings.h"
+#include "UiFonts.h"
+
+static float sourceValue(uint8_t src){
+  switch (src) {
+    case DS_TEMP:     return statusTempC;
+    case DS_VIN:      return statusVinV;
+    case DS_FAN1_I:   return fan1Current_mA;
+    case DS_FAN2_I:   return fan2Current_mA;
+    case DS_FAN1_P:   return fan1Power_W;
+    case DS_FAN2_P:   return fan2Power_W;
+    case DS_FAN1_RUN: return fan1Run_m;
+    case DS_FAN2_RUN: return fan2Run_m;
+    default:          return 0;
+  }
+}
+
+uint8_t dashFormat(char* out, uint8_t size, float v, uint8_t prec){
+  static const uint32_t POW10[] = { 1, 10, 100, 1000, 10000 };
+  if (prec > 4) prec = 4;
+  const bool neg = v < 0;
+  if (neg) v = -v;
+  const uint32_t scaled = (uint32_t)(v * POW10[prec] + 0.5f);
+  const unsigned long ip = (unsigned long)(scaled / POW10[prec]);
+  const unsigned long fp = (unsigned long)(scaled % POW10[prec]);
+  int n = prec ? snprintf(out, size, "%s%lu.%0*lu", neg ? "-" : "", ip, (int)prec, fp)
+               : snprintf(out, size, "%s%lu", neg ? "-" : "", ip);
+  if (n < 0) n = 0;
+  return (uint8_t)(n >= size ? size - 1 : n);
+}
+
+Dashboard::Dashboard(U8G2& display, const DashWidget* widgets, uint8_t count)
+  : u8g2_(display), w_(widgets),
+    count_(count > DASH_MAX_WIDGETS ? DASH_MAX_WIDGETS : count), pages_(0),
+    spark_(display, 0, 0, DASH_TREND_W, DASH_TREND_H) {
+  for (uint8_t i = 0; i < count_; i++) {
+    if (w_[i].page + 1 > pages_) pages_ = (uint8_t)(w_[i].page + 1);
+    cache_[i].valid = false;
+  }
+}
+
+// Re-format a value widget's text if its value changed (font: UI_FONT_VALUE)
+bool Dashboard::refresh(const DashWidget& w, Cache& c){
+  const float v = sourceValue(w.src);
+  if (c.valid && v == c.value) return false;
+  uint8_t n = (uint8_t)strlen(w.label);
+  if (n > sizeof(c.text) - 1) n = sizeof(c.text) - 1;
+  memcpy(c.text, w.label, n);
+  n += dashFormat(c.text + n, (uint8_t)(sizeof(c.text) - n), v, w.prec);
+  strncpy(c.text + n, w.units, sizeof(c.text) - 1 - n);
+  c.text[sizeof(c.text) - 1] = 0;
+  c.textW = (uint8_t)u8g2_.getStrWidth(c.text);
+  c.value = v;
+  c.valid = true;
+  formats_++;
+  return true;
+}
+
+// What a trend or site widget shows; a change means a redraw
+uint32_t Dashboard::signature(const DashWidget& w) const {
+  if (w.type == DW_TREND) return historyGeneration((HistRes)w.res);
+  ModbusSite site;
+  modbusSiteGet(site);
+  uint32_t h = 2166136261UL;                    // FNV-1a over the drawn fields
+  auto mix = [&h](uint32_t v){ h = (h ^ v) * 16777619UL; };
+  mix(site.count);
+  mix(site.online);
+  mix(site.cycleMs);
+  for (uint8_t i = 0; i < site.count && i < MB_MAX_NODES; i++) {
+    const ModbusSiteNode& n = site.node[i];
+    mix(n.addr);
+    mix(n.online);
+    mix((uint16_t)n.tempDc);
+    mix(n.alarms);
+  }
+  return h;
+}
+
+// Screen area a widget can cover (values: textW wide, font set by caller)
+DashBox Dashboard::box(const DashWidget& w, uint8_t textW){
+  const int16_t right = (int16_t)u8g2_.getDisplayWidth();
+  if (w.type == DW_VALUE) {
+    const int16_t h = u8g2_.getMaxCharHeight();
+    return { w.x, (int16_t)(w.y - h), textW, (uint8_t)(h - u8g2_.getDescent() + 1) };
+  }
+  if (w.type == DW_TREND) return { w.x, w.y, (uint8_t)(right - w.x), (uint8_t)(DASH_TREND_H + 2) };
+  return { w.x, (int16_t)(w.y - 7), (uint8_t)(right - w.x),
+           (uint8_t)(u8g2_.getDisplayHeight() - (w.y - 7)) };   // header and 4x4 grid to the bottom
+}
+
+void Dashboard::drawValue(const DashWidget& w, Cache& c){
+  u8g2_.setFont(UI_FONT_VALUE);
+  refresh(w, c);
+  u8g2_.drawStr(w.x, w.y, c.text);
+}
+
+void Dashboard::drawTrend(const DashWidget& w){
+  spark_.moveTo(w.x, w.y);
+  spark_.bind((HistChannel)w.src, (HistRes)w.res);
+  spark_.draw();
+
+  const int tx = w.x + DASH_TREND_W + 3;
+  char buf[12];
+  u8g2_.setFont(UI_FONT_SMALL);
+  u8g2_.drawStr(tx, w.y + 5, w.label);
+  dashFormat(buf, sizeof(buf), spark_.hi(), w.prec);
+  u8g2_.drawStr(tx, w.y + 13, buf);
+  dashFormat(buf, sizeof(buf), spark_.lo(), w.prec);
+  u8g2_.drawStr(tx, w.y + DASH_TREND_H, buf);
+}
+
+void Dashboard::drawSite(const DashWidget& w){
+  static const uint8_t COLS = 4, CELL_W = 32, CELL_H = 10;
+  ModbusSite site;
+  modbusSiteGet(site);
+  char buf[24];
+  u8g2_.setFont(UI_FONT_SMALL);
+  if (!site.count) {
+    u8g2_.drawStr(w.x, w.y, S_DASH_SITE_OFF);
+    return;
+  }
+  snprintf(buf, sizeof(buf), S_DASH_SITE_FMT, (unsigned)site.online, (unsigned)site.count,
+           (unsigned)site.cycleMs);
+  u8g2_.drawStr(w.x, w.y, buf);
+
+  for (uint8_t i = 0; i < site.count && i < COLS * 4; i++) {
+    const ModbusSiteNode& n = site.node[i];
+    const int cx = w.x + (i % COLS) * CELL_W;
+    const int cy = w.y + 2 + (i / COLS) * CELL_H;
+    uint8_t k = (uint8_t)snprintf(buf, sizeof(buf), "%u ", (unsigned)n.addr);
+    if (n.online) dashFormat(buf + k, (uint8_t)(sizeof(buf) - k), n.tempDc / 10.0f, 1);
+    else          strncpy(buf + k, "--", sizeof(buf) - k);
+    const bool alarm = n.online && n.alarms;
+    if (alarm) {
+      u8g2_.drawBox(cx, cy, CELL_W - 1, CELL_H - 1);
+      u8g2_.setDrawColor(0);
+    }
+    u8g2_.drawStr(cx + 1, cy + 7, buf);
+    u8g2_.setDrawColor(1);
+  }
+}
+
+void Dashboard::draw(uint8_t page){
+  for (uint8_t i = 0; i < count_; i++) {
+    if (w_[i].page != page) continue;
+    if (w_[i].type == DW_VALUE) {
+      drawValue(w_[i], cache_[i]);
+      continue;
+    }
+    cache_[i].sig = signature(w_[i]);
+    cache_[i].valid = true;
+    if (w_[i].type == DW_TREND) drawTrend(w_[i]);
+    else                        drawSite(w_[i]);
+  }
+}
+
+uint8_t Dashboard::changes(uint8_t page, DashBox* out, uint8_t max){
+  uint8_t n = 0;
+  u8g2_.setFont(UI_FONT_VALUE);
+  for (uint8_t i = 0; i < count_ && n < max; i++) {
+    if (w_[i].page != page) continue;
+    Cache& c = cache_[i];
+    if (w_[i].type == DW_VALUE) {
+      const uint8_t was = c.valid ? c.textW : 0;
+      if (!refresh(w_[i], c)) continue;
+      out[n++] = box(w_[i], c.textW > was ? c.textW : was);   // the old text goes too
+      continue;
+    }
+    const uint32_t sig = signature(w_[i]);
+    if (c.valid && sig == c.sig) continue;
+    c.sig = sig;
+    c.valid = true;
+    out[n++] = box(w_[i], 0);
+  }
+  return n;
+}
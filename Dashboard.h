@@ -0,0 +1,99 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "Sparkline.h"
+
+// ===== Idle dashboard =====
+// Idle pages are a table of widgets (DashboardLayout.h); adding a page is a
+// matter of adding rows. Value widgets keep their formatted text and only
+// re-format when the bound value changes (float printing is the expensive
+// part of the old per-frame print sequence).
+//
+// While the last frame stays in the buffer, changes() reports the boxes of
+// the widgets whose content changed since they were drawn (a value's text,
+// a trend's history generation, the site snapshot); the UI clears and
+// redraws only those, so an idle page with steady telemetry draws nothing.
+
+#ifndef DASH_MAX_WIDGETS
+#define DASH_MAX_WIDGETS 16
+#endif
+#ifndef DASH_TREND_W
+#define DASH_TREND_W 60
+#endif
+#ifndef DASH_TREND_H
+#define DASH_TREND_H 24
+#endif
+
+enum DashWidgetType : uint8_t {
+  DW_VALUE,           // "<label><value><units>" at (x, baseline y), 6x12 font
+  DW_TREND,           // sparkline at (x, y) top-left + label and hi/lo scale
+  DW_SITE             // Modbus master: header at (x, baseline y), then a 4x4
+                      // grid of "addr temp" cells, inverted on alarm
+};
+
+// Telemetry a DW_VALUE widget can show
+enum DashSource : uint8_t {
+  DS_TEMP, DS_VIN, DS_FAN1_I, DS_FAN2_I, DS_FAN1_P, DS_FAN2_P,
+  DS_FAN1_RUN, DS_FAN2_RUN,
+  DS_COUNT
+};
+
+struct DashBox {
+  int16_t x, y;
+  uint8_t w, h;
+};
+
+struct DashWidget {
+  uint8_t page;
+  DashWidgetType type;
+  uint8_t src;        // DashSource (DW_VALUE) or HistChannel (DW_TREND)
+  uint8_t res;        // HistRes (DW_TREND only)
+  uint8_t x, y;
+  uint8_t prec;       // decimals
+  const char* label;
+  const char* units;
+};
+
+class Dashboard {
+public:
+  Dashboard(U8G2& display, const DashWidget* widgets, uint8_t count);
+
+  uint8_t pageCount() const { return pages_; }
+
+  // Draw one page into the current buffer
+  void draw(uint8_t page);
+
+  // Boxes (up to max) of page's widgets that changed since last drawn. The
+  // change counts as taken: the caller must redraw those boxes.
+  uint8_t changes(uint8_t page, DashBox* out, uint8_t max);
+
+  // Number of value re-formats so far (cache misses)
+  uint32_t formats() const { return formats_; }
+
+private:
+  struct Cache {
+    float value;
+    bool valid;
+    uint8_t textW;    // DW_VALUE: text width, px
+    uint32_t sig;     // DW_TREND: history generation; DW_SITE: snapshot hash
+    char text[20];
+  };
+
+  bool refresh(const DashWidget& w, Cache& c);
+  uint32_t signature(const DashWidget& w) const;
+  DashBox box(const DashWidget& w, uint8_t textW);
+  void drawValue(const DashWidget& w, Cache& c);
+  void drawTrend(const DashWidget& w);
+  void drawSite(const DashWidget& w);
+
+  U8G2& u8g2_;
+  const DashWidget* w_;
+  uint8_t count_;
+  uint8_t pages_;
+  Sparkline spark_;
+  Cache cache_[DASH_MAX_WIDGETS];
+  uint32_t formats_ = 0;
+};
+
+// Fixed-point "%.<prec>f" without float printf; returns chars written
+uint8_t dashFormat(char* out, uint8_t size, float v, uint8_t prec);
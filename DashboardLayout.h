@@ -0,0 +1,21 @@
+#pragma once
+#include "Dashboard.h"
+#include "Strings.h"
+
+// Idle dashboard pages (Up/Down on the idle screen cycles them).
+// Page count follows the highest page number used here.
+static const DashWidget DASH_LAYOUT[] = {
+  // page type      source            res       x   y  prec label            units
+  { 0, DW_VALUE, DS_TEMP,          0,         2, 26, 2, S_DASH_TEMP,     U_DEG_C },
+  { 0, DW_VALUE, DS_VIN,           0,         2, 40, 2, S_DASH_VIN,      U_VOLT  },
+  { 1, DW_VALUE, DS_FAN1_I,        0,         2, 26, 2, S_DASH_F1C,      U_MA    },
+  { 1, DW_VALUE, DS_FAN2_I,        0,         2, 40, 2, S_DASH_F2C,      U_MA    },
+  { 2, DW_VALUE, DS_FAN1_P,        0,         2, 26, 2, S_DASH_F1P,      U_WATT  },
+  { 2, DW_VALUE, DS_FAN2_P,        0,         2, 40, 2, S_DASH_F2P,      U_WATT  },
+  { 3, DW_VALUE, DS_FAN1_RUN,      0,         2, 26, 2, S_DASH_F1RUN,    U_RUN_M },
+  { 3, DW_VALUE, DS_FAN2_RUN,      0,         2, 40, 2, S_DASH_F2RUN,    U_RUN_M },
+  { 4, DW_TREND, HIST_TEMP,        HIST_SEC,  2, 17, 1, S_DASH_TREND_T,  ""      },
+  { 5, DW_TREND, HIST_FAN1_I,      HIST_SEC,  2, 17, 0, S_DASH_TREND_F1, ""      },
+  { 6, DW_SITE,  0,                0,         0, 19, 0, "",              ""      },
+};
+static const uint8_t DASH_LAYOUT_COUNT = sizeof(DASH_LAYOUT) / sizeof(DASH_LAYOUT[0]);
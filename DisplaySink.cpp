@@ -0,0 +1,55 @@
+#include "DisplaySink.h"
+
+static DisplaySink* sinks[DISPLAY_MAX_SINKS];
+static uint16_t sinkUs[DISPLAY_MAX_SINKS];
+static uint8_t sinkCount = 0;
+
+void U8g2Sink::pushFrame(const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                         const FrameDiffSpan* dirty){
+  if (panel_.getBufferTileWidth() != tileW || panel_.getBufferTileHeight() != tileH) return;
+  memcpy(panel_.getBufferPtr(), buf, (size_t)tileW * tileH * 8);
+  if (!dirty) {
+    panel_.sendBuffer();
+    return;
+  }
+  for (uint8_t p = 0; p < tileH; p++) {
+    if (dirty[p].w) panel_.updateDisplayArea(dirty[p].x0, p, dirty[p].w, 1);
+  }
+}
+
+bool displayAddSink(DisplaySink* sink){
+  if (!sink || sinkCount >= DISPLAY_MAX_SINKS) return false;
+  sinks[sinkCount] = sink;
+  sinkUs[sinkCount] = 0;
+  sinkCount++;
+  return true;
+}
+
+void displayPush(U8G2& primary, const FrameDiffSpan* dirty){
+  const uint8_t* buf = primary.getBufferPtr();
+  const uint8_t tw = primary.getBufferTileWidth(), th = primary.getBufferTileHeight();
+  for (uint8_t i = 0; i < sinkCount; i++) {
+    const uint32_t t0 = micros();
+    sinks[i]->pushFrame(buf, tw, th, dirty);
+    const uint32_t us = micros() - t0;
+    sinkUs[i] = (uint16_t)(sinkUs[i] ? (sinkUs[i] * 7u + (us > 0xFFFF ? 0xFFFF : us)) / 8 : (us > 0xFFFF ? 0xFFFF : us));
+  }
+}
+
+uint16_t displaySinkUs(uint8_t index){ return index < sinkCount ? sinkUs[index] : 0; }
+uint8_t displaySinkCount(){ return sinkCount; }
+
+void displayBenchRun(U8G2& primary, Print& out, uint16_t frames){
+  const uint8_t* buf = primary.getBufferPtr();
+  const uint8_t tw = primary.getBufferTileWidth(), th = primary.getBufferTileHeight();
+  out.print("{\"display_sinks\":[");
+  for (uint8_t i = 0; i < sinkCount; i++) {
+    const uint32_t t0 = micros();
+    for (uint16_t k = 0; k < frames; k++) sinks[i]->pushFrame(buf, tw, th, nullptr);
+    const uint32_t us = micros() - t0;
+    out.print(i ? ",{" : "{");
+    out.print("\"us_per_frame\":"); out.print((unsigned long)(frames ? us / frames : 0));
+    out.print("}");
+  }
+  out.println("]}");
+}
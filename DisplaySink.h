@@ -0,0 +1,50 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "FrameDiffLogic.h"
+
+// ===== Display fan-out =====
+// The UI renders each frame once into the primary panel's full buffer and
+// sends it; displayPush() then hands the same buffer to every extra sink
+// (second panel, Serial mirror, ...). Buffers are in SSD1306 page layout:
+// tileH pages of tileW*8 bytes, one byte = 8 vertical pixels. dirty is the
+// primary's flush (one span per page, FrameDiffLogic.h) or nullptr when the
+// whole frame is new.
+
+#ifndef DISPLAY_MAX_SINKS
+#define DISPLAY_MAX_SINKS 3
+#endif
+
+class DisplaySink {
+public:
+  virtual void pushFrame(const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                         const FrameDiffSpan* dirty) = 0;
+};
+
+// Another U8g2 full-buffer panel (any controller with the same geometry).
+// The panel must be begun; it gets the primary's buffer verbatim, so give
+// it the same rotation. It is initialized and reset together with the
+// primary, so it only needs the primary's dirty spans.
+class U8g2Sink : public DisplaySink {
+public:
+  explicit U8g2Sink(U8G2& panel) : panel_(panel) {}
+  void pushFrame(const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                 const FrameDiffSpan* dirty) override;
+private:
+  U8G2& panel_;
+};
+
+// Register a sink (call from setup). False when the table is full.
+bool displayAddSink(DisplaySink* sink);
+
+// Fan the primary's current buffer out to all sinks (after it was sent;
+// dirty = what was sent, nullptr = all of it)
+void displayPush(U8G2& primary, const FrameDiffSpan* dirty = nullptr);
+
+// Mean cost of each sink's pushFrame in us (index = registration order)
+uint16_t displaySinkUs(uint8_t index);
+uint8_t displaySinkCount();
+
+// Push the primary's current buffer `frames` times through each sink and
+// print {"display_sinks":[{"us_per_frame":...},...]} (UI_BENCH)
+void displayBenchRun(U8G2& primary, Print& out, uint16_t frames);
@@ -0,0 +1,203 @@
+#include "DrawBench.h"
+#include "IconAtlas.h"
+#include "AppData.h"
+#include "DashboardLayout.h"
+#include "UiFonts.h"
+#include "FanSprite.h"
+#include "images.h"
+
+// ===== Timer =====
+// DWT cycle counter where the core has one (M3/M4/M7), micros() otherwise
+#if defined(DWT) && defined(CoreDebug) && defined(DWT_CTRL_CYCCNTENA_Msk)
+#define BENCH_HAS_DWT 1
+static inline void timerInit(){
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+static inline uint32_t timerNow(){ return DWT->CYCCNT; }
+#else
+#define BENCH_HAS_DWT 0
+static inline void timerInit(){}
+static inline uint32_t timerNow(){ return micros(); }
+#endif
+
+static uint32_t clockHz(){
+#if defined(F_CPU)
+  return (uint32_t)F_CPU;     // STM32 core maps this to SystemCoreClock
+#else
+  return 0;
+#endif
+}
+
+// ===== Cases =====
+// Sizes, fonts and strings are the ones MenuUI actually draws, in the
+// language (and font subset) this build was made for
+struct BenchCase {
+  const char* name;
+  const uint8_t* font;   // nullptr = not a text case
+  void (*run)(U8G2& d, const uint8_t* font);
+};
+
+static void runXbm16(U8G2& d, const uint8_t*)  { d.drawXBMP(0, 44, 16, 16, iconGet(ICON_ID_WATER_16)); }
+static void runXbm24(U8G2& d, const uint8_t*)  { d.drawXBMP(52, 20, 24, 24, iconGet(ICON_ID_STATUS_24)); }
+static void runIconHit24(U8G2& d, const uint8_t*) { iconDraw(d, 52, 20, ICON_ID_ABOUT_24); }
+// Cycle through more compressed icons than cache slots so every call decodes
+static void runIconMiss(U8G2& d, const uint8_t*) {
+  static const IconId ids[] = {
+    ICON_ID_ABOUT_24, ICON_ID_ALARMS_24, ICON_ID_SETTINGS_24, ICON_ID_STATUS_24,
+    ICON_ID_ABOUT_16, ICON_ID_LIGHT_16
+  };
+  static uint8_t k = 0;
+  iconDraw(d, 52, 20, ids[k]);
+  k = (uint8_t)((k + 1) % (sizeof(ids) / sizeof(ids[0])));
+}
+static void runStrTitle(U8G2& d, const uint8_t*)   { d.drawStr(2, 12, FW_DEVICE_NAME); }
+static void runStrLabel(U8G2& d, const uint8_t*)   { d.drawStr(40, 52, S_SETTINGS); }
+static void runStrSmall(U8G2& d, const uint8_t*)   { d.drawStr(10, 58, S_PASS_HINT); }
+static void runStrConfirm(U8G2& d, const uint8_t*) { d.drawStr(16, 36, S_DISCARD_EXIT); }
+static void runStrBold(U8G2& d, const uint8_t*)    { d.drawStr(20, 14, S_ENTER_PASSWORD); }
+static void runBoxTile(U8G2& d, const uint8_t*)    { d.drawBox(36, 14, 56, 40); }
+static void runBoxRow(U8G2& d, const uint8_t*)     { d.drawBox(12, 24, 104, 11); }
+static void runBoxFull(U8G2& d, const uint8_t*)    { d.drawBox(0, 0, 128, 64); }
+static void runFrameDialog(U8G2& d, const uint8_t*){ d.drawFrame(6, 5, 116, 54); }
+static void runFrameDigit(U8G2& d, const uint8_t*) { d.drawFrame(16, 24, 22, 18); }
+static void runWidth(U8G2& d, const uint8_t*)      { (void)d.getStrWidth(S_SETTINGS); }
+static void runPrintFloat(U8G2& d, const uint8_t*) { d.setCursor(2, 26); d.print(27.53f, 2); }
+
+// One generated fan frame (FanSprite.h); uiSetup builds FAN_SPRITE_FRAMES_16
+static void runFanFrame(U8G2&, const uint8_t*) {
+  static uint8_t out[32];
+  static uint16_t turn = 0;
+  fanSpriteRotate(bitmap_logo1, 16, 16, turn, FAN_SPRITE_ROTOR_R_16, out);
+  turn += 2731;                      // ~15 deg per call
+}
+
+// Idle page 0: the former switch-case print sequence vs the dashboard table.
+// The print sequence formats and draws every frame; the dashboard, with the
+// last frame retained (MenuUI.cpp), only clears and redraws the boxes of
+// changed widgets. Both "changed" cases step page 0's telemetry through TELE
+// on every call (each entry differs from the last), so they pay the same
+// formatting work; "unchanged" holds the values: a steady frame's cost.
+static const float TELE[][2] = {
+  {21.37f, 12.04f}, {21.41f, 12.02f}, {21.38f, 11.97f}, {21.52f, 12.11f},
+  {21.49f, 12.06f}, {21.63f, 11.94f}, {21.58f, 12.00f}, {21.44f, 12.08f},
+};
+static const uint8_t TELE_COUNT = sizeof(TELE) / sizeof(TELE[0]);
+static uint8_t teleIdx = 0;
+static void teleStep(){
+  teleIdx = (uint8_t)((teleIdx + 1) % TELE_COUNT);
+  statusTempC = TELE[teleIdx][0];
+  statusVinV  = TELE[teleIdx][1];
+}
+static Dashboard& benchDash(U8G2& d){
+  static Dashboard dash(d, DASH_LAYOUT, DASH_LAYOUT_COUNT);
+  return dash;
+}
+static void idleDashFrame(U8G2& d){
+  DashBox box[DASH_MAX_WIDGETS];
+  const uint8_t n = benchDash(d).changes(0, box, DASH_MAX_WIDGETS);
+  for (uint8_t i = 0; i < n; i++) {
+    d.setClipWindow(box[i].x, box[i].y, box[i].x + box[i].w, box[i].y + box[i].h);
+    d.setDrawColor(0);
+    d.drawBox(box[i].x, box[i].y, box[i].w, box[i].h);
+    d.setDrawColor(1);
+    benchDash(d).draw(0);
+  }
+  d.setMaxClipWindow();
+}
+static void runIdleSwitch(U8G2& d, const uint8_t*) {
+  teleStep();
+  d.setCursor(2, 26); d.print(S_DASH_TEMP); d.print(statusTempC, 2); d.print(U_DEG_C);
+  d.setCursor(2, 40); d.print(S_DASH_VIN); d.print(statusVinV, 2); d.print(U_VOLT);
+}
+static void runIdleDashChanged(U8G2& d, const uint8_t*) {
+  teleStep();
+  idleDashFrame(d);
+}
+static void runIdleDashUnchanged(U8G2& d, const uint8_t*) { idleDashFrame(d); }
+
+static const BenchCase CASES[] = {
+  {"drawXBMP_16x16",           nullptr,            runXbm16},
+  {"drawXBMP_24x24",           nullptr,            runXbm24},
+  {"iconDraw_24x24_cached",    nullptr,            runIconHit24},
+  {"iconDraw_decode",          nullptr,            runIconMiss},
+  {"drawStr_title",            UI_FONT_TITLE,      runStrTitle},
+  {"drawStr_tile",             UI_FONT_TILE,       runStrLabel},
+  {"drawStr_small",            UI_FONT_SMALL,      runStrSmall},
+  {"drawStr_menu",             UI_FONT_MENU,       runStrConfirm},
+  {"drawStr_dialog",           UI_FONT_DIALOG,     runStrBold},
+  {"drawBox_56x40",            nullptr,            runBoxTile},
+  {"drawBox_104x11",           nullptr,            runBoxRow},
+  {"drawBox_128x64",           nullptr,            runBoxFull},
+  {"drawFrame_116x54",         nullptr,            runFrameDialog},
+  {"drawFrame_22x18",          nullptr,            runFrameDigit},
+  {"getStrWidth_title",        UI_FONT_TITLE,      runWidth},
+  {"getStrWidth_tile",         UI_FONT_TILE,       runWidth},
+  {"getStrWidth_small",        UI_FONT_SMALL,      runWidth},
+  {"getStrWidth_menu",         UI_FONT_MENU,       runWidth},
+  {"getStrWidth_dialog",       UI_FONT_DIALOG,     runWidth},
+  {"printFloat_value",         UI_FONT_VALUE,      runPrintFloat},
+  {"idlePage_print_value",     UI_FONT_VALUE,      runIdleSwitch},
+  {"idlePage_dashboard_changed",   nullptr,        runIdleDashChanged},
+  {"idlePage_dashboard_unchanged", nullptr,        runIdleDashUnchanged},
+  {"fanSprite_frame_16x16",    nullptr,            runFanFrame},
+};
+static const uint8_t CASE_COUNT = sizeof(CASES) / sizeof(CASES[0]);
+
+// ===== Runner =====
+void drawBenchRun(U8G2& d, Print& out){
+  timerInit();
+  const float liveTempC = statusTempC, liveVinV = statusVinV;   // the idle cases step these
+  d.clearBuffer();
+  d.setDrawColor(1);
+  d.setFontMode(1);
+  d.setBitmapMode(1);
+
+  // Cost of the empty loop, subtracted from every case
+  uint32_t t0 = timerNow();
+  for (uint16_t i = 0; i < UI_BENCH_ITERS; i++) { __asm__ volatile("" ::: "memory"); }
+  const uint32_t overhead = timerNow() - t0;
+
+  const uint32_t hz = clockHz();
+  out.print("{\"clock_hz\":");   out.print((unsigned long)hz);
+  out.print(",\"timer\":\"");    out.print(BENCH_HAS_DWT ? "dwt" : "micros");
+  out.print("\",\"iters\":");    out.print((unsigned long)UI_BENCH_ITERS);
+  out.print(",\"lang\":\"");   out.print(S_LANG_CODE);
+  out.print("\",\"font_subset\":"); out.print((int)UI_FONT_SUBSET);
+  out.print(",\"results\":[");
+
+  for (uint8_t c = 0; c < CASE_COUNT; c++) {
+    const BenchCase& bc = CASES[c];
+    if (bc.font) d.setFont(bc.font);
+    bc.run(d, bc.font);              // warm-up (font header, caches)
+
+    t0 = timerNow();
+    for (uint16_t i = 0; i < UI_BENCH_ITERS; i++) {
+      bc.run(d, bc.font);
+      __asm__ volatile("" ::: "memory");
+    }
+    uint32_t elapsed = timerNow() - t0;
+    elapsed = elapsed > overhead ? elapsed - overhead : 0;
+    d.clearBuffer();
+
+    // Fixed-point: ticks per op with 2 decimals
+    const uint32_t per100 = (uint32_t)(((uint64_t)elapsed * 100) / UI_BENCH_ITERS);
+    out.print(c ? ",{" : "{");
+    out.print("\"name\":\"");  out.print(bc.name);
+    out.print(BENCH_HAS_DWT ? "\",\"cycles_per_op\":" : "\",\"us_per_op\":");
+    out.print((unsigned long)(per100 / 100)); out.print(".");
+    if (per100 % 100 < 10) out.print("0");
+    out.print((unsigned long)(per100 % 100));
+#if BENCH_HAS_DWT
+    if (hz) {
+      const uint32_t ns = (uint32_t)(((uint64_t)elapsed * 1000000000ULL) / ((uint64_t)hz * UI_BENCH_ITERS));
+      out.print(",\"ns_per_op\":"); out.print((unsigned long)ns);
+    }
+#endif
+    out.print("}");
+  }
+  out.println("]}");
+  statusTempC = liveTempC;
+  statusVinV = liveVinV;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// ===== Drawing primitive micro-benchmarks =====
+// Build with UI_BENCH=1 to run the suite once at boot (before the menu is
+// drawn) and print the results as a single JSON document.
+// tools/draw_bench_host.cpp runs the cases outside U8g2 (icon cache and
+// decode, fan frames) on the host.
+#ifndef UI_BENCH
+#define UI_BENCH 0
+#endif
+
+// Iterations per case (results are reported per operation)
+#ifndef UI_BENCH_ITERS
+#define UI_BENCH_ITERS 200
+#endif
+
+/**
+ * Runs every case against the display buffer (nothing is sent to the panel)
+ * and writes {"clock_hz":...,"timer":"dwt|micros","lang":...,"results":[...]} to out.
+ * The buffer is cleared afterwards.
+ */
+void drawBenchRun(U8G2& display, Print& out);
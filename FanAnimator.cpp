@@ -3,7 +3,7 @@
 FanAnimator::FanAnimator(U8G2& display) : u8g2_(display) {
   // Initialize slots
   for (uint8_t i = 0; i < FAN_ANIMATOR_MAX_FANS; i++) {
-    fans_[i] = {0,0,nullptr,0,0,0,100,0,0,false};
+    fans_[i] = {0,0,nullptr,0,0,0,0,0,false,0xFF};
   }
 }
 
@@ -14,14 +14,19 @@ uint8_t FanAnimator::addFan(int16_t x, int16_t y,
   if (fanCount >= FAN_ANIMATOR_MAX_FANS) return 255;
   fans_[fanCount] = {
     x, y, frames, frameCount, w, h,
-    intervalMs, 0, 0, true
+    fanPhaseRateInterval(intervalMs, frameCount), 0, true, 0xFF
   };
   return fanCount++;
 }
 
 void FanAnimator::setFanSpeed(uint8_t idx, uint32_t intervalMs) {
   if (idx >= fanCount) return;
-  fans_[idx].intervalMs = intervalMs;
+  fans_[idx].rate = fanPhaseRateInterval(intervalMs, fans_[idx].frameCount);
+}
+
+void FanAnimator::setFanRpm(uint8_t idx, uint32_t rpm) {
+  if (idx >= fanCount) return;
+  fans_[idx].rate = fanPhaseRateRpm(rpm);
 }
 
 void FanAnimator::moveFan(uint8_t idx, int16_t x, int16_t y) {
@@ -36,28 +41,40 @@ void FanAnimator::setFanVisible(uint8_t idx, bool visible) {
 }
 
 void FanAnimator::update() {
-  const uint32_t now = millis();
+  update(millis());
+}
+
+void FanAnimator::update(uint32_t now) {
+  // One time step for all fans; speed changes keep the current phase
+  const uint32_t dt = started_ ? (uint32_t)(now - lastUpdate_) : 0;
+  lastUpdate_ = now;
+  started_ = true;
   for (uint8_t i = 0; i < fanCount; i++) {
     Fan& f = fans_[i];
     if (!f.visible || f.frameCount == 0 || f.frames == nullptr) continue;
-
-    if ((uint32_t)(now - f.lastTick) >= f.intervalMs) {
-      f.frameIndex++;
-      if (f.frameIndex >= f.frameCount) f.frameIndex = 0;
-      f.lastTick = now;
-    }
+    f.phase = fanPhaseAdvance(f.phase, f.rate, dt);
   }
 }
 
 void FanAnimator::draw() {
   for (uint8_t i = 0; i < fanCount; i++) {
     Fan& f = fans_[i];
-    if (!f.visible || f.frameCount == 0 || f.frames == nullptr) continue;
-    const uint8_t* bmp = f.frames[f.frameIndex];
-    u8g2_.drawXBMP(f.x, f.y, f.w, f.h, bmp);
+    if (!f.visible || f.frameCount == 0 || f.frames == nullptr) { f.shown = 0xFF; continue; }
+    f.shown = fanPhaseFrame(f.phase, f.frameCount);
+    u8g2_.drawXBMP(f.x, f.y, f.w, f.h, f.frames[f.shown]);
   }
 }
 
+bool FanAnimator::changed(uint8_t idx, int16_t& x, int16_t& y, uint8_t& w, uint8_t& h) const {
+  if (idx >= fanCount) return false;
+  const Fan& f = fans_[idx];
+  const bool drawn = f.visible && f.frameCount && f.frames;
+  const uint8_t want = drawn ? fanPhaseFrame(f.phase, f.frameCount) : 0xFF;
+  if (want == f.shown) return false;
+  x = f.x; y = f.y; w = f.w; h = f.h;
+  return true;
+}
+
 void FanAnimator::drawScene(bool clearBuffer, bool sendBuffer) {
   if (clearBuffer) u8g2_.clearBuffer();
   draw();
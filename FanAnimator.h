@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include <U8g2lib.h>
+#include "FanPhase.h"
 
 // You can override this before including the header if you want more fans.
 #ifndef FAN_ANIMATOR_MAX_FANS
@@ -27,15 +28,23 @@ public:
                  uint32_t intervalMs);
 
   void setFanSpeed(uint8_t idx, uint32_t intervalMs);
+  // Turn at a rate proportional to a measured fan speed (see FanPhase.h)
+  void setFanRpm(uint8_t idx, uint32_t rpm);
   void moveFan(uint8_t idx, int16_t x, int16_t y);
   void setFanVisible(uint8_t idx, bool visible);
 
-  // Advance animations based on millis() (non-blocking)
+  // Advance every fan's phase by the time since the last call (non-blocking)
   void update();
+  // Same, with an explicit timestamp (used by deterministic trace replay)
+  void update(uint32_t now);
 
   // Draw all fans into the CURRENT U8g2 buffer (does not clear or send)
   void draw();
 
+  // True (and the fan's box) if draw() would show fan idx differently from
+  // the last time: with the last frame retained, only that box needs redrawing
+  bool changed(uint8_t idx, int16_t& x, int16_t& y, uint8_t& w, uint8_t& h) const;
+
   // Convenience: clear → draw fans → send
   void drawScene(bool clearBuffer = true, bool sendBuffer = true);
 
@@ -50,13 +59,15 @@ private:
     uint8_t frameCount;
     uint8_t w;
     uint8_t h;
-    uint32_t intervalMs;
-    uint8_t frameIndex;
-    uint32_t lastTick;
+    uint32_t rate;                // phase units per ms
+    uint32_t phase;               // 2^32 = one pass through all frames
     bool visible;
+    uint8_t shown;                // frame last drawn, 0xFF = none
   };
 
   U8G2& u8g2_;
   Fan fans_[FAN_ANIMATOR_MAX_FANS];
   uint8_t fanCount = 0;
+  uint32_t lastUpdate_ = 0;
+  bool started_ = false;
 };
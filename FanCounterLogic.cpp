@@ -0,0 +1,42 @@
+#include "FanCounterLogic.h"
+#include <string.h>
+
+static const uint64_t UJ_PER_WH = 3600000000ULL;
+static const uint32_t MS_PER_H = 3600000UL;
+
+static uint64_t totalEnergy(const FanCounters& c){
+  uint64_t e = 0;
+  for (uint8_t i = 0; i < FAN_COUNTER_FANS; i++) e += c.fan[i].energyUj;
+  return e;
+}
+
+void fanCountersInit(FanCounters& c, const FanTotals* saved){
+  memset(&c, 0, sizeof(c));
+  if (saved) memcpy(c.fan, saved, sizeof(c.fan));
+  c.energyAtCommitUj = totalEnergy(c);
+}
+
+void fanCountersStep(FanCounters& c, uint32_t dtMs, const uint32_t* powerMw){
+  c.sinceCommitMs = c.sinceCommitMs + dtMs < c.sinceCommitMs ? 0xFFFFFFFFUL : c.sinceCommitMs + dtMs;
+  for (uint8_t i = 0; i < FAN_COUNTER_FANS; i++) {
+    if (powerMw[i] < FAN_COUNTER_RUN_MW) continue;
+    c.fan[i].runMs += dtMs;
+    c.fan[i].energyUj += (uint64_t)powerMw[i] * dtMs;
+    c.dirty = true;
+  }
+}
+
+FanCommitReason fanCountersCommitDue(const FanCounters& c, bool brownout){
+  if (!c.dirty) return FC_NONE;
+  if (brownout) return c.sinceCommitMs >= FAN_COUNTER_BROWNOUT_GAP_S * 1000UL ? FC_BROWNOUT : FC_NONE;
+  if (c.sinceCommitMs >= FAN_COUNTER_COMMIT_H * MS_PER_H) return FC_TIME;
+  if (c.sinceCommitMs >= FAN_COUNTER_MIN_GAP_H * MS_PER_H &&
+      totalEnergy(c) - c.energyAtCommitUj >= FAN_COUNTER_DELTA_WH * UJ_PER_WH) return FC_DELTA;
+  return FC_NONE;
+}
+
+void fanCountersCommitted(FanCounters& c){
+  c.energyAtCommitUj = totalEnergy(c);
+  c.sinceCommitMs = 0;
+  c.dirty = false;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Fan run-time and energy counters =====
+// Hardware-free part of the persisted fan counters (FanCounters.h feeds it
+// from the UI loop and commits to Storage; tools/fan_counter_sim.cpp runs
+// it for simulated years).
+//
+// Each sample adds dt to the run time of every fan drawing at least
+// FAN_COUNTER_RUN_MW and power * dt to its energy, in integers (ms and
+// uJ = mW * ms), so totals never lose precision however large they get.
+//
+// Totals live in RAM and are committed in batches, since every commit
+// erases a flash page: when FAN_COUNTER_DELTA_WH has accumulated (but not
+// within FAN_COUNTER_MIN_GAP_H of the last commit), at the latest after
+// FAN_COUNTER_COMMIT_H, and on brown-out (at most every
+// FAN_COUNTER_BROWNOUT_GAP_S, supplies can dip repeatedly).
+
+#define FAN_COUNTER_FANS 2
+
+#ifndef FAN_COUNTER_RUN_MW
+#define FAN_COUNTER_RUN_MW 500UL        // drawing less counts as stopped
+#endif
+#ifndef FAN_COUNTER_DELTA_WH
+#define FAN_COUNTER_DELTA_WH 1000UL     // commit early after this much energy
+#endif
+#ifndef FAN_COUNTER_MIN_GAP_H
+#define FAN_COUNTER_MIN_GAP_H 12UL
+#endif
+#ifndef FAN_COUNTER_COMMIT_H
+#define FAN_COUNTER_COMMIT_H 24UL       // commit changes at least this often
+#endif
+#ifndef FAN_COUNTER_BROWNOUT_GAP_S
+#define FAN_COUNTER_BROWNOUT_GAP_S 60UL
+#endif
+
+// What gets persisted, per fan
+struct FanTotals {
+  uint64_t runMs;
+  uint64_t energyUj;
+};
+
+struct FanCounters {
+  FanTotals fan[FAN_COUNTER_FANS];
+  uint64_t energyAtCommitUj;      // all fans, at the last commit
+  uint32_t sinceCommitMs;         // wall time since the last commit
+  bool dirty;                     // totals changed since the last commit
+};
+
+enum FanCommitReason : uint8_t { FC_NONE, FC_DELTA, FC_TIME, FC_BROWNOUT };
+
+// Start from persisted totals (nullptr: from zero)
+void fanCountersInit(FanCounters& c, const FanTotals* saved);
+
+// One sample: powerMw[i] is fan i's draw over the last dtMs
+void fanCountersStep(FanCounters& c, uint32_t dtMs, const uint32_t* powerMw);
+
+// Whether to commit now; brownout = the supply is failing
+FanCommitReason fanCountersCommitDue(const FanCounters& c, bool brownout);
+
+// Call after the totals were written
+void fanCountersCommitted(FanCounters& c);
+
+inline float fanRunMinutes(const FanTotals& t){ return (float)(t.runMs / 1000) / 60.0f; }
+inline float fanEnergyKwh(const FanTotals& t){ return (float)(t.energyUj / 3600000ULL) / 1e6f; }
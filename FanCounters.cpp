@@ -0,0 +1,128 @@
+#include "FanCounters.h"
+#include <STM32FreeRTOS.h>
+#include <math.h>
+#include <string.h>
+#include "AppData.h"
+#include "HealthMonitor.h"
+#include "StaticAlloc.h"
+#include "Storage.h"
+#include "UiTrace.h"
+
+uint16_t diagCounterCommits = 0;
+
+static FanCounters counters;            // guarded by taskENTER_CRITICAL (UI and PWRF tasks)
+static unsigned long lastMs = 0;
+static bool started = false;
+
+static uint32_t toMw(float w){
+  return w > 0 ? (uint32_t)lroundf(w * 1000.0f) : 0;
+}
+
+static bool save(const FanTotals* totals){
+  if (!storageSave(STORE_FAN_COUNTERS, totals, sizeof(counters.fan))) return false;
+  if (diagCounterCommits < 0xFFFF) diagCounterCommits++;
+  return true;
+}
+
+// ===== Brown-out =====
+#if FAN_COUNTER_BROWNOUT && defined(PVD_IRQn)
+static TaskHandle_t pwrfHandle = nullptr;
+static const uint16_t PWRF_STACK_WORDS = 128;
+static const UBaseType_t PWRF_PRIORITY = configMAX_PRIORITIES - 1;   // above everything
+TASK_MEM(pwrf, PWRF_STACK_WORDS);
+
+// The supply is falling through the PVD threshold: wake the commit task.
+// No flash from here - the ISR could land in the middle of a storageSave().
+extern "C" void HAL_PWR_PVDCallback(){
+  BaseType_t woken = pdFALSE;
+  if (pwrfHandle) vTaskNotifyGiveFromISR(pwrfHandle, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+extern "C" void PVD_IRQHandler(){
+  HAL_PWR_PVD_IRQHandler();
+}
+
+// Last chance to write. A save already in progress (the service's own
+// commit, the unlock code) holds the storage lock; we wait it out with its
+// task raised to our priority, then write the newer totals.
+static void pwrfTask(void*){
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    FanTotals snapshot[FAN_COUNTER_FANS];
+    taskENTER_CRITICAL();
+    const bool due = fanCountersCommitDue(counters, true) != FC_NONE;
+    if (due) memcpy(snapshot, counters.fan, sizeof(snapshot));
+    taskEXIT_CRITICAL();
+    if (due && save(snapshot)) {
+      taskENTER_CRITICAL();
+      fanCountersCommitted(counters);
+      taskEXIT_CRITICAL();
+    }
+  }
+}
+
+static void brownoutArm(){
+  if (!TASK_START(pwrfTask, "PWRF", pwrf, PWRF_STACK_WORDS,
+                  PWRF_PRIORITY, &pwrfHandle)) return;   // no task: leave PVD off
+  healthRegisterTask(pwrfHandle, PWRF_STACK_WORDS);
+  PWR_PVDTypeDef cfg = {};
+  cfg.PVDLevel = FAN_COUNTER_PVD_LEVEL;
+  cfg.Mode = PWR_PVD_MODE_IT_RISING;            // PVDO rises as VDD falls
+  __HAL_RCC_PWR_CLK_ENABLE();
+  HAL_PWR_ConfigPVD(&cfg);
+  HAL_PWR_EnablePVD();
+  // Lowest priority: may use the FromISR API
+  HAL_NVIC_SetPriority(PVD_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(PVD_IRQn);
+}
+#else
+static void brownoutArm(){}
+#endif
+
+// ===== Task side =====
+static void publish(){
+  fan1Run_m = fanRunMinutes(counters.fan[0]);
+  fan2Run_m = fanRunMinutes(counters.fan[1]);
+  fan1Energy_kWh = fanEnergyKwh(counters.fan[0]);
+  fan2Energy_kWh = fanEnergyKwh(counters.fan[1]);
+}
+
+void fanCountersStart(){
+  FanTotals saved[FAN_COUNTER_FANS];
+  const bool ok = storageLoad(STORE_FAN_COUNTERS, saved, sizeof(saved));
+  fanCountersInit(counters, ok ? saved : nullptr);
+  lastMs = millis();
+  started = true;
+  publish();
+  brownoutArm();
+}
+
+void fanCountersService(unsigned long now){
+  if (!started) return;
+  const uint32_t dt = (uint32_t)(now - lastMs);
+  lastMs = now;
+  // A trace replay scripts power and run time: nothing real to count
+  if (traceReplaying()) return;
+
+  const uint32_t mw[FAN_COUNTER_FANS] = { toMw(fan1Power_W), toMw(fan2Power_W) };
+  FanTotals snapshot[FAN_COUNTER_FANS];
+  taskENTER_CRITICAL();
+  fanCountersStep(counters, dt, mw);
+  const bool due = fanCountersCommitDue(counters, false) != FC_NONE;
+  if (due) memcpy(snapshot, counters.fan, sizeof(snapshot));
+  taskEXIT_CRITICAL();
+
+  // The page erase stalls for tens of ms: not with interrupts masked
+  if (due) {
+    const bool ok = save(snapshot);
+    taskENTER_CRITICAL();
+    if (ok) fanCountersCommitted(counters);   // only this task adds to the totals
+    taskEXIT_CRITICAL();
+  }
+  publish();
+}
+
+const FanTotals& fanCountersTotals(uint8_t fan){
+  return counters.fan[fan < FAN_COUNTER_FANS ? fan : 0];
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include "FanCounterLogic.h"
+
+// ===== Persisted fan counters =====
+// Run time and energy per fan (FanCounterLogic.h), integrated from
+// fan1Power_W / fan2Power_W every UI loop and kept in the STORE_FAN_COUNTERS
+// record across resets. fanCountersService() publishes fan1Run_m /
+// fan2Run_m and fan1Energy_kWh / fan2Energy_kWh.
+//
+// Where the part has a programmable voltage detector, FAN_COUNTER_PVD_LEVEL
+// arms it; its interrupt wakes a top-priority task that commits the totals
+// while the supply fails (after any save already in progress). The bulk
+// capacitors must hold up to two flash page erases (tens of ms each).
+
+#ifndef FAN_COUNTER_BROWNOUT
+#define FAN_COUNTER_BROWNOUT 1
+#endif
+#ifndef FAN_COUNTER_PVD_LEVEL
+#define FAN_COUNTER_PVD_LEVEL PWR_PVDLEVEL_7   // highest threshold: most hold-up time
+#endif
+
+// ----- Diagnostics -----
+extern uint16_t diagCounterCommits;    // counter records written since boot
+
+// Load the saved totals (after storageInit) and arm the brown-out detector
+void fanCountersStart();
+
+// Integrate the fans' power since the last call; commits when due
+void fanCountersService(unsigned long now);
+
+const FanTotals& fanCountersTotals(uint8_t fan);
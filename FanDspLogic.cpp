@@ -0,0 +1,138 @@
+#include "FanDspLogic.h"
+#include <math.h>
+#include <string.h>
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
+// ===== Kernels =====
+void fdspStatsPortable(const uint16_t* x, uint16_t n, FdspStats& out){
+  uint32_t sum = 0;
+  uint64_t sq = 0;
+  uint16_t lo = 0xFFFF, hi = 0;
+  for (uint16_t i = 0; i < n; i += 4) {
+    const uint32_t a = x[i], b = x[i + 1], c = x[i + 2], d = x[i + 3];
+    sum += a + b + c + d;
+    sq += a * a + b * b + c * c + d * d;     // 4 x 24 bits: no 32-bit overflow
+    uint32_t mx = a > b ? a : b, mx2 = c > d ? c : d;
+    uint32_t mn = a < b ? a : b, mn2 = c < d ? c : d;
+    if (mx2 > mx) mx = mx2;
+    if (mn2 < mn) mn = mn2;
+    if (mx > hi) hi = (uint16_t)mx;
+    if (mn < lo) lo = (uint16_t)mn;
+  }
+  out.sum = sum;
+  out.sumSq = sq;
+  out.min = n ? lo : 0;
+  out.max = hi;
+}
+
+#if defined(__ARM_FEATURE_SIMD32)
+// Two samples per word; codes are below 0x8000, so the signed lanes hold them
+void fdspStats(const uint16_t* x, uint16_t n, FdspStats& out){
+  if (!n) { fdspStatsPortable(x, n, out); return; }
+  int64_t sq = 0;
+  int32_t sum = 0;
+  uint32_t hi, lo;
+  memcpy(&hi, x, 4);
+  lo = hi;
+  for (uint16_t i = 0; i < n; i += 2) {
+    uint32_t v;
+    memcpy(&v, x + i, 4);                    // one LDR
+    sq = __smlald((int16x2_t)v, (int16x2_t)v, sq);
+    sum = __smlad((int16x2_t)v, (int16x2_t)0x00010001, sum);
+    __ssub16((int16x2_t)v, (int16x2_t)hi);   // GE per lane where v >= hi
+    hi = __sel(v, hi);
+    __ssub16((int16x2_t)lo, (int16x2_t)v);   // GE per lane where v <= lo
+    lo = __sel(v, lo);
+  }
+  const uint16_t h0 = (uint16_t)hi, h1 = (uint16_t)(hi >> 16);
+  const uint16_t l0 = (uint16_t)lo, l1 = (uint16_t)(lo >> 16);
+  out.sum = (uint32_t)sum;
+  out.sumSq = (uint64_t)sq;
+  out.max = h0 > h1 ? h0 : h1;
+  out.min = l0 < l1 ? l0 : l1;
+}
+#else
+void fdspStats(const uint16_t* x, uint16_t n, FdspStats& out){
+  fdspStatsPortable(x, n, out);
+}
+#endif
+
+int32_t fdspGoertzelCoeff(float hz, float fsHz){
+  return (int32_t)lroundf(2.0f * cosf(6.2831853f * hz / fsHz) * (1L << FDSP_COEFF_SHIFT));
+}
+
+uint64_t fdspGoertzel(const uint16_t* x, uint16_t n, int32_t mean, int32_t coeff){
+  int32_t s1 = 0, s2 = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    const int32_t s0 = (int32_t)x[i] - mean + (int32_t)(((int64_t)coeff * s1) >> FDSP_COEFF_SHIFT) - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+  const int64_t p = (int64_t)s1 * s1 + (int64_t)s2 * s2
+                  - (((int64_t)coeff * s1) >> FDSP_COEFF_SHIFT) * s2;
+  return p > 0 ? (uint64_t)p : 0;
+}
+
+// ===== Block analysis =====
+void fdspAnalyze(const uint16_t* x, uint16_t n, float fsHz, float bandHz,
+                 float maPerCode, FanWave& out){
+  memset(&out, 0, sizeof(out));
+  if (!n) return;
+  FdspStats st;
+  fdspStats(x, n, st);
+  const float mean = (float)st.sum / n;
+  const float ms = (float)st.sumSq / n;
+  const float rms = sqrtf(ms);
+  const float ac = ms > mean * mean ? sqrtf(ms - mean * mean) : 0.0f;
+  out.meanMa = mean * maPerCode;
+  out.rmsMa = rms * maPerCode;
+  out.rippleMa = ac * maPerCode;
+  out.peakMa = st.max * maPerCode;
+  out.crest = rms > 0 ? st.max / rms : 0;
+
+  if (bandHz <= 0) return;
+  const float step = fsHz / n;
+  const int32_t m = (int32_t)(mean + 0.5f);
+  uint64_t p = 0;
+  for (int8_t b = -(FAN_DSP_BAND_BINS / 2); b <= FAN_DSP_BAND_BINS / 2; b++) {
+    const float f = bandHz + b * step;
+    if (f <= 0 || f >= fsHz / 2) continue;
+    p += fdspGoertzel(x, n, m, fdspGoertzelCoeff(f, fsHz));
+  }
+  out.bandMa = 2.0f * sqrtf((float)p) / n * maPerCode;
+}
+
+static uint8_t penalty(float v, float warn, float fail){
+  if (v <= warn) return 0;
+  if (v >= fail) return 100;
+  return (uint8_t)((v - warn) * 100.0f / (fail - warn));
+}
+
+uint8_t fdspScore(const FanWave& w){
+  if (w.meanMa < FAN_DSP_MIN_MA) return 100;
+  uint8_t worst = penalty(100.0f * w.rippleMa / w.meanMa, FAN_DSP_RIPPLE_WARN, FAN_DSP_RIPPLE_FAIL);
+  const uint8_t crest = penalty(w.crest, FAN_DSP_CREST_WARN, FAN_DSP_CREST_FAIL);
+  const uint8_t band = penalty(100.0f * w.bandMa / w.meanMa, FAN_DSP_BAND_WARN, FAN_DSP_BAND_FAIL);
+  if (crest > worst) worst = crest;
+  if (band > worst) worst = band;
+  return (uint8_t)(100 - worst);
+}
+
+void fdspHealthReset(FanHealthState& s){
+  memset(&s, 0, sizeof(s));
+  s.score = 100;
+}
+
+bool fdspHealthUpdate(FanHealthState& s, uint8_t score){
+  s.score = score;
+  s.blocks++;
+  if (score < FAN_DSP_FAULT_SCORE) {
+    if (s.lowBlocks < 0xFF) s.lowBlocks++;
+  } else {
+    s.lowBlocks = 0;
+  }
+  s.fault = s.lowBlocks >= FAN_DSP_FAULT_BLOCKS;
+  return s.fault;
+}
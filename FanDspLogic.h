@@ -0,0 +1,104 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Fan current waveform analysis =====
+// Hardware-free part of the fan health check (FanHealth.h captures the
+// blocks; tools/fan_dsp_bench.cpp times the kernels and checks them against
+// synthetic waveforms on a host).
+//
+// A block is n raw ADC codes of one fan's current shunt taken at a fixed
+// rate. One pass (fdspStats) gives sum, sum of squares, min and max, hence
+// mean current, RMS, ripple (AC RMS), peak and crest factor. Goertzel bins
+// around the rotation frequency (tach rpm / 60) give the 1x band, where
+// imbalance and bearing wear show up as current modulation well before the
+// fan slows down; restart attempts against a blocked rotor show up as
+// inrush peaks (crest factor). fdspScore maps the ratios to 0..100, and a
+// fan scoring below FAN_DSP_FAULT_SCORE for FAN_DSP_FAULT_BLOCKS blocks in
+// a row is faulty.
+//
+// With the SIMD instructions of the Cortex-M DSP extension (M4/M7/M33) the
+// stats pass loads two samples at a time and uses the dual 16-bit
+// multiply-accumulates; elsewhere (M0/M3, host) it is a 4x unrolled
+// portable loop. Goertzel is a recursion and stays scalar.
+
+#ifndef FAN_DSP_BLOCK
+#define FAN_DSP_BLOCK 256               // samples per block, multiple of 4
+#endif
+#ifndef FAN_DSP_BAND_BINS
+#define FAN_DSP_BAND_BINS 3             // Goertzel bins centred on 1x, odd
+#endif
+#ifndef FAN_DSP_MIN_MA
+#define FAN_DSP_MIN_MA 20.0f            // below: not running, not scored
+#endif
+// Warn / fail levels; the score falls linearly from 100 to 0 between them
+#ifndef FAN_DSP_RIPPLE_WARN
+#define FAN_DSP_RIPPLE_WARN 15.0f       // AC RMS, % of mean
+#endif
+#ifndef FAN_DSP_RIPPLE_FAIL
+#define FAN_DSP_RIPPLE_FAIL 40.0f
+#endif
+#ifndef FAN_DSP_CREST_WARN
+#define FAN_DSP_CREST_WARN 1.5f         // peak / RMS
+#endif
+#ifndef FAN_DSP_CREST_FAIL
+#define FAN_DSP_CREST_FAIL 2.5f
+#endif
+#ifndef FAN_DSP_BAND_WARN
+#define FAN_DSP_BAND_WARN 5.0f          // 1x amplitude, % of mean
+#endif
+#ifndef FAN_DSP_BAND_FAIL
+#define FAN_DSP_BAND_FAIL 20.0f
+#endif
+#ifndef FAN_DSP_FAULT_SCORE
+#define FAN_DSP_FAULT_SCORE 30
+#endif
+#ifndef FAN_DSP_FAULT_BLOCKS
+#define FAN_DSP_FAULT_BLOCKS 3
+#endif
+
+#define FDSP_COEFF_SHIFT 14             // Goertzel coefficient, Q14
+
+struct FdspStats {
+  uint32_t sum;
+  uint64_t sumSq;
+  uint16_t min, max;
+};
+
+// ----- Kernels -----
+// One pass over n codes (12-bit; x 4-byte aligned, n a multiple of 4)
+void fdspStats(const uint16_t* x, uint16_t n, FdspStats& out);
+// The portable loop, also on targets with the DSP extension (bench, checks)
+void fdspStatsPortable(const uint16_t* x, uint16_t n, FdspStats& out);
+
+// 2 cos(2 pi hz / fsHz) in Q14, once per bin
+int32_t fdspGoertzelCoeff(float hz, float fsHz);
+// |X(hz)|^2 of x - mean: a sine of amplitude A codes on a bin gives
+// (A n / 2)^2
+uint64_t fdspGoertzel(const uint16_t* x, uint16_t n, int32_t mean, int32_t coeff);
+
+// ----- Block analysis -----
+struct FanWave {
+  float meanMa, rmsMa;
+  float rippleMa;                       // AC RMS
+  float peakMa;
+  float crest;                          // peak / RMS
+  float bandMa;                         // amplitude around 1x, 0 without rpm
+};
+
+// bandHz = rotation frequency, 0 = skip the band
+void fdspAnalyze(const uint16_t* x, uint16_t n, float fsHz, float bandHz,
+                 float maPerCode, FanWave& out);
+
+// 100 = healthy (also when the fan is not running: the tach judges stalls)
+uint8_t fdspScore(const FanWave& w);
+
+struct FanHealthState {
+  uint8_t score;
+  uint8_t lowBlocks;                    // in a row below FAN_DSP_FAULT_SCORE
+  bool fault;
+  uint32_t blocks;
+};
+
+void fdspHealthReset(FanHealthState& s);
+// Fold one block's score in; returns the fault state
+bool fdspHealthUpdate(FanHealthState& s, uint8_t score);
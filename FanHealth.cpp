@@ -0,0 +1,76 @@
+#include "FanHealth.h"
+#include <STM32FreeRTOS.h>
+#include "AppData.h"
+#include "AviationLight.h"
+#include "FanTach.h"
+#include "Pins.h"
+#include "UiTrace.h"
+
+uint8_t diagFan1Health = 100;
+uint8_t diagFan2Health = 100;
+uint16_t diagFanBlocksLate = 0;
+
+static const UBaseType_t FAN_HEALTH_PRIORITY = tskIDLE_PRIORITY + 3;   // above the UI while sampling
+static const uint32_t BLOCK_SPAN_US = (FAN_DSP_BLOCK - 1) * (1000000UL / configTICK_RATE_HZ);
+
+static FanHealthState health[FAN_TACH_COUNT];
+static volatile bool faults[FAN_TACH_COUNT];
+
+#if FAN_HEALTH
+alignas(4) static uint16_t block[FAN_TACH_COUNT][FAN_DSP_BLOCK];
+static uint16_t fill = 0;
+static bool open = false, started = false;
+static unsigned long lastBlockMs = 0;
+static uint32_t firstUs = 0;
+static UBaseType_t basePriority;
+#endif
+
+bool fanHealthSample(unsigned long now){
+#if FAN_HEALTH
+  if (!open) {
+    if (started && now - lastBlockMs < FAN_HEALTH_PERIOD_MS) return false;
+    started = true;
+    lastBlockMs = now;
+    open = true;
+    fill = 0;
+    basePriority = uxTaskPriorityGet(nullptr);
+    vTaskPrioritySet(nullptr, FAN_HEALTH_PRIORITY);
+  }
+  if (fill == 0) firstUs = micros();
+  block[0][fill] = (uint16_t)analogRead(FAN1_ISENSE_PIN);
+  block[1][fill] = (uint16_t)analogRead(FAN2_ISENSE_PIN);
+  if (++fill < FAN_DSP_BLOCK) return true;
+
+  const uint32_t spanUs = micros() - firstUs;
+  open = false;
+  vTaskPrioritySet(nullptr, basePriority);
+  if (spanUs < BLOCK_SPAN_US - BLOCK_SPAN_US / 20 || spanUs > BLOCK_SPAN_US + BLOCK_SPAN_US / 20) {
+    diagFanBlocksLate++;
+    return false;
+  }
+  fanHealthFeed(block[0], block[1], FAN_DSP_BLOCK, (FAN_DSP_BLOCK - 1) * 1e6f / spanUs);
+#else
+  (void)now;
+#endif
+  return false;
+}
+
+void fanHealthFeed(const uint16_t* fan1, const uint16_t* fan2, uint16_t n, float fsHz){
+  static const float MA_PER_CODE = (float)FAN_ISENSE_FULL_MA / (1UL << AVI_ADC_BITS);
+  const uint16_t* x[FAN_TACH_COUNT] = { fan1, fan2 };
+  FanWave w[FAN_TACH_COUNT];
+  for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) {
+    fdspAnalyze(x[i], n, fsHz, fanTachRpm(i) / 60.0f, MA_PER_CODE, w[i]);
+    faults[i] = fdspHealthUpdate(health[i], fdspScore(w[i]));
+  }
+  diagFan1Health = health[0].score;
+  diagFan2Health = health[1].score;
+  // A trace replay scripts these itself
+  if (traceReplaying()) return;
+  fan1Current_mA = w[0].meanMa;
+  fan2Current_mA = w[1].meanMa;
+}
+
+bool fanHealthFault(uint8_t ch){
+  return ch < FAN_TACH_COUNT && faults[ch];
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <Arduino.h>
+#include "FanDspLogic.h"
+
+// ===== Fan current waveforms =====
+// Each fan's current shunt amplifier (Pins.h) is sampled in blocks of
+// FAN_DSP_BLOCK codes every FAN_HEALTH_PERIOD_MS by the aviation task (the
+// ADC owner) and analysed with FanDspLogic.h. Publishes fan1Current_mA /
+// fan2Current_mA (block mean) and a health score per fan; FanTach.cpp
+// raises alarmFanFault on a waveform fault of a fitted fan as well as on a
+// stall, so a failing fan is flagged while it still turns.
+//
+// A block is taken one conversion per fan per tick (1 kHz), with the task
+// raised to FAN_HEALTH_PRIORITY so the UI cannot delay samples; that costs
+// two conversions, some 30 us, per tick for FAN_DSP_BLOCK ticks. Blocks
+// whose span is off by more than 5 % are dropped. fanHealthFeed() takes
+// whole blocks, so an ADC with DMA can feed it from its transfer callback.
+
+#ifndef FAN_HEALTH
+#define FAN_HEALTH 1                    // 0: demo data fakes the fan currents
+#endif
+#ifndef FAN_HEALTH_PERIOD_MS
+#define FAN_HEALTH_PERIOD_MS 2000UL
+#endif
+#ifndef FAN_ISENSE_FULL_MA
+#define FAN_ISENSE_FULL_MA 2000UL       // shunt amplifier full scale
+#endif
+
+// Diagnostics (read-only menu fields)
+extern uint8_t diagFan1Health;          // %, 100 = healthy
+extern uint8_t diagFan2Health;
+extern uint16_t diagFanBlocksLate;      // blocks dropped for uneven sampling
+
+// Aviation task, every call: starts a block when due and takes one sample
+// pair while it is open. True while a block is open (call again next tick).
+bool fanHealthSample(unsigned long now);
+
+// Analyse one block per fan (n codes each at fsHz) and publish
+void fanHealthFeed(const uint16_t* fan1, const uint16_t* fan2, uint16_t n, float fsHz);
+
+// Waveform fault of fan ch (0, 1); fitted or not is the caller's business
+bool fanHealthFault(uint8_t ch);
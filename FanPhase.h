@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Fan animation phase =====
+// One full icon cycle (all frames) is 2^32 phase units, so the accumulator
+// wraps exactly once per cycle and keeps the sub-frame remainder between
+// updates. Rates are phase units per ms.
+//
+// An icon turns once per FAN_ANIMATOR_RPM_DIV measured revolutions, which
+// keeps real fan speeds (hundreds to thousands of rpm) below the display's
+// frame rate while staying proportional.
+
+#ifndef FAN_ANIMATOR_RPM_DIV
+#define FAN_ANIMATOR_RPM_DIV 25         // 3000 rpm -> 2 icon cycles per second
+#endif
+
+// Rate for a measured fan speed
+static inline uint32_t fanPhaseRateRpm(uint32_t rpm){
+  // cycles per ms = rpm / (60000 * DIV); scaled by 2^32
+  const uint64_t rate = ((uint64_t)rpm << 32) / (60000ULL * FAN_ANIMATOR_RPM_DIV);
+  return rate > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)rate;
+}
+
+// Rate for a fixed "ms per frame" speed
+static inline uint32_t fanPhaseRateInterval(uint32_t intervalMs, uint8_t frameCount){
+  const uint64_t msPerCycle = (uint64_t)intervalMs * frameCount;
+  if (msPerCycle == 0) return 0;
+  return msPerCycle == 1 ? 0xFFFFFFFFUL : (uint32_t)((1ULL << 32) / msPerCycle);
+}
+
+static inline uint32_t fanPhaseAdvance(uint32_t phase, uint32_t rate, uint32_t dtMs){
+  return phase + rate * dtMs;                 // modulo 2^32 = whole cycles
+}
+
+static inline uint8_t fanPhaseFrame(uint32_t phase, uint8_t frameCount){
+  return (uint8_t)(((uint64_t)phase * frameCount) >> 32);
+}
@@ -0,0 +1,51 @@
+#include "FanSprite.h"
+#include <string.h>
+
+// sin(k * 90/16 deg) in Q15, k = 0..16
+static const uint16_t QUARTER_SIN[17] = {
+  0, 3212, 6393, 9512, 12540, 15447, 18205, 20788,
+  23170, 25330, 27246, 28899, 30274, 31357, 32138, 32610, 32767
+};
+
+// sin of turn/65536 of a full turn, Q15
+static int32_t sinQ15(uint16_t turn){
+  const uint8_t quadrant = (uint8_t)(turn >> 14);
+  uint16_t t = turn & 0x3FFF;                     // 0..16383 within the quadrant
+  if (quadrant & 1) t = (uint16_t)(0x4000 - t);   // mirror: sin(90+a) = sin(90-a)
+  const uint8_t k = (uint8_t)(t >> 10);            // 16 steps per quadrant
+  const uint16_t frac = t & 0x3FF;
+  int32_t v = QUARTER_SIN[k];
+  if (k < 16) v += ((int32_t)(QUARTER_SIN[k + 1] - QUARTER_SIN[k]) * frac) >> 10;
+  return (quadrant & 2) ? -v : v;
+}
+
+static inline bool getPixel(const uint8_t* xbm, uint8_t stride, int16_t x, int16_t y){
+  return (xbm[y * stride + (x >> 3)] >> (x & 7)) & 1;
+}
+
+void fanSpriteRotate(const uint8_t* master, uint8_t w, uint8_t h,
+                     uint16_t turn, uint8_t rotorR, uint8_t* out){
+  const uint8_t stride = (uint8_t)((w + 7) / 8);
+  memset(out, 0, (size_t)stride * h);
+  const int32_t s = sinQ15(turn);
+  const int32_t c = sinQ15((uint16_t)(turn + 0x4000));
+  const int32_t r2 = (int32_t)rotorR * rotorR * 4;   // doubled coordinates
+
+  // Doubled coordinates relative to the centre keep half-pixel centres exact
+  for (uint8_t y = 0; y < h; y++) {
+    const int32_t dy = 2 * y - (h - 1);
+    for (uint8_t x = 0; x < w; x++) {
+      const int32_t dx = 2 * x - (w - 1);
+      int16_t sx = x, sy = y;
+      if (dx * dx + dy * dy <= r2) {
+        // Inverse rotation: where in the master does this pixel come from
+        const int32_t rx = dx * c + dy * s;               // Q15, doubled
+        const int32_t ry = dy * c - dx * s;
+        sx = (int16_t)((rx + ((int32_t)(w - 1) << 15) + (1 << 15)) >> 16);
+        sy = (int16_t)((ry + ((int32_t)(h - 1) << 15) + (1 << 15)) >> 16);
+        if (sx < 0 || sy < 0 || sx >= w || sy >= h) continue;
+      }
+      if (getPixel(master, stride, sx, sy)) out[y * stride + (x >> 3)] |= (uint8_t)(1 << (x & 7));
+    }
+  }
+}
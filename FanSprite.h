@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Procedural fan frames =====
+// The fan icon is stored once (images.cpp: bitmap_logo1) and its rotation
+// frames are generated at startup into RAM, in the XBM layout drawXBMP()
+// takes. Only the rotor (pixels within rotorR of the centre) is rotated, so
+// the housing ring stays crisp. Rotation uses a 17-entry Q15 quarter-sine
+// table with linear interpolation and nearest-pixel sampling.
+//
+// The rotor repeats every 360/FAN_SPRITE_BLADES degrees, so that is all the
+// frames of one cycle need to cover. More frames = smoother motion for
+// (w+7)/8*h bytes of RAM each; flash cost is the master alone.
+// tools/fan_sprite_report.cpp prints the tradeoff and build time on a host.
+
+#ifndef FAN_SPRITE_BLADES
+#define FAN_SPRITE_BLADES 3
+#endif
+#ifndef FAN_SPRITE_FRAMES_16
+#define FAN_SPRITE_FRAMES_16 8          // frames per cycle for the 16x16 fan
+#endif
+#ifndef FAN_SPRITE_ROTOR_R_16
+#define FAN_SPRITE_ROTOR_R_16 6         // rotor radius in pixels (ring outside)
+#endif
+
+// Rotate master (XBM, w x h) by turn/65536 of a full turn into out
+void fanSpriteRotate(const uint8_t* master, uint8_t w, uint8_t h,
+                     uint16_t turn, uint8_t rotorR, uint8_t* out);
+
+// Frame cache for one sprite size; a plain aggregate so it can live in the
+// UI arena (StaticAlloc.h). frames[] plugs straight into FanAnimator::addFan.
+template<uint8_t W, uint8_t H, uint8_t N>
+struct FanSpriteSet {
+  static constexpr uint16_t FRAME_BYTES = (uint16_t)((W + 7) / 8 * H);
+  static constexpr uint8_t COUNT = N;
+
+  uint8_t bits[N][FRAME_BYTES];
+  const uint8_t* frames[N];
+
+  void build(const uint8_t* master, uint8_t blades, uint8_t rotorR){
+    for (uint8_t i = 0; i < N; i++) {
+      // Frame i of N across one blade period
+      const uint16_t turn = (uint16_t)(((uint32_t)i << 16) / ((uint32_t)N * blades));
+      fanSpriteRotate(master, W, H, turn, rotorR, bits[i]);
+      frames[i] = bits[i];
+    }
+  }
+};
@@ -0,0 +1,100 @@
+#include "FanTach.h"
+#include <STM32FreeRTOS.h>
+#include "AppData.h"
+#include "FanHealth.h"
+#include "Pins.h"
+#include "PowerManager.h"
+#include "UiTrace.h"
+
+static const uint32_t TACH_PINS[FAN_TACH_COUNT] = { FAN1_TACH_PIN, FAN2_TACH_PIN };
+
+static HardwareTimer* tim = nullptr;
+static TIM_TypeDef* timInst = nullptr;
+static uint32_t channels[FAN_TACH_COUNT];
+static volatile uint16_t overflows = 0;          // upper half of the 32-bit us clock
+static TachEdges edges[FAN_TACH_COUNT];          // ISR-owned; read in a critical section
+static TachState state[FAN_TACH_COUNT];
+static TachDuty duty;
+
+// A capture can land just after the counter wrapped but before the update
+// interrupt ran; a pending update with a small count means "one more wrap"
+static uint32_t extend(uint16_t count){
+  uint16_t hi = overflows;
+  if ((timInst->SR & TIM_SR_UIF) && count < 0x8000) hi++;
+  return ((uint32_t)hi << 16) | count;
+}
+
+static void onOverflow(){ overflows++; }
+
+template<uint8_t CH>
+static void onCapture(){
+  tachEdge(edges[CH], extend((uint16_t)tim->getCaptureCompare(channels[CH])));
+}
+
+static void (*const CAPTURE_ISR[FAN_TACH_COUNT])() = { onCapture<0>, onCapture<1> };
+
+bool fanTachStart(){
+  // All tach pins must be channels of the same timer (shared time base)
+  for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) {
+    const PinName pin = digitalPinToPinName(TACH_PINS[i]);
+    TIM_TypeDef* inst = (TIM_TypeDef*)pinmap_peripheral(pin, PinMap_TIM);
+    if (!inst || (timInst && inst != timInst)) return false;
+    timInst = inst;
+    channels[i] = STM_PIN_CHANNEL(pinmap_function(pin, PinMap_TIM));
+  }
+
+  // Function-local static: constructed here, after the HAL is up, and not
+  // on the heap (STATIC_ALLOC)
+  static HardwareTimer timer(timInst);
+  tim = &timer;
+  tim->setPrescaleFactor(tim->getTimerClkFreq() / 1000000UL);
+  tim->setOverflow(0x10000, TICK_FORMAT);
+  tim->attachInterrupt(onOverflow);
+  for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) {
+    pinMode(TACH_PINS[i], INPUT_PULLUP);        // open-collector tach output
+    tim->setMode(channels[i], TIMER_INPUT_CAPTURE_FALLING, TACH_PINS[i]);
+    tim->attachInterrupt(channels[i], CAPTURE_ISR[i]);
+  }
+
+  const uint32_t now = extend((uint16_t)timInst->CNT);
+  for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) tachReset(state[i], now);
+  tim->resume();
+  tachDutyReset(duty, millis());
+  powerStopHold(POWER_HOLD_TACH, true);         // STOP would halt the timer: stalls, rpm gaps
+  return true;
+}
+
+void fanTachService(){
+  if (!tim) return;
+  // Panel OFF: let STOP halt the timer between capture windows; the last
+  // rpm and alarmFanFault stay published meanwhile
+  bool opened;
+  const bool run = tachDutyTick(duty, powerDisplayOn(), millis(), &opened);
+  powerStopHold(POWER_HOLD_TACH, run);
+  if (!run) return;
+
+  TachEdges taken[FAN_TACH_COUNT];
+  taskENTER_CRITICAL();
+  const uint32_t now = extend((uint16_t)timInst->CNT);
+  for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) {
+    if (opened) edges[i] = {};                  // spans across a STOP are not periods
+    taken[i] = tachTake(edges[i]);
+  }
+  taskEXIT_CRITICAL();
+  if (opened) {
+    for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) tachResume(state[i], now);
+  }
+
+  for (uint8_t i = 0; i < FAN_TACH_COUNT; i++) tachUpdate(state[i], taken[i], now);
+
+  // A trace replay scripts these itself
+  if (traceReplaying()) return;
+  fan1Rpm = state[0].rpm;
+  fan2Rpm = state[1].rpm;
+  alarmFanFault = (gLive.fan1nominal > 0 && (state[0].stalled || fanHealthFault(0))) ||
+                  (gLive.fan2nominal > 0 && (state[1].stalled || fanHealthFault(1)));
+}
+
+uint16_t fanTachRpm(uint8_t ch){ return ch < FAN_TACH_COUNT ? state[ch].rpm : 0; }
+bool fanTachStalled(uint8_t ch){ return ch < FAN_TACH_COUNT && state[ch].stalled; }
+uint32_t fanTachGlitches(uint8_t ch){ return ch < FAN_TACH_COUNT ? state[ch].glitches : 0; }
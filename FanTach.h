@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+#include "FanTachLogic.h"
+
+// ===== Fan tachometers =====
+// Each fan's tach line (Pins.h) goes to a channel of one timer in input
+// capture mode, counting at 1 MHz. The capture ISR timestamps falling edges
+// only; fanTachService() (UI loop) turns them into rpm with FanTachLogic.h,
+// publishes fan1Rpm / fan2Rpm and owns alarmFanFault: a stall or a current
+// waveform fault (FanHealth.h) on a fitted fan (nominal current > 0)
+// raises it. While the panel is OFF the timer only holds STOP off during
+// capture windows (FanTachLogic.h), so the idle task can enter STOP between
+// them.
+
+#define FAN_TACH_COUNT 2                // fan 1, fan 2
+
+// Configure the capture timer; call once in setup()
+bool fanTachStart();
+
+// Sample all channels; cheap, call every UI loop
+void fanTachService();
+
+uint16_t fanTachRpm(uint8_t ch);
+bool fanTachStalled(uint8_t ch);
+uint32_t fanTachGlitches(uint8_t ch);    // edges rejected since start
@@ -0,0 +1,111 @@
+#include "FanTachLogic.h"
+
+static const uint32_t US_PER_MIN = 60000000UL;
+static const uint32_t MIN_EDGE_US = US_PER_MIN / (FAN_TACH_MAX_RPM * FAN_TACH_PPR);
+static const uint32_t STOP_EDGE_US = US_PER_MIN / (FAN_TACH_MIN_RPM * FAN_TACH_PPR);
+
+void tachEdge(TachEdges& e, uint32_t us){
+  if (e.edges == 0) {
+    e.firstUs = e.lastUs = us;
+    e.edges = 1;
+    return;
+  }
+  const uint32_t gap = us - e.lastUs;
+  if (gap < MIN_EDGE_US) { e.glitches++; return; }
+  if (gap >= STOP_EDGE_US) {                 // restart after a stop: not a period
+    e.firstUs = e.lastUs = us;
+    e.edges = 1;
+    return;
+  }
+  e.lastUs = us;
+  if (e.edges < 0xFFFF) e.edges++;
+}
+
+TachEdges tachTake(TachEdges& e){
+  const TachEdges w = e;
+  if (e.edges) {
+    e.firstUs = e.lastUs;
+    e.edges = 1;
+  }
+  e.glitches = 0;
+  return w;
+}
+
+void tachReset(TachState& s, uint32_t nowUs){
+  s = {};
+  s.lastEdgeUs = nowUs;
+  s.slowSinceUs = nowUs;
+}
+
+static uint16_t rpmFromPeriod(uint32_t spanUs, uint32_t periods){
+  if (spanUs == 0) return 0;
+  const uint64_t rpm = ((uint64_t)US_PER_MIN * periods + spanUs * FAN_TACH_PPR / 2) /
+                       ((uint64_t)spanUs * FAN_TACH_PPR);
+  return rpm > 0xFFFF ? 0xFFFF : (uint16_t)rpm;
+}
+
+uint16_t tachUpdate(TachState& s, const TachEdges& w, uint32_t nowUs){
+  s.glitches += w.glitches;
+  if (w.edges) {
+    s.seen = true;
+    s.lastEdgeUs = w.lastUs;
+  }
+  if (w.edges >= 2) {
+    s.accUs += w.lastUs - w.firstUs;
+    s.accPeriods += w.edges - 1;
+    if (s.accUs >= FAN_TACH_WINDOW_MS * 1000UL) {
+      s.rpm = rpmFromPeriod(s.accUs, s.accPeriods);
+      s.accUs = 0;
+      s.accPeriods = 0;
+    }
+  } else {
+    // No full period this time. Two periods without an edge means the fan
+    // is slowing down hard: it is at most as fast as one period ending now
+    const uint32_t quiet = nowUs - s.lastEdgeUs;
+    if (!s.seen || quiet >= STOP_EDGE_US) {
+      s.rpm = 0;
+      s.accUs = 0;
+      s.accPeriods = 0;
+    } else if (s.rpm && quiet > 2 * (US_PER_MIN / ((uint32_t)s.rpm * FAN_TACH_PPR))) {
+      s.rpm = rpmFromPeriod(quiet, 1);
+      s.accUs = 0;
+      s.accPeriods = 0;
+    }
+  }
+
+  if (s.rpm >= FAN_TACH_MIN_RPM) {
+    s.slowSinceUs = nowUs;
+    s.stalled = false;
+  } else if (nowUs - s.slowSinceUs >= FAN_TACH_STALL_MS * 1000UL) {
+    s.stalled = true;
+  }
+  return s.rpm;
+}
+
+void tachResume(TachState& s, uint32_t nowUs){
+  s.lastEdgeUs = nowUs;
+  s.accUs = 0;
+  s.accPeriods = 0;
+  if (!s.stalled) s.slowSinceUs = nowUs;
+}
+
+void tachDutyReset(TachDuty& d, uint32_t nowMs){
+  d.running = true;
+  d.sinceMs = nowMs;
+}
+
+bool tachDutyTick(TachDuty& d, bool panelOn, uint32_t nowMs, bool* opened){
+  *opened = false;
+  const uint32_t held = nowMs - d.sinceMs;
+  if (d.running) {
+    if (!panelOn && held >= FAN_TACH_OFF_WINDOW_MS) {
+      d.running = false;
+      d.sinceMs = nowMs;
+    }
+  } else if (panelOn || held >= FAN_TACH_OFF_PERIOD_MS - FAN_TACH_OFF_WINDOW_MS) {
+    d.running = true;
+    d.sinceMs = nowMs;
+    *opened = true;
+  }
+  return d.running;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Fan tachometer math =====
+// Hardware-free part of the tach measurement (FanTach.h feeds it from timer
+// input capture; tools/fan_tach_sim.cpp drives it with synthetic pulse
+// trains on a host).
+//
+// The capture ISR only timestamps edges (tachEdge). The reader takes the
+// edges collected since its last call (tachTake) and averages whole periods
+// over at least FAN_TACH_WINDOW_MS, so the result is exact to the capture
+// clock and does not depend on how often the UI loop reads it. When edges
+// stop coming for more than two periods the reading follows the time since
+// the last edge, so a stopping fan ramps down to 0 instead of freezing;
+// below FAN_TACH_MIN_RPM for FAN_TACH_STALL_MS it reports a stall.
+//
+// Times are in capture ticks of 1 us (32-bit, wrap-safe).
+//
+// STOP halts the capture timer, so while the panel is OFF the tach runs in
+// windows (tachDutyTick): FAN_TACH_OFF_WINDOW_MS every FAN_TACH_OFF_PERIOD_MS,
+// with the STOP hold taken only inside them. tachResume() restarts the
+// timing when a window opens and keeps rpm and the stall, so a fault seen in
+// one window stays raised (and does not wake the panel again) until a later
+// window sees the fan turn.
+
+#ifndef FAN_TACH_PPR
+#define FAN_TACH_PPR 2                  // tach pulses per revolution (PC fans: 2)
+#endif
+#ifndef FAN_TACH_MAX_RPM
+#define FAN_TACH_MAX_RPM 20000UL        // faster edges are glitches
+#endif
+#ifndef FAN_TACH_MIN_RPM
+#define FAN_TACH_MIN_RPM 200UL          // slower counts as stopped
+#endif
+#ifndef FAN_TACH_WINDOW_MS
+#define FAN_TACH_WINDOW_MS 250UL        // averaging time per reading
+#endif
+#ifndef FAN_TACH_STALL_MS
+#define FAN_TACH_STALL_MS 3000UL
+#endif
+// Panel OFF: a capture window this often...
+#ifndef FAN_TACH_OFF_PERIOD_MS
+#define FAN_TACH_OFF_PERIOD_MS 60000UL
+#endif
+// ...this long: a stall plus the UI task's 1 s OFF slices (POWER_OFF_SLICE_MS)
+#ifndef FAN_TACH_OFF_WINDOW_MS
+#define FAN_TACH_OFF_WINDOW_MS (FAN_TACH_STALL_MS + 2000UL)
+#endif
+
+// Written by the capture ISR, taken by the reader with the IRQ masked
+struct TachEdges {
+  uint32_t firstUs;         // oldest edge in the window
+  uint32_t lastUs;          // newest edge
+  uint16_t edges;           // edges in the window (incl. the first)
+  uint16_t glitches;        // edges rejected as too close together
+};
+
+struct TachState {
+  uint16_t rpm;
+  bool     stalled;
+  bool     seen;            // any edge since reset
+  uint32_t lastEdgeUs;
+  uint32_t slowSinceUs;     // when rpm first fell below FAN_TACH_MIN_RPM
+  uint32_t accUs;           // whole periods collected towards the next reading
+  uint16_t accPeriods;
+  uint32_t glitches;
+};
+
+// ISR side: one captured edge
+void tachEdge(TachEdges& e, uint32_t us);
+
+// Reader side (IRQ masked): copy the window and start the next one at the
+// newest edge, so no interval is ever dropped between reads
+TachEdges tachTake(TachEdges& e);
+
+void tachReset(TachState& s, uint32_t nowUs);
+
+// Fold one taken window into the state; returns the rpm
+uint16_t tachUpdate(TachState& s, const TachEdges& w, uint32_t nowUs);
+
+// Restart the timing after the capture clock stood still (keeps rpm, stall
+// and glitch count; the edge window must be cleared too)
+void tachResume(TachState& s, uint32_t nowUs);
+
+// ----- Duty cycle while the panel is OFF -----
+struct TachDuty {
+  bool running;             // capture timer needed (STOP held off)
+  uint32_t sinceMs;         // when it last started or stopped
+};
+
+void tachDutyReset(TachDuty& d, uint32_t nowMs);   // starts running
+
+// Call every UI loop. Returns whether the timer must run; *opened: it just
+// started again (tachResume() every channel).
+bool tachDutyTick(TachDuty& d, bool panelOn, uint32_t nowMs, bool* opened);
@@ -0,0 +1,80 @@
+#include "FieldEdit.h"
+#include "AppData.h"
+
+struct EditRamp {
+  int32_t value;
+  unsigned long lastStepMs;
+  bool stepped;             // at least one step taken in this hold
+};
+
+static EditRamp ramp;
+static uint8_t rampId = 0xFF;
+static unsigned long rampHoldMs = 0;
+static bool pending = false;
+
+// Repeat cadence: quick at first so single steps stay controllable
+static uint16_t repeatMs(unsigned long heldMs){
+  if (heldMs > 1800) return 25;           // one step a frame: the long tail of wide fields
+  if (heldMs > 1200) return 50;
+  if (heldMs > 600)  return 100;
+  return 160;
+}
+
+static int32_t stepFor(unsigned long heldMs, uint16_t base, int32_t range){
+  int32_t step = base;
+  if (heldMs < FIELD_EDIT_FIRST_DECADE_MS) return step;
+  unsigned long k = 1 + (heldMs - FIELD_EDIT_FIRST_DECADE_MS) / FIELD_EDIT_DECADE_MS;
+  while (k-- && step * 10 <= range / 10) step *= 10;
+  return step;
+}
+
+static int32_t floorDiv(int32_t a, int32_t b){ return a >= 0 ? a / b : -((-a + b - 1) / b); }
+
+// Advance one ramp; returns true if the value moved
+static bool advance(EditRamp& r, int32_t lo, int32_t hi, uint16_t base, int8_t dir,
+                    unsigned long heldMs, unsigned long now){
+  if (r.stepped && now - r.lastStepMs < repeatMs(heldMs)) return false;
+  const int32_t step = stepFor(heldMs, base, hi - lo);
+  int32_t v = r.value + dir * step;
+  // Snap onto the step grid in the direction of travel
+  if (step > base) v = dir > 0 ? floorDiv(v, step) * step : -floorDiv(-v, step) * step;
+  if (v > hi) v = hi;
+  if (v < lo) v = lo;
+  r.lastStepMs = now;
+  r.stepped = true;
+  if (v == r.value) return false;
+  r.value = v;
+  return true;
+}
+
+void fieldEditHold(uint8_t id, uint16_t baseStep, int8_t dir,
+                   unsigned long holdStartMs, unsigned long now){
+  int32_t lo, hi;
+  if (!settingsFieldRange(id, lo, hi)) return;
+  if (id != rampId || holdStartMs != rampHoldMs) {
+    fieldEditFlush();
+    if (!settingsGetField(gStage, id, ramp.value)) return;
+    ramp.stepped = false;
+    rampId = id;
+    rampHoldMs = holdStartMs;
+  }
+  if (advance(ramp, lo, hi, baseStep, dir, now - holdStartMs, now)) pending = true;
+}
+
+bool fieldEditFlush(){
+  if (!pending) return false;
+  pending = false;
+  return settingsSetField(gStage, rampId, ramp.value);
+}
+
+unsigned long fieldEditFullRangeMs(uint8_t id, uint16_t baseStep, uint16_t loopMs){
+  int32_t lo, hi;
+  if (!settingsFieldRange(id, lo, hi) || loopMs == 0) return 0;
+  EditRamp r = { lo, 0, false };
+  unsigned long t = 0;
+  while (r.value < hi && t < 600000UL) {
+    t += loopMs;
+    advance(r, lo, hi, baseStep, +1, t, t);
+  }
+  return t;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Accelerated numeric field editing =====
+// Holding Up/Down on a settings field steps the staged value directly
+// (no nav commands). The step grows by decades with hold time (base, x10,
+// x100...) up to about a tenth of the field's range, and the value snaps to
+// the current step so it reads 1240, 1300, 2000... Repeats only update a
+// pending value; fieldEditFlush() writes it to gStage once per frame.
+
+#ifndef FIELD_EDIT_DECADE_MS
+#define FIELD_EDIT_DECADE_MS 1000       // hold time per x10 step increase
+#endif
+#ifndef FIELD_EDIT_FIRST_DECADE_MS
+#define FIELD_EDIT_FIRST_DECADE_MS 1000 // single steps for this long
+#endif
+
+// One repeat of a held button on field id (SettingsField). holdStartMs
+// identifies the hold; a new value starts a new ramp.
+void fieldEditHold(uint8_t id, uint16_t baseStep, int8_t dir,
+                   unsigned long holdStartMs, unsigned long now);
+
+// Write the pending value into gStage; true if something was written
+bool fieldEditFlush();
+
+// Simulated hold from the low to the high limit, polled every loopMs.
+// Returns the time it takes (ms); used by the UI_BENCH report.
+unsigned long fieldEditFullRangeMs(uint8_t id, uint16_t baseStep, uint16_t loopMs);
@@ -0,0 +1,43 @@
+#include "FrameDiffLogic.h"
+
+// FNV-1a over the tile's 8 bytes
+static uint32_t tileHash(const uint8_t* t){
+  uint32_t h = 2166136261UL;
+  for (uint8_t i = 0; i < 8; i++) h = (h ^ t[i]) * 16777619UL;
+  return h;
+}
+
+void frameDiffInvalidate(FrameDiff& d){
+  d.valid = false;
+}
+
+uint16_t frameDiffScan(FrameDiff& d, const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                       FrameDiffSpan* spans){
+  const bool fits = tileW <= FRAME_DIFF_MAX_TILES_W && tileH <= FRAME_DIFF_MAX_TILES_H;
+  uint16_t tiles = 0;
+  for (uint8_t p = 0; p < tileH; p++) {
+    const uint8_t* page = buf + (uint16_t)p * tileW * 8;
+    int16_t first = -1, last = -1;
+    for (uint8_t x = 0; x < tileW; x++) {
+      if (!fits) { first = first < 0 ? x : first; last = x; continue; }
+      const uint32_t h = tileHash(page + x * 8);
+      if (d.valid && h == d.hash[p][x]) continue;
+      d.hash[p][x] = h;
+      if (first < 0) first = x;
+      last = x;
+    }
+    spans[p].x0 = first < 0 ? 0 : (uint8_t)first;
+    spans[p].w = first < 0 ? 0 : (uint8_t)(last - first + 1);
+    tiles += spans[p].w;
+  }
+  d.valid = fits;
+  return tiles;
+}
+
+uint32_t frameDiffBytes(const FrameDiffSpan* spans, uint8_t tileH){
+  uint32_t bytes = 0;
+  for (uint8_t p = 0; p < tileH; p++) {
+    if (spans[p].w) bytes += (uint32_t)spans[p].w * 8 + FRAME_DIFF_SPAN_OVERHEAD;
+  }
+  return bytes;
+}
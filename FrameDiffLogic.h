@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Dirty-tile flush =====
+// Hardware-free part of the partial panel update (MenuUI.cpp flushes with
+// it; tools/redraw_sim.cpp replays a menu session through it).
+//
+// Keeps a 32-bit hash per 8x8 tile of the last frame sent. A scan of the
+// new full buffer (SSD1306 page layout: tileH pages of tileW*8 bytes)
+// yields one span per page, from the first to the last changed tile, and
+// takes the new hashes: sending just the spans brings the panel up to
+// date. A cursor move in a submenu touches the two rows' pages, a value
+// edit one row, a turning fan its own tiles.
+
+#ifndef FRAME_DIFF_MAX_TILES_W
+#define FRAME_DIFF_MAX_TILES_W 16      // 128 px
+#endif
+#ifndef FRAME_DIFF_MAX_TILES_H
+#define FRAME_DIFF_MAX_TILES_H 8       // 64 px
+#endif
+// Bytes besides the tile data per span sent (address/page commands)
+#ifndef FRAME_DIFF_SPAN_OVERHEAD
+#define FRAME_DIFF_SPAN_OVERHEAD 6
+#endif
+
+struct FrameDiffSpan {
+  uint8_t x0;                          // first tile
+  uint8_t w;                           // tiles; 0 = page unchanged
+};
+
+struct FrameDiff {
+  uint32_t hash[FRAME_DIFF_MAX_TILES_H][FRAME_DIFF_MAX_TILES_W];
+  bool valid;                          // false: next scan marks everything
+};
+
+// Forget the panel content (after begin()/a bus reset; a stored hash could
+// otherwise hide a tile the panel lost)
+void frameDiffInvalidate(FrameDiff& d);
+
+// Fill spans[0..tileH) for buf and remember it as sent. Returns the tiles
+// to send (x8 = data bytes); a buffer larger than the maximum is all dirty.
+uint16_t frameDiffScan(FrameDiff& d, const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                       FrameDiffSpan* spans);
+
+// Bytes on the bus for spans, data plus the per-span overhead
+uint32_t frameDiffBytes(const FrameDiffSpan* spans, uint8_t tileH);
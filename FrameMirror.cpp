@@ -0,0 +1,59 @@
+#include "FrameMirror.h"
+#include <STM32FreeRTOS.h>
+#include "Crc.h"
+
+FrameMirror frameMirror;
+
+static uint8_t shadow[MIRROR_MAX_BYTES];
+static uint16_t pageBytes = 0;
+static uint8_t pageCount = 0;
+static volatile uint8_t dirty = 0;
+static volatile uint32_t frameCrc = 0;
+static volatile bool enabled = false;
+
+void FrameMirror::pushFrame(const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                            const FrameDiffSpan*){
+  if (!enabled) return;
+  const uint16_t pb = (uint16_t)tileW * 8;
+  if (tileH > 8 || (uint32_t)pb * tileH > sizeof(shadow)) return;
+  if (pb != pageBytes || tileH != pageCount) {
+    pageBytes = pb;
+    pageCount = tileH;
+    dirty = (uint8_t)((1u << tileH) - 1);
+  }
+  uint8_t changed = 0;
+  for (uint8_t p = 0; p < tileH; p++) {
+    if (memcmp(shadow + p * pb, buf + p * pb, pb) != 0) changed |= (uint8_t)(1u << p);
+  }
+  if (!changed && !dirty) return;
+  const uint32_t crc = crc32(buf, (size_t)pb * tileH);
+  taskENTER_CRITICAL();
+  for (uint8_t p = 0; p < tileH; p++) {
+    if (changed & (1u << p)) memcpy(shadow + p * pb, buf + p * pb, pb);
+  }
+  dirty |= changed;
+  frameCrc = crc;
+  taskEXIT_CRITICAL();
+}
+
+void frameMirrorEnable(bool on){
+  taskENTER_CRITICAL();
+  enabled = on;
+  dirty = on ? (uint8_t)((1u << pageCount) - 1) : 0;
+  taskEXIT_CRITICAL();
+}
+
+bool frameMirrorEnabled(){ return enabled; }
+
+uint8_t frameMirrorTake(uint8_t* out, uint32_t* crc, uint16_t* pb){
+  taskENTER_CRITICAL();
+  const uint8_t mask = dirty;
+  for (uint8_t p = 0; p < pageCount; p++) {
+    if (mask & (1u << p)) memcpy(out + p * pageBytes, shadow + p * pageBytes, pageBytes);
+  }
+  dirty = 0;
+  *crc = frameCrc;
+  *pb = pageBytes;
+  taskEXIT_CRITICAL();
+  return mask;
+}
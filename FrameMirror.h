@@ -0,0 +1,28 @@
+#pragma once
+#include "DisplaySink.h"
+
+// ===== Framebuffer mirror =====
+// A display sink that keeps a shadow of the last frame and marks the pages
+// that changed. The remote link (RCMD_MIRROR) drains them at its own pace,
+// so a slow Serial never holds up the UI. Costs nothing while disabled.
+
+#ifndef MIRROR_MAX_BYTES
+#define MIRROR_MAX_BYTES 1024           // 128x64 panel
+#endif
+
+class FrameMirror : public DisplaySink {
+public:
+  // Compares against its own shadow: the link drains at its own pace
+  void pushFrame(const uint8_t* buf, uint8_t tileW, uint8_t tileH,
+                 const FrameDiffSpan* dirty) override;
+};
+extern FrameMirror frameMirror;
+
+// Start/stop mirroring; enabling marks every page dirty (full first frame)
+void frameMirrorEnable(bool on);
+bool frameMirrorEnabled();
+
+// Copy the dirty pages into out (same layout as the panel buffer) and clear
+// them. Returns the dirty page mask; *crc is the CRC-32 of the whole frame
+// the copy completes, *pageBytes the size of one page.
+uint8_t frameMirrorTake(uint8_t* out, uint32_t* crc, uint16_t* pageBytes);
@@ -0,0 +1,62 @@
+#include "HealthLogic.h"
+
+// ===== UI loop =====
+void healthLoopMark(HealthLoop& l, uint32_t nowUs){
+  if (l.beginUs != 0) {
+    const uint32_t period = nowUs - l.beginUs;
+    l.avgUs = l.avgUs ? (l.avgUs * 7 + period) / 8 : period;
+    l.sumUs += period;
+    l.count++;
+    if (period > l.maxUs) l.maxUs = period;
+    l.jitterSumUs += period > l.avgUs ? period - l.avgUs : l.avgUs - period;
+  }
+  l.beginUs = nowUs ? nowUs : 1;
+}
+
+void healthLoopDone(HealthLoop& l, uint32_t nowUs){
+  l.busyUs += nowUs - l.beginUs;
+}
+
+HealthWindow healthLoopTake(HealthLoop& l, uint32_t windowUs){
+  HealthWindow w;
+  w.count = l.count;
+  w.avgUs = l.count ? l.sumUs / l.count : 0;
+  w.jitterUs = l.count ? l.jitterSumUs / l.count : 0;
+  w.maxUs = l.maxUs;
+  w.busyPct = healthPercent(l.busyUs, windowUs);
+  l.busyUs = l.sumUs = l.count = l.maxUs = l.jitterSumUs = 0;
+  return w;
+}
+
+// ===== Tasks =====
+bool healthTaskAdd(HealthTasks& t, void* handle, uint16_t stackWords){
+  if (!handle || t.count >= HEALTH_MAX_TASKS) return false;
+  t.task[t.count] = {};
+  t.task[t.count].handle = handle;
+  t.task[t.count].stackWords = stackWords;
+  t.count++;
+  return true;
+}
+
+void healthTaskStacks(HealthTasks& t, uint16_t (*freeWords)(void* handle)){
+  for (uint8_t i = 0; i < t.count; i++) t.task[i].freeWords = freeWords(t.task[i].handle);
+}
+
+void healthTaskRun(HealthTasks& t, void* handle, uint32_t runCounter, uint32_t dTotal){
+  for (uint8_t i = 0; i < t.count; i++) {
+    if (t.task[i].handle != handle) continue;
+    t.task[i].cpu = healthPercent(runCounter - t.task[i].lastRun, dTotal);
+    t.task[i].lastRun = runCounter;
+  }
+}
+
+// ===== Helpers =====
+uint8_t healthPercent(uint64_t part, uint64_t total){
+  if (!total) return 0;
+  const uint64_t p = part * 100 / total;
+  return (uint8_t)(p > 100 ? 100 : p);
+}
+
+bool healthUiAlive(uint32_t nowMs, uint32_t lastBeatMs, uint32_t stallMs){
+  return nowMs - lastBeatMs < stallMs;
+}
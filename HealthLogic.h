@@ -0,0 +1,61 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Task health: loop statistics, stacks, watchdog feed =====
+// Hardware-free part of the monitor (HealthMonitor.h runs it on FreeRTOS;
+// tools/health_sim.cpp runs it against a stubbed kernel and watchdog).
+//
+// The UI task marks the start and end of every loop; the monitor takes
+// the accumulated window every sample period and turns it into the mean
+// loop period, the jitter (mean distance from a 1/8 EWMA of the period),
+// the worst period and the busy share. Registered tasks keep their stack
+// depth and the free words the kernel last reported. The watchdog is fed
+// only while the last loop start is younger than the stall limit.
+
+#ifndef HEALTH_MAX_TASKS
+#define HEALTH_MAX_TASKS 6
+#endif
+
+// ----- UI loop -----
+struct HealthLoop {
+  uint32_t beginUs;             // start of the running loop, 0 = none yet
+  uint32_t avgUs;               // EWMA of the period (jitter reference)
+  uint32_t busyUs, sumUs, count, maxUs, jitterSumUs;   // since the last take
+};
+
+struct HealthWindow {
+  uint32_t count;               // loop starts in the window
+  uint32_t avgUs, jitterUs, maxUs;
+  uint8_t busyPct;
+};
+
+void healthLoopMark(HealthLoop& l, uint32_t nowUs);   // loop start
+void healthLoopDone(HealthLoop& l, uint32_t nowUs);   // loop end
+// Summarise and restart the window; windowUs = time since the last take
+HealthWindow healthLoopTake(HealthLoop& l, uint32_t windowUs);
+
+// ----- Tasks -----
+struct HealthTask {
+  void* handle;
+  uint16_t stackWords;          // depth passed at creation
+  uint16_t freeWords;           // never used (kernel high-water mark)
+  uint8_t cpu;                  // % of the last sample period
+  uint32_t lastRun;             // run-time counter at the last sample
+};
+
+struct HealthTasks {
+  HealthTask task[HEALTH_MAX_TASKS];
+  uint8_t count;
+};
+
+// False when full or handle is null
+bool healthTaskAdd(HealthTasks& t, void* handle, uint16_t stackWords);
+// Refresh every task's free words from the kernel
+void healthTaskStacks(HealthTasks& t, uint16_t (*freeWords)(void* handle));
+// A task's run-time counter now; dTotal = total run time over the period
+void healthTaskRun(HealthTasks& t, void* handle, uint32_t runCounter, uint32_t dTotal);
+
+// ----- Helpers -----
+uint8_t healthPercent(uint64_t part, uint64_t total);   // clamped to 100
+// Feed the watchdog? True while the UI loop started within stallMs
+bool healthUiAlive(uint32_t nowMs, uint32_t lastBeatMs, uint32_t stallMs);
@@ -0,0 +1,167 @@
+#include "HealthMonitor.h"
+#include "StaticAlloc.h"
+#if HEALTH_WATCHDOG
+#include <IWatchdog.h>
+#endif
+
+// ===== Diagnostics =====
+uint16_t diagUiStackFree = 0;
+uint16_t diagMonStackFree = 0;
+uint8_t  diagUiCpu = 0;
+uint8_t  diagCpuLoad = 0;
+uint16_t diagLoopAvgUs = 0;
+uint16_t diagLoopMaxUs = 0;
+uint16_t diagLoopJitterUs = 0;
+uint16_t diagI2cStalls = 0;
+uint32_t diagUptimeS = 0;
+bool     diagWdtReset = false;
+
+// ===== Registered tasks =====
+static HealthTasks tasks;
+
+static TaskHandle_t monHandle = nullptr;
+static const uint16_t MON_STACK_WORDS = 256;
+static const UBaseType_t MON_PRIORITY = tskIDLE_PRIORITY + 1;
+TASK_MEM(mon, MON_STACK_WORDS);
+
+// ===== UI loop statistics (written by UI task, read by monitor) =====
+static HealthLoop uiLoopStats;
+static volatile uint32_t lastBeatMs = 0;
+
+void healthRegisterTask(TaskHandle_t handle, uint16_t stackWords){
+  // The boot task registers LINK while the monitor is already running
+  taskENTER_CRITICAL();
+  healthTaskAdd(tasks, handle, stackWords);
+  taskEXIT_CRITICAL();
+}
+
+void healthLoopBegin(){
+  healthLoopMark(uiLoopStats, micros());
+  lastBeatMs = millis();
+}
+
+void healthLoopEnd(){
+  healthLoopDone(uiLoopStats, micros());
+}
+
+void healthNoteTransferUs(uint32_t us){
+  if (us > HEALTH_I2C_STALL_US && diagI2cStalls < 0xFFFF) diagI2cStalls++;
+}
+
+// ===== Sampling =====
+static inline uint16_t clip16(uint32_t v){ return v > 0xFFFF ? 0xFFFF : (uint16_t)v; }
+
+static uint16_t stackFree(void* handle){
+  return (uint16_t)uxTaskGetStackHighWaterMark((TaskHandle_t)handle);
+}
+
+static void sampleStacks(){
+#if INCLUDE_uxTaskGetStackHighWaterMark
+  healthTaskStacks(tasks, stackFree);
+  diagUiStackFree  = tasks.count ? tasks.task[0].freeWords : 0;
+  diagMonStackFree = (uint16_t)uxTaskGetStackHighWaterMark(nullptr);
+#endif
+}
+
+static void sampleCpu(){
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_TRACE_FACILITY == 1)
+  static TaskStatus_t st[HEALTH_MAX_TASKS + 4];
+  static uint32_t lastTotal = 0;
+  uint32_t total = 0;
+  const UBaseType_t n = uxTaskGetSystemState(st, HEALTH_MAX_TASKS + 4, &total);
+  const uint32_t dTotal = total - lastTotal;
+  lastTotal = total;
+  if (dTotal == 0) return;
+  const TaskHandle_t idle = xTaskGetIdleTaskHandle();
+  for (UBaseType_t k = 0; k < n; k++) {
+    if (st[k].xHandle == idle) {
+      static uint32_t lastIdle = 0;
+      const uint32_t dIdle = st[k].ulRunTimeCounter - lastIdle;
+      lastIdle = st[k].ulRunTimeCounter;
+      diagCpuLoad = (uint8_t)(100 - healthPercent(dIdle, dTotal));
+      continue;
+    }
+    healthTaskRun(tasks, st[k].xHandle, st[k].ulRunTimeCounter, dTotal);
+  }
+#endif
+}
+
+static void sampleLoop(uint32_t windowUs){
+  taskENTER_CRITICAL();
+  const HealthWindow w = healthLoopTake(uiLoopStats, windowUs);
+  taskEXIT_CRITICAL();
+
+  diagUiCpu = w.busyPct;
+  if (w.count) {
+    diagLoopAvgUs = clip16(w.avgUs);
+    diagLoopJitterUs = clip16(w.jitterUs);
+  }
+  if (w.maxUs > diagLoopMaxUs) diagLoopMaxUs = clip16(w.maxUs);
+}
+
+static void report(){
+  Serial.print("HEALTH up=");      Serial.print(diagUptimeS);
+  Serial.print("s cpu=");          Serial.print(diagCpuLoad);
+  Serial.print("% ui_busy=");      Serial.print(diagUiCpu);
+  Serial.print("% loop_avg=");     Serial.print(diagLoopAvgUs);
+  Serial.print("us loop_max=");    Serial.print(diagLoopMaxUs);
+  Serial.print("us jitter=");      Serial.print(diagLoopJitterUs);
+  Serial.print("us i2c_stalls=");  Serial.print(diagI2cStalls);
+  for (uint8_t i = 0; i < tasks.count; i++) {
+    const HealthTask& t = tasks.task[i];
+    Serial.print(" ");
+    Serial.print(pcTaskGetName((TaskHandle_t)t.handle));
+    Serial.print(":stack_free=");  Serial.print(t.freeWords);
+    Serial.print("/");             Serial.print(t.stackWords);
+    Serial.print("w,cpu=");        Serial.print(t.cpu);
+    Serial.print("%");
+  }
+  Serial.print(" MON:stack_free=");
+  Serial.print(diagMonStackFree);
+  Serial.println("w");
+  diagLoopMaxUs = 0;                 // max is per report window
+}
+
+static void monitorTask(void*){
+  TickType_t wake = xTaskGetTickCount();
+  uint32_t lastSampleUs = micros();
+  uint32_t lastReportMs = millis();
+  for (;;) {
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(HEALTH_SAMPLE_MS));
+
+    const uint32_t nowUs = micros();
+    sampleLoop(nowUs - lastSampleUs);
+    lastSampleUs = nowUs;
+    sampleStacks();
+    sampleCpu();
+    diagUptimeS = millis() / 1000;
+
+    // Feed the dog only while the UI loop is still turning
+    const bool uiAlive = healthUiAlive(millis(), lastBeatMs, HEALTH_UI_STALL_MS);
+#if HEALTH_WATCHDOG
+    if (uiAlive) IWatchdog.reload();
+#endif
+    if (!uiAlive) Serial.println("HEALTH UI loop stalled");
+
+#if HEALTH_REPORT_MS > 0
+    if (millis() - lastReportMs >= HEALTH_REPORT_MS) {
+      lastReportMs = millis();
+      report();
+    }
+#endif
+  }
+}
+
+bool healthStart(){
+#if HEALTH_WATCHDOG
+  diagWdtReset = IWatchdog.isReset(true);
+  if (diagWdtReset) Serial.println("HEALTH last reset: watchdog");
+#endif
+  if (!TASK_START(monitorTask, "MON", mon, MON_STACK_WORDS,
+                  MON_PRIORITY, &monHandle)) return false;
+  lastBeatMs = millis();
+#if HEALTH_WATCHDOG
+  IWatchdog.begin((uint32_t)HEALTH_WDT_TIMEOUT_MS * 1000UL);
+#endif
+  return true;
+}
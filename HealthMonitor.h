@@ -0,0 +1,58 @@
+#pragma once
+#include <Arduino.h>
+#include <STM32FreeRTOS.h>
+#include "HealthLogic.h"
+
+// ===== Task health monitor =====
+// A low-priority task that samples stack high-water marks (and per-task CPU
+// when FreeRTOS run-time stats are enabled), tracks UI loop period/jitter and
+// slow display transfers, feeds the independent watchdog only while the UI
+// loop is alive, and reports over Serial. The bookkeeping is in
+// HealthLogic.h.
+
+#ifndef HEALTH_SAMPLE_MS
+#define HEALTH_SAMPLE_MS 500
+#endif
+#ifndef HEALTH_REPORT_MS
+#define HEALTH_REPORT_MS 10000          // 0 = no Serial report
+#endif
+#ifndef HEALTH_WATCHDOG
+#define HEALTH_WATCHDOG 1
+#endif
+#ifndef HEALTH_WDT_TIMEOUT_MS
+#define HEALTH_WDT_TIMEOUT_MS 4000
+#endif
+// UI loop considered hung after this long without healthLoopBegin()
+#ifndef HEALTH_UI_STALL_MS
+#define HEALTH_UI_STALL_MS 2000
+#endif
+// A frame transfer slower than this counts as an I2C stall
+#ifndef HEALTH_I2C_STALL_US
+#define HEALTH_I2C_STALL_US 50000UL
+#endif
+
+// ----- Diagnostics (read-only menu fields) -----
+extern uint16_t diagUiStackFree;     // words never used by the UI task
+extern uint16_t diagMonStackFree;    // same for the monitor task
+extern uint8_t  diagUiCpu;           // % of time inside uiLoop()
+extern uint8_t  diagCpuLoad;         // % non-idle (needs run-time stats, else 0)
+extern uint16_t diagLoopAvgUs;       // mean UI loop period
+extern uint16_t diagLoopMaxUs;       // worst period since last report
+extern uint16_t diagLoopJitterUs;    // mean |period - avg|
+extern uint16_t diagI2cStalls;       // slow/timed-out display transfers
+extern uint32_t diagUptimeS;
+extern bool     diagWdtReset;        // last reset came from the watchdog
+
+// Register a task for stack/CPU sampling (stackWords = depth passed at creation).
+// Register the UI task first: diagUiStackFree reports slot 0.
+void healthRegisterTask(TaskHandle_t handle, uint16_t stackWords);
+
+// Create the monitor task and start the watchdog; call before the scheduler
+bool healthStart();
+
+// Bracket every UI loop iteration (called from the UI task)
+void healthLoopBegin();
+void healthLoopEnd();
+
+// Report how long a display transfer took (counts I2C stalls)
+void healthNoteTransferUs(uint32_t us);
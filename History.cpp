@@ -0,0 +1,179 @@
+#include "History.h"
+#include "AppData.h"
+
+// ===== Storage =====
+// One ring per resolution; all channels share head/count since they are
+// appended together.
+template <uint8_t N>
+struct HistRing {
+  HistBucket slots[HIST_CHANNELS][N];
+  uint8_t head;          // next write position
+  uint8_t count;
+  uint32_t gen;
+};
+
+// Rollup accumulator feeding the next coarser resolution
+struct HistAcc {
+  int16_t min[HIST_CHANNELS];
+  int16_t max[HIST_CHANNELS];
+  int32_t sum[HIST_CHANNELS];
+  uint8_t n;
+};
+
+static HistRing<HISTORY_SEC_SLOTS>  secRing;
+static HistRing<HISTORY_MIN_SLOTS>  minRing;
+static HistRing<HISTORY_HOUR_SLOTS> hourRing;
+static HistAcc minAcc, hourAcc;
+
+static unsigned long lastSampleMs = 0;
+static bool started = false;
+
+// 0.1 C, 0.1 V, 1 mA
+static const float SCALE[HIST_CHANNELS] = {10.0f, 10.0f, 1.0f, 1.0f};
+
+// ===== Helpers =====
+static inline int16_t toFixed(float v, float scale){
+  float s = v * scale;
+  if (s >  32767.0f) return  32767;
+  if (s < -32768.0f) return -32768;
+  return (int16_t)(s >= 0 ? s + 0.5f : s - 0.5f);
+}
+
+static void accReset(HistAcc& a){
+  a.n = 0;
+}
+
+static void accAdd(HistAcc& a, const HistBucket* b){
+  for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+    if (a.n == 0) {
+      a.min[c] = b[c].min;
+      a.max[c] = b[c].max;
+      a.sum[c] = 0;
+    } else {
+      if (b[c].min < a.min[c]) a.min[c] = b[c].min;
+      if (b[c].max > a.max[c]) a.max[c] = b[c].max;
+    }
+    a.sum[c] += b[c].avg;
+  }
+  a.n++;
+}
+
+static void accResult(const HistAcc& a, HistBucket* out){
+  for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+    out[c].min = a.min[c];
+    out[c].max = a.max[c];
+    out[c].avg = (int16_t)(a.sum[c] / a.n);
+  }
+}
+
+template <uint8_t N>
+static void ringAppend(HistRing<N>& r, const HistBucket* b){
+  for (uint8_t c = 0; c < HIST_CHANNELS; c++) r.slots[c][r.head] = b[c];
+  r.head = (uint8_t)((r.head + 1) % N);
+  if (r.count < N) r.count++;
+  r.gen++;
+}
+
+template <uint8_t N>
+static bool ringGet(const HistRing<N>& r, uint8_t ch, uint8_t age, HistBucket& out){
+  if (age >= r.count) return false;
+  uint8_t idx = (uint8_t)((r.head + N - 1 - age) % N);
+  out = r.slots[ch][idx];
+  return true;
+}
+
+// ===== Public API =====
+void historyInit(){
+  secRing.head = secRing.count = 0;
+  minRing.head = minRing.count = 0;
+  hourRing.head = hourRing.count = 0;
+  accReset(minAcc);
+  accReset(hourAcc);
+  started = false;
+}
+
+void historyPush(const float (&values)[HIST_CHANNELS]){
+  HistBucket b[HIST_CHANNELS];
+  for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+    int16_t v = toFixed(values[c], SCALE[c]);
+    b[c] = {v, v, v};
+  }
+  ringAppend(secRing, b);
+
+  accAdd(minAcc, b);
+  if (minAcc.n < 60) return;
+  accResult(minAcc, b);
+  accReset(minAcc);
+  ringAppend(minRing, b);
+
+  accAdd(hourAcc, b);
+  if (hourAcc.n < 60) return;
+  accResult(hourAcc, b);
+  accReset(hourAcc);
+  ringAppend(hourRing, b);
+}
+
+void historyTick(unsigned long now){
+  if (!started) {
+    started = true;
+    lastSampleMs = now;
+    return;
+  }
+  if (now - lastSampleMs < 1000) return;
+
+  // Catch up missed seconds (e.g. after a long I2C stall), but never spin
+  // for more than a few samples; resync instead.
+  uint8_t missed = 0;
+  while (now - lastSampleMs >= 1000 && missed < 5) {
+    lastSampleMs += 1000;
+    missed++;
+  }
+  if (now - lastSampleMs >= 1000) lastSampleMs = now;
+
+  const float values[HIST_CHANNELS] = {
+    statusTempC, statusVinV, fan1Current_mA, fan2Current_mA
+  };
+  while (missed--) historyPush(values);
+}
+
+uint8_t historyCount(HistRes res){
+  switch (res) {
+    case HIST_SEC:  return secRing.count;
+    case HIST_MIN:  return minRing.count;
+    default:        return hourRing.count;
+  }
+}
+
+uint8_t historyCapacity(HistRes res){
+  switch (res) {
+    case HIST_SEC:  return HISTORY_SEC_SLOTS;
+    case HIST_MIN:  return HISTORY_MIN_SLOTS;
+    default:        return HISTORY_HOUR_SLOTS;
+  }
+}
+
+bool historyGet(HistChannel ch, HistRes res, uint8_t age, HistBucket& out){
+  if (ch >= HIST_CHANNELS) return false;
+  switch (res) {
+    case HIST_SEC:  return ringGet(secRing,  ch, age, out);
+    case HIST_MIN:  return ringGet(minRing,  ch, age, out);
+    default:        return ringGet(hourRing, ch, age, out);
+  }
+}
+
+uint32_t historyGeneration(HistRes res){
+  switch (res) {
+    case HIST_SEC:  return secRing.gen;
+    case HIST_MIN:  return minRing.gen;
+    default:        return hourRing.gen;
+  }
+}
+
+float historyScale(HistChannel ch){
+  return ch < HIST_CHANNELS ? SCALE[ch] : 1.0f;
+}
+
+size_t historyMemoryBytes(){
+  return sizeof(secRing) + sizeof(minRing) + sizeof(hourRing)
+       + sizeof(minAcc) + sizeof(hourAcc);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Fixed-memory trend store for the idle screen.
+// Every channel keeps three ring buffers: 1 s samples, 1 min and 1 h rollups
+// (min/max/avg). Override the slot counts before including if RAM is tight.
+#ifndef HISTORY_SEC_SLOTS
+#define HISTORY_SEC_SLOTS  60
+#endif
+#ifndef HISTORY_MIN_SLOTS
+#define HISTORY_MIN_SLOTS  60
+#endif
+#ifndef HISTORY_HOUR_SLOTS
+#define HISTORY_HOUR_SLOTS 24
+#endif
+
+enum HistChannel : uint8_t { HIST_TEMP, HIST_VIN, HIST_FAN1_I, HIST_FAN2_I, HIST_CHANNELS };
+enum HistRes     : uint8_t { HIST_SEC, HIST_MIN, HIST_HOUR, HIST_RES_COUNT };
+
+// Values are stored as int16 in channel units * historyScale(ch)
+struct HistBucket {
+  int16_t min;
+  int16_t max;
+  int16_t avg;
+};
+
+void historyInit();
+
+// Samples the live telemetry once per second (call from the UI loop)
+void historyTick(unsigned long now);
+
+// Append one 1 s sample for every channel (raw engineering units)
+void historyPush(const float (&values)[HIST_CHANNELS]);
+
+uint8_t historyCount(HistRes res);
+uint8_t historyCapacity(HistRes res);
+
+// age 0 = newest bucket; returns false if no such bucket yet
+bool historyGet(HistChannel ch, HistRes res, uint8_t age, HistBucket& out);
+
+// Increments on every append at that resolution (for incremental renderers)
+uint32_t historyGeneration(HistRes res);
+
+float historyScale(HistChannel ch);
+
+// Static RAM used by the store, for sizing reports
+size_t historyMemoryBytes();
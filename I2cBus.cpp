@@ -0,0 +1,178 @@
+#include "I2cBus.h"
+#include <STM32FreeRTOS.h>
+#include <Wire.h>
+#include "HealthMonitor.h"
+#include "Pins.h"
+#include "StaticAlloc.h"
+
+uint16_t diagI2cSensorMaxUs = 0;
+uint16_t diagI2cErrors = 0;
+uint16_t diagI2cResets = 0;
+
+static TaskHandle_t busHandle = nullptr;
+static const uint16_t BUS_STACK_WORDS = 256;
+static const UBaseType_t BUS_PRIORITY = tskIDLE_PRIORITY + 3;   // above the UI
+TASK_MEM(bus, BUS_STACK_WORDS);
+
+static I2cQueue queue;                     // guarded by taskENTER_CRITICAL
+static uint8_t failStreak = 0;
+static volatile uint16_t resetCount = 0;
+
+// ===== Bus access (bus task, or inline before the scheduler) =====
+static void wireBegin(){
+  Wire.setSDA(I2C_SDA);
+  Wire.setSCL(I2C_SCL);
+  Wire.begin();
+  Wire.setClock(I2C_BUS_HZ);
+}
+
+// ----- Recovery on the pins (I2cBusLogic.h) -----
+// Only the peripheral is reset: Wire keeps its buffers (STATIC_ALLOC)
+static void pinsRelease(void*){
+  HAL_I2C_DeInit(Wire.getHandle());
+  digitalWrite(I2C_SDA, HIGH);
+  digitalWrite(I2C_SCL, HIGH);
+  pinMode(I2C_SDA, OUTPUT_OPEN_DRAIN);
+  pinMode(I2C_SCL, OUTPUT_OPEN_DRAIN);
+  delayMicroseconds(5);
+}
+
+static bool pinsSdaHigh(void*){ return digitalRead(I2C_SDA) == HIGH; }
+
+static void pinsDrive(void*, bool scl, bool high){
+  digitalWrite(scl ? I2C_SCL : I2C_SDA, high ? HIGH : LOW);
+  delayMicroseconds(5);
+}
+
+static void pinsRestore(void*){
+  pinmap_pinout(digitalPinToPinName(I2C_SDA), PinMap_I2C_SDA);
+  pinmap_pinout(digitalPinToPinName(I2C_SCL), PinMap_I2C_SCL);
+  HAL_I2C_Init(Wire.getHandle());          // same Init, so the same bus clock
+}
+
+static void busRecover(){
+  static const I2cRecoverPins PINS = { nullptr, pinsRelease, pinsSdaHigh, pinsDrive, pinsRestore };
+  i2cBusRecover(PINS);
+  if (diagI2cResets < 0xFFFF) diagI2cResets++;
+  resetCount = (uint16_t)(resetCount + 1);
+}
+
+static I2cResult wireResult(uint8_t code){
+  switch (code) {
+    case 0: return I2C_OK;
+    case 2: return I2C_NACK_ADDR;
+    case 3: return I2C_NACK_DATA;
+    case 5: return I2C_TIMEOUT;
+    default: return I2C_BUS_ERROR;
+  }
+}
+
+static I2cResult execute(const I2cXfer& x){
+  I2cResult r = I2C_OK;
+  if (x.txLen || !x.rxLen) {
+    Wire.beginTransmission(x.addr);
+    Wire.write(x.tx, x.txLen);
+    r = wireResult(Wire.endTransmission(x.rxLen ? false : true));
+  }
+  if (r == I2C_OK && x.rxLen) {
+    const uint8_t got = Wire.requestFrom(x.addr, (uint8_t)x.rxLen);
+    for (uint8_t i = 0; i < got; i++) x.rx[i] = (uint8_t)Wire.read();
+    if (got != x.rxLen) r = I2C_NACK_ADDR;
+  }
+
+  if (r == I2C_OK) {
+    failStreak = 0;
+  } else {
+    if (diagI2cErrors < 0xFFFF) diagI2cErrors++;
+    if (++failStreak >= I2C_BUS_RESET_AFTER) {
+      failStreak = 0;
+      busRecover();
+    }
+  }
+  return r;
+}
+
+// ===== Bus task =====
+static void busTask(void*){
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (;;) {
+      taskENTER_CRITICAL();
+      I2cXfer* x = i2cQueuePop(queue);
+      taskEXIT_CRITICAL();
+      if (!x) break;
+
+      // The client may return as soon as result is set: read it all first
+      const TaskHandle_t waiter = (TaskHandle_t)x->waiter;
+      const uint32_t queuedUs = x->queuedUs;
+      const I2cPrio prio = x->prio;
+      const I2cResult r = execute(*x);
+      if (prio == I2C_PRIO_SENSOR) {
+        const uint32_t us = micros() - queuedUs;
+        if (us > diagI2cSensorMaxUs) diagI2cSensorMaxUs = (uint16_t)(us > 0xFFFF ? 0xFFFF : us);
+      }
+      x->result = r;
+      xTaskNotifyGive(waiter);
+    }
+  }
+}
+
+bool i2cBusStart(){
+  wireBegin();
+  if (!TASK_START(busTask, "I2C", bus, BUS_STACK_WORDS,
+                  BUS_PRIORITY, &busHandle)) return false;
+  healthRegisterTask(busHandle, BUS_STACK_WORDS);
+  return true;
+}
+
+I2cResult i2cBusTransfer(uint8_t addr, const uint8_t* tx, uint16_t txLen,
+                         uint8_t* rx, uint16_t rxLen, I2cPrio prio){
+  I2cXfer x = {addr, prio, tx, txLen, rx, rxLen, I2C_PENDING, (uint32_t)micros(), nullptr, nullptr};
+  if (!busHandle || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+    x.result = execute(x);                 // setup(): nobody to share with yet
+    return x.result;
+  }
+
+  x.waiter = xTaskGetCurrentTaskHandle();
+  taskENTER_CRITICAL();
+  i2cQueuePush(queue, &x);
+  taskEXIT_CRITICAL();
+  xTaskNotifyGive(busHandle);
+
+  // The same notification slot also carries e.g. the power manager's
+  // wake-up; pass on any that arrive while we wait
+  bool foreign = false;
+  while (x.result == I2C_PENDING) {
+    const uint32_t n = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (x.result == I2C_PENDING || n > 1) foreign = true;
+  }
+  if (foreign) xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+  return x.result;
+}
+
+uint16_t i2cBusResetCount(){ return resetCount; }
+
+// ===== U8g2 byte procedure =====
+static bool sendChunk(void* ctx, const uint8_t* data, uint8_t len){
+  u8x8_t* u8x8 = (u8x8_t*)ctx;
+  return i2cBusTransfer(u8x8_GetI2CAddress(u8x8) >> 1, data, len, nullptr, 0, I2C_PRIO_DISPLAY) == I2C_OK;
+}
+
+extern "C" uint8_t u8x8_byte_i2c_bus(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr){
+  I2cChunker& c = *(I2cChunker*)u8x8_GetUserPtr(u8x8);
+  switch (msg) {
+    case U8X8_MSG_BYTE_INIT:             // Wire belongs to i2cBusStart()
+    case U8X8_MSG_BYTE_SET_DC:
+      return 1;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      i2cChunkStart(c, I2C_DISPLAY_CHUNK);
+      return 1;
+    case U8X8_MSG_BYTE_SEND:
+      i2cChunkAppend(c, (const uint8_t*)arg_ptr, arg_int, sendChunk, u8x8);
+      return 1;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      i2cChunkEnd(c, sendChunk, u8x8);
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "I2cBusLogic.h"
+
+// ===== Shared I2C bus =====
+// One task owns Wire. Clients (panels through the U8g2 byte callback
+// below, sensors through i2cBusTransfer) queue transactions and block until
+// theirs is done; the task serves sensor priority first and display
+// streams arrive in I2C_DISPLAY_CHUNK pieces, so a sensor read never waits
+// behind a whole frame (tools/i2c_bus_sim.cpp measures the bound).
+//
+// After I2C_BUS_RESET_AFTER failed transactions in a row the task frees the
+// bus (up to 9 SCL pulses + STOP), re-initialises the I2C peripheral (not
+// Wire, which would reallocate its buffers) and bumps i2cBusResetCount();
+// the UI re-initialises its panels when that changes.
+//
+// Before the scheduler runs (setup) transfers execute inline.
+
+#ifndef I2C_BUS_HZ
+#define I2C_BUS_HZ 400000UL
+#endif
+#ifndef I2C_BUS_RESET_AFTER
+#define I2C_BUS_RESET_AFTER 3
+#endif
+
+// ----- Diagnostics (read-only menu fields) -----
+extern uint16_t diagI2cSensorMaxUs;  // worst queue + transfer time, sensor priority
+extern uint16_t diagI2cErrors;       // failed transactions
+extern uint16_t diagI2cResets;       // bus recoveries
+
+// Set up Wire on the Pins.h pins and create the bus task. Call before any
+// I2C traffic (uiSetup) and before the scheduler starts.
+bool i2cBusStart();
+
+// Write tx, then read rx after a repeated start; blocks until done
+I2cResult i2cBusTransfer(uint8_t addr, const uint8_t* tx, uint16_t txLen,
+                         uint8_t* rx, uint16_t rxLen, I2cPrio prio = I2C_PRIO_SENSOR);
+
+// Bumps after every bus recovery; panels need a begin() when it changes
+uint16_t i2cBusResetCount();
+
+// ----- U8g2 on the bus -----
+// u8x8 byte procedure that sends through the bus task at display priority
+extern "C" uint8_t u8x8_byte_i2c_bus(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+
+// Any U8g2 I2C panel, given its u8g2_Setup_* function, e.g.
+//   U8G2_I2C_BUS oled{u8g2_Setup_ssd1306_i2c_128x64_noname_f, U8G2_R2, 0x3C, RESET_PIN};
+typedef void (*U8g2I2cSetup)(u8g2_t* u8g2, const u8g2_cb_t* rotation, u8x8_msg_cb byte_cb,
+                             u8x8_msg_cb gpio_and_delay_cb);
+
+class U8G2_I2C_BUS : public U8G2 {
+public:
+  U8G2_I2C_BUS(U8g2I2cSetup setup, const u8g2_cb_t* rotation, uint8_t addr7,
+               uint8_t reset = U8X8_PIN_NONE) : U8G2() {
+    setup(&u8g2, rotation, u8x8_byte_i2c_bus, u8x8_gpio_and_delay_arduino);
+    u8x8_SetPin_HW_I2C(getU8x8(), reset, U8X8_PIN_NONE, U8X8_PIN_NONE);
+    u8x8_SetUserPtr(getU8x8(), &chunker_);
+    setI2CAddress(addr7 * 2);
+  }
+private:
+  I2cChunker chunker_{};
+};
@@ -0,0 +1,121 @@
+#include "I2cBusLogic.h"
+#include <string.h>
+
+void i2cQueuePush(I2cQueue& q, I2cXfer* x){
+  const uint8_t p = x->prio < I2C_PRIO_COUNT ? x->prio : I2C_PRIO_COUNT - 1;
+  x->next = nullptr;
+  if (q.tail[p]) q.tail[p]->next = x; else q.head[p] = x;
+  q.tail[p] = x;
+}
+
+I2cXfer* i2cQueuePop(I2cQueue& q){
+  for (uint8_t p = 0; p < I2C_PRIO_COUNT; p++) {
+    I2cXfer* x = q.head[p];
+    if (!x) continue;
+    q.head[p] = x->next;
+    if (!q.head[p]) q.tail[p] = nullptr;
+    x->next = nullptr;
+    return x;
+  }
+  return nullptr;
+}
+
+bool i2cQueueEmpty(const I2cQueue& q){
+  for (uint8_t p = 0; p < I2C_PRIO_COUNT; p++) if (q.head[p]) return false;
+  return true;
+}
+
+uint32_t i2cXferUs(const I2cXfer& x, uint32_t hz){
+  // START + addr byte + data; a read adds a repeated START + addr byte
+  uint32_t clocks = 1 + 9 + 9UL * x.txLen + 1;
+  if (x.rxLen) clocks += 1 + 9 + 9UL * x.rxLen;
+  return (uint32_t)(((uint64_t)clocks * 1000000UL + hz - 1) / hz);
+}
+
+// ===== Chunker =====
+static bool splittable(const I2cChunker& c){
+  return c.len > 0 && (c.buf[0] & 0xBF) == 0;     // 0x00 or 0x40, Co = 0
+}
+
+static bool flush(I2cChunker& c, I2cChunkSend send, void* ctx){
+  if (c.len && !c.failed && !send(ctx, c.buf, c.len)) c.failed = true;
+  return !c.failed;
+}
+
+void i2cChunkStart(I2cChunker& c, uint8_t limit){
+  c.len = 0;
+  c.limit = limit >= 2 && limit <= I2C_DISPLAY_CHUNK ? limit : I2C_DISPLAY_CHUNK;
+  c.failed = false;
+}
+
+bool i2cChunkAppend(I2cChunker& c, const uint8_t* data, uint16_t n, I2cChunkSend send, void* ctx){
+  while (n && !c.failed) {
+    if (c.len == c.limit) {
+      if (!splittable(c)) { c.failed = true; break; }
+      const uint8_t control = c.buf[0];
+      if (!flush(c, send, ctx)) break;
+      c.buf[0] = control;
+      c.len = 1;
+    }
+    uint16_t k = (uint16_t)(c.limit - c.len);
+    if (k > n) k = n;
+    memcpy(c.buf + c.len, data, k);
+    c.len = (uint8_t)(c.len + k);
+    data += k;
+    n = (uint16_t)(n - k);
+  }
+  return !c.failed;
+}
+
+bool i2cChunkEnd(I2cChunker& c, I2cChunkSend send, void* ctx){
+  const bool ok = flush(c, send, ctx);
+  c.len = 0;
+  return ok;
+}
+
+struct FrameTime { uint32_t hz, overheadUs, us; };
+
+static bool frameTimeAdd(void* ctx, const uint8_t*, uint8_t len){
+  FrameTime& f = *(FrameTime*)ctx;
+  const I2cXfer x = {0, I2C_PRIO_DISPLAY, nullptr, len, nullptr, 0, I2C_OK, 0, nullptr, nullptr};
+  f.us += f.overheadUs + i2cXferUs(x, f.hz);
+  return true;
+}
+
+uint32_t i2cDisplayFrameUs(uint8_t pages, uint16_t pageBytes, uint8_t chunk, uint32_t hz,
+                           uint32_t overheadUs){
+  FrameTime f = {hz, overheadUs, 0};
+  I2cChunker c;
+  static const uint8_t CMD[] = {0x00, 0xB0, 0x00, 0x10};
+  static const uint8_t DATA[16] = {0x40};
+  for (uint8_t p = 0; p < pages; p++) {
+    i2cChunkStart(c, chunk);
+    i2cChunkAppend(c, CMD, sizeof(CMD), frameTimeAdd, &f);
+    i2cChunkEnd(c, frameTimeAdd, &f);
+    i2cChunkStart(c, chunk);
+    i2cChunkAppend(c, DATA, 1, frameTimeAdd, &f);
+    for (uint16_t n = pageBytes; n; ) {
+      const uint16_t k = n < sizeof(DATA) ? n : (uint16_t)sizeof(DATA);
+      i2cChunkAppend(c, DATA, k, frameTimeAdd, &f);      // contents do not matter
+      n = (uint16_t)(n - k);
+    }
+    i2cChunkEnd(c, frameTimeAdd, &f);
+  }
+  return f.us;
+}
+
+// ===== Recovery =====
+uint8_t i2cBusRecover(const I2cRecoverPins& p){
+  p.release(p.ctx);
+  uint8_t clocks = 0;
+  while (clocks < I2C_RECOVER_CLOCKS && !p.sdaHigh(p.ctx)) {
+    p.drive(p.ctx, true, false);
+    p.drive(p.ctx, true, true);
+    clocks++;
+  }
+  // SCL is high: SDA low is a START, SDA high a STOP; both reset the slaves
+  p.drive(p.ctx, false, false);
+  p.drive(p.ctx, false, true);
+  p.restore(p.ctx);
+  return clocks;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+
+// ===== I2C bus scheduling =====
+// Hardware-free part of the shared I2C bus (I2cBus.h runs it in the bus
+// task; tools/i2c_bus_sim.cpp runs it against a simulated bus).
+//
+// Clients queue transactions with a priority; the bus task always starts
+// the oldest transaction of the most urgent priority next. Display streams
+// are cut into transactions of at most I2C_DISPLAY_CHUNK bytes, so a sensor
+// read waits for at most one chunk (plus its own transfer) however much
+// the panels are sending.
+
+#ifndef I2C_DISPLAY_CHUNK
+#define I2C_DISPLAY_CHUNK 32            // bytes incl. control byte; <= Wire buffer
+#endif
+
+enum I2cPrio : uint8_t { I2C_PRIO_SENSOR, I2C_PRIO_DISPLAY, I2C_PRIO_COUNT };  // 0 served first
+
+enum I2cResult : uint8_t {
+  I2C_OK, I2C_NACK_ADDR, I2C_NACK_DATA, I2C_BUS_ERROR, I2C_TIMEOUT, I2C_PENDING
+};
+
+// One transaction: write tx (may be empty), then read rx after a repeated
+// start (may be empty). Lives with the client until result != I2C_PENDING.
+struct I2cXfer {
+  uint8_t addr;                   // 7-bit
+  I2cPrio prio;
+  const uint8_t* tx;
+  uint16_t txLen;
+  uint8_t* rx;
+  uint16_t rxLen;
+  volatile I2cResult result;
+  uint32_t queuedUs;              // for the wait statistics
+  void* waiter;                   // task to wake on completion
+  I2cXfer* next;
+};
+
+struct I2cQueue {
+  I2cXfer* head[I2C_PRIO_COUNT];
+  I2cXfer* tail[I2C_PRIO_COUNT];
+};
+
+void i2cQueuePush(I2cQueue& q, I2cXfer* x);
+I2cXfer* i2cQueuePop(I2cQueue& q);      // nullptr when empty
+bool i2cQueueEmpty(const I2cQueue& q);
+
+// Time on the wire at hz: start, address, 9 clocks per byte, stop
+uint32_t i2cXferUs(const I2cXfer& x, uint32_t hz);
+
+// ----- Display stream chunker -----
+// Collects one u8x8 transfer (START .. END) and hands it out in pieces.
+// SSD13xx/SH1106 streams start with a control byte (0x00 commands, 0x40
+// data) that may be repeated at the start of every piece; other streams
+// must fit in one chunk.
+typedef bool (*I2cChunkSend)(void* ctx, const uint8_t* data, uint8_t len);
+
+struct I2cChunker {
+  uint8_t buf[I2C_DISPLAY_CHUNK];
+  uint8_t len;
+  uint8_t limit;                  // <= I2C_DISPLAY_CHUNK
+  bool failed;
+};
+
+void i2cChunkStart(I2cChunker& c, uint8_t limit);
+// Returns false once any piece failed or an unsplittable stream overflowed
+bool i2cChunkAppend(I2cChunker& c, const uint8_t* data, uint16_t n, I2cChunkSend send, void* ctx);
+bool i2cChunkEnd(I2cChunker& c, I2cChunkSend send, void* ctx);
+
+// Bus time of a whole-panel update: per page a 4-byte command transfer and
+// 0x40 + pageBytes of data, both through the chunker, overheadUs per transfer
+uint32_t i2cDisplayFrameUs(uint8_t pages, uint16_t pageBytes, uint8_t chunk, uint32_t hz,
+                           uint32_t overheadUs);
+
+// ----- Stuck-bus recovery -----
+// A slave reset mid-read holds SDA low until it has shifted out its byte.
+// Works on the pins only: take them from the peripheral, clock SCL until
+// SDA is released (at most 8 bits + ACK), START + STOP, hand them back and
+// re-initialise the peripheral. Never Wire.end()/begin(): they free and
+// reallocate Wire's buffers, which halts a STATIC_ALLOC build after
+// heapLock() (tools/i2c_bus_sim.cpp counts the allocations).
+struct I2cRecoverPins {
+  void* ctx;
+  void (*release)(void* ctx);               // peripheral off, both pins open-drain high
+  bool (*sdaHigh)(void* ctx);
+  void (*drive)(void* ctx, bool scl, bool high);   // one line, then half a bit time
+  void (*restore)(void* ctx);               // pins back to the peripheral, re-init it
+};
+
+#define I2C_RECOVER_CLOCKS 9
+
+// Returns the SCL pulses it took
+uint8_t i2cBusRecover(const I2cRecoverPins& p);
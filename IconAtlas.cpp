@@ -0,0 +1,26 @@
+#include "IconAtlas.h"
+
+static IconCacheStats stats = {0, 0, 0};
+
+const uint8_t* iconGet(IconId id){
+  const uint32_t t0 = micros();
+  bool decoded;
+  const uint8_t* bits = iconFetch(id, &decoded);
+  if (decoded) {
+    stats.decodeUs += micros() - t0;
+    stats.misses++;
+  } else if (iconCompressed(id)) {
+    stats.hits++;
+  }
+  return bits;
+}
+
+void iconDraw(U8G2& display, int16_t x, int16_t y, IconId id){
+  const uint8_t* bits = iconGet(id);
+  if (!bits) return;
+  display.drawXBMP(x, y, iconWidth(id), iconHeight(id), bits);
+}
+
+const IconCacheStats& iconCacheStats(){
+  return stats;
+}
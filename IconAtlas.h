@@ -0,0 +1,24 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "IconAtlasLogic.h"
+
+// ===== Icon atlas =====
+// All UI icons live in one flash blob (IconAtlasData.h, generated by
+// tools/gen_icon_atlas.py). Raw icons are drawn straight from flash;
+// bit-run coded ones are decoded into a small LRU cache of XBM tiles
+// (IconAtlasLogic.h).
+
+// XBM pointer for drawXBMP. For compressed icons the pointer refers to a
+// cache slot and stays valid until ICON_CACHE_SLOTS other icons are fetched.
+const uint8_t* iconGet(IconId id);
+
+// Convenience: fetch and draw at (x, y) with the current draw/bitmap mode
+void iconDraw(U8G2& display, int16_t x, int16_t y, IconId id);
+
+struct IconCacheStats {
+  uint32_t hits;
+  uint32_t misses;      // = decodes
+  uint32_t decodeUs;    // total time spent decoding
+};
+const IconCacheStats& iconCacheStats();
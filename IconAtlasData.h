@@ -0,0 +1,61 @@
+// Generated by tools/gen_icon_atlas.py from assets/icons - do not edit.
+#pragma once
+// Included by IconAtlasLogic.cpp only.
+
+static const uint8_t ICON_BLOB[569] = {
+  0x46, 0x8a, 0xc6, 0x73, 0x61, 0xe2, 0xf1, 0x90, 0xf1, 0xf1, 0xf1, 0x71, 0xe1, 0xc3, 0xc4, 0xa4,
+  0x94, 0x37, 0x0d, 0x4a, 0x0f, 0xa2, 0xec, 0xf9, 0x10, 0xf7, 0x30, 0xf5, 0x50, 0xa3, 0xa2, 0xa2,
+  0xa2, 0xf1, 0xf0, 0xf0, 0xe0, 0xf2, 0x70, 0xf2, 0x70, 0xf2, 0x70, 0xb2, 0xa1, 0xa2, 0xa2, 0xa2,
+  0xf3, 0x50, 0xf4, 0x50, 0xf5, 0x30, 0xf6, 0x10, 0xf7, 0x10, 0xe7, 0x79, 0x0f, 0x0f, 0x0b, 0x00,
+  0x00, 0x00, 0x00, 0x80, 0x01, 0xc0, 0x03, 0xe1, 0x87, 0xe5, 0xa7, 0xe5, 0xa7, 0xf5, 0xaf, 0xf5,
+  0xaf, 0xf1, 0x8f, 0xf0, 0x0f, 0xf0, 0x0f, 0xc0, 0x03, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x0f,
+  0x0f, 0x0f, 0x0f, 0x0f, 0x28, 0x0f, 0x46, 0x1b, 0x67, 0x17, 0x12, 0x11, 0x84, 0x14, 0x11, 0x11,
+  0x12, 0xa3, 0x13, 0x22, 0x12, 0xa3, 0x13, 0x22, 0x11, 0xa4, 0x14, 0x21, 0x11, 0xa4, 0x14, 0x21,
+  0x11, 0xa4, 0x14, 0x21, 0x12, 0xa3, 0x13, 0x22, 0x12, 0xa3, 0x13, 0x12, 0x11, 0x11, 0xa3, 0x13,
+  0x11, 0x12, 0xc4, 0x14, 0xc7, 0xeb, 0xea, 0x0f, 0x0f, 0x49, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x07,
+  0xc0, 0x03, 0x7e, 0x0e, 0x42, 0x38, 0x7a, 0x60, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x43,
+  0x4a, 0x43, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0xff, 0xff,
+  0x80, 0x03, 0xe0, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x60, 0x02, 0xc0, 0x03, 0x40, 0x3e,
+  0x40, 0x62, 0xfe, 0xc3, 0x02, 0x8f, 0x06, 0x9b, 0x84, 0xb1, 0xfc, 0xe0, 0x00, 0x00, 0x00, 0x00,
+  0xe0, 0x03, 0x20, 0x02, 0x30, 0x06, 0x90, 0x04, 0x90, 0x04, 0x90, 0x04, 0x90, 0x04, 0x90, 0x04,
+  0x90, 0x04, 0x90, 0x04, 0x98, 0x0c, 0xc8, 0x09, 0xe8, 0x0b, 0xc8, 0x09, 0x98, 0x0c, 0xf0, 0x07,
+  0x0f, 0x0f, 0x29, 0x2e, 0x2e, 0x2e, 0x4d, 0x8a, 0xa7, 0x44, 0x41, 0x41, 0x28, 0x2e, 0x2e, 0x4d,
+  0x0f, 0x0f, 0x08, 0x00, 0x02, 0x00, 0x0c, 0x00, 0x1c, 0x00, 0x3c, 0x00, 0x28, 0x00, 0x68, 0x00,
+  0x48, 0x00, 0x48, 0x00, 0x4c, 0x01, 0x46, 0x0e, 0x43, 0xfe, 0x61, 0x0c, 0x30, 0x38, 0x18, 0xe0,
+  0x0f, 0x00, 0x00, 0x46, 0x19, 0x42, 0x12, 0x35, 0x41, 0x31, 0xe3, 0xc3, 0xa5, 0x63, 0xc4, 0xc4,
+  0xc4, 0x64, 0xa3, 0xc5, 0xe3, 0x33, 0x41, 0x31, 0x15, 0x42, 0x12, 0x49, 0x06, 0x0f, 0x0f, 0x44,
+  0x0f, 0x45, 0x2f, 0x43, 0x23, 0x49, 0x61, 0x41, 0xf7, 0x30, 0xf6, 0x30, 0xf7, 0x10, 0xe9, 0x69,
+  0x64, 0x85, 0x86, 0x82, 0x86, 0x82, 0x86, 0x82, 0x86, 0x65, 0x64, 0xe9, 0xf9, 0x10, 0xf7, 0x30,
+  0xf6, 0x30, 0x47, 0x61, 0x41, 0x29, 0x43, 0x23, 0x4f, 0x0f, 0x45, 0x0f, 0x0f, 0x04, 0xc0, 0x00,
+  0xf0, 0x03, 0x18, 0x06, 0x08, 0x04, 0x08, 0x1c, 0x0c, 0x30, 0x06, 0x20, 0x12, 0x24, 0x22, 0x62,
+  0xc3, 0xc1, 0x41, 0x81, 0x71, 0xc7, 0x47, 0x61, 0x7c, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x80, 0x01, 0x80, 0x01, 0x98, 0x19, 0xb8, 0x1d, 0x30, 0x0c, 0x00, 0x00, 0x1e, 0x78, 0x1e, 0x78,
+  0x00, 0x00, 0x30, 0x0c, 0xb8, 0x1d, 0x98, 0x19, 0x80, 0x01, 0x80, 0x01, 0x00, 0x00, 0x0f, 0x0f,
+  0x44, 0x1e, 0x45, 0x15, 0x37, 0x44, 0x34, 0x55, 0x43, 0x53, 0x55, 0x42, 0x52, 0x57, 0x41, 0x51,
+  0x49, 0x41, 0x41, 0x2b, 0x28, 0x0f, 0x0f, 0x71, 0x78, 0x72, 0x78, 0x72, 0x78, 0x72, 0x78, 0x0f,
+  0x0f, 0x21, 0x28, 0x4b, 0x41, 0x41, 0x59, 0x41, 0x51, 0x57, 0x42, 0x52, 0x55, 0x43, 0x53, 0x35,
+  0x44, 0x34, 0x17, 0x45, 0x15, 0x4e, 0x0f, 0x0f, 0x04, 0x80, 0x01, 0x86, 0x61, 0x8e, 0x71, 0x0c,
+  0x30, 0xe0, 0x07, 0x30, 0x0c, 0x10, 0x08, 0x17, 0xe8, 0x17, 0xe8, 0x10, 0x08, 0x30, 0x0c, 0xe0,
+  0x07, 0x0c, 0x30, 0x8e, 0x71, 0x86, 0x61, 0x80, 0x01, 0x80, 0x01, 0xc0, 0x03, 0x40, 0x02, 0x60,
+  0x06, 0x30, 0x0c, 0x10, 0x08, 0x18, 0x18, 0x08, 0x10, 0x08, 0x10, 0x0c, 0x34, 0x04, 0x24, 0x0c,
+  0x36, 0x08, 0x12, 0x18, 0x18, 0x30, 0x0c, 0xc0, 0x03,
+};
+
+static const IconEntry ICON_INDEX[ICON_ID_COUNT] = {
+  {   0, 16, 16 | ICON_CODEC_BITRUN},  // ABOUT_16, 19 B
+  {  19, 24, 24 | ICON_CODEC_BITRUN},  // ABOUT_24, 44 B
+  {  63, 16, 16},  // ALARMS_16, 32 B
+  {  95, 24, 24 | ICON_CODEC_BITRUN},  // ALARMS_24, 65 B
+  { 160, 16, 16},  // DOOR_16, 32 B
+  { 192, 16, 16},  // FAN_16, 32 B
+  { 224, 16, 16},  // FIRE_16, 32 B
+  { 256, 16, 16 | ICON_CODEC_BITRUN},  // LIGHT_16, 19 B
+  { 275, 16, 16},  // MOON_16, 32 B
+  { 307, 16, 16 | ICON_CODEC_BITRUN},  // SETTINGS_16, 26 B
+  { 333, 24, 24 | ICON_CODEC_BITRUN},  // SETTINGS_24, 49 B
+  { 382, 16, 16},  // SMOKE_16, 32 B
+  { 414, 16, 16},  // STATUS_16, 32 B
+  { 446, 24, 24 | ICON_CODEC_BITRUN},  // STATUS_24, 59 B
+  { 505, 16, 16},  // SUM_16, 32 B
+  { 537, 16, 16},  // WATER_16, 32 B
+};
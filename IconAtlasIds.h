@@ -0,0 +1,26 @@
+// Generated by tools/gen_icon_atlas.py from assets/icons - do not edit.
+#pragma once
+#include <stdint.h>
+
+enum IconId : uint8_t {
+  ICON_ID_ABOUT_16,
+  ICON_ID_ABOUT_24,
+  ICON_ID_ALARMS_16,
+  ICON_ID_ALARMS_24,
+  ICON_ID_DOOR_16,
+  ICON_ID_FAN_16,
+  ICON_ID_FIRE_16,
+  ICON_ID_LIGHT_16,
+  ICON_ID_MOON_16,
+  ICON_ID_SETTINGS_16,
+  ICON_ID_SETTINGS_24,
+  ICON_ID_SMOKE_16,
+  ICON_ID_STATUS_16,
+  ICON_ID_STATUS_24,
+  ICON_ID_SUM_16,
+  ICON_ID_WATER_16,
+  ICON_ID_COUNT
+};
+
+// Largest decoded size of a compressed icon (cache slot size)
+#define ICON_ATLAS_MAX_TILE_BYTES 72
@@ -0,0 +1,99 @@
+#include "IconAtlasLogic.h"
+#include <string.h>
+
+// ===== Index layout =====
+struct IconEntry {
+  uint16_t offset;      // into ICON_BLOB; size = next offset - offset
+  uint8_t  w;
+  uint8_t  h;           // bit 7 = codec
+};
+#define ICON_CODEC_BITRUN 0x80
+#define ICON_H_MASK       0x7F
+
+#include "IconAtlasData.h"
+
+static const uint16_t BLOB_SIZE = sizeof(ICON_BLOB);
+
+// ===== Decoded tile cache =====
+struct IconSlot {
+  uint8_t id;           // ICON_ID_COUNT = empty
+  uint8_t age;          // 0 = most recently used
+  uint8_t bits[ICON_ATLAS_MAX_TILE_BYTES];
+};
+static IconSlot cache[ICON_CACHE_SLOTS];
+static bool cacheReady = false;
+
+static void cacheInit(){
+  for (uint8_t i = 0; i < ICON_CACHE_SLOTS; i++) {
+    cache[i].id = ICON_ID_COUNT;
+    cache[i].age = i;
+  }
+  cacheReady = true;
+}
+
+static void touch(uint8_t slot){
+  const uint8_t was = cache[slot].age;
+  for (uint8_t i = 0; i < ICON_CACHE_SLOTS; i++) {
+    if (cache[i].age < was) cache[i].age++;
+  }
+  cache[slot].age = 0;
+}
+
+// Alternating run lengths (first run is background) packed as nibbles,
+// low nibble first; see tools/gen_icon_atlas.py
+static void decodeBitrun(const uint8_t* src, uint16_t n, uint8_t w, uint8_t h, uint8_t* dst){
+  const uint8_t rowBytes = (uint8_t)((w + 7) / 8);
+  memset(dst, 0, (size_t)rowBytes * h);
+  uint8_t x = 0, y = 0, colour = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    const uint8_t b = src[i];
+    for (uint8_t half = 0; half < 2; half++) {
+      uint8_t run = half ? (b >> 4) : (b & 0x0F);
+      while (run--) {
+        if (colour) dst[y * rowBytes + (x >> 3)] |= (uint8_t)(1 << (x & 7));
+        if (++x == w) { x = 0; if (++y == h) return; }
+      }
+      colour ^= 1;
+    }
+  }
+}
+
+// ===== Public API =====
+uint8_t iconWidth(IconId id){
+  return id < ICON_ID_COUNT ? ICON_INDEX[id].w : 0;
+}
+
+uint8_t iconHeight(IconId id){
+  return id < ICON_ID_COUNT ? (uint8_t)(ICON_INDEX[id].h & ICON_H_MASK) : 0;
+}
+
+bool iconCompressed(IconId id){
+  return id < ICON_ID_COUNT && (ICON_INDEX[id].h & ICON_CODEC_BITRUN);
+}
+
+bool iconDecode(IconId id, uint8_t* dst){
+  if (!iconCompressed(id)) return false;
+  const IconEntry& e = ICON_INDEX[id];
+  const uint16_t end = (id + 1 < ICON_ID_COUNT) ? ICON_INDEX[id + 1].offset : BLOB_SIZE;
+  decodeBitrun(ICON_BLOB + e.offset, (uint16_t)(end - e.offset),
+               e.w, (uint8_t)(e.h & ICON_H_MASK), dst);
+  return true;
+}
+
+const uint8_t* iconFetch(IconId id, bool* decoded){
+  if (decoded) *decoded = false;
+  if (id >= ICON_ID_COUNT) return nullptr;
+  if (!iconCompressed(id)) return ICON_BLOB + ICON_INDEX[id].offset;
+
+  if (!cacheReady) cacheInit();
+  uint8_t victim = 0;
+  for (uint8_t i = 0; i < ICON_CACHE_SLOTS; i++) {
+    if (cache[i].id == id) { touch(i); return cache[i].bits; }
+    if (cache[i].age > cache[victim].age) victim = i;
+  }
+  iconDecode(id, cache[victim].bits);
+  if (decoded) *decoded = true;
+  cache[victim].id = id;
+  touch(victim);
+  return cache[victim].bits;
+}
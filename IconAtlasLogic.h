@@ -0,0 +1,24 @@
+#pragma once
+#include <stdint.h>
+#include "IconAtlasIds.h"
+
+// ===== Icon atlas: index, decoder, tile cache =====
+// Hardware-free part of the atlas (IconAtlas.h draws with it;
+// tools/draw_bench_host.cpp times it on the host).
+
+#ifndef ICON_CACHE_SLOTS
+#define ICON_CACHE_SLOTS 4      // worst screen (carousel) needs 3 decoded icons
+#endif
+
+uint8_t iconWidth(IconId id);
+uint8_t iconHeight(IconId id);
+bool iconCompressed(IconId id);
+
+// Decode a bit-run coded icon into dst (ICON_ATLAS_MAX_TILE_BYTES);
+// false for raw icons and bad ids
+bool iconDecode(IconId id, uint8_t* dst);
+
+// XBM pointer: flash for raw icons, an LRU cache slot for compressed ones
+// (decoded on a miss, *decoded = true). A slot stays valid until
+// ICON_CACHE_SLOTS other compressed icons are fetched.
+const uint8_t* iconFetch(IconId id, bool* decoded);
@@ -0,0 +1,135 @@
+#pragma once
+// German UI strings (see Strings.h). Keep the names in step with Lang_en.h.
+#define S_LANG_CODE        "de"
+
+// ----- Main carousel -----
+#define S_MAIN             "Men\xfc"
+#define S_STATUS           "Status"
+#define S_ALARMS           "Alarme"
+#define S_SETTINGS         "Setup"
+#define S_ABOUT            "Info"
+#define S_BACK             "<Zur\xfc" "ck"
+
+// ----- Status / alarms -----
+#define S_TEMPERATURE      "Temperatur"
+#define S_INPUT_VOLTAGE    "Eingangsspg."
+#define S_DOOR_ALARM       "T\xfcralarm"
+#define S_WATER_ALARM      "Wasseralarm"
+#define S_SMOKE_ALARM      "Rauchalarm"
+#define S_TEMP_ALARM       "Temp.alarm"
+#define S_FANFAULT_ALARM   "L\xfc" "fterfehler"
+#define S_AVIATION_ALARM   "Flugfeueralarm"
+
+// ----- Settings -----
+#define S_TEMP_SETTINGS    "Temperatur"
+#define S_TEMP_THR_LOW     "TempUnten"
+#define S_TEMP_THR_HIGH    "TempOben"
+#define S_TEMP_HIGH_THR    "TempAlarm"
+#define S_SYSTEM_SETTINGS  "System"
+#define S_VOLT_LOW_THR     "SpgUnten"
+#define S_VOLT_HIGH_THR    "SpgOben"
+#define S_DIM_AFTER        "DimmenNach"
+#define S_OFF_AFTER        "AusNach"
+#define S_PAGE_ROTATE      "Seitenwechsel"
+#define S_FAN_CURRENT_UNIT "Stromeinheit"
+#define S_FAN_PROFILE      "L\xfc" "fterprofil"
+#define S_AUTO             "Auto"
+#define S_NORMAL           "Normal"
+#define S_FAN1_MODEL       "L\xfc" "fter1Typ"
+#define S_FAN2_MODEL       "L\xfc" "fter2Typ"
+#define S_CUSTOM           "EIGENE"
+#define S_FAN1_SETTINGS    "L\xfc" "fter 1"
+#define S_FAN2_SETTINGS    "L\xfc" "fter 2"
+#define S_NOM_FAN1_CURR    "Nennstrom1"
+#define S_NOM_FAN2_CURR    "Nennstrom2"
+#define S_FAN1_SPEED       "Drehzahl1"
+#define S_FAN2_SPEED       "Drehzahl2"
+#define S_FAN1_RUN         "Laufzeit1"
+#define S_FAN2_RUN         "Laufzeit2"
+#define S_FAN1_ENERGY      "Energie1"
+#define S_FAN2_ENERGY      "Energie2"
+#define S_FAN_SETTINGS     "L\xfc" "fter"
+#define S_TOGGLE_PERIOD    "Wechselzeit"
+#define S_BAUDRATE         "Baudrate"
+#define S_MODBUS_SETTINGS  "Modbus"
+#define S_SLAVE_ID         "SlaveID"
+#define S_MB_MASTER        "Master"
+#define S_MB_NODES         "Knoten"
+#define S_AVIATION_SETTINGS "Flugfeuer"
+#define S_AVI_LDR_THR      "LDRSchwelle"
+#define S_AVI_LUX          "Helligkeit"
+#define S_AVI_LAMP         "Lampenstrom"
+#define S_AVI_TEST         "Lampentest"
+#define S_CALIBRATION      "Kalibrierung"
+#define S_CAL_VIN_REF      "SpannRef"
+#define S_CAL_VIN_SET      "Spannung abgleichen"
+#define S_CAL_VIN_GAIN     "SpannFaktor"
+#define S_CAL_VIN_OFFSET   "SpannOffset"
+#define S_CAL_TEMP_REF     "TempRef"
+#define S_CAL_TEMP_SET     "Temp. abgleichen"
+#define S_CAL_NTC_OFFSET   "TempOffset"
+#define S_SECURITY         "Sicherheit"
+#define S_CODE_LENGTH      "Codel\xe4nge"
+#define S_CHANGE_CODE      "Code \xe4ndern"
+#define S_FACTORY_RESET    "Werkseinstellung"
+
+// ----- Diagnostics -----
+#define S_DIAGNOSTICS      "Diagnose"
+#define S_UPTIME           "Laufzeit"
+#define S_CPU_LOAD         "CPULast"
+#define S_UI_BUSY          "UILast"
+#define S_UI_STACK_FREE    "UIStackFrei"
+#define S_MON_STACK_FREE   "MonStackFrei"
+#define S_LOOP_AVG         "ZyklusMittel"
+#define S_LOOP_MAX         "ZyklusMax"
+#define S_LOOP_JITTER      "ZyklusJitter"
+#define S_I2C_STALLS       "I2CH\xe4nger"
+#define S_I2C_SENSOR_WAIT  "I2CSensorZeit"
+#define S_I2C_ERRORS       "I2CFehler"
+#define S_I2C_RESETS       "I2CResets"
+#define S_COUNTER_COMMITS  "ZaehlerSich"
+#define S_WDT_RESET        "WDTReset"
+#define S_PANEL_ON         "DisplayAn"
+#define S_WAKE_LATENCY     "Weckzeit"
+#define S_MB_CYCLE         "MbZyklus"
+#define S_MB_SERVED        "MbAntworten"
+#define S_FAN1_HEALTH      "L1Zustand"
+#define S_FAN2_HEALTH      "L2Zustand"
+#define S_FAN_BLOCKS_LATE  "L\xfc" "BlkSp\xe4t"
+
+// ----- About -----
+#define S_ABOUT_VERSION    "SW-Version: " FW_VERSION
+#define S_ABOUT_DATE       "SW-Datum: " FW_DATE
+#define S_ABOUT_INSTALLED  "Installiert: " FW_INSTALLED
+#define S_ABOUT_SERIAL     "Serie: " FW_SERIAL
+
+// ----- Confirm dialog -----
+#define S_CONFIRM          "Best\xe4tigen"
+#define S_APPLY            "\xdc" "bernehmen"
+#define S_APPLY_EXIT       "\xdc" "bernehmen+Ende"
+#define S_DISCARD_EXIT     "Verwerfen+Ende"
+#define S_CANCEL           "Abbrechen"
+
+// ----- Password dialog -----
+#define S_NEW_CODE         "Neuer Code"
+#define S_REPEAT_CODE      "Code wiederh."
+#define S_ENTER_PASSWORD   "Code eingeben"
+#define S_PASS_HINT        "Auf/Ab ENT=Vor ESC=Zur\xfc" "ck"
+#define S_PASS_WRONG       "Falscher Code.Nochmal"
+#define S_CODES_DIFFER     "Codes ungleich.Nochmal"
+#define S_CHECKING         "Pr\xfc" "fe..."
+#define S_LOCKED_FMT       "Gesperrt: %lus warten"
+
+// ----- Idle dashboard -----
+#define S_DASH_TEMP        "Temp:"
+#define S_DASH_VIN         "Uein:"
+#define S_DASH_F1C         "L1I :"
+#define S_DASH_F2C         "L2I :"
+#define S_DASH_F1P         "L1P :"
+#define S_DASH_F2P         "L2P :"
+#define S_DASH_F1RUN       "L1  :"
+#define S_DASH_F2RUN       "L2  :"
+#define S_DASH_TREND_T     "T 1m"
+#define S_DASH_TREND_F1    "L1 1m"
+#define S_DASH_SITE_FMT    "Anlage %u/%u %ums"
+#define S_DASH_SITE_OFF    "Mastermodus aus"
@@ -0,0 +1,135 @@
+#pragma once
+// English UI strings (see Strings.h). Keep the names in step with Lang_de.h.
+#define S_LANG_CODE        "en"
+
+// ----- Main carousel -----
+#define S_MAIN             "Main"
+#define S_STATUS           "Status"
+#define S_ALARMS           "Alarms"
+#define S_SETTINGS         "Settings"
+#define S_ABOUT            "About"
+#define S_BACK             "<Back"
+
+// ----- Status / alarms -----
+#define S_TEMPERATURE      "Temperature"
+#define S_INPUT_VOLTAGE    "InputVoltage"
+#define S_DOOR_ALARM       "DoorAlarm"
+#define S_WATER_ALARM      "WaterAlarm"
+#define S_SMOKE_ALARM      "SmokeAlarm"
+#define S_TEMP_ALARM       "TempAlarm"
+#define S_FANFAULT_ALARM   "FanFaultAlarm"
+#define S_AVIATION_ALARM   "AviationAlarm"
+
+// ----- Settings -----
+#define S_TEMP_SETTINGS    "TemperatureSettings"
+#define S_TEMP_THR_LOW     "TempThresLOW"
+#define S_TEMP_THR_HIGH    "TempThreHIGH"
+#define S_TEMP_HIGH_THR    "TempHIGHThres"
+#define S_SYSTEM_SETTINGS  "SystemSettings"
+#define S_VOLT_LOW_THR     "VoltLOWThres"
+#define S_VOLT_HIGH_THR    "VoltHIGHThres"
+#define S_DIM_AFTER        "DimAfter"
+#define S_OFF_AFTER        "OffAfter"
+#define S_PAGE_ROTATE      "PageRotate"
+#define S_FAN_CURRENT_UNIT "FanCurrentUnit"
+#define S_FAN_PROFILE      "FanProfile"
+#define S_AUTO             "Auto"
+#define S_NORMAL           "Normal"
+#define S_FAN1_MODEL       "Fan1Model"
+#define S_FAN2_MODEL       "Fan2Model"
+#define S_CUSTOM           "CUSTOM"
+#define S_FAN1_SETTINGS    "Fan 1 Settings"
+#define S_FAN2_SETTINGS    "Fan 2 Settings"
+#define S_NOM_FAN1_CURR    "NomFan1Curr"
+#define S_NOM_FAN2_CURR    "NomFan2Curr"
+#define S_FAN1_SPEED       "Fan1Speed"
+#define S_FAN2_SPEED       "Fan2Speed"
+#define S_FAN1_RUN         "Fan1Run"
+#define S_FAN2_RUN         "Fan2Run"
+#define S_FAN1_ENERGY      "Fan1Energy"
+#define S_FAN2_ENERGY      "Fan2Energy"
+#define S_FAN_SETTINGS     "FanSettings"
+#define S_TOGGLE_PERIOD    "TogglePeriod"
+#define S_BAUDRATE         "Baudrate"
+#define S_MODBUS_SETTINGS  "ModbusSettings"
+#define S_SLAVE_ID         "SlaveID"
+#define S_MB_MASTER        "Master"
+#define S_MB_NODES         "Nodes"
+#define S_AVIATION_SETTINGS "AviationSettings"
+#define S_AVI_LDR_THR      "AviLDRThres"
+#define S_AVI_LUX          "AviLux"
+#define S_AVI_LAMP         "LampCurr"
+#define S_AVI_TEST         "Test Light"
+#define S_CALIBRATION      "Calibration"
+#define S_CAL_VIN_REF      "VinRef"
+#define S_CAL_VIN_SET      "Set Vin to Ref"
+#define S_CAL_VIN_GAIN     "VinGain"
+#define S_CAL_VIN_OFFSET   "VinOffset"
+#define S_CAL_TEMP_REF     "TempRef"
+#define S_CAL_TEMP_SET     "Set Temp to Ref"
+#define S_CAL_NTC_OFFSET   "TempOffset"
+#define S_SECURITY         "Security"
+#define S_CODE_LENGTH      "CodeLength"
+#define S_CHANGE_CODE      "Change Code"
+#define S_FACTORY_RESET    "Run Factory Reset"
+
+// ----- Diagnostics -----
+#define S_DIAGNOSTICS      "Diagnostics"
+#define S_UPTIME           "Uptime"
+#define S_CPU_LOAD         "CPULoad"
+#define S_UI_BUSY          "UIBusy"
+#define S_UI_STACK_FREE    "UIStackFree"
+#define S_MON_STACK_FREE   "MonStackFree"
+#define S_LOOP_AVG         "LoopAvg"
+#define S_LOOP_MAX         "LoopMax"
+#define S_LOOP_JITTER      "LoopJitter"
+#define S_I2C_STALLS       "I2CStalls"
+#define S_I2C_SENSOR_WAIT  "I2CSensWait"
+#define S_I2C_ERRORS       "I2CErrors"
+#define S_I2C_RESETS       "I2CResets"
+#define S_COUNTER_COMMITS  "CntCommits"
+#define S_WDT_RESET        "WDTReset"
+#define S_PANEL_ON         "PanelOn"
+#define S_WAKE_LATENCY     "WakeLatency"
+#define S_MB_CYCLE         "MbCycle"
+#define S_MB_SERVED        "MbServed"
+#define S_FAN1_HEALTH      "Fan1Health"
+#define S_FAN2_HEALTH      "Fan2Health"
+#define S_FAN_BLOCKS_LATE  "FanBlkLate"
+
+// ----- About -----
+#define S_ABOUT_VERSION    "SWVersion: " FW_VERSION
+#define S_ABOUT_DATE       "SWDate: " FW_DATE
+#define S_ABOUT_INSTALLED  "Installed: " FW_INSTALLED
+#define S_ABOUT_SERIAL     "Serial: " FW_SERIAL
+
+// ----- Confirm dialog -----
+#define S_CONFIRM          "Confirm"
+#define S_APPLY            "Apply"
+#define S_APPLY_EXIT       "Apply & Exit"
+#define S_DISCARD_EXIT     "Discard & Exit"
+#define S_CANCEL           "Cancel"
+
+// ----- Password dialog -----
+#define S_NEW_CODE         "New Code"
+#define S_REPEAT_CODE      "Repeat Code"
+#define S_ENTER_PASSWORD   "Enter Password"
+#define S_PASS_HINT        "Up/Dn=Edit ENT=Next ESC=Prev"
+#define S_PASS_WRONG       "Wrong password.Try again"
+#define S_CODES_DIFFER     "Codes differ.Try again"
+#define S_CHECKING         "Checking..."
+#define S_LOCKED_FMT       "Locked: wait %lus"
+
+// ----- Idle dashboard -----
+#define S_DASH_TEMP        "Temp:"
+#define S_DASH_VIN         "Vin :"
+#define S_DASH_F1C         "F1C :"
+#define S_DASH_F2C         "F2C :"
+#define S_DASH_F1P         "F1P :"
+#define S_DASH_F2P         "F2P :"
+#define S_DASH_F1RUN       "F1  :"
+#define S_DASH_F2RUN       "F2  :"
+#define S_DASH_TREND_T     "T 1m"
+#define S_DASH_TREND_F1    "F1 1m"
+#define S_DASH_SITE_FMT    "Site %u/%u %ums"
+#define S_DASH_SITE_OFF    "Master mode off"
@@ -7,17 +7,43 @@
 #include <menuIO/chainStream.h>
 #include <OneButton.h>
 #include <U8g2lib.h>
-#include <Wire.h>
 
 #include "AppData.h"
 #include "Pins.h"
 #include "FanAnimator.h"
+#include "FanTach.h"
+#include "FanCounters.h"
+#include "FanHealth.h"
+#include "FanSprite.h"
+#include "History.h"
+#include "Dashboard.h"
+#include "DashboardLayout.h"
+#include "UiTrace.h"
+#include "DrawBench.h"
+#include "HealthMonitor.h"
+#include "PowerManager.h"
+#include "AlarmLog.h"
+#include "Password.h"
+#include "ModalLogic.h"
+#include "FieldEdit.h"
+#include "IconAtlas.h"
+#include "DisplaySink.h"
+#include "FrameDiffLogic.h"
+#include "FrameMirror.h"
+#include "AviationLight.h"
+#include "Sensors.h"
+#include "Boot.h"
+#include "I2cBus.h"
+#include "Modbus.h"
+#include "StaticAlloc.h"
+#include "Strings.h"
+#include "UiFonts.h"
 #include "images.h"
 
 using namespace Menu;
 
 // ===== Display / fonts =====
-#define fontName u8g2_font_5x8_tf   // keep for your custom screens
+#define fontName UI_FONT_CUSTOM      // keep for your custom screens
 #define fontX 7                      // wider cells for submenu
 #define fontY 12                     // taller cells for submenu
 #define offsetX 0
@@ -25,7 +51,47 @@ using namespace Menu;
 #define U8_Width 128
 #define U8_Height 64
 
-static U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R2, RESET_PIN, OLED_ADDR);
+// Everything is drawn into u8g2; extra sinks get a copy of each frame.
+// Both panels talk through the shared bus task (I2cBus.h).
+#if DISPLAY2_ENABLE
+#ifndef DISPLAY2_SETUP
+#define DISPLAY2_SETUP u8g2_Setup_sh1106_i2c_128x64_noname_f
+#endif
+#endif
+
+// ===== UI arena =====
+// The library objects the UI owns, in one block (StaticAlloc.h). The U8g2
+// frame buffer itself is a static inside the u8g2 setup function.
+struct UiObjects {
+  U8G2_I2C_BUS u8g2{u8g2_Setup_ssd1306_i2c_128x64_noname_f, U8G2_R2, OLED_ADDR, RESET_PIN};
+#if DISPLAY2_ENABLE
+  U8G2_I2C_BUS u8g2Door{DISPLAY2_SETUP, U8G2_R2, OLED2_ADDR};
+  U8g2Sink doorSink{u8g2Door};
+#endif
+  FanAnimator fans{u8g2};
+  FanSpriteSet<16,16,FAN_SPRITE_FRAMES_16> fanFrames;    // built in uiSetup()
+  Dashboard dash{u8g2, DASH_LAYOUT, DASH_LAYOUT_COUNT};
+  OneButton btnUp{BTN_UP,true,true};
+  OneButton btnDown{BTN_DOWN,true,true};
+  OneButton btnEnter{BTN_ENTER,true,true};
+  OneButton btnEsc{BTN_ESC,true,true};
+};
+static UiObjects ui UI_ARENA;
+STATIC_SIZE_REPORT(UiObjects);
+static_assert(sizeof(UiObjects) <= UI_ARENA_BYTES, "UI arena over UI_ARENA_BYTES");
+
+static auto& u8g2 = ui.u8g2;
+#if DISPLAY2_ENABLE
+static auto& u8g2Door = ui.u8g2Door;
+static auto& doorSink = ui.doorSink;
+#endif
+static auto& fans = ui.fans;
+static auto& fanFrames = ui.fanFrames;
+static auto& dash = ui.dash;
+static auto& btnUp = ui.btnUp;
+static auto& btnDown = ui.btnDown;
+static auto& btnEnter = ui.btnEnter;
+static auto& btnEsc = ui.btnEsc;
 
 // ===== Menu colors =====
 static const colorDef<uint8_t> colors[6] MEMMODE={
@@ -38,11 +104,23 @@ static const colorDef<uint8_t> colors[6] MEMMODE={
 };
 
 // ===== Password / unlock =====
-static bool passwordVisible=false;
-static uint8_t passDigits[4]={0,0,0,0};
-static uint8_t passIndex=0;
-static const uint8_t PASSWORD[4]={1,0,0,1};
-static bool passWrong=false;
+// The same digit dialog unlocks Settings and sets a new code (entered twice).
+// Its state is the frame of passFlow() (ModalLogic.h); the dialog draws it.
+enum PassDialog : uint8_t { PASSDLG_UNLOCK, PASSDLG_NEW, PASSDLG_REPEAT };
+struct PassFrame {
+  ModalFrame co;
+  PassDialog mode;
+  uint8_t len;
+  uint8_t digits[PASS_MAX_LEN];
+  uint8_t first[PASS_MAX_LEN];                // new code waiting for its repeat
+  uint8_t index;
+  bool wrong;
+  bool busy;                                  // hash running in Password.cpp
+  PassResult result;
+};
+static PassFrame pass={};
+// Digits for the next code set from Settings > Security
+static uint8_t passNewLen=PASS_MIN_LEN;
 // Keep Settings unlocked until we return to Idle
 static bool settingsUnlocked=false;
 
@@ -52,7 +130,7 @@ static unsigned long lastInputMs=0;
 static const unsigned long MENU_TIMEOUT_MS=60000UL;
 
 // ===== Horizontal main menu =====
-static const char* MAIN_LABELS[4] = {"Status","Alarms","Settings","About"};
+static const char* MAIN_LABELS[4] = {S_STATUS,S_ALARMS,S_SETTINGS,S_ABOUT};
 static uint8_t mainIdx = 0;
 static const uint8_t MAIN_COUNT = 4;
 
@@ -61,7 +139,11 @@ static uint8_t winStart = 0;       // index of left tile in the window
 
 // ----- Idle page cycling -----
 static uint8_t idleCaseIndex = 0; 
-static uint8_t MaxDataPage  = 4; 
+static unsigned long lastPageMs = 0;   // for gLive.dashRotateS
+// Idle page left in the buffer by the last frame (-1: none, draw it whole)
+// and the sun/moon + alarm icons on it
+static int16_t idleDrawnPage = -1;
+static uint8_t idleDrawnIcons = 0;
 
 static inline void ensureWindow(){
   // keep mainIdx visible inside [winStart, winStart+WIN_SIZE-1]
@@ -86,13 +168,15 @@ static inline uint16_t accelInterval(unsigned long heldMs){
   return 160;
 }
 
-// Exit confirmation
-static bool confirmVisible=false;
-static uint8_t confirmIdx=0;
+// Exit confirmation (frame of confirmFlow())
+struct ConfirmFrame {
+  ModalFrame co;
+  uint8_t idx;
+};
+static ConfirmFrame confirm={};
 
-// Fans
-extern const uint8_t* images[4];
-static FanAnimator fans(u8g2);
+// The open dialog flow, if any: it gets every button event
+static ModalRunner modal={};
 
 // ===== Button queue → ArduinoMenu input bridge =====
 static const uint8_t BTN_Q_SIZE=8;
@@ -119,12 +203,6 @@ static inline void pushCmd(char c){
   if (next!=qTail){ btnQueue[qHead]=c; qHead=next; }
 }
 
-// ===== Buttons =====
-static OneButton btnUp(BTN_UP,true,true);
-static OneButton btnDown(BTN_DOWN,true,true);
-static OneButton btnEnter(BTN_ENTER,true,true);
-static OneButton btnEsc(BTN_ESC,true,true);
-
 // ===== Menu geometry =====
 #define MAX_DEPTH 6
 #define MENU_PX_W 160
@@ -134,16 +212,36 @@ static OneButton btnEsc(BTN_ESC,true,true);
 // Render throttle
 static const uint16_t FRAME_MS=25;
 static unsigned long lastFrameMs=0;
+static uint16_t busResetsSeen=0;               // i2cBusResetCount() the panels match
+
+// Send only the tiles that changed (FrameDiffLogic.h); 0 = sendBuffer() always
+#ifndef UI_DIRTY_FLUSH
+#define UI_DIRTY_FLUSH 1
+#endif
+// Resend everything this often anyway (a hash collision or a glitch on the
+// panel side cannot stick)
+#ifndef UI_FULL_FLUSH_MS
+#define UI_FULL_FLUSH_MS 10000UL
+#endif
+static FrameDiff frameDiff;                    // invalid until the first flush
+static FrameDiffSpan frameSpans[FRAME_DIFF_MAX_TILES_H];
+static unsigned long lastFullFlushMs=0;
 
 // ===== Forward decls =====
 static result doFactoryReset(eventMask, prompt&);
 static result onEnterSettings(eventMask, prompt&);
+static result onChangeCode(eventMask, prompt&);
 // Forward-declare goIdle so handlers can call it before nav exists
 static inline void goIdle();
 
 // ===== Helpers =====
-static void passReset(){ passDigits[0]=passDigits[1]=passDigits[2]=passDigits[3]=0; passIndex=0; passWrong=false; }
-static bool passIsCorrect(){ for(int i=0;i<4;i++) if(passDigits[i]!=PASSWORD[i]) return false; return true; }
+extern const ModalFlow PASS_FLOW, CONFIRM_FLOW;
+// The boot task owns the password state until bootDone()
+static void passOpen(PassDialog mode, uint8_t len){
+  if(!bootDone()) return;
+  pass.mode=mode; pass.len=len;
+  modalOpen(modal, PASS_FLOW);
+}
 
 #ifndef ROFIELD
 #define ROFIELD(target,label,units,low,high,step,tune) \
@@ -152,79 +250,88 @@ static bool passIsCorrect(){ for(int i=0;i<4;i++) if(passDigits[i]!=PASSWORD[i])
 #endif
 
 // ===== Menus =====
-MENU(MenuStatus,"Status",doNothing,noEvent,noStyle
-  ,ROFIELD(statusTempC,"Temperature","C",-40,125,1,0)
-  ,ROFIELD(statusVinV,"InputVoltage","V",0,300,1,0)
-  ,EXIT("<Back")
+MENU(MenuStatus,S_STATUS,doNothing,noEvent,noStyle
+  ,ROFIELD(statusTempC,S_TEMPERATURE,U_DEG_C,-40,125,1,0)
+  ,ROFIELD(statusVinV,S_INPUT_VOLTAGE,U_VOLT,0,300,1,0)
+  ,EXIT(S_BACK)
 )
 
-MENU(MenuAlarms,"Alarms",doNothing,noEvent,noStyle
-  ,ROFIELD(alarmDoor,"DoorAlarm"," ",0,1,1,0)
-  ,ROFIELD(alarmWater,"WaterAlarm"," ",0,1,1,0)
-  ,ROFIELD(alarmSmoke,"SmokeAlarm"," ",0,1,1,0)
-  ,ROFIELD(alarmTemp,"TempAlarm"," ",0,1,1,0)
-  ,ROFIELD(alarmFanFault,"FanFaultAlarm"," ",0,1,1,0)
-  ,ROFIELD(alarmAviation,"AviationAlarm"," ",0,1,1,0)
-  ,EXIT("<Back")
+MENU(MenuAlarms,S_ALARMS,doNothing,noEvent,noStyle
+  ,ROFIELD(alarmDoor,S_DOOR_ALARM,U_NONE,0,1,1,0)
+  ,ROFIELD(alarmWater,S_WATER_ALARM,U_NONE,0,1,1,0)
+  ,ROFIELD(alarmSmoke,S_SMOKE_ALARM,U_NONE,0,1,1,0)
+  ,ROFIELD(alarmTemp,S_TEMP_ALARM,U_NONE,0,1,1,0)
+  ,ROFIELD(alarmFanFault,S_FANFAULT_ALARM,U_NONE,0,1,1,0)
+  ,ROFIELD(alarmAviation,S_AVIATION_ALARM,U_NONE,0,1,1,0)
+  ,EXIT(S_BACK)
 )
 
-MENU(MenuTempSettings,"TemperatureSettings",doNothing,noEvent,noStyle
-  ,FIELD(gStage.tempThrL,"TempThresLOW","C",-40,125,1,0,doNothing,noEvent,noStyle)
-  ,FIELD(gStage.tempThrH,"TempThreHIGH","C",-40,125,1,0,doNothing,noEvent,noStyle)
-  ,FIELD(gStage.tempHighThr,"TempHIGHThres","C",-40,125,1,0,doNothing,noEvent,noStyle)
-  ,EXIT("<Back")
+MENU(MenuTempSettings,S_TEMP_SETTINGS,doNothing,noEvent,noStyle
+  ,FIELD(gStage.tempThrL,S_TEMP_THR_LOW,U_DEG_C,-40,125,1,0,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.tempThrH,S_TEMP_THR_HIGH,U_DEG_C,-40,125,1,0,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.tempHighThr,S_TEMP_HIGH_THR,U_DEG_C,-40,125,1,0,doNothing,noEvent,noStyle)
+  ,EXIT(S_BACK)
 );
 
-MENU(MenuSystemSettings,"SystemSettings",doNothing,noEvent,noStyle
-  ,FIELD(gStage.voltLThrV,"VoltLOWThres","V",0,300,1,0,doNothing,noEvent,noStyle)
-  ,FIELD(gStage.voltHighThrV,"VoltHIGHThres","V",0,300,1,0,doNothing,noEvent,noStyle)
-  ,EXIT("<Back")
+MENU(MenuSystemSettings,S_SYSTEM_SETTINGS,doNothing,noEvent,noStyle
+  ,FIELD(gStage.voltLThrV,S_VOLT_LOW_THR,U_VOLT,0,300,1,0,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.voltHighThrV,S_VOLT_HIGH_THR,U_VOLT,0,300,1,0,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.dimAfterS,S_DIM_AFTER,U_SEC,0,3600,10,1,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.offAfterS,S_OFF_AFTER,U_SEC,0,7200,10,1,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.dashRotateS,S_PAGE_ROTATE,U_SEC,0,600,5,1,doNothing,noEvent,noStyle)
+  ,EXIT(S_BACK)
 );
 
-SELECT(gStage.fanCurrentUnit, MenuFanCurrentUnit,"FanCurrentUnit",doNothing,noEvent,noStyle
-  ,VALUE("mA",UNIT_mA,doNothing,noEvent)
-  ,VALUE("A", UNIT_A, doNothing,noEvent)
+SELECT(gStage.fanCurrentUnit, MenuFanCurrentUnit,S_FAN_CURRENT_UNIT,doNothing,noEvent,noStyle
+  ,VALUE(U_MA,UNIT_mA,doNothing,noEvent)
+  ,VALUE(U_AMP, UNIT_A, doNothing,noEvent)
 );
 
-SELECT(gStage.fanProfile, MenuFanProfile,"FanProfile",doNothing,noEvent,noStyle
-  ,VALUE("Auto",PROF_AUTO,doNothing,noEvent)
-  ,VALUE("Normal",PROF_NORMAL,doNothing,noEvent)
+SELECT(gStage.fanProfile, MenuFanProfile,S_FAN_PROFILE,doNothing,noEvent,noStyle
+  ,VALUE(S_AUTO,PROF_AUTO,doNothing,noEvent)
+  ,VALUE(S_NORMAL,PROF_NORMAL,doNothing,noEvent)
 );
 
-SELECT(gStage.fan1Model, MenuFan1Model,"Fan1Model",doNothing,noEvent,noStyle
-  ,VALUE("KRUBO",MODEL_KRUBO,doNothing,noEvent)
-  ,VALUE("DELTA",MODEL_DELTA,doNothing,noEvent)
-  ,VALUE("CUSTOM",MODEL_CUSTOM,doNothing,noEvent)
+SELECT(gStage.fan1Model, MenuFan1Model,S_FAN1_MODEL,doNothing,noEvent,noStyle
+  ,VALUE(S_MODEL_KRUBO,MODEL_KRUBO,doNothing,noEvent)
+  ,VALUE(S_MODEL_DELTA,MODEL_DELTA,doNothing,noEvent)
+  ,VALUE(S_CUSTOM,MODEL_CUSTOM,doNothing,noEvent)
 );
 
-MENU(Fan1Settings,"Fan 1 Settings",doNothing,noEvent,noStyle
+MENU(Fan1Settings,S_FAN1_SETTINGS,doNothing,noEvent,noStyle
   ,SUBMENU(MenuFan1Model)
-  ,FIELD(gStage.fan1nominal,"NomFan1Curr","mA",0,10000,1,0,doNothing,noEvent,noStyle)
-  ,EXIT("<Back")
+  ,FIELD(gStage.fan1nominal,S_NOM_FAN1_CURR,U_MA,0,10000,1,0,doNothing,noEvent,noStyle)
+  ,ROFIELD(fan1Rpm,S_FAN1_SPEED,U_RPM,0,20000,1,0)
+  ,ROFIELD(fan1Run_m,S_FAN1_RUN,U_MINUTE,0,0,1,0)
+  ,ROFIELD(fan1Energy_kWh,S_FAN1_ENERGY,U_KWH,0,0,1,0)
+  ,EXIT(S_BACK)
 );
 
-SELECT(gStage.fan2Model, MenuFan2Model,"Fan2Model",doNothing,noEvent,noStyle
-  ,VALUE("KRUBO",MODEL_KRUBO,doNothing,noEvent)
-  ,VALUE("DELTA",MODEL_DELTA,doNothing,noEvent)
-  ,VALUE("CUSTOM",MODEL_CUSTOM,doNothing,noEvent)
+SELECT(gStage.fan2Model, MenuFan2Model,S_FAN2_MODEL,doNothing,noEvent,noStyle
+  ,VALUE(S_MODEL_KRUBO,MODEL_KRUBO,doNothing,noEvent)
+  ,VALUE(S_MODEL_DELTA,MODEL_DELTA,doNothing,noEvent)
+  ,VALUE(S_CUSTOM,MODEL_CUSTOM,doNothing,noEvent)
 );
 
-MENU(Fan2Settings,"Fan 2 Settings",doNothing,noEvent,noStyle
+MENU(Fan2Settings,S_FAN2_SETTINGS,doNothing,noEvent,noStyle
   ,SUBMENU(MenuFan2Model)
-  ,FIELD(gStage.fan2nominal,"NomFan2Curr","mA",0,10000,1,0,doNothing,noEvent,noStyle)
-  ,EXIT("<Back")
+  ,FIELD(gStage.fan2nominal,S_NOM_FAN2_CURR,U_MA,0,10000,1,0,doNothing,noEvent,noStyle)
+  ,ROFIELD(fan2Rpm,S_FAN2_SPEED,U_RPM,0,20000,1,0)
+  ,ROFIELD(fan2Run_m,S_FAN2_RUN,U_MINUTE,0,0,1,0)
+  ,ROFIELD(fan2Energy_kWh,S_FAN2_ENERGY,U_KWH,0,0,1,0)
+  ,EXIT(S_BACK)
 );
 
-MENU(MenuFanSettings,"FanSettings",doNothing,noEvent,noStyle
-  ,FIELD(gStage.togglePeriodMs,"TogglePeriod","min",0,100,1,0,doNothing,noEvent,noStyle)
+MENU(MenuFanSettings,S_FAN_SETTINGS,doNothing,noEvent,noStyle
+  ,FIELD(gStage.togglePeriodMs,S_TOGGLE_PERIOD,U_MINUTE,0,100,1,0,doNothing,noEvent,noStyle)
   ,SUBMENU(MenuFanCurrentUnit)
   ,SUBMENU(MenuFanProfile)
   ,SUBMENU(Fan1Settings)
   ,SUBMENU(Fan2Settings)
-  ,EXIT("<Back")
+  ,EXIT(S_BACK)
 );
 
-SELECT(gStage.baudrate, MenuBaudrate,"Baudrate",doNothing,noEvent,noStyle
+SELECT(gStage.baudrate, MenuBaudrate,S_BAUDRATE,doNothing,noEvent,noStyle
   ,VALUE("9600",9600,doNothing,noEvent)
   ,VALUE("19200",19200,doNothing,noEvent)
   ,VALUE("38400",38400,doNothing,noEvent)
@@ -232,45 +339,124 @@ SELECT(gStage.baudrate, MenuBaudrate,"Baudrate",doNothing,noEvent,noStyle
   ,VALUE("115200",115200,doNothing,noEvent)
 );
 
-MENU(MenuModbusSettings,"ModbusSettings",doNothing,noEvent,noStyle
+MENU(MenuModbusSettings,S_MODBUS_SETTINGS,doNothing,noEvent,noStyle
   ,SUBMENU(MenuBaudrate)
-  ,FIELD(gStage.slaveID,"SlaveID","",1,247,1,0,doNothing,noEvent,noStyle)
-  ,EXIT("<Back")
+  ,FIELD(gStage.slaveID,S_SLAVE_ID,"",1,247,1,0,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.modbusMaster,S_MB_MASTER,"",0,1,1,0,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.modbusNodes,S_MB_NODES,"",0,MB_MAX_NODES,1,0,doNothing,noEvent,noStyle)
+  ,EXIT(S_BACK)
+);
+
+static result onAviationTest(eventMask, prompt&){
+  aviationTestNow();
+  return proceed;
+}
+
+MENU(MenuAviationSettings,S_AVIATION_SETTINGS,doNothing,noEvent,noStyle
+  ,FIELD(gStage.LDRThreshold,S_AVI_LDR_THR,U_LUX,1,247,1,0,doNothing,noEvent,noStyle)
+  ,ROFIELD(diagAviLux,S_AVI_LUX,U_LUX,0,0,1,0)
+  ,ROFIELD(diagAviLampMa,S_AVI_LAMP,U_MA,0,0,1,0)
+  ,OP(S_AVI_TEST,onAviationTest,enterEvent)
+  ,EXIT(S_BACK)
 );
 
-MENU(MenuAviationSettings,"AviationSettings",doNothing,noEvent,noStyle
-  ,FIELD(gStage.LDRThreshold,"AviLDRThres","LUX",1,247,1,0,doNothing,noEvent,noStyle)
-  ,EXIT("<Back")
+// Calibration: apply a known voltage / temperature, enter it as the
+// reference and let the unit work out the trim. The trims are staged like
+// any setting; the readings above them change once they are applied.
+static float calVinRefV = 24.0f;
+static float calTempRefC = 25.0f;
+
+static result onCalVin(eventMask, prompt&){
+  if(!sensorsCalibrateVin(calVinRefV, gStage)) Serial.println("[Cal] Vin: no reading or trim out of range");
+  return proceed;
+}
+
+static result onCalTemp(eventMask, prompt&){
+  if(!sensorsCalibrateTemp(calTempRefC, gStage)) Serial.println("[Cal] Temp: no reading or trim out of range");
+  return proceed;
+}
+
+MENU(MenuCalibration,S_CALIBRATION,doNothing,noEvent,noStyle
+  ,ROFIELD(statusVinV,S_INPUT_VOLTAGE,U_VOLT,0,300,1,0)
+  ,FIELD(calVinRefV,S_CAL_VIN_REF,U_VOLT,0,300,1,0.1,doNothing,noEvent,noStyle)
+  ,OP(S_CAL_VIN_SET,onCalVin,enterEvent)
+  ,FIELD(gStage.vinGainTrim,S_CAL_VIN_GAIN,U_PCT100,-2000,2000,10,1,doNothing,noEvent,noStyle)
+  ,FIELD(gStage.vinOffsetMv,S_CAL_VIN_OFFSET,U_MV,-2000,2000,10,1,doNothing,noEvent,noStyle)
+  ,ROFIELD(statusTempC,S_TEMPERATURE,U_DEG_C,-40,125,1,0)
+  ,FIELD(calTempRefC,S_CAL_TEMP_REF,U_DEG_C,-40,125,1,0.1,doNothing,noEvent,noStyle)
+  ,OP(S_CAL_TEMP_SET,onCalTemp,enterEvent)
+  ,FIELD(gStage.ntcOffsetDc,S_CAL_NTC_OFFSET,U_DECI_C,-100,100,1,0,doNothing,noEvent,noStyle)
+  ,EXIT(S_BACK)
 );
 
 // Gate Settings with password unless unlocked
 static result onEnterSettings(eventMask, prompt&){
+  if(!bootDone()) return quit;                 // stored code not loaded yet
   if(!settingsUnlocked){
-    passwordVisible=true; passReset();
+    passOpen(PASSDLG_UNLOCK, passwordLength());
     return quit;
   }
   return proceed;
 }
 
-MENU(MenuSettings,"Settings",onEnterSettings,enterEvent,noStyle
+static result onChangeCode(eventMask, prompt&){
+  passOpen(PASSDLG_NEW, passNewLen);
+  return proceed;
+}
+
+MENU(MenuSecurity,S_SECURITY,doNothing,noEvent,noStyle
+  ,FIELD(passNewLen,S_CODE_LENGTH,U_NONE,PASS_MIN_LEN,PASS_MAX_LEN,1,0,doNothing,noEvent,noStyle)
+  ,OP(S_CHANGE_CODE,onChangeCode,enterEvent)
+  ,EXIT(S_BACK)
+);
+
+MENU(MenuSettings,S_SETTINGS,onEnterSettings,enterEvent,noStyle
   ,SUBMENU(MenuTempSettings)
   ,SUBMENU(MenuSystemSettings)
   ,SUBMENU(MenuFanSettings)
   ,SUBMENU(MenuModbusSettings)
   ,SUBMENU(MenuAviationSettings)
-  ,OP("Run Factory Reset",doFactoryReset,enterEvent)
-  ,EXIT("<Back")
+  ,SUBMENU(MenuCalibration)
+  ,SUBMENU(MenuSecurity)
+  ,OP(S_FACTORY_RESET,doFactoryReset,enterEvent)
+  ,EXIT(S_BACK)
+);
+
+MENU(MenuDiagnostics,S_DIAGNOSTICS,doNothing,noEvent,noStyle
+  ,ROFIELD(diagUptimeS,S_UPTIME,U_SEC,0,0,1,0)
+  ,ROFIELD(diagCpuLoad,S_CPU_LOAD,U_PCT,0,100,1,0)
+  ,ROFIELD(diagUiCpu,S_UI_BUSY,U_PCT,0,100,1,0)
+  ,ROFIELD(diagUiStackFree,S_UI_STACK_FREE,U_WORDS,0,0,1,0)
+  ,ROFIELD(diagMonStackFree,S_MON_STACK_FREE,U_WORDS,0,0,1,0)
+  ,ROFIELD(diagLoopAvgUs,S_LOOP_AVG,U_US,0,0,1,0)
+  ,ROFIELD(diagLoopMaxUs,S_LOOP_MAX,U_US,0,0,1,0)
+  ,ROFIELD(diagLoopJitterUs,S_LOOP_JITTER,U_US,0,0,1,0)
+  ,ROFIELD(diagI2cStalls,S_I2C_STALLS,U_NONE,0,0,1,0)
+  ,ROFIELD(diagI2cSensorMaxUs,S_I2C_SENSOR_WAIT,U_US,0,0,1,0)
+  ,ROFIELD(diagI2cErrors,S_I2C_ERRORS,U_NONE,0,0,1,0)
+  ,ROFIELD(diagI2cResets,S_I2C_RESETS,U_NONE,0,0,1,0)
+  ,ROFIELD(diagCounterCommits,S_COUNTER_COMMITS,U_NONE,0,0,1,0)
+  ,ROFIELD(diagWdtReset,S_WDT_RESET,U_NONE,0,1,1,0)
+  ,ROFIELD(diagPanelOnPct,S_PANEL_ON,U_PCT,0,100,1,0)
+  ,ROFIELD(diagWakeLatencyMs,S_WAKE_LATENCY,U_MS,0,0,1,0)
+  ,ROFIELD(diagMbCycleMs,S_MB_CYCLE,U_MS,0,0,1,0)
+  ,ROFIELD(diagMbServed,S_MB_SERVED,U_NONE,0,0,1,0)
+  ,ROFIELD(diagFan1Health,S_FAN1_HEALTH,U_PCT,0,100,1,0)
+  ,ROFIELD(diagFan2Health,S_FAN2_HEALTH,U_PCT,0,100,1,0)
+  ,ROFIELD(diagFanBlocksLate,S_FAN_BLOCKS_LATE,U_NONE,0,0,1,0)
+  ,EXIT(S_BACK)
 );
 
-MENU(MenuAbout,"About",doNothing,noEvent,noStyle
-  ,OP("SWVersion: 1.14",doNothing,noEvent)
-  ,OP("SWDate: 2025-04-01",doNothing,noEvent)
-  ,OP("Installed: 2025-04-01",doNothing,noEvent)
-  ,OP("Serial: SARBS_ODCC_1001",doNothing,noEvent)
-  ,EXIT("<Back")
+MENU(MenuAbout,S_ABOUT,doNothing,noEvent,noStyle
+  ,OP(S_ABOUT_VERSION,doNothing,noEvent)
+  ,OP(S_ABOUT_DATE,doNothing,noEvent)
+  ,OP(S_ABOUT_INSTALLED,doNothing,noEvent)
+  ,OP(S_ABOUT_SERIAL,doNothing,noEvent)
+  ,SUBMENU(MenuDiagnostics)
+  ,EXIT(S_BACK)
 );
 
-MENU(mainMenu,"Main",doNothing,noEvent,noStyle
+MENU(mainMenu,S_MAIN,doNothing,noEvent,noStyle
   ,SUBMENU(MenuStatus)
   ,SUBMENU(MenuAlarms)
   ,SUBMENU(MenuSettings)
@@ -290,8 +476,7 @@ static bool atRoot(){ return nav.level==0; }
 
 // Now that nav exists, define goIdle
 static inline void goIdle(){
-  confirmVisible=false;
-  passwordVisible=false;
+  modalClose(modal);
   uiMode=UI_IDLE;
   btnInput.flush();
   nav.reset();
@@ -326,20 +511,20 @@ static void openMainFromIndex(uint8_t idx){
 
 static void drawMainMenuHorizontal(){
   // Title
-  u8g2.setFont(u8g2_font_7x14_tr);
+  u8g2.setFont(UI_FONT_TITLE);
   u8g2.setDrawColor(1);
-  u8g2.drawStr(50, 12, "Main");
+  u8g2.drawStr(50, 12, S_MAIN);
 
   // ----- geometry -----
   const int Y_TOP = 14;
 
   // center (selected) tile
   const int C_W = 56, C_H = 40;
-  const int C_ICON_W = 24, C_ICON_H = 24;
+  const int C_ICON_W = 24;
 
   // side (unselected) tiles
   const int S_W = 36, S_H = 28;
-  const int S_ICON_W = 16, S_ICON_H = 16;
+  const int S_ICON_W = 16;
 
   const int GAP_CS = 6; // gap between center and a side
 
@@ -356,21 +541,12 @@ static void drawMainMenuHorizontal(){
   const uint8_t right = wrap(sel + 1, MAIN_COUNT);
 
   // ----- helpers -----
-  auto icon24For = [](uint8_t item)->const uint8_t* {
-    switch(item){
-      case 0: return ICON_STATUS_24;
-      case 1: return ICON_ALARMS_24;
-      case 2: return ICON_SETTINGS_24;
-      default:return ICON_ABOUT_24;
-    }
+  // Carousel icons per main item (atlas ids)
+  static const IconId ICON24[MAIN_COUNT] = {
+    ICON_ID_STATUS_24, ICON_ID_ALARMS_24, ICON_ID_SETTINGS_24, ICON_ID_ABOUT_24
   };
-  auto icon16For = [](uint8_t item)->const uint8_t* {
-    switch(item){
-      case 0: return ICON_STATUS_16;
-      case 1: return ICON_ALARMS_16;
-      case 2: return ICON_SETTINGS_16;
-      default:return ICON_ABOUT_16;
-    }
+  static const IconId ICON16[MAIN_COUNT] = {
+    ICON_ID_STATUS_16, ICON_ID_ALARMS_16, ICON_ID_SETTINGS_16, ICON_ID_ABOUT_16
   };
   auto labelFor = [](uint8_t item)->const char* {
     return MAIN_LABELS[item];
@@ -383,9 +559,9 @@ static void drawMainMenuHorizontal(){
     // icon
     const int ix = x + (S_W - S_ICON_W)/2;
     const int iy = y + 4;
-    u8g2.drawXBMP(ix, iy +5, S_ICON_W, S_ICON_H, icon16For(left));
+    iconDraw(u8g2, ix, iy + 5, ICON16[left]);
     // label
-    u8g2.setFont(u8g2_font_4x6_tr);
+    u8g2.setFont(UI_FONT_SMALL);
     int w = u8g2.getStrWidth(labelFor(left));
     u8g2.drawStr(x + (S_W - w)/2, y + S_H + 5, labelFor(left));
   }
@@ -401,10 +577,10 @@ static void drawMainMenuHorizontal(){
     // icon
     const int ix = x + (C_W - C_ICON_W)/2;
     const int iy = y + 6;
-    u8g2.drawXBMP(ix, iy, C_ICON_W, C_ICON_H, icon24For(sel));
+    iconDraw(u8g2, ix, iy, ICON24[sel]);
 
     // label
-    u8g2.setFont(u8g2_font_5x7_tr);
+    u8g2.setFont(UI_FONT_TILE);
     int w = u8g2.getStrWidth(labelFor(sel));
     u8g2.drawStr(x + (C_W - w)/2, y + C_H - 2, labelFor(sel));
 
@@ -418,9 +594,9 @@ static void drawMainMenuHorizontal(){
     // icon
     const int ix = x + (S_W - S_ICON_W)/2;
     const int iy = y + 4;
-    u8g2.drawXBMP(ix, iy + 5, S_ICON_W, S_ICON_H, icon16For(right));
+    iconDraw(u8g2, ix, iy + 5, ICON16[right]);
     // label
-    u8g2.setFont(u8g2_font_4x6_tr);
+    u8g2.setFont(UI_FONT_SMALL);
     int w = u8g2.getStrWidth(labelFor(right));
     u8g2.drawStr(x + (S_W - w)/2, y + S_H + 5, labelFor(right));
   }
@@ -431,87 +607,72 @@ static void drawMainMenuHorizontal(){
 
 
 // ===== Drawing helpers =====
+static uint8_t idleIcons(){
+  return (uint8_t)((Light_Condition ? 0x01 : 0) | (alarmDoor==1 ? 0x02 : 0) | (alarmWater==1 ? 0x04 : 0) |
+                   (alarmSmoke==1 ? 0x08 : 0) | (alarmTemp==1 ? 0x10 : 0) | (alarmFanFault==1 ? 0x20 : 0) |
+                   (alarmAviation==1 ? 0x40 : 0));
+}
+
 static void drawIdleScreen(){
-  u8g2.setFont(u8g2_font_7x14_tr);
+  idleDrawnIcons = idleIcons();
+  u8g2.setFont(UI_FONT_TITLE);
   u8g2.setDrawColor(1);
   u8g2.setFontMode(1);
   u8g2.setBitmapMode(1);
-  u8g2.drawStr(2,12,"SARBS TCU");
-  u8g2.setFont(u8g2_font_6x12_tr);
-  switch (idleCaseIndex) {
-
-    case 0: // Temp / Vin
-      u8g2.setCursor(2, 26);
-      u8g2.print("Temp:");
-      u8g2.print(statusTempC, 2);
-      u8g2.print("C");
-
-      u8g2.setCursor(2, 40);
-      u8g2.print("Vin :");
-      u8g2.print(statusVinV, 2);
-      u8g2.print("V");
-      break;
-
-    case 1: // F1C / F2C (mA)
-      u8g2.setCursor(2, 26);
-      u8g2.print("F1C :");
-      u8g2.print(fan1Current_mA, 2);
-      u8g2.print("mA");
-
-      u8g2.setCursor(2, 40);
-      u8g2.print("F2C :");
-      u8g2.print(fan2Current_mA, 2);
-      u8g2.print("mA");
-      break;
-
-    case 2: // F1P / F2P (W)
-      u8g2.setCursor(2, 26);
-      u8g2.print("F1P :");
-      u8g2.print(fan1Power_W, 2);
-      u8g2.print("W");
-
-      u8g2.setCursor(2, 40);
-      u8g2.print("F2P :");
-      u8g2.print(fan2Power_W, 2);
-      u8g2.print("W");
-      break;
-
-    case 3: // F1 / F2 (M)
-      u8g2.setCursor(2, 26);
-      u8g2.print("F1  :");
-      u8g2.print(fan1Run_m, 2);
-      u8g2.print("M");
-
-      u8g2.setCursor(2, 40);
-      u8g2.print("F2  :");
-      u8g2.print(fan2Run_m, 2);
-      u8g2.print("M");
-      break;
-  }
-
+  u8g2.drawStr(2,12,FW_DEVICE_NAME);
+  dash.draw(idleCaseIndex);
 
   if(Light_Condition == true){
-    u8g2.drawXBMP(U8_Width-16-6, 2, 16, 16, ICON_SUM_16); 
+    iconDraw(u8g2, U8_Width-16-6, 2, ICON_ID_SUM_16);
   }
   else{
-    u8g2.drawXBMP(U8_Width-16-6, 2, 16, 16, ICON_MOON_16); 
+    iconDraw(u8g2, U8_Width-16-6, 2, ICON_ID_MOON_16);
   }
 
-  if(alarmDoor == 1){     u8g2.drawXBMP(0,  44, 16, 16, ICON_DOOR_16); }
-  if(alarmWater == 1){    u8g2.drawXBMP(28, 44, 16, 16, ICON_WATER_16); }
-  if(alarmSmoke == 1){    u8g2.drawXBMP(59, 44, 16, 16, ICON_SMOKE_16); }
-  if(alarmTemp == 1){     u8g2.drawXBMP(16, 48, 16, 16, ICON_FIRE_16); }
-  if(alarmFanFault == 1){ u8g2.drawXBMP(42, 48, 16, 16, ICON_FAN_16);  }
-  if(alarmAviation == 1){ u8g2.drawXBMP(75, 48, 16, 16, ICON_LIGHT_16); }
-  // u8g2.drawXBMP(0,  44, 16, 16, ICON_DOOR_16);  
-  // u8g2.drawXBMP(28, 44, 16, 16, ICON_WATER_16);
-  // u8g2.drawXBMP(59, 44, 16, 16, ICON_SMOKE_16);
-  // u8g2.drawXBMP(16, 48, 16, 16, ICON_FIRE_16); 
-  // u8g2.drawXBMP(42, 48, 16, 16, ICON_FAN_16);  
-  // u8g2.drawXBMP(75, 48, 16, 16, ICON_LIGHT_16);
+  if(alarmDoor == 1){     iconDraw(u8g2, 0, 44, ICON_ID_DOOR_16); }
+  if(alarmWater == 1){    iconDraw(u8g2, 28, 44, ICON_ID_WATER_16); }
+  if(alarmSmoke == 1){    iconDraw(u8g2, 59, 44, ICON_ID_SMOKE_16); }
+  if(alarmTemp == 1){     iconDraw(u8g2, 16, 48, ICON_ID_FIRE_16); }
+  if(alarmFanFault == 1){ iconDraw(u8g2, 42, 48, ICON_ID_FAN_16);  }
+  if(alarmAviation == 1){ iconDraw(u8g2, 75, 48, ICON_ID_LIGHT_16); }
+  // iconDraw(u8g2, 0,  44, ICON_ID_DOOR_16);
+  // iconDraw(u8g2, 28, 44, ICON_ID_WATER_16);
+  // iconDraw(u8g2, 59, 44, ICON_ID_SMOKE_16);
+  // iconDraw(u8g2, 16, 48, ICON_ID_FIRE_16);
+  // iconDraw(u8g2, 42, 48, ICON_ID_FAN_16);
+  // iconDraw(u8g2, 75, 48, ICON_ID_LIGHT_16);
   fans.draw();
 }
 
+// The idle page is still in the buffer: clear only the boxes whose content
+// changed and redraw the page clipped to each, so whatever overlaps a box
+// (a long value under the fans, the site grid) comes back as drawn whole
+static void drawIdleChanges(){
+  DashBox box[DASH_MAX_WIDGETS+3];
+  uint8_t n=dash.changes(idleCaseIndex, box, DASH_MAX_WIDGETS);
+  const uint8_t icons=idleIcons();
+  if((icons^idleDrawnIcons)&0x01) box[n++]={(int16_t)(U8_Width-16-6), 2, 16, 16};
+  if((icons^idleDrawnIcons)&~0x01) box[n++]={0, 44, 91, 20};          // alarm icon strip
+  int16_t x0=U8_Width, y0=U8_Height, x1=0, y1=0;                      // changed fans, as one box
+  for(uint8_t i=0;i<fans.count();i++){
+    int16_t x, y; uint8_t w, h;
+    if(!fans.changed(i, x, y, w, h)) continue;
+    if(x<x0) x0=x;
+    if(y<y0) y0=y;
+    if(x+w>x1) x1=x+w;
+    if(y+h>y1) y1=y+h;
+  }
+  if(x1>x0) box[n++]={x0, y0, (uint8_t)(x1-x0), (uint8_t)(y1-y0)};
+
+  for(uint8_t i=0;i<n;i++){
+    u8g2.setClipWindow(box[i].x, box[i].y, box[i].x+box[i].w, box[i].y+box[i].h);
+    u8g2.setDrawColor(0);
+    u8g2.drawBox(box[i].x, box[i].y, box[i].w, box[i].h);
+    drawIdleScreen();
+  }
+  u8g2.setMaxClipWindow();
+}
+
 static void drawConfirmDialog(){
   u8g2.setDrawColor(0); 
   u8g2.drawBox(0,0,U8_Width,U8_Height);
@@ -522,22 +683,22 @@ static void drawConfirmDialog(){
   const int x=(U8_Width-w)/2, y=(U8_Height-h)/2;
   u8g2.drawFrame(x ,y,w,h);
 
-  u8g2.setFont(u8g2_font_7x13B_mf);
-  u8g2.drawStr(x+10, y+13, "Confirm");
+  u8g2.setFont(UI_FONT_DIALOG);
+  u8g2.drawStr(x+10, y+13, S_CONFIRM);
 
   // 4 options now
   static const char* opts[4] = {
-    "Apply",
-    "Apply & Exit",
-    "Discard & Exit",
-    "Cancel"
+    S_APPLY,
+    S_APPLY_EXIT,
+    S_DISCARD_EXIT,
+    S_CANCEL
   };
 
   // List items
-  u8g2.setFont(u8g2_font_6x10_tf);
+  u8g2.setFont(UI_FONT_MENU);
   for(int k=0;k<4;++k){
     int yy = y + 22 + k*10;
-    if(confirmIdx==k){
+    if(confirm.idx==k){
       // highlight row
       u8g2.setDrawColor(1); 
       u8g2.drawBox(x+6, yy-10, w-12, 11);
@@ -559,32 +720,34 @@ static void drawPasswordDialog(){
 
   // ===== Title (bigger) =====
   // Use a bold, taller font; 7x13B is crisp on 128x64
-  u8g2.setFont(u8g2_font_7x13B_mf);
-  const char* title = "Enter Password";
+  u8g2.setFont(UI_FONT_DIALOG);
+  const char* title = pass.mode==PASSDLG_NEW    ? S_NEW_CODE
+                    : pass.mode==PASSDLG_REPEAT ? S_REPEAT_CODE
+                    : S_ENTER_PASSWORD;
   int tw = u8g2.getStrWidth(title);
   int tx = (U8_Width - tw) / 2;
   int ty = 14;                  // baseline
   u8g2.drawStr(tx, ty, title);
 
   // ===== Digit boxes (bigger) =====
-  // 4 boxes, centered
-  const int boxW = 22;
+  // pass.len boxes, centered (narrower for codes longer than 4)
+  const int boxW = pass.len<=4 ? 22 : 12;
   const int boxH = 18;
-  const int gap  = 8;
-  const int totalW = 4*boxW + 3*gap;
+  const int gap  = pass.len<=4 ? 8 : 3;
+  const int totalW = pass.len*boxW + (pass.len-1)*gap;
   const int startX = (U8_Width - totalW) / 2;
   const int baseY  = 24;        // top of digit row
 
   // Bigger digit font
-  u8g2.setFont(u8g2_font_7x13B_mf);
+  u8g2.setFont(UI_FONT_DIALOG);
 
-  for(int i=0;i<4;i++){
+  for(int i=0;i<pass.len;i++){
     int bx = startX + i*(boxW + gap);
     // selected -> filled box (inverted digits), otherwise framed box
-    if(i == passIndex){
+    if(i == pass.index){
       u8g2.drawBox(bx, baseY, boxW, boxH);
       u8g2.setDrawColor(0);
-      char d[2]; d[0] = '0' + passDigits[i]; d[1] = 0;
+      char d[2]; d[0] = '0' + pass.digits[i]; d[1] = 0;
       // center digit inside the box
       int dw = u8g2.getStrWidth(d);
       int dx = bx + (boxW - dw)/2;
@@ -593,7 +756,7 @@ static void drawPasswordDialog(){
       u8g2.setDrawColor(1);
     } else {
       u8g2.drawFrame(bx, baseY, boxW, boxH);
-      char d[2]; d[0] = '0' + passDigits[i]; d[1] = 0;
+      char d[2]; d[0] = '0' + pass.digits[i]; d[1] = 0;
       int dw = u8g2.getStrWidth(d);
       int dx = bx + (boxW - dw)/2;
       int dy = baseY + (boxH + 7)/2;
@@ -603,14 +766,21 @@ static void drawPasswordDialog(){
 
   // ===== Bottom hint / error (larger than before) =====
   // Use 6x10 for better readability; center it
-  u8g2.setFont(u8g2_font_4x6_tf);
-  const char* okHint   = "Up/Dn=Edit ENT=Next ESC=Prev";
-  const char* errHint  = "Wrong password.Try again";
-  const char* msg = passWrong ? errHint : okHint;
+  u8g2.setFont(UI_FONT_SMALL);
+  const char* okHint   = S_PASS_HINT;
+  const char* errHint  = pass.mode==PASSDLG_UNLOCK ? S_PASS_WRONG : S_CODES_DIFFER;
+  const unsigned long lockMs = passwordLockedMs(uiMillis());
+  char lockHint[24];
+  const char* msg = pass.wrong ? errHint : okHint;
+  if(pass.busy) msg = S_CHECKING;
+  else if(lockMs && pass.mode==PASSDLG_UNLOCK){
+    snprintf(lockHint, sizeof(lockHint), S_LOCKED_FMT, (lockMs+999)/1000);
+    msg = lockHint;
+  }
   int mw = u8g2.getStrWidth(msg);
   int mx = (U8_Width - mw) / 2;
   int my = U8_Height - 6;     // a bit above bottom
-  if(passWrong){
+  if(pass.wrong){
     // draw a subtle invert band behind the error for emphasis
     int pad = 2;
     u8g2.setDrawColor(1);
@@ -630,152 +800,259 @@ static result doFactoryReset(eventMask, prompt&){
   return proceed;
 }
 
-// ===== Buttons =====
-static void setupButtonHandlers(){
-  btnUp.attachClick([](){
-    lastInputMs=millis();
-    if(passwordVisible){ passWrong=false; passDigits[passIndex]=(uint8_t)((passDigits[passIndex]+1)%10); return; }
-    if(confirmVisible){ if(confirmIdx<3) confirmIdx++; return; }
-
-    if(!passwordVisible && !confirmVisible && uiMode==UI_MENU && atRoot()){
-      mainIdx = (uint8_t)((mainIdx + 1) % MAIN_COUNT);   // 0→1→2→3→0
-      return;
-    }
+// ===== Input state machine =====
+// The table is UiFsmLogic.h; the actions below bind its entries.
+// Build with UI_FSM_CHECK=1 to verify every landing at run time.
+#ifndef UI_FSM_CHECK
+#define UI_FSM_CHECK 0
+#endif
 
+static UiState classify(){
+  if(modalIs(modal, PASS_FLOW))    return ST_PASSWORD;
+  if(modalIs(modal, CONFIRM_FLOW)) return ST_CONFIRM;
+  return uiClassify(uiMode, nav.level);
+}
 
-    // If we're in idle screen, cycle the idle case pages
-    if (uiMode == UI_IDLE) {
-      idleCaseIndex = (uint8_t)((idleCaseIndex + 1) % MaxDataPage);
-      return;                 // don't pass to menu nav when idle
-    }
+// ----- Actions -----
+static void aNone(){}
 
-    if(uiMode==UI_MENU||uiMode==UI_SUBMENU) pushCmd(defaultNavCodes[upCmd].ch);
-  });
+static void aIdleNext(){ idleCaseIndex=(uint8_t)((idleCaseIndex+1)%dash.pageCount()); lastPageMs=uiMillis(); }
+static void aIdlePrev(){ idleCaseIndex=(uint8_t)((idleCaseIndex+dash.pageCount()-1)%dash.pageCount()); lastPageMs=uiMillis(); }
 
-  // Down: move right at root AND tell ArduinoMenu to move down too
-  btnDown.attachClick([](){
-    lastInputMs=millis();
-    if(passwordVisible){ passWrong=false; passDigits[passIndex]=(uint8_t)((passDigits[passIndex]+9)%10); return; }
-    if(confirmVisible){ if(confirmIdx>0) confirmIdx--; return; }
+static void aTileNext(){ mainIdx=(uint8_t)((mainIdx+1)%MAIN_COUNT); }              // 0→1→2→3→0
+static void aTilePrev(){ mainIdx=(uint8_t)((mainIdx+MAIN_COUNT-1)%MAIN_COUNT); }   // 0→3→2→1→0
+static void aTileOpen(){ openMainFromIndex(MAIN_COUNT-mainIdx-1); }                // the tile the user sees
 
-    if(!passwordVisible && !confirmVisible && uiMode==UI_MENU && atRoot()){
-      mainIdx = (uint8_t)((mainIdx + MAIN_COUNT - 1) % MAIN_COUNT);  // 0→3→2→1→0
-      return;
-    }
+static void aNavUp()   { pushCmd(defaultNavCodes[upCmd].ch); }
+static void aNavDown() { pushCmd(defaultNavCodes[downCmd].ch); }
+static void aNavEnter(){ pushCmd(defaultNavCodes[enterCmd].ch); }
+static void aNavEsc()  { if(!atRoot()) pushCmd(defaultNavCodes[escCmd].ch); }
 
+// Double ENTER outside the password dialog: (re)open the menu with a fresh stage
+static void aMenuOpen(){ uiMode=UI_MENU; stageBegin(); }
 
-    // If we're in idle screen, cycle the idle case pages
-    if (uiMode == UI_IDLE) {
-      idleCaseIndex = (uint8_t)((idleCaseIndex +MaxDataPage - 1) % MaxDataPage);
-      return;                 // don't pass to menu nav when idle
-    }
+// Double ESC: ask when there are staged edits, else straight to idle (relocks)
+static void aMenuLeave(){
+  if(settingsDirty()) modalOpen(modal, CONFIRM_FLOW);
+  else goIdle();
+}
 
-    if(uiMode==UI_MENU||uiMode==UI_SUBMENU) pushCmd(defaultNavCodes[downCmd].ch);
-  });
-
-  // Enter: at root, just forward ENTER (nav already points to same item)
-  btnEnter.attachClick([](){
-    lastInputMs=millis();
-    if(passwordVisible){ passWrong=false; passIndex=(uint8_t)((passIndex+1)%4); return; }
-    if(confirmVisible){
-      switch (confirmIdx){
-        case 0: // Apply (stay)
-          stageApply();
-          confirmVisible = false;       // close dialog, remain in menu
-          break;
-
-        case 1: // Apply & Exit
-          stageApply();
-          goIdle();                     // exit to idle (locks settings again)
-          break;
-
-        case 2: // Discard & Exit
-          stageDiscard();
-          goIdle();
-          break;
-
-        case 3: // Cancel
-        default:
-          confirmVisible = false;       // just close dialog
-          break;
-      }
-      return;
-    }
+static void aTimeout(){ stageDiscard(); goIdle(); }
 
-    if(!passwordVisible && !confirmVisible && uiMode==UI_MENU && atRoot()){
-      openMainFromIndex(MAIN_COUNT-mainIdx-1);   // open the tile the user sees
-      return;
-    }
+static void aHoldStartUp()  { digitHoldStartMsUp=uiMillis();   lastDigitStepMs=0; }
+static void aHoldStartDown(){ digitHoldStartMsDown=uiMillis(); lastDigitStepMs=0; }
 
+// Held Up/Down: repeat with acceleration
+static bool holdStepDue(unsigned long startMs){
+  unsigned long now=uiMillis();
+  if(now-lastDigitStepMs<accelInterval(now-startMs)) return false;
+  lastDigitStepMs=now;
+  return true;
+}
 
-    if(uiMode==UI_MENU||uiMode==UI_SUBMENU) pushCmd(defaultNavCodes[enterCmd].ch);
-  });
-
-
-  btnEsc.attachClick([](){
-    lastInputMs=millis();
-    if(passwordVisible){ passWrong=false; passIndex=(uint8_t)((passIndex+3)%4); return; }
-    if(confirmVisible){ confirmVisible=false; return; }
-    if(!atRoot()) pushCmd(defaultNavCodes[escCmd].ch);
-  });
-
-  // Double ENTER
-  btnEnter.attachDoubleClick([](){
-    lastInputMs=millis();
-    if(passwordVisible){
-      if(passIsCorrect()){
-        settingsUnlocked=true;               // keep unlocked until Idle
-        passwordVisible=false; passWrong=false; passReset();
-        pushCmd(defaultNavCodes[enterCmd].ch);   // immediately enter Settings
-      } else {
-        settingsUnlocked=false;
-        passWrong=true;
-      }
-      return;
+// ===== Dialog flows =====
+// Each dialog reads as one sequence (ModalLogic.h); frames: pass, confirm.
+
+// Digit editing shared by every step of the password dialog
+static void passDigitStep(int8_t d){ pass.digits[pass.index]=(uint8_t)((pass.digits[pass.index]+10+d)%10); }
+static void passReset(){ memset(pass.digits,0,sizeof(pass.digits)); pass.index=0; pass.wrong=false; }
+static void passEdit(uint8_t ev){
+  switch(ev){
+    case EV_UP_CLICK:       pass.wrong=false; passDigitStep(+1); break;
+    case EV_DOWN_CLICK:     pass.wrong=false; passDigitStep(-1); break;
+    case EV_ENTER_CLICK:    pass.wrong=false; pass.index=(uint8_t)((pass.index+1)%pass.len); break;
+    case EV_ESC_CLICK:      pass.wrong=false; pass.index=(uint8_t)((pass.index+pass.len-1)%pass.len); break;
+    case EV_UP_HOLD_START:  aHoldStartUp(); break;
+    case EV_DOWN_HOLD_START:aHoldStartDown(); break;
+    case EV_UP_HOLD:        if(holdStepDue(digitHoldStartMsUp))   passDigitStep(+1); break;
+    case EV_DOWN_HOLD:      if(holdStepDue(digitHoldStartMsDown)) passDigitStep(-1); break;
+    default: break;
+  }
+}
+
+// Unlock: code, check, Settings. New code: code, repeat, store.
+// Double ENTER submits, double ESC cancels (not while a hash runs).
+static ModalStatus passFlow(uint8_t ev){
+  MODAL_BEGIN(pass.co);
+  passReset();
+  pass.busy=false;
+  for(;;){
+    MODAL_AWAIT_EVENT(pass.co, ev);
+    if(ev==EV_ESC_DOUBLE){
+      passReset();
+      if(pass.mode==PASSDLG_UNLOCK) uiMode=UI_MENU;
+      break;
     }
-    confirmVisible=false; uiMode=UI_MENU; stageBegin();
-  });
-
-  // Double ESC
-  btnEsc.attachDoubleClick([](){
-    lastInputMs=millis();
-    if(passwordVisible){ passwordVisible=false; passReset(); passWrong=false; uiMode=UI_MENU; return; }
-    if(uiMode==UI_MENU||uiMode==UI_SUBMENU){
-      if(settingsDirty()){ confirmVisible=true; confirmIdx=0; }
-      else { goIdle(); } // relock on Idle
+    if(ev!=EV_ENTER_DOUBLE){ passEdit(ev); continue; }
+
+    pass.wrong=false;
+    if(pass.mode==PASSDLG_NEW){
+      memcpy(pass.first, pass.digits, pass.len);
+      pass.mode=PASSDLG_REPEAT; passReset();
+      continue;
     }
-  });
-
-  auto sendRightIfEditing=[](){
-    unsigned long now=millis(); lastInputMs=now;
-    if(passwordVisible){
-      unsigned long held=now-digitHoldStartMsUp; uint16_t step=accelInterval(held);
-      if(now-lastDigitStepMs>=step){ passDigits[passIndex]=(uint8_t)((passDigits[passIndex]+1)%10); lastDigitStepMs=now; }
-      return;
+    if(pass.mode==PASSDLG_REPEAT && memcmp(pass.first, pass.digits, pass.len)!=0){
+      pass.mode=PASSDLG_NEW; passReset(); pass.wrong=true;
+      continue;
     }
-    if(!confirmVisible && uiMode==UI_SUBMENU && nav.level>=2){
-      unsigned long held=now-digitHoldStartMsUp; uint16_t step=accelInterval(held);
-      if(now-lastDigitStepMs>=step){ pushCmd(defaultNavCodes[rightCmd].ch); lastDigitStepMs=now; }
+    pass.busy = pass.mode==PASSDLG_UNLOCK
+              ? passwordCheck(pass.digits, pass.len, uiMillis())    // false while locked out
+              : passwordChange(pass.digits, pass.len);
+    if(!pass.busy) continue;
+
+    // The hash runs a slice per resume; buttons wait
+    MODAL_AWAIT(pass.co, (pass.result=passwordPoll(uiMillis()))!=PASS_BUSY);
+    pass.busy=false;
+    if(pass.result==PASS_OK){
+      settingsUnlocked=true;               // keep unlocked until Idle
+      passReset();
+      pushCmd(defaultNavCodes[enterCmd].ch);   // immediately enter Settings
+      break;
     }
-  };
+    if(pass.result==PASS_CHANGED){ passReset(); break; }   // back to the Security menu
+    settingsUnlocked=false;                // PASS_WRONG
+    pass.wrong=true;
+  }
+  MODAL_END(pass.co);
+}
 
-  auto sendLeftIfEditing=[](){
-    unsigned long now=millis(); lastInputMs=now;
-    if(passwordVisible){
-      unsigned long held=now-digitHoldStartMsDown; uint16_t step=accelInterval(held);
-      if(now-lastDigitStepMs>=step){ passDigits[passIndex]=(uint8_t)((passDigits[passIndex]+9)%10); lastDigitStepMs=now; }
-      return;
-    }
-    if(!confirmVisible && uiMode==UI_SUBMENU && nav.level>=2){
-      unsigned long held=now-digitHoldStartMsDown; uint16_t step=accelInterval(held);
-      if(now-lastDigitStepMs>=step){ pushCmd(defaultNavCodes[leftCmd].ch); lastDigitStepMs=now; }
-    }
-  };
+// Apply / Apply & Exit / Discard & Exit / Cancel
+static ModalStatus confirmFlow(uint8_t ev){
+  MODAL_BEGIN(confirm.co);
+  confirm.idx=0;
+  for(;;){
+    MODAL_AWAIT_EVENT(confirm.co, ev);
+    if(ev==EV_UP_CLICK){ if(confirm.idx<3) confirm.idx++; continue; }
+    if(ev==EV_DOWN_CLICK){ if(confirm.idx>0) confirm.idx--; continue; }
+    if(ev==EV_UP_HOLD_START){ aHoldStartUp(); continue; }
+    if(ev==EV_DOWN_HOLD_START){ aHoldStartDown(); continue; }
+    if(ev==EV_ESC_DOUBLE){ confirm.idx=0; continue; }   // still dirty: ask again
+    if(ev==EV_ENTER_DOUBLE){ aMenuOpen(); break; }
+    if(ev==EV_ESC_CLICK) break;
+    if(ev!=EV_ENTER_CLICK) continue;
+    if(confirm.idx==0) stageApply();                    // Apply (stay)
+    else if(confirm.idx==1){ stageApply(); goIdle(); }  // Apply & Exit (locks settings again)
+    else if(confirm.idx==2){ stageDiscard(); goIdle(); }// Discard & Exit
+    break;                                              // Cancel: just close
+  }
+  MODAL_END(confirm.co);
+}
+
+const ModalFlow PASS_FLOW    = { &pass.co,    passFlow,    drawPasswordDialog };
+const ModalFlow CONFIRM_FLOW = { &confirm.co, confirmFlow, drawConfirmDialog };
+
+// Settings fields with accelerated hold editing (labels as in the MENUs)
+struct HoldField { const char* label; uint8_t id; uint16_t base; };
+static const HoldField HOLD_FIELDS[] = {
+  {S_TEMP_THR_LOW,  SF_TEMP_THR_L,    1}, {S_TEMP_THR_HIGH, SF_TEMP_THR_H,    1},
+  {S_TEMP_HIGH_THR, SF_TEMP_HIGH_THR, 1}, {S_VOLT_LOW_THR,  SF_VOLT_L_THR,    1},
+  {S_VOLT_HIGH_THR, SF_VOLT_HIGH_THR, 1}, {S_DIM_AFTER,     SF_DIM_AFTER,    10},
+  {S_OFF_AFTER,     SF_OFF_AFTER,    10}, {S_NOM_FAN1_CURR, SF_FAN1_NOMINAL,  1},
+  {S_NOM_FAN2_CURR, SF_FAN2_NOMINAL,  1}, {S_TOGGLE_PERIOD, SF_TOGGLE_PERIOD, 1},
+  {S_SLAVE_ID,      SF_SLAVE_ID,      1}, {S_AVI_LDR_THR,   SF_LDR_THRESHOLD, 1},
+  {S_PAGE_ROTATE,   SF_DASH_ROTATE,   5}, {S_CAL_VIN_GAIN,  SF_VIN_GAIN,     10},
+  {S_CAL_VIN_OFFSET,SF_VIN_OFFSET,   10}, {S_CAL_NTC_OFFSET,SF_NTC_OFFSET,    1},
+};
+
+// The field being edited, if it is one of HOLD_FIELDS
+static const HoldField* holdField(){
+  if(!nav.navFocus || nav.navFocus==&nav.active()) return nullptr;   // list has focus
+  const char* label=nav.selected().getText();
+  for(const HoldField& f : HOLD_FIELDS) if(strcmp(label, f.label)==0) return &f;
+  return nullptr;
+}
+
+// Known fields ramp their value directly; anything else steps via the menu
+static void editHold(int8_t dir, unsigned long startMs, navCmds cmd){
+  if(const HoldField* f=holdField()){ fieldEditHold(f->id, f->base, dir, startMs, uiMillis()); return; }
+  if(holdStepDue(startMs)) pushCmd(defaultNavCodes[cmd].ch);
+}
+static void aEditHoldInc(){ editHold(+1, digitHoldStartMsUp,   rightCmd); }
+static void aEditHoldDec(){ editHold(-1, digitHoldStartMsDown, leftCmd); }
+
+// ----- Table bindings -----
+static constexpr void (*ACTIONS[])() = {
+  nullptr,       aNone,
+  aIdleNext,     aIdlePrev,
+  aTileNext,     aTilePrev,     aTileOpen,
+  aNavUp,        aNavDown,      aNavEnter,      aNavEsc,
+  aMenuOpen,     aMenuLeave,    aTimeout,
+  aHoldStartUp,  aHoldStartDown,
+  aEditHoldInc,  aEditHoldDec,
+};
+static_assert(sizeof(ACTIONS)/sizeof(ACTIONS[0])==UA_COUNT, "one binding per UiAction");
+
+static void uiDispatch(uint8_t ev){
+  if(ev!=EV_UP_HOLD && ev!=EV_DOWN_HOLD) fieldEditFlush();   // land a ramp before anything else
+  if(modalFeed(modal, ev)) return;             // a dialog flow owns the buttons
+  const UiState s = classify();
+  const UiTransition& t = UI_FSM[s][ev];
+  ACTIONS[t.action]();
+#if UI_FSM_CHECK
+  const UiState want = t.next==ST_SAME ? s : t.next;
+  if(want!=ST_ANY && classify()!=want){
+    Serial.print("FSM state "); Serial.print((int)s);
+    Serial.print(" ev ");       Serial.print((int)ev);
+    Serial.print(" landed ");   Serial.print((int)classify());
+    Serial.print(" want ");     Serial.println((int)want);
+  }
+#endif
+}
+
+#if UI_BENCH
+// Input path costs: FSM lookup (classify() + table fetch, no side effects)
+// and full-range hold-edit times
+static void inputBenchRun(Print& out){
+  const uint32_t n=(uint32_t)UI_BENCH_ITERS*EV_ALL;
+  volatile uintptr_t sink=0;
+  const uint32_t t0=micros();
+  const UiState s=classify();
+  if(s>=ST_COUNT) return;                      // a dialog is open
+  for(uint32_t i=0;i<n;i++) sink=sink+UI_FSM[classify()][i%EV_ALL].action;
+  const uint32_t us=micros()-t0;
+  out.print("{\"fsm_dispatch\":{\"lookups\":"); out.print((unsigned long)n);
+  out.print(",\"ns_per_lookup\":");             out.print((unsigned long)((uint64_t)us*1000/n));
+  out.println("}}");
+
+  // Time for a held Up to sweep each accelerated field end to end
+  out.print("{\"field_edit_full_range_ms\":{");
+  for(uint8_t i=0;i<sizeof(HOLD_FIELDS)/sizeof(HOLD_FIELDS[0]);i++){
+    if(i) out.print(",");
+    out.print("\""); out.print(HOLD_FIELDS[i].label); out.print("\":");
+    out.print(fieldEditFullRangeMs(HOLD_FIELDS[i].id, HOLD_FIELDS[i].base, UI_TRACE_LOOP_MS));
+  }
+  out.println("}}");
+}
+#endif
 
-  btnUp.attachLongPressStart([](){ digitHoldStartMsUp=millis(); lastDigitStepMs=0; lastInputMs=millis(); });
-  btnDown.attachLongPressStart([](){ digitHoldStartMsDown=millis(); lastDigitStepMs=0; lastInputMs=millis(); });
-  btnUp.attachDuringLongPress(sendRightIfEditing);
-  btnDown.attachDuringLongPress(sendLeftIfEditing);
+// Resume the open dialog once per loop (it advances its hash job); a job
+// whose dialog was closed meanwhile still runs to the end
+static void passService(){
+  if(!bootDone()) return;                      // passwordInit() still running
+  if(!modalFeed(modal, MODAL_POLL)) passwordPoll(uiMillis());
+}
+
+// Single entry point for physical buttons and trace replay
+void uiHandleEvent(UIEvent ev){
+  traceRecordEvent(ev);
+  if(powerNoteActivity(uiMillis())) return;   // press only woke the panel
+  if(ev>=EV_COUNT) return;
+  lastInputMs=uiMillis();
+  uiDispatch(ev);
+}
+
+static void setupButtonHandlers(){
+  btnUp.attachClick([](){ uiHandleEvent(EV_UP_CLICK); });
+  btnDown.attachClick([](){ uiHandleEvent(EV_DOWN_CLICK); });
+  btnEnter.attachClick([](){ uiHandleEvent(EV_ENTER_CLICK); });
+  btnEsc.attachClick([](){ uiHandleEvent(EV_ESC_CLICK); });
+  btnEnter.attachDoubleClick([](){ uiHandleEvent(EV_ENTER_DOUBLE); });
+  btnEsc.attachDoubleClick([](){ uiHandleEvent(EV_ESC_DOUBLE); });
+
+  btnUp.attachLongPressStart([](){ uiHandleEvent(EV_UP_HOLD_START); });
+  btnDown.attachLongPressStart([](){ uiHandleEvent(EV_DOWN_HOLD_START); });
+  btnUp.attachDuringLongPress([](){ uiHandleEvent(EV_UP_HOLD); });
+  btnDown.attachDuringLongPress([](){ uiHandleEvent(EV_DOWN_HOLD); });
 
   btnUp.setClickTicks(60);     btnDown.setClickTicks(60);
   btnEnter.setClickTicks(220); btnEsc.setClickTicks(220);
@@ -784,7 +1061,48 @@ static void setupButtonHandlers(){
   btnEnter.setDebounceTicks(2); btnEsc.setDebounceTicks(2);
 }
 
+// ===== Frame flush =====
+// Menu frames are rendered whole (the menu output redraws every row), idle
+// frames only where something changed; either way only the changed tiles
+// go out on the bus. Returns bytes sent.
+static uint32_t flushFrame(unsigned long now){
+  const uint8_t tw=u8g2.getBufferTileWidth(), th=u8g2.getBufferTileHeight();
+#if UI_DIRTY_FLUSH
+  if(now-lastFullFlushMs>=UI_FULL_FLUSH_MS){
+    lastFullFlushMs=now;
+    frameDiffInvalidate(frameDiff);
+  }
+  frameDiffScan(frameDiff, u8g2.getBufferPtr(), tw, th, frameSpans);
+  for(uint8_t p=0;p<th;p++){
+    if(frameSpans[p].w) u8g2.updateDisplayArea(frameSpans[p].x0, p, frameSpans[p].w, 1);
+  }
+  return frameDiffBytes(frameSpans, th);
+#else
+  (void)now;
+  u8g2.sendBuffer();
+  return (uint32_t)tw*th*8;
+#endif
+}
+
 // ===== Public API =====
+bool uiSettingsIdle(){
+  return uiMode==UI_IDLE && !modalActive(modal);
+}
+
+void uiSplash(){
+  // begin() would also clear the panel: a full 1 KB frame before the splash
+  u8g2.initDisplay();                        // Wire: i2cBusStart()
+  u8g2.clearBuffer();
+  u8g2.setBitmapMode(1);
+  u8g2.drawXBMP((U8_Width-16)/2, 8, 16, 16, bitmap_logo1);
+  u8g2.setFont(UI_FONT_TITLE);
+  u8g2.drawStr((U8_Width-u8g2.getStrWidth(FW_DEVICE_NAME))/2, 40, FW_DEVICE_NAME);
+  u8g2.setFont(UI_FONT_SMALL);
+  u8g2.drawStr((U8_Width-u8g2.getStrWidth(FW_VERSION))/2, 54, FW_VERSION);
+  u8g2.sendBuffer();
+  u8g2.setPowerSave(0);                      // display on after the frame is in RAM
+}
+
 void uiSetup(){
   pinMode(BTN_UP,INPUT_PULLUP);
   pinMode(BTN_DOWN,INPUT_PULLUP);
@@ -792,73 +1110,118 @@ void uiSetup(){
   pinMode(BTN_ESC,INPUT_PULLUP);
   setupButtonHandlers();
 
-  Wire.setSDA(I2C_SDA);
-  Wire.setSCL(I2C_SCL);
-  Wire.begin();
-  u8g2.begin();
+  powerInit(u8g2);                           // panel is up: uiSplash()
+#if DISPLAY2_ENABLE
+  u8g2Door.initDisplay();                    // no clear frame: the first flush is a full one
+  u8g2Door.setPowerSave(0);
+  displayAddSink(&doorSink);
+#endif
+  displayAddSink(&frameMirror);              // idle until a host asks (RCMD_MIRROR)
+#if UI_BENCH
+  drawBenchRun(u8g2, Serial);
+  inputBenchRun(Serial);
+  displayBenchRun(u8g2, Serial, 20);
+#endif
   u8g2.setFont(fontName);
 
-  fans.addFan(U8_Width-16-20,U8_Height-16-20,images,4,16,16,50);
-  fans.addFan(U8_Width-16-2, U8_Height-16-20,images,4,16,16,150);
-  fans.addFan(U8_Width-16-20,U8_Height-16-2,images,4,16,16,450);
-  fans.addFan(U8_Width-16-2, U8_Height-16-2,images,4,16,16,1350);
+  historyInit();
+
+  // Left column turns with fan 1, right column with fan 2 (uiLoop)
+  fanFrames.build(bitmap_logo1, FAN_SPRITE_BLADES, FAN_SPRITE_ROTOR_R_16);
+  fans.addFan(U8_Width-16-20,U8_Height-16-20,fanFrames.frames,fanFrames.COUNT,16,16,0);
+  fans.addFan(U8_Width-16-2, U8_Height-16-20,fanFrames.frames,fanFrames.COUNT,16,16,0);
+  fans.addFan(U8_Width-16-20,U8_Height-16-2,fanFrames.frames,fanFrames.COUNT,16,16,0);
+  fans.addFan(U8_Width-16-2, U8_Height-16-2,fanFrames.frames,fanFrames.COUNT,16,16,0);
 
-  lastInputMs=millis();
+  traceBegin();
+
+  lastInputMs=uiMillis();
   lastFrameMs=0;
   lastDigitStepMs=0;
 }
 
 void uiLoop(){
-  demoDataTick(millis());
-  btnUp.tick(); btnDown.tick(); btnEnter.tick(); btnEsc.tick();
-
-  uint32_t now = millis();
-  if ((now / 5000) % 2 == 0) {
-    fans.setFanSpeed(0, 50);   // first 5s = fast
+  if(traceReplaying()){
+    traceReplayStep();                 // scripted input + telemetry
   } else {
-    fans.setFanSpeed(0, 800);  // next 5s = slow
+    demoDataTick(millis());
+    btnUp.tick(); btnDown.tick(); btnEnter.tick(); btnEsc.tick();
+  }
+  historyTick(uiMillis());
+  alarmLogPoll(uiMillis());
+  passService();
+  powerTick(uiMillis());
+
+  fanTachService();
+  fanCountersService(millis());
+
+  uint32_t now = uiMillis();
+  for(uint8_t i=0;i<fans.count();i++) fans.setFanRpm(i,(uint32_t)((i&1) ? fan2Rpm : fan1Rpm));
+  if(uiMode==UI_IDLE) fans.update(now);
+
+  // Idle dashboard auto-rotate (manual paging restarts the period)
+  if(uiMode==UI_IDLE && gLive.dashRotateS && now-lastPageMs >= gLive.dashRotateS*1000UL){
+    idleCaseIndex=(uint8_t)((idleCaseIndex+1)%dash.pageCount());
+    lastPageMs=now;
   }
 
-  if(uiMode==UI_IDLE) fans.update();
-
-  if(!confirmVisible && !passwordVisible && (uiMode==UI_MENU || uiMode==UI_SUBMENU)){
+  if(!modalActive(modal) && (uiMode==UI_MENU || uiMode==UI_SUBMENU)){
     nav.doInput();                                // <-- IMPORTANT: always run
     uiMode = (nav.level==0) ? UI_MENU : UI_SUBMENU;
 
-    if(millis()-lastInputMs > MENU_TIMEOUT_MS){
-      stageDiscard();
-      confirmVisible=false; passwordVisible=false;
-      goIdle();
-    }
+    if(uiMillis()-lastInputMs > MENU_TIMEOUT_MS) uiDispatch(EV_TIMEOUT);
   }
 
-  unsigned long now1=millis();
-  if(now1-lastFrameMs<FRAME_MS) return;
-  lastFrameMs=now1;
+  // The bus was reset: the panels may have lost their setup
+  if(i2cBusResetCount()!=busResetsSeen){
+    busResetsSeen=i2cBusResetCount();
+    u8g2.begin();
+#if DISPLAY2_ENABLE
+    u8g2Door.begin();
+#endif
+    powerRestorePanel();
+    frameDiffInvalidate(frameDiff);            // begin() cleared both panels
+    idleDrawnPage=-1;                          // and the buffer
+  }
 
-  u8g2.firstPage();
-  do{
-    // inside the page loop:
-    if(uiMode==UI_MENU || uiMode==UI_SUBMENU){
-      if(confirmVisible)       drawConfirmDialog();
-      else if(passwordVisible) drawPasswordDialog();
-      else {
-        if(atRoot()){
-            // Just draw your custom 2-tile carousel; don’t push nav commands here.
-            u8g2.setDrawColor(1);
-            u8g2.setFont(u8g2_font_5x7_tr);
-            drawMainMenuHorizontal();
-          }
-        else {
-          // normal submenus
+  if(!powerDisplayOn()) return;                // panel off: nothing to draw
+  unsigned long now1=uiMillis();
+  if(now1-lastFrameMs<powerFrameMs(FRAME_MS)) return;
+  lastFrameMs=now1;
+  fieldEditFlush();                            // held-edit steps: one update per frame
+
+  // Render once into the full buffer, send it, then fan out
+  const uint32_t t0=micros();
+  const bool idle=!(uiMode==UI_MENU || uiMode==UI_SUBMENU);
+  if(idle && idleDrawnPage==idleCaseIndex) drawIdleChanges();
+  else u8g2.clearBuffer();
+  if(!idle){
+    idleDrawnPage=-1;
+    if(modalActive(modal)) modal.active->draw();
+    else {
+      if(atRoot()){
+          // Just draw your custom 2-tile carousel; don’t push nav commands here.
           u8g2.setDrawColor(1);
-          u8g2.setFont(u8g2_font_6x10_tf);
-          nav.doOutput();
+          u8g2.setFont(UI_FONT_TILE);
+          drawMainMenuHorizontal();
         }
+      else {
+        // normal submenus
+        u8g2.setDrawColor(1);
+        u8g2.setFont(UI_FONT_MENU);
+        nav.doOutput();
       }
-    } else {
-      drawIdleScreen();
     }
-
-  } while(u8g2.nextPage());
+  } else if(idleDrawnPage!=idleCaseIndex){
+    drawIdleScreen();
+    idleDrawnPage=idleCaseIndex;
+  }
+  const uint32_t t1=micros();
+  const uint32_t bytes=flushFrame(now1);
+  const uint32_t us=micros()-t0;
+  displayPush(u8g2, UI_DIRTY_FLUSH ? frameSpans : nullptr);   // second panel / Serial mirror
+
+  healthNoteTransferUs(us);
+  powerFrameSent(uiMillis());
+  traceFrame(u8g2, t1-t0, us-(t1-t0), bytes);
 }
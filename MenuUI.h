@@ -1,11 +1,18 @@
 #pragma once
 #include <Arduino.h>
+#include "UiFsmLogic.h"    // UIMode, UIEvent
 
-// Simple UI states
-enum UIMode { UI_IDLE, UI_MENU, UI_SUBMENU };
+// Boot: bring the main panel up and show the splash (before uiSetup)
+void uiSplash();
 
-// Call once in setup()
+// Call once, in the UI task before uiLoop()
 void uiSetup();
 
 // Call every loop()
 void uiLoop();
+
+// Feed one button event into the UI
+void uiHandleEvent(UIEvent ev);
+
+// True while nobody is editing settings on the panel (safe for remote writes)
+bool uiSettingsIdle();
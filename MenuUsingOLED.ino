@@ -2,6 +2,19 @@
 #include <STM32FreeRTOS.h>     // <-- this library
 #include "MenuUI.h"
 #include "AppData.h"
+#include "HealthMonitor.h"
+#include "PowerManager.h"
+#include "RemoteLink.h"
+#include "Modbus.h"
+#include "Storage.h"
+#include "AviationLight.h"
+#include "FanTach.h"
+#include "FanCounters.h"
+#include "I2cBus.h"
+#include "Password.h"
+#include "Boot.h"
+#include "StaticAlloc.h"
+#include "UiTrace.h"
 
 // ===== UI task config =====
 static TaskHandle_t uiTaskHandle = nullptr;
@@ -9,37 +22,114 @@ static TaskHandle_t uiTaskHandle = nullptr;
 static constexpr uint16_t UI_TASK_STACK_WORDS = 2048;
 static constexpr UBaseType_t UI_TASK_PRIORITY  = tskIDLE_PRIORITY + 2;
 static constexpr TickType_t  UI_LOOP_DELAY     = pdMS_TO_TICKS(5);
+TASK_MEM(ui, UI_TASK_STACK_WORDS);
 
 static void uiTask(void*){
+  bootRun(BOOT_CTX_UI);
+  bootInteractive();
   for(;;){
+    healthLoopBegin();
     uiLoop();                    // your existing non-blocking loop
-    vTaskDelay(UI_LOOP_DELAY);   // cooperative yield
+    healthLoopEnd();
+    powerLoopDelay(UI_LOOP_DELAY); // cooperative yield (longer when dimmed/off)
   }
 }
 
-void setup() {
-  Serial.begin(115200);
-  while(!Serial) { /* optional */ }
-  Serial.println("ODCC Menu (STM32 + STM32FreeRTOS) start");
+// ===== Boot steps (BootPlan.h) =====
+// setup: only what the splash needs, then the tasks
+void bootStep_I2C(){
+  if (!i2cBusStart()) {   // before the panels: they talk through it
+    Serial.println("WARN: I2C bus task not started (transfers run inline)");
+  }
+}
 
-  // Your original init (keep I2C/U8g2 init in setup)
-  demoDataInit();
-  uiSetup();
+void bootStep_SPLASH(){
+  uiSplash();
+  bootFirstFrame();
+}
 
-  // Create UI task
-  BaseType_t ok = xTaskCreate(
+void bootStep_TASKS(){
+  // Create UI task (static stack with STATIC_ALLOC, heap otherwise)
+  bool ok = TASK_START(
     uiTask,                // task function
     "UI",                  // name
+    ui,                    // TASK_MEM storage
     UI_TASK_STACK_WORDS,   // stack (WORDS, not bytes)
-    nullptr,               // arg
     UI_TASK_PRIORITY,      // priority
     &uiTaskHandle          // handle
   );
-  if (ok != pdPASS) {
+  if (!ok) {
     Serial.println("ERROR: UI task create failed (heap/stack too small).");
     for(;;); // halt
   }
-  
+  healthRegisterTask(uiTaskHandle, UI_TASK_STACK_WORDS);
+  powerSetWakeTask(uiTaskHandle);
+
+  // Monitor task + watchdog (feeds only while the UI loop is alive)
+  if (!healthStart()) {
+    Serial.println("WARN: health monitor not started");
+  }
+
+  // Aviation light: LDR day/night, lamp check, self-tests
+  if (!aviationStart()) {
+    Serial.println("WARN: aviation light task not started");
+  }
+
+  // Fan tach capture (rpm, animation speed, stall alarm)
+  if (!fanTachStart()) {
+    Serial.println("WARN: fan tach pins not on one capture timer");
+  }
+}
+
+// UI task, before its first loop
+void bootStep_UI(){
+  uiSetup();
+}
+
+// Boot task, in the UI's idle time (Settings stays closed until bootDone())
+void bootStep_STORAGE(){
+  storageInit();          // the unlock code and fan totals live there
+}
+
+void bootStep_COUNTERS(){
+  fanCountersStart();     // run time / energy totals from the last run
+}
+
+void bootStep_PASSWORD(){
+  passwordInit(uiMillis());   // the clock passwordPoll() and the lockout use
+}
+
+void bootStep_REMOTE(){
+  // Binary settings/telemetry link (lower priority than the UI)
+  if (!remoteStart()) {
+    Serial.println("WARN: remote link not started");
+  }
+}
+
+void bootStep_MODBUS(){
+  // RS-485: answers as slaveID, or polls the site in master mode
+  if (!modbusStart()) {
+    Serial.println("WARN: modbus task not started");
+  }
+}
+
+void setup() {
+  Serial.begin(115200);   // no wait for a host: see BOOT_SERIAL_WAIT_MS
+  Serial.println("ODCC Menu (STM32 + STM32FreeRTOS) start");
+
+  demoDataInit();
+  bootRun(BOOT_CTX_SETUP);  // splash on the panel, tasks created
+
+#if STATIC_ALLOC
+  // Everything is allocated by now (the boot task's steps use static
+  // storage too); from here on the heap is off limits
+  Serial.print("HEAP setup allocs=");
+  Serial.print(heapAllocCount());
+  Serial.print(" bytes=");
+  Serial.println(heapAllocBytes());
+  heapLock();
+#endif
+
   vTaskStartScheduler();
 
 }
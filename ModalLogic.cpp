@@ -0,0 +1,19 @@
+#include "ModalLogic.h"
+
+bool modalOpen(ModalRunner& r, const ModalFlow& flow){
+  r.active = &flow;
+  flow.co->line = 0;
+  return modalFeed(r, MODAL_POLL) && r.active == &flow;
+}
+
+bool modalFeed(ModalRunner& r, uint8_t ev){
+  const ModalFlow* f = r.active;
+  if (!f) return false;
+  // The flow may close itself or open another one while it runs
+  if (f->step(ev) == MODAL_DONE && r.active == f) r.active = nullptr;
+  return true;
+}
+
+void modalClose(ModalRunner& r){
+  r.active = nullptr;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Modal flows =====
+// Stackless coroutines for the dialogs (MenuUI.cpp runs the password and
+// confirm flows; tools/modal_bench.cpp times them against flag dispatch).
+//
+// A flow is a function resumed with every button event while it is open,
+// and with MODAL_POLL once per UI loop. It reads top to bottom: it waits
+// for the next button (MODAL_AWAIT_EVENT) or a condition (MODAL_AWAIT),
+// returning to the UI loop in between, and closes by running off its end.
+// Its frame is a static struct: the resume point plus every variable that
+// must survive a wait (locals do not). Nothing is allocated, and a flow has
+// at most one instance: opening it again restarts the frame.
+//
+//   static ModalStatus flow(uint8_t ev){
+//     MODAL_BEGIN(f.co);
+//     f.n = 0;
+//     while (f.n < 3) {
+//       MODAL_AWAIT_EVENT(f.co, ev);
+//       if (ev == EV_UP_CLICK) f.n++;
+//     }
+//     MODAL_AWAIT(f.co, jobDone());
+//     MODAL_END(f.co);
+//   }
+//
+// Keep waits out of nested switch statements (the resume points are case
+// labels of MODAL_BEGIN's switch) and no two waits on one source line.
+
+static const uint8_t MODAL_POLL = 0xFF;        // resume without an event
+
+enum ModalStatus : uint8_t { MODAL_RUNNING, MODAL_DONE };
+
+struct ModalFrame {
+  uint16_t line;                               // resume point, 0 = start
+};
+
+#define MODAL_BEGIN(co)  switch ((co).line) { case 0:
+
+// Suspend; resume with the next button event (polls do not count)
+#define MODAL_AWAIT_EVENT(co, ev)                                    \
+  do {                                                               \
+    (co).line = __LINE__; return MODAL_RUNNING; case __LINE__:       \
+    if ((ev) == MODAL_POLL) return MODAL_RUNNING;                    \
+  } while (0)
+
+// Suspend until cond holds (checked now and on every resume)
+#define MODAL_AWAIT(co, cond)                                        \
+  do {                                                               \
+    (co).line = __LINE__; [[fallthrough]]; case __LINE__:            \
+    if (!(cond)) return MODAL_RUNNING;                               \
+  } while (0)
+
+#define MODAL_END(co)  } (co).line = 0; return MODAL_DONE
+
+struct ModalFlow {
+  ModalFrame* co;
+  ModalStatus (*step)(uint8_t ev);
+  void (*draw)();
+};
+
+// At most one open flow; it owns the buttons and the screen
+struct ModalRunner {
+  const ModalFlow* active;
+};
+
+// Close whatever is open, restart flow and run it to its first wait.
+// False if it finished at once (nothing opened).
+bool modalOpen(ModalRunner& r, const ModalFlow& flow);
+
+// Give ev (or MODAL_POLL) to the open flow. False if none is open.
+bool modalFeed(ModalRunner& r, uint8_t ev);
+
+// Abandon the open flow where it waits
+void modalClose(ModalRunner& r);
+
+inline bool modalActive(const ModalRunner& r){ return r.active != nullptr; }
+inline bool modalIs(const ModalRunner& r, const ModalFlow& flow){ return r.active == &flow; }
@@ -0,0 +1,196 @@
+#include "Modbus.h"
+#include <STM32FreeRTOS.h>
+#include "AppData.h"
+#include "FanHealth.h"
+#include "HealthMonitor.h"
+#include "Pins.h"
+#include "SerialWake.h"
+#include "StaticAlloc.h"
+
+uint16_t diagMbCycleMs = 0;
+uint16_t diagMbServed = 0;
+
+static HardwareSerial mbPort(MODBUS_RX_PIN, MODBUS_TX_PIN);
+
+static TaskHandle_t mbHandle = nullptr;
+static const uint16_t MB_STACK_WORDS = 256;
+static const UBaseType_t MB_PRIORITY = tskIDLE_PRIORITY + 1;    // below UI
+TASK_MEM(mb, MB_STACK_WORDS);
+
+// Bus settings in effect (copied from gLive)
+struct BusConfig {
+  long baud;
+  uint8_t slaveID, master, nodes;
+};
+static BusConfig cfg = {};
+static uint32_t gapUs = 0;
+static TickType_t gapTicks = 1;
+
+static MbMaster master;          // node table: task writes, UI reads, both in a critical section
+static uint8_t rx[MB_FRAME_MAX];
+static uint8_t tx[MB_FRAME_MAX];
+static uint16_t rxLen = 0;
+
+// ===== Port =====
+static void sendFrame(uint16_t n){
+  digitalWrite(MODBUS_DE_PIN, HIGH);
+  mbPort.write(tx, n);
+  mbPort.flush();                // until the last stop bit has left
+  digitalWrite(MODBUS_DE_PIN, LOW);
+}
+
+static void drainInput(){
+  while (mbPort.available()) mbPort.read();
+  rxLen = 0;
+}
+
+static bool configChanged(){
+  BusConfig now;
+  taskENTER_CRITICAL();
+  now.baud = gLive.baudrate;
+  now.slaveID = gLive.slaveID;
+  now.master = gLive.modbusMaster;
+  now.nodes = gLive.modbusNodes;
+  taskEXIT_CRITICAL();
+  if (now.baud == cfg.baud && now.slaveID == cfg.slaveID &&
+      now.master == cfg.master && now.nodes == cfg.nodes) return false;
+  cfg = now;
+  return true;
+}
+
+static void applyConfig(){
+  mbPort.end();
+  mbPort.begin((unsigned long)cfg.baud, SERIAL_8E1);
+  gapUs = mbFrameGapUs((uint32_t)cfg.baud);
+  gapTicks = serialWakeTicks(gapUs);
+  serialWakeAttach(MODBUS_RX_PIN);
+  drainInput();
+  taskENTER_CRITICAL();
+  mbMasterInit(master, (uint8_t)(cfg.slaveID + 1), cfg.master ? cfg.nodes : 0, (uint32_t)cfg.baud);
+  taskEXIT_CRITICAL();
+  diagMbCycleMs = 0;
+}
+
+// ===== Slave =====
+static int16_t scaled(float v, float k){
+  v *= k;
+  return (int16_t)(v < -32768.0f ? -32768 : v > 32767.0f ? 32767 : v + (v < 0 ? -0.5f : 0.5f));
+}
+
+static void fillRegs(uint16_t* r){
+  r[MB_REG_TEMP]     = (uint16_t)scaled(statusTempC, 10);
+  r[MB_REG_VIN]      = (uint16_t)scaled(statusVinV, 100);
+  r[MB_REG_FAN1_MA]  = (uint16_t)scaled(fan1Current_mA, 1);
+  r[MB_REG_FAN2_MA]  = (uint16_t)scaled(fan2Current_mA, 1);
+  r[MB_REG_FAN1_DW]  = (uint16_t)scaled(fan1Power_W, 10);
+  r[MB_REG_FAN2_DW]  = (uint16_t)scaled(fan2Power_W, 10);
+  r[MB_REG_FAN1_RPM] = (uint16_t)scaled(fan1Rpm, 1);
+  r[MB_REG_FAN2_RPM] = (uint16_t)scaled(fan2Rpm, 1);
+  r[MB_REG_ALARMS]   = alarmMask();
+  r[MB_REG_LIGHT]    = Light_Condition ? 1 : 0;
+  r[MB_REG_FAN1_HEALTH] = diagFan1Health;
+  r[MB_REG_FAN2_HEALTH] = diagFan2Health;
+}
+
+// Collect bytes; a silence of one frame gap ends the request. Sleeps on
+// the RX start bit between requests (MB_TASK_IDLE_MS to see new settings).
+static void slaveStep(){
+  static uint32_t lastByteUs = 0;
+  while (mbPort.available()) {
+    const uint8_t b = (uint8_t)mbPort.read();
+    if (rxLen < sizeof(rx)) rx[rxLen++] = b;
+    lastByteUs = micros();
+  }
+  if (!rxLen) {
+    serialWakeWait(MODBUS_RX_PIN, pdMS_TO_TICKS(MB_TASK_IDLE_MS));
+    return;
+  }
+  const uint32_t quietUs = micros() - lastByteUs;
+  if (quietUs < gapUs) {
+    serialWakeWait(MODBUS_RX_PIN, serialWakeTicks(gapUs - quietUs));
+    return;
+  }
+  uint16_t regs[MB_REG_COUNT];
+  fillRegs(regs);
+  const uint16_t n = mbServe(rx, rxLen, cfg.slaveID, regs, MB_REG_COUNT, tx);
+  rxLen = 0;
+  if (n) {
+    sendFrame(n);
+    diagMbServed++;
+  }
+}
+
+// ===== Master =====
+// One poll: request out, then read until the known reply length (no gap
+// wait), an exception reply or the node's timeout
+static void masterStep(){
+  taskENTER_CRITICAL();
+  const int8_t i = mbMasterNext(master, micros());
+  const uint32_t cycleUs = master.lastCycleUs;
+  taskEXIT_CRITICAL();
+  diagMbCycleMs = (uint16_t)(cycleUs / 1000);
+  if (i < 0) {
+    vTaskDelay(pdMS_TO_TICKS(MB_TASK_IDLE_MS));
+    return;
+  }
+  const uint8_t addr = master.node[i].addr;
+  const uint32_t timeoutUs = mbMasterTimeoutUs(master, (uint8_t)i);
+  const uint16_t want = mbReadReplyLen(MB_REG_COUNT);
+
+  drainInput();                  // late replies of the last poll
+  sendFrame(mbBuildRead(tx, addr, 0, MB_REG_COUNT));
+  const uint32_t sentUs = micros();
+  for (;;) {
+    const uint32_t waitedUs = micros() - sentUs;
+    if (rxLen >= want || waitedUs >= timeoutUs) break;
+    if (!mbPort.available()) {
+      // Once the reply has started, a missed last edge costs one gap
+      serialWakeWait(MODBUS_RX_PIN, rxLen ? gapTicks : serialWakeTicks(timeoutUs - waitedUs));
+      continue;
+    }
+    while (mbPort.available() && rxLen < sizeof(rx)) rx[rxLen++] = (uint8_t)mbPort.read();
+    if (rxLen >= 5 && (rx[1] & 0x80)) break;
+  }
+  const uint32_t rttUs = micros() - sentUs;
+
+  uint16_t regs[MB_REG_COUNT];
+  const MbResult r = rxLen ? mbParseRead(rx, rxLen, addr, MB_REG_COUNT, regs, nullptr) : MB_TIMEOUT;
+  taskENTER_CRITICAL();
+  mbMasterDone(master, (uint8_t)i, r, rttUs, regs, millis());
+  taskEXIT_CRITICAL();
+
+  vTaskDelay(gapTicks);          // frame gap before the next request
+}
+
+static void mbTask(void*){
+  for (;;) {
+    if (configChanged()) applyConfig();
+    if (cfg.master) masterStep();
+    else            slaveStep();
+  }
+}
+
+void modbusSiteGet(ModbusSite& out){
+  taskENTER_CRITICAL();
+  out.count = master.count;
+  out.cycleMs = (uint16_t)(master.lastCycleUs / 1000);
+  for (uint8_t i = 0; i < master.count; i++) {
+    const MbNode& n = master.node[i];
+    out.node[i].addr = n.addr;
+    out.node[i].online = n.online;
+    out.node[i].tempDc = (int16_t)n.regs[MB_REG_TEMP];
+    out.node[i].alarms = (uint8_t)n.regs[MB_REG_ALARMS];
+  }
+  taskEXIT_CRITICAL();
+  out.online = 0;
+  for (uint8_t i = 0; i < out.count; i++) out.online += out.node[i].online;
+}
+
+bool modbusStart(){
+  pinMode(MODBUS_DE_PIN, OUTPUT);
+  digitalWrite(MODBUS_DE_PIN, LOW);         // receive
+  if (!TASK_START(mbTask, "MBUS", mb, MB_STACK_WORDS,
+                  MB_PRIORITY, &mbHandle)) return false;
+  healthRegisterTask(mbHandle, MB_STACK_WORDS);
+  return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+#include "ModbusLogic.h"
+
+// ===== Modbus RTU link =====
+// A low-priority task on the RS-485 port (Pins.h), settings from gLive
+// (baudrate, slaveID, modbusMaster, modbusNodes; re-applied when changed):
+//   slave   answers "read input registers" at slaveID with this unit's
+//           telemetry and alarms (MbReg in ModbusLogic.h)
+//   master  polls the units at slaveID+1 .. slaveID+modbusNodes back to
+//           back and caches their registers for the site page
+// 8E1 framing; the frame gap is timed with micros() and the tick. The task
+// blocks between frames: on the RX start bit (SerialWake.h) or the tick,
+// never spinning, so the MCU idles (tickless) while the bus is quiet.
+
+#ifndef MB_TASK_IDLE_MS
+#define MB_TASK_IDLE_MS 500             // nothing to do (no nodes, no request): settings check
+#endif
+
+// Diagnostics (read-only menu fields)
+extern uint16_t diagMbCycleMs;          // last full poll cycle (master)
+extern uint16_t diagMbServed;           // requests answered (slave)
+
+// One downstream unit, as the site page shows it
+struct ModbusSiteNode {
+  uint8_t addr;
+  bool online;
+  int16_t tempDc;                       // 0.1 C
+  uint8_t alarms;                       // alarmMask() bits
+};
+
+struct ModbusSite {
+  uint8_t count;                        // 0 = master mode off
+  uint8_t online;
+  uint16_t cycleMs;
+  ModbusSiteNode node[MB_MAX_NODES];
+};
+
+// Create the task (boot task, DEFERRED)
+bool modbusStart();
+
+// Snapshot of the polled units (UI task)
+void modbusSiteGet(ModbusSite& out);
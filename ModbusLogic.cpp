@@ -0,0 +1,147 @@
+#include "ModbusLogic.h"
+#include <string.h>
+#include "Crc.h"
+
+uint32_t mbCharUs(uint32_t baud){
+  return baud ? (11000000UL + baud - 1) / baud : 0;
+}
+
+uint32_t mbFrameGapUs(uint32_t baud){
+  return baud > 19200 ? 1750 : (mbCharUs(baud) * 7 + 1) / 2;
+}
+
+static uint16_t putCrc(uint8_t* f, uint16_t n){
+  const uint16_t crc = crc16Modbus(f, n);
+  f[n] = (uint8_t)crc;
+  f[n + 1] = (uint8_t)(crc >> 8);
+  return (uint16_t)(n + 2);
+}
+
+static bool crcOk(const uint8_t* f, uint16_t len){
+  if (len < 4) return false;
+  const uint16_t crc = crc16Modbus(f, len - 2);
+  return f[len - 2] == (uint8_t)crc && f[len - 1] == (uint8_t)(crc >> 8);
+}
+
+// ===== Frames =====
+uint8_t mbBuildRead(uint8_t* out, uint8_t addr, uint16_t start, uint16_t count){
+  out[0] = addr;
+  out[1] = MB_FC_READ_INPUT;
+  out[2] = (uint8_t)(start >> 8); out[3] = (uint8_t)start;
+  out[4] = (uint8_t)(count >> 8); out[5] = (uint8_t)count;
+  return (uint8_t)putCrc(out, 6);
+}
+
+MbResult mbParseRead(const uint8_t* f, uint16_t len, uint8_t addr, uint16_t count,
+                     uint16_t* regs, uint8_t* exCode){
+  if (len < 5) return MB_BAD_FRAME;
+  if (!crcOk(f, len)) return MB_BAD_CRC;
+  if (f[0] != addr) return MB_BAD_FRAME;
+  if (f[1] == (MB_FC_READ_INPUT | 0x80) && len == 5) {
+    if (exCode) *exCode = f[2];
+    return MB_EXCEPTION;
+  }
+  if (f[1] != MB_FC_READ_INPUT || f[2] != 2 * count || len != mbReadReplyLen(count)) return MB_BAD_FRAME;
+  for (uint16_t i = 0; i < count; i++) regs[i] = (uint16_t)((f[3 + 2 * i] << 8) | f[4 + 2 * i]);
+  return MB_OK;
+}
+
+uint16_t mbServe(const uint8_t* req, uint16_t len, uint8_t addr,
+                 const uint16_t* regs, uint16_t regCount, uint8_t* out){
+  if (len < 4 || req[0] != addr || addr == 0 || !crcOk(req, len)) return 0;
+  out[0] = addr;
+  uint8_t ex = 0;
+  if (req[1] != MB_FC_READ_INPUT) ex = MB_EX_FUNCTION;
+  else if (len != 8) ex = MB_EX_VALUE;
+  else {
+    const uint16_t start = (uint16_t)((req[2] << 8) | req[3]);
+    const uint16_t count = (uint16_t)((req[4] << 8) | req[5]);
+    if (count == 0 || count > 125) ex = MB_EX_VALUE;
+    else if ((uint32_t)start + count > regCount) ex = MB_EX_ADDRESS;
+    else {
+      out[1] = MB_FC_READ_INPUT;
+      out[2] = (uint8_t)(2 * count);
+      for (uint16_t i = 0; i < count; i++) {
+        out[3 + 2 * i] = (uint8_t)(regs[start + i] >> 8);
+        out[4 + 2 * i] = (uint8_t)regs[start + i];
+      }
+      return putCrc(out, (uint16_t)(3 + 2 * count));
+    }
+  }
+  out[1] = (uint8_t)(req[1] | 0x80);
+  out[2] = ex;
+  return putCrc(out, 3);
+}
+
+// ===== Master poll schedule =====
+void mbMasterInit(MbMaster& m, uint8_t firstAddr, uint8_t count, uint32_t baud){
+  memset(&m, 0, sizeof(m));
+  if (firstAddr == 0) firstAddr = 1;
+  if (count > MB_MAX_NODES) count = MB_MAX_NODES;
+  if (firstAddr + count - 1 > 247) count = (uint8_t)(firstAddr > 247 ? 0 : 248 - firstAddr);
+  m.count = count;
+  m.replyWireUs = mbReadReplyLen(MB_REG_COUNT) * mbCharUs(baud);
+  for (uint8_t i = 0; i < count; i++) m.node[i].addr = (uint8_t)(firstAddr + i);
+}
+
+static bool dead(const MbNode& n){ return n.misses >= MB_DEAD_AFTER; }
+
+int8_t mbMasterNext(MbMaster& m, uint32_t nowUs){
+  for (uint8_t tries = 0; tries < m.count; tries++) {
+    if (m.next == 0) {
+      if (m.cycles) m.lastCycleUs = nowUs - m.cycleStartUs;
+      m.cycleStartUs = nowUs;
+      m.cycles++;
+    }
+    const uint8_t i = m.next;
+    m.next = (uint8_t)((m.next + 1) % m.count);
+    if (!dead(m.node[i]) || m.cycles % MB_PROBE_CYCLES == 0) return (int8_t)i;
+  }
+  return -1;
+}
+
+uint32_t mbMasterTimeoutUs(const MbMaster& m, uint8_t i){
+  const MbNode& n = m.node[i];
+  if (!n.srttUs) return MB_TIMEOUT_MAX_US;
+  const uint32_t lo = m.replyWireUs + MB_TIMEOUT_MARGIN_US;
+  const uint32_t t = n.srttUs + 4 * n.rttvarUs;
+  return t < lo ? lo : t > MB_TIMEOUT_MAX_US ? MB_TIMEOUT_MAX_US : t;
+}
+
+void mbMasterDone(MbMaster& m, uint8_t i, MbResult r, uint32_t rttUs,
+                  const uint16_t* regs, uint32_t nowMs){
+  MbNode& n = m.node[i];
+  n.polls++;
+  if (r != MB_OK) {
+    if (r == MB_TIMEOUT) {
+      n.timeouts++;
+      // Slower than we thought: widen before the next try
+      if (n.srttUs) n.rttvarUs = n.rttvarUs * 2 > MB_TIMEOUT_MAX_US ? MB_TIMEOUT_MAX_US : n.rttvarUs * 2 + 1;
+    } else {
+      n.errors++;
+    }
+    if (n.misses < 0xFF) n.misses++;
+    if (dead(n)) n.online = false;
+    return;
+  }
+  n.answers++;
+  n.misses = 0;
+  n.online = true;
+  n.lastOkMs = nowMs;
+  memcpy(n.regs, regs, sizeof(n.regs));
+  if (!n.srttUs) {
+    n.srttUs = rttUs;
+    n.rttvarUs = rttUs / 2;
+  } else {
+    const int32_t err = (int32_t)(rttUs - n.srttUs);
+    n.srttUs = (uint32_t)((int32_t)n.srttUs + err / 8);
+    const uint32_t aerr = (uint32_t)(err < 0 ? -err : err);
+    n.rttvarUs = (uint32_t)((int32_t)n.rttvarUs + ((int32_t)aerr - (int32_t)n.rttvarUs) / 4);
+  }
+}
+
+uint8_t mbMasterOnline(const MbMaster& m){
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < m.count; i++) n += m.node[i].online;
+  return n;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Modbus RTU =====
+// Hardware-free part of the RS-485 link (Modbus.h runs it on the UART;
+// tools/modbus_site_sim.cpp runs it over ptys against simulated units).
+//
+// Every unit serves its telemetry as input registers (function 0x04) at
+// its slaveID. In master mode one unit instead polls the units at
+// slaveID+1 .. slaveID+nodes and keeps their last registers for the site
+// page.
+//
+// The poll schedule is back to back: the reply length is known, so the
+// next request goes out one frame gap after the last reply byte instead of
+// in a fixed slot. Each node's timeout follows its measured response time
+// (smoothed mean + 4 deviations, as TCP's retransmit timer), and a node
+// that missed MB_DEAD_AFTER polls in a row is only probed every
+// MB_PROBE_CYCLES cycles, so dead cabinets do not stretch every cycle.
+
+#ifndef MB_MAX_NODES
+#define MB_MAX_NODES 16
+#endif
+#ifndef MB_DEAD_AFTER
+#define MB_DEAD_AFTER 3                // missed polls in a row
+#endif
+#ifndef MB_PROBE_CYCLES
+#define MB_PROBE_CYCLES 8              // a dead node is polled every Nth cycle
+#endif
+#ifndef MB_TIMEOUT_MAX_US
+#define MB_TIMEOUT_MAX_US 100000UL     // before the first answer; ceiling
+#endif
+#ifndef MB_TIMEOUT_MARGIN_US
+#define MB_TIMEOUT_MARGIN_US 2000UL    // floor above the reply's wire time
+#endif
+#define MB_FRAME_MAX 256
+
+// Input registers every unit serves (read from 0, MB_REG_COUNT long)
+enum MbReg : uint8_t {
+  MB_REG_TEMP,                         // 0.1 C, signed
+  MB_REG_VIN,                          // 10 mV
+  MB_REG_FAN1_MA, MB_REG_FAN2_MA,
+  MB_REG_FAN1_DW, MB_REG_FAN2_DW,      // 0.1 W
+  MB_REG_FAN1_RPM, MB_REG_FAN2_RPM,
+  MB_REG_ALARMS,                       // alarmMask()
+  MB_REG_LIGHT,                        // 1 = day
+  MB_REG_FAN1_HEALTH, MB_REG_FAN2_HEALTH,   // %, 100 = healthy
+  MB_REG_COUNT
+};
+
+enum MbFunc : uint8_t { MB_FC_READ_INPUT = 0x04 };
+enum MbException : uint8_t { MB_EX_FUNCTION = 1, MB_EX_ADDRESS = 2, MB_EX_VALUE = 3 };
+enum MbResult : uint8_t { MB_OK, MB_TIMEOUT, MB_BAD_CRC, MB_BAD_FRAME, MB_EXCEPTION };
+
+// One character on the wire (11 bits: start, 8 data, parity or 2nd stop, stop)
+uint32_t mbCharUs(uint32_t baud);
+// Silence that ends a frame: 3.5 characters, fixed 1750 us above 19200 baud
+uint32_t mbFrameGapUs(uint32_t baud);
+
+// ----- Frames -----
+// Read input registers request; returns its length (8)
+uint8_t mbBuildRead(uint8_t* out, uint8_t addr, uint16_t start, uint16_t count);
+inline uint16_t mbReadReplyLen(uint16_t count){ return (uint16_t)(5 + 2 * count); }
+
+// Check a reply to mbBuildRead(addr, ., count); regs gets count values on
+// MB_OK, *exCode the code on MB_EXCEPTION
+MbResult mbParseRead(const uint8_t* f, uint16_t len, uint8_t addr, uint16_t count,
+                     uint16_t* regs, uint8_t* exCode);
+
+// Slave: answer a complete request frame from regs[0..regCount). Returns
+// the reply length in out (MB_FRAME_MAX); 0 = stay silent (other address,
+// broadcast, bad CRC or runt)
+uint16_t mbServe(const uint8_t* req, uint16_t len, uint8_t addr,
+                 const uint16_t* regs, uint16_t regCount, uint8_t* out);
+
+// ----- Master poll schedule -----
+struct MbNode {
+  uint8_t addr;
+  bool online;                         // answered, not dead since
+  uint8_t misses;                      // polls in a row without a valid reply
+  uint32_t srttUs, rttvarUs;           // 0 = no reply yet
+  uint32_t lastOkMs;
+  uint16_t regs[MB_REG_COUNT];         // last good reply
+  uint32_t polls, answers, timeouts, errors;
+};
+
+struct MbMaster {
+  MbNode node[MB_MAX_NODES];
+  uint8_t count;
+  uint8_t next;                        // index polled next
+  uint32_t cycles;                     // started so far
+  uint32_t replyWireUs;                // a full reply on the wire
+  uint32_t cycleStartUs;
+  uint32_t lastCycleUs;                // duration of the last full cycle
+};
+
+// Nodes at firstAddr .. firstAddr+count-1 (count clamped to MB_MAX_NODES
+// and to address 247)
+void mbMasterInit(MbMaster& m, uint8_t firstAddr, uint8_t count, uint32_t baud);
+
+// Node to poll now (dead nodes are skipped outside probe cycles), -1 if
+// none. Coming back to the first node closes a cycle (lastCycleUs).
+int8_t mbMasterNext(MbMaster& m, uint32_t nowUs);
+
+// How long to wait for node i's reply after the request has gone out
+uint32_t mbMasterTimeoutUs(const MbMaster& m, uint8_t i);
+
+// Outcome of polling node i; rttUs = end of request to last reply byte,
+// regs = MB_REG_COUNT values on MB_OK
+void mbMasterDone(MbMaster& m, uint8_t i, MbResult r, uint32_t rttUs,
+                  const uint16_t* regs, uint32_t nowMs);
+
+uint8_t mbMasterOnline(const MbMaster& m);
@@ -0,0 +1,51 @@
+#include "Password.h"
+#include <Arduino.h>
+#include "Crc.h"
+#include "Storage.h"
+
+static PassState st;
+
+static void makeSalt(uint8_t* s){
+  for (uint8_t i = 0; i < 2; i++) {
+    const uint32_t seed[4] = { (uint32_t)micros(), (uint32_t)millis(), (uint32_t)st.work[i] << 8 | st.rec.hash[i], i };
+    const uint32_t c = crc32((const uint8_t*)seed, sizeof(seed));
+    memcpy(s + 4 * i, &c, 4);
+  }
+}
+
+// ===== Public API =====
+void passwordInit(unsigned long now){
+  if (storageLoad(STORE_PASSWORD, &st.rec, sizeof(st.rec)) &&
+      st.rec.len >= PASS_MIN_LEN && st.rec.len <= PASS_MAX_LEN) {
+    passRestore(st, now);
+    return;
+  }
+  // Nothing stored yet: derive the default code once, in RAM only
+  static const char DEF[] = PASS_DEFAULT_CODE;
+  uint8_t digits[PASS_MAX_LEN];
+  const uint8_t len = (uint8_t)(sizeof(DEF) - 1);
+  for (uint8_t i = 0; i < len; i++) digits[i] = (uint8_t)(DEF[i] - '0');
+  passSetDefault(st, digits, len);
+}
+
+uint8_t passwordLength(){ return st.rec.len; }
+
+unsigned long passwordLockedMs(unsigned long now){ return passLockedMs(st, now); }
+
+bool passwordCheck(const uint8_t* digits, uint8_t len, unsigned long now){
+  return passStartCheck(st, digits, len, now);
+}
+
+bool passwordChange(const uint8_t* digits, uint8_t len){
+  if (st.job != PASS_JOB_NONE) return false;
+  uint8_t salt[8];
+  makeSalt(salt);
+  return passStartChange(st, digits, len, salt);
+}
+
+PassResult passwordPoll(unsigned long now){
+  bool save;
+  const PassResult r = passStep(st, now, PASS_ROUNDS_PER_POLL, &save);
+  if (save) storageSave(STORE_PASSWORD, &st.rec, sizeof(st.rec));
+  return r;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+
+#include "PasswordLogic.h"
+
+// ===== Unlock code =====
+// The code is never stored in clear: the persistent record holds a random
+// salt and an iterated SHA-256 of salt + digits (PasswordLogic.h). Hashing
+// runs in small slices from the UI loop (passwordPoll) so the dialog keeps
+// animating, and every check costs the same number of rounds and a
+// constant-time compare. After PASS_FREE_TRIES wrong codes each further
+// failure doubles a lockout.
+
+// Used until a code has been changed from the service menu
+#ifndef PASS_DEFAULT_CODE
+#define PASS_DEFAULT_CODE "1001"
+#endif
+// SHA-256 blocks per passwordPoll() call (~20 us each on a 72 MHz M3)
+#ifndef PASS_ROUNDS_PER_POLL
+#define PASS_ROUNDS_PER_POLL 32
+#endif
+
+// Load the stored record (or derive the default code); call once at startup
+void passwordInit(unsigned long now);
+
+// Digits in the current code
+uint8_t passwordLength();
+
+// Remaining lockout time, 0 when a check is allowed
+unsigned long passwordLockedMs(unsigned long now);
+
+// Start checking a code (digits 0..9). False while locked out or busy.
+bool passwordCheck(const uint8_t* digits, uint8_t len, unsigned long now);
+
+// Start replacing the code (PASS_MIN_LEN..PASS_MAX_LEN digits). False if busy.
+bool passwordChange(const uint8_t* digits, uint8_t len);
+
+// Run one hashing slice. Returns PASS_BUSY while working, then the outcome
+// exactly once, then PASS_IDLE.
+PassResult passwordPoll(unsigned long now);
@@ -0,0 +1,165 @@
+#include "PasswordLogic.h"
+#include <string.h>
+
+// ===== SHA-256 (single-block messages only, <= 55 bytes) =====
+static const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t ror(uint32_t x, uint8_t n){ return (x >> n) | (x << (32 - n)); }
+
+void passSha256Short(const uint8_t* msg, uint8_t n, uint8_t out[32]){
+  uint32_t w[64];
+  uint8_t block[64];
+  memset(block, 0, sizeof(block));
+  memcpy(block, msg, n);
+  block[n] = 0x80;
+  block[62] = (uint8_t)((n * 8) >> 8);
+  block[63] = (uint8_t)(n * 8);
+  for (uint8_t i = 0; i < 16; i++) {
+    w[i] = ((uint32_t)block[4*i] << 24) | ((uint32_t)block[4*i+1] << 16) |
+           ((uint32_t)block[4*i+2] << 8) | block[4*i+3];
+  }
+  for (uint8_t i = 16; i < 64; i++) {
+    const uint32_t s0 = ror(w[i-15], 7) ^ ror(w[i-15], 18) ^ (w[i-15] >> 3);
+    const uint32_t s1 = ror(w[i-2], 17) ^ ror(w[i-2], 19) ^ (w[i-2] >> 10);
+    w[i] = w[i-16] + s0 + w[i-7] + s1;
+  }
+  static const uint32_t H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  uint32_t h[8];
+  memcpy(h, H0, sizeof(h));
+  for (uint8_t i = 0; i < 64; i++) {
+    const uint32_t S1 = ror(h[4], 6) ^ ror(h[4], 11) ^ ror(h[4], 25);
+    const uint32_t ch = (h[4] & h[5]) ^ (~h[4] & h[6]);
+    const uint32_t t1 = h[7] + S1 + ch + K[i] + w[i];
+    const uint32_t S0 = ror(h[0], 2) ^ ror(h[0], 13) ^ ror(h[0], 22);
+    const uint32_t mj = (h[0] & h[1]) ^ (h[0] & h[2]) ^ (h[1] & h[2]);
+    memmove(h + 1, h, 7 * sizeof(uint32_t));
+    h[4] += t1;
+    h[0] = t1 + S0 + mj;
+  }
+  for (uint8_t i = 0; i < 8; i++) {
+    const uint32_t v = H0[i] + h[i];
+    out[4*i] = (uint8_t)(v >> 24); out[4*i+1] = (uint8_t)(v >> 16);
+    out[4*i+2] = (uint8_t)(v >> 8); out[4*i+3] = (uint8_t)v;
+  }
+}
+
+bool passDigestEqual(const uint8_t* a, const uint8_t* b, uint8_t n){
+  // Always walks the whole digest; volatile keeps the compiler from
+  // turning the OR chain back into an early exit
+  volatile uint8_t diff = 0;
+  for (uint8_t i = 0; i < n; i++) diff = (uint8_t)(diff | (a[i] ^ b[i]));
+  return diff == 0;
+}
+
+uint32_t passLockDuration(uint8_t fails){
+  if (fails < PASS_FREE_TRIES) return 0;
+  const uint8_t k = (uint8_t)(fails - PASS_FREE_TRIES);
+  if (k >= 20) return PASS_LOCK_MAX_MS;
+  const uint32_t d = PASS_LOCK_BASE_MS << k;
+  return d > PASS_LOCK_MAX_MS ? PASS_LOCK_MAX_MS : d;
+}
+
+// ===== Incremental hashing job =====
+static void jobStart(PassState& s, PassJobKind j, const uint8_t* digits, uint8_t len, const uint8_t* salt){
+  uint8_t msg[9 + PASS_MAX_LEN];
+  memcpy(msg, salt, 8);
+  msg[8] = len;
+  memcpy(msg + 9, digits, len);
+  passSha256Short(msg, (uint8_t)(9 + len), s.work);
+  memset(msg, 0, sizeof(msg));
+  memcpy(s.jobSalt, salt, 8);
+  s.jobLen = len;
+  s.roundsLeft = PASS_HASH_ROUNDS - 1;
+  s.job = j;
+}
+
+static void jobRun(PassState& s, uint16_t rounds){
+  uint8_t msg[40];
+  while (s.roundsLeft && rounds--) {
+    memcpy(msg, s.work, 32);
+    memcpy(msg + 32, s.jobSalt, 8);
+    passSha256Short(msg, sizeof(msg), s.work);
+    s.roundsLeft--;
+  }
+}
+
+// ===== State =====
+void passRestore(PassState& s, uint32_t now){
+  s.lockStartMs = now;
+  s.lockLenMs = passLockDuration(s.rec.fails);
+}
+
+void passSetDefault(PassState& s, const uint8_t* digits, uint8_t len){
+  memset(&s.rec, 0, sizeof(s.rec));
+  jobStart(s, PASS_JOB_CHANGE, digits, len, s.rec.salt);
+  jobRun(s, PASS_HASH_ROUNDS);
+  s.rec.len = len;
+  memcpy(s.rec.hash, s.work, sizeof(s.rec.hash));
+  s.job = PASS_JOB_NONE;
+}
+
+uint32_t passLockedMs(const PassState& s, uint32_t now){
+  const uint32_t el = now - s.lockStartMs;
+  return el < s.lockLenMs ? s.lockLenMs - el : 0;
+}
+
+bool passStartCheck(PassState& s, const uint8_t* digits, uint8_t len, uint32_t now){
+  if (s.job != PASS_JOB_NONE || passLockedMs(s, now)) return false;
+  if (len > PASS_MAX_LEN) len = PASS_MAX_LEN;
+  jobStart(s, PASS_JOB_CHECK, digits, len, s.rec.salt);
+  return true;
+}
+
+bool passStartChange(PassState& s, const uint8_t* digits, uint8_t len, const uint8_t* salt){
+  if (s.job != PASS_JOB_NONE || len < PASS_MIN_LEN || len > PASS_MAX_LEN) return false;
+  jobStart(s, PASS_JOB_CHANGE, digits, len, salt);
+  return true;
+}
+
+PassResult passStep(PassState& s, uint32_t now, uint16_t rounds, bool* save){
+  *save = false;
+  if (s.job == PASS_JOB_NONE) return PASS_IDLE;
+  jobRun(s, rounds);
+  if (s.roundsLeft) return PASS_BUSY;
+
+  const PassJobKind done = s.job;
+  s.job = PASS_JOB_NONE;
+  if (done == PASS_JOB_CHANGE) {
+    s.rec.len = s.jobLen;
+    s.rec.fails = 0;
+    memcpy(s.rec.salt, s.jobSalt, sizeof(s.rec.salt));
+    memcpy(s.rec.hash, s.work, sizeof(s.rec.hash));
+    s.lockLenMs = 0;
+    *save = true;
+    return PASS_CHANGED;
+  }
+
+  // The length folds into the digest compare's result without a branch
+  const bool same = passDigestEqual(s.work, s.rec.hash, sizeof(s.rec.hash)) & (s.jobLen == s.rec.len);
+  if (same) {
+    if (s.rec.fails) {
+      *save = s.rec.fails >= PASS_FREE_TRIES;    // persisted once locking
+      s.rec.fails = 0;
+    }
+    return PASS_OK;
+  }
+  if (s.rec.fails < 0xFF) s.rec.fails++;
+  if (s.rec.fails >= PASS_FREE_TRIES) {
+    s.lockStartMs = now;
+    s.lockLenMs = passLockDuration(s.rec.fails);
+    *save = true;
+  }
+  return PASS_WRONG;
+}
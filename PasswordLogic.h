@@ -0,0 +1,86 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Unlock code: hashing, compare, lockout =====
+// Hardware-free part of the unlock code (Password.h adds storage and salt
+// entropy; tools/password_check.cpp runs it on the host).
+//
+// A code is kept as h0 = H(salt | len | digits), h(i+1) = H(h(i) | salt)
+// over PASS_HASH_ROUNDS SHA-256 blocks. A check costs the same rounds and
+// the same compare whatever the digits: the digest compare walks all 32
+// bytes and the length without branching on them. After PASS_FREE_TRIES
+// wrong codes each further failure doubles a lockout, PASS_LOCK_BASE_MS up
+// to PASS_LOCK_MAX_MS.
+
+#ifndef PASS_MIN_LEN
+#define PASS_MIN_LEN 4
+#endif
+#ifndef PASS_MAX_LEN
+#define PASS_MAX_LEN 8
+#endif
+#ifndef PASS_HASH_ROUNDS
+#define PASS_HASH_ROUNDS 256
+#endif
+#ifndef PASS_FREE_TRIES
+#define PASS_FREE_TRIES 3
+#endif
+#ifndef PASS_LOCK_BASE_MS
+#define PASS_LOCK_BASE_MS 5000UL
+#endif
+#ifndef PASS_LOCK_MAX_MS
+#define PASS_LOCK_MAX_MS 600000UL
+#endif
+
+enum PassResult : uint8_t {
+  PASS_IDLE,          // nothing pending
+  PASS_BUSY,          // hashing in progress
+  PASS_OK,            // check passed
+  PASS_WRONG,         // check failed (may have started a lockout)
+  PASS_CHANGED        // new code stored
+};
+
+// The persistent record (STORE_PASSWORD)
+struct PassRecord {
+  uint8_t len;
+  uint8_t fails;          // consecutive wrong codes (persisted once locking)
+  uint8_t salt[8];
+  uint8_t hash[32];
+};
+
+enum PassJobKind : uint8_t { PASS_JOB_NONE, PASS_JOB_CHECK, PASS_JOB_CHANGE };
+
+struct PassState {
+  PassRecord rec;
+  uint32_t lockStartMs, lockLenMs;
+  PassJobKind job;
+  uint8_t jobLen;
+  uint8_t jobSalt[8];
+  uint8_t work[32];
+  uint16_t roundsLeft;
+};
+
+// SHA-256 of a single-block message (n <= 55)
+void passSha256Short(const uint8_t* msg, uint8_t n, uint8_t out[32]);
+
+// a == b over n bytes, in time independent of the contents
+bool passDigestEqual(const uint8_t* a, const uint8_t* b, uint8_t n);
+
+// Lockout after `fails` consecutive wrong codes
+uint32_t passLockDuration(uint8_t fails);
+
+// A valid stored record was loaded into s.rec: a reboot does not clear a lockout
+void passRestore(PassState& s, uint32_t now);
+
+// No record: hash the default code into s.rec, all rounds at once
+void passSetDefault(PassState& s, const uint8_t* digits, uint8_t len);
+
+uint32_t passLockedMs(const PassState& s, uint32_t now);
+
+// Start a check / a change (salt: 8 fresh bytes). False while busy, locked
+// out (check) or with a bad length (change).
+bool passStartCheck(PassState& s, const uint8_t* digits, uint8_t len, uint32_t now);
+bool passStartChange(PassState& s, const uint8_t* digits, uint8_t len, const uint8_t* salt);
+
+// Run up to `rounds` hash rounds. Returns PASS_BUSY while working, then the
+// outcome once, then PASS_IDLE; *save is set when s.rec must be persisted.
+PassResult passStep(PassState& s, uint32_t now, uint16_t rounds, bool* save);
@@ -25,3 +25,39 @@
 
 // OLED I2C address
 #define OLED_ADDR 0x3C
+
+// Optional second panel (e.g. on the door), same I2C bus. It mirrors the
+// main panel; see DISPLAY2_SETUP in MenuUI.cpp for the controller type.
+#ifndef DISPLAY2_ENABLE
+#define DISPLAY2_ENABLE 0
+#endif
+#define OLED2_ADDR 0x3D
+
+// Remote settings/telemetry link (RemoteLink.h) on USART1, a port of its
+// own: debug prints and the menu stay on USB Serial.
+#define REMOTE_RX_PIN   PA10   // USART1_RX
+#define REMOTE_TX_PIN   PA9    // USART1_TX
+
+// Aviation obstruction light (AviationLight.h)
+#define AVI_LDR_PIN     PA2    // LDR divider, analog
+#define AVI_ISENSE_PIN  PA3    // lamp current shunt amplifier, analog
+#define AVI_LAMP_PIN    PB0    // lamp driver (high = on)
+
+// Fan tachometers (FanTach.h): channels of one timer, input capture
+#define FAN1_TACH_PIN   PA6    // TIM3_CH1
+#define FAN2_TACH_PIN   PA7    // TIM3_CH2
+
+// Status sensors (Sensors.h), analog
+#define SENSOR_NTC_PIN  PA4    // NTC to GND, CAL_NTC_SERIES_OHM to VREF
+#define SENSOR_VIN_PIN  PA5    // supply through SENSOR_VIN_DIVIDER
+
+// Modbus RTU over RS-485 (Modbus.h). USART3; the USART2 pins are the
+// aviation inputs above. DE and /RE of the transceiver tied together.
+#define MODBUS_RX_PIN   PB11   // USART3_RX
+#define MODBUS_TX_PIN   PB10   // USART3_TX
+#define MODBUS_DE_PIN   PB1    // driver enable (high = transmit)
+
+// Fan current shunt amplifiers (FanHealth.h), analog. The commented-out
+// button layout above has BTN_DOWN on PA0.
+#define FAN1_ISENSE_PIN PA0    // ADC_IN0
+#define FAN2_ISENSE_PIN PA1    // ADC_IN1
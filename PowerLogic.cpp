@@ -0,0 +1,91 @@
+#include "PowerLogic.h"
+
+static void account(PowerLogic& p, uint32_t now){
+  const uint32_t dt = now - p.stateSinceMs;
+  if (p.state == PWR_ACTIVE) p.activeMs += dt;
+  p.totalMs += dt;
+  p.stateSinceMs = now;
+  // Halve both so the ratio tracks recent behaviour and never overflows
+  if (p.totalMs > 0x40000000UL) { p.activeMs >>= 1; p.totalMs >>= 1; }
+}
+
+static void enter(PowerLogic& p, PowerState s, uint32_t now){
+  if (s == p.state) return;
+  account(p, now);
+  p.state = s;
+}
+
+void powerLogicReset(PowerLogic& p, uint32_t now){
+  p = PowerLogic();
+  p.state = PWR_ACTIVE;
+  p.lastActivityMs = p.stateSinceMs = now;
+}
+
+void powerLogicWake(PowerLogic& p, uint32_t edgeMs, uint32_t now){
+  p.wakeEdgeMs = edgeMs;
+  p.wakePending = true;
+  p.swallowNext = true;
+  p.lastActivityMs = now;
+  enter(p, PWR_ACTIVE, now);
+}
+
+bool powerLogicActivity(PowerLogic& p, uint32_t now){
+  // Input without an edge interrupt (e.g. replay): wake here
+  if (p.state == PWR_OFF) powerLogicWake(p, now, now);
+  p.lastActivityMs = now;
+  if (p.swallowNext) {
+    p.swallowNext = false;
+    return now - p.wakeEdgeMs < POWER_SWALLOW_MS;
+  }
+  if (p.state == PWR_DIM) enter(p, PWR_ACTIVE, now);
+  return false;
+}
+
+PowerState powerLogicTick(PowerLogic& p, uint32_t now, uint16_t dimAfterS, uint16_t offAfterS,
+                          uint8_t alarms){
+  const uint8_t raised = alarms & ~p.alarms;
+  p.alarms = alarms;
+  if (raised && p.state != PWR_ACTIVE) {
+    // Nothing to swallow: no press woke it
+    if (p.state == PWR_OFF) {
+      p.wakeEdgeMs = now;
+      p.wakePending = true;
+    }
+    p.lastActivityMs = now;
+    enter(p, PWR_ACTIVE, now);
+    return p.state;
+  }
+
+  const uint32_t idleS = (now - p.lastActivityMs) / 1000;
+  if (p.state != PWR_OFF && offAfterS && idleS >= offAfterS) {
+    enter(p, PWR_OFF, now);
+  } else if (p.state == PWR_ACTIVE && dimAfterS && idleS >= dimAfterS) {
+    enter(p, PWR_DIM, now);
+  }
+  if (now - p.stateSinceMs > 1000) account(p, now);
+  return p.state;
+}
+
+bool powerLogicFrameSent(PowerLogic& p, uint32_t now, uint32_t* latencyMs){
+  if (!p.wakePending) return false;
+  p.wakePending = false;
+  *latencyMs = now - p.wakeEdgeMs;
+  return true;
+}
+
+uint8_t powerLogicOnPct(const PowerLogic& p){
+  return p.totalMs ? (uint8_t)((uint64_t)p.activeMs * 100 / p.totalMs) : 100;
+}
+
+uint16_t powerLogicFrameMs(PowerState s, uint16_t activeFrameMs, uint16_t dimFrameMs){
+  return s == PWR_DIM ? dimFrameMs : activeFrameMs;
+}
+
+// ===== Idle =====
+PowerSleep powerSleepPlan(PowerState s, uint32_t idleMs, uint8_t holds){
+  PowerSleep plan = { POWER_SLEEP_WFI, 0 };
+  if (s != PWR_OFF || holds || idleMs < POWER_STOP_MIN_MS) return plan;
+  plan.mode = POWER_SLEEP_STOP;
+  plan.ms = idleMs - POWER_STOP_WAKE_MS;
+  return plan;
+}
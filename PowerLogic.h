@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Power states and sleep planning =====
+// Hardware-free part of the power manager (PowerManager.h applies it to the
+// panel and the kernel; tools/power_sim.cpp runs it on a simulated clock).
+//
+// ACTIVE -> (dimAfterS) -> DIM -> (offAfterS) -> OFF, timed from the last
+// input. A button edge while OFF, or a newly raised wake alarm while DIM or
+// OFF, returns to ACTIVE; the press that woke the panel is swallowed. The
+// time spent ACTIVE over all time gives the panel-on share, the edge to the
+// first frame after it the wake latency.
+//
+// The idle task asks powerSleepPlan() how to spend a stretch with every task
+// blocked: STOP (RTC alarm armed for the next task timeout, less the clock
+// restart) only while OFF, with no hold on and a stretch worth the restart;
+// otherwise WFI until the next tick.
+
+enum PowerState : uint8_t { PWR_ACTIVE, PWR_DIM, PWR_OFF };
+
+#ifndef POWER_SWALLOW_MS
+#define POWER_SWALLOW_MS 1000           // a press this soon after the wake edge only woke the panel
+#endif
+// Shortest idle stretch worth STOP (the restart costs POWER_STOP_WAKE_MS)
+#ifndef POWER_STOP_MIN_MS
+#define POWER_STOP_MIN_MS 20
+#endif
+// HSE + PLL restart after STOP, taken off the RTC alarm so tasks wake on time
+#ifndef POWER_STOP_WAKE_MS
+#define POWER_STOP_WAKE_MS 2
+#endif
+
+struct PowerLogic {
+  PowerState state;
+  uint32_t lastActivityMs;
+  uint32_t stateSinceMs;
+  uint32_t activeMs, totalMs;           // duty accounting
+  uint32_t wakeEdgeMs;                  // edge (or alarm) of the last wake
+  uint8_t alarms;                       // wake alarm bits seen last tick
+  bool wakePending;                     // waiting for the first frame
+  bool swallowNext;                     // the press that woke the panel
+};
+
+void powerLogicReset(PowerLogic& p, uint32_t now);
+
+// A button edge at edgeMs while OFF, seen by the UI at now
+void powerLogicWake(PowerLogic& p, uint32_t edgeMs, uint32_t now);
+
+// An input. True if it only woke the panel and should not be acted on.
+bool powerLogicActivity(PowerLogic& p, uint32_t now);
+
+// Timeouts and alarm wake (alarms: the wake alarm bits now). Returns the
+// state the panel should show.
+PowerState powerLogicTick(PowerLogic& p, uint32_t now, uint16_t dimAfterS, uint16_t offAfterS,
+                          uint8_t alarms);
+
+// A frame went out at now. True (and *latencyMs) for the first after a wake.
+bool powerLogicFrameSent(PowerLogic& p, uint32_t now, uint32_t* latencyMs);
+
+uint8_t powerLogicOnPct(const PowerLogic& p);   // % of the time ACTIVE
+uint16_t powerLogicFrameMs(PowerState s, uint16_t activeFrameMs, uint16_t dimFrameMs);
+
+// ----- Idle -----
+enum PowerSleepMode : uint8_t { POWER_SLEEP_WFI, POWER_SLEEP_STOP };
+
+// Peripherals whose clocks STOP would halt
+enum PowerHold : uint8_t {
+  POWER_HOLD_TACH = 0x01,               // fan tach capture timer (windows while OFF)
+};
+
+struct PowerSleep {
+  PowerSleepMode mode;
+  uint32_t ms;                          // STOP: RTC alarm after this long
+};
+
+// Every task blocked for idleMs (the kernel's expected idle time); holds:
+// peripherals that must keep running (POWER_HOLD_* bits)
+PowerSleep powerSleepPlan(PowerState s, uint32_t idleMs, uint8_t holds);
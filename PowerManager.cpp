@@ -0,0 +1,177 @@
+#include "PowerManager.h"
+#include "AppData.h"
+#include "Pins.h"
+#if POWER_STOP_MODE
+#include <STM32LowPower.h>
+#include <STM32RTC.h>
+#if configUSE_TICKLESS_IDLE != 2
+#error "POWER_STOP_MODE needs configUSE_TICKLESS_IDLE 2 in the FreeRTOS config (STOP from the idle task)"
+#endif
+#endif
+
+uint8_t  diagPanelOnPct = 100;
+uint16_t diagWakeLatencyMs = 0;
+
+static U8G2* disp = nullptr;
+static TaskHandle_t wakeTask = nullptr;
+static PowerLogic logic;                     // UI task only
+static volatile PowerState shown = PWR_ACTIVE;   // on the panel; read by the ISR and the idle hook
+static volatile uint8_t stopHolds = 0;
+
+// Wake bookkeeping (ISR -> UI task)
+static volatile bool wakeEdge = false;
+static volatile uint32_t wakeEdgeMs = 0;
+
+static const uint8_t WAKE_PINS[] = {BTN_UP, BTN_DOWN, BTN_ENTER, BTN_ESC};
+
+static void onButtonEdge(){
+  if (shown != PWR_OFF) return;
+  if (!wakeEdge) wakeEdgeMs = millis();
+  wakeEdge = true;
+  if (wakeTask) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(wakeTask, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+static void applyPanel(PowerState s){
+  switch (s) {
+    case PWR_ACTIVE:
+      disp->setPowerSave(0);                // GDDRAM still holds the last frame
+      disp->setContrast(POWER_CONTRAST_ACTIVE);
+      break;
+    case PWR_DIM:
+      disp->setPowerSave(0);
+      disp->setContrast(POWER_CONTRAST_DIM);
+      break;
+    case PWR_OFF:
+      disp->setPowerSave(1);
+      break;
+  }
+}
+
+// Bring the panel to the logic's state
+static void show(){
+  if (logic.state != shown) {
+    applyPanel(logic.state);
+    shown = logic.state;
+  }
+  diagPanelOnPct = powerLogicOnPct(logic);
+}
+
+void powerRestorePanel(){
+  if (disp) applyPanel(shown);
+}
+
+void powerInit(U8G2& display){
+  disp = &display;
+  powerLogicReset(logic, millis());
+  shown = PWR_ACTIVE;
+  disp->setContrast(POWER_CONTRAST_ACTIVE);
+#if POWER_STOP_MODE
+  STM32RTC::getInstance().begin();          // wake alarm and sleep time
+  LowPower.begin();
+  for (uint8_t i = 0; i < sizeof(WAKE_PINS); i++) {
+    LowPower.attachInterruptWakeup(WAKE_PINS[i], onButtonEdge, FALLING, DEEP_SLEEP_MODE);
+  }
+#else
+  for (uint8_t i = 0; i < sizeof(WAKE_PINS); i++) {
+    attachInterrupt(digitalPinToInterrupt(WAKE_PINS[i]), onButtonEdge, FALLING);
+  }
+#endif
+}
+
+void powerSetWakeTask(TaskHandle_t task){
+  wakeTask = task;
+}
+
+bool powerNoteActivity(unsigned long now){
+  if (!disp) return false;
+  if (wakeEdge) powerTick(now);             // the edge of this press
+  const bool swallow = powerLogicActivity(logic, now);
+  show();
+  return swallow;
+}
+
+void powerTick(unsigned long now){
+  if (!disp) return;
+  if (wakeEdge) {
+    wakeEdge = false;
+    powerLogicWake(logic, wakeEdgeMs, now);
+  } else {
+    powerLogicTick(logic, now, gLive.dimAfterS, gLive.offAfterS, alarmMask() & POWER_WAKE_ALARMS);
+  }
+  show();
+}
+
+PowerState powerState(){ return shown; }
+
+bool powerDisplayOn(){ return shown != PWR_OFF; }
+
+uint16_t powerFrameMs(uint16_t activeFrameMs){
+  return powerLogicFrameMs(shown, activeFrameMs, POWER_FRAME_MS_DIM);
+}
+
+void powerFrameSent(unsigned long now){
+  uint32_t lat;
+  if (powerLogicFrameSent(logic, now, &lat)) diagWakeLatencyMs = lat > 0xFFFF ? 0xFFFF : (uint16_t)lat;
+}
+
+void powerLoopDelay(TickType_t activeDelay){
+  switch (shown) {
+    case PWR_ACTIVE:
+      vTaskDelay(activeDelay);
+      break;
+    case PWR_DIM:
+      vTaskDelay(activeDelay * 4);          // buttons still feel responsive
+      break;
+    case PWR_OFF:
+      // Block until a button edge; the idle task sleeps (tickless, STOP
+      // with POWER_STOP_MODE) when the other tasks block too
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(POWER_OFF_SLICE_MS));
+      break;
+  }
+}
+
+void powerStopHold(uint8_t hold, bool on){
+  taskENTER_CRITICAL();
+  stopHolds = on ? (uint8_t)(stopHolds | hold) : (uint8_t)(stopHolds & ~hold);
+  taskEXIT_CRITICAL();
+}
+
+// ===== Tickless idle (POWER_STOP_MODE) =====
+#if POWER_STOP_MODE
+static uint32_t rtcMs(){
+  uint32_t sub = 0;
+  const uint32_t s = STM32RTC::getInstance().getEpoch(&sub);
+  return s * 1000 + sub;
+}
+
+// Called by the idle task, scheduler suspended, when every task is blocked
+// for `expected` ticks
+extern "C" void vPortSuppressTicksAndSleep(TickType_t expected){
+  const PowerSleep plan = powerSleepPlan(shown, expected * portTICK_PERIOD_MS, stopHolds);
+  if (plan.mode != POWER_SLEEP_STOP) {
+    __WFI();                                // the next tick or any interrupt ends it
+    return;
+  }
+  __disable_irq();
+  if (eTaskConfirmSleepModeStatus() == eAbortSleep) {   // a task got ready meanwhile
+    __enable_irq();
+    return;
+  }
+  SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+  const uint32_t t0 = rtcMs();
+  // RTC alarm or a button EXTI ends it (pending with interrupts masked);
+  // the library restores the system clock
+  LowPower.deepSleep(plan.ms);
+  TickType_t ticks = (rtcMs() - t0) / portTICK_PERIOD_MS;
+  if (ticks > expected) ticks = expected;
+  vTaskStepTick(ticks);
+  uwTick += ticks * portTICK_PERIOD_MS;     // millis() stood still too
+  SysTick->VAL = 0;
+  SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+  __enable_irq();                           // a button edge's ISR runs now
+}
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <STM32FreeRTOS.h>
+#include "PowerLogic.h"
+
+// ===== Power manager =====
+// ACTIVE -> (gLive.dimAfterS) -> DIM -> (gLive.offAfterS) -> OFF
+// (PowerLogic.h). DIM lowers SSD1306 contrast and frame rate; OFF powers
+// the panel down (its RAM keeps the last frame, so wake is instant) and
+// lets the UI task block until a button edge or POWER_OFF_SLICE_MS, so the
+// idle task can run tickless (configUSE_TICKLESS_IDLE in the FreeRTOS
+// config). A newly raised POWER_WAKE_ALARMS alarm wakes the panel too.
+//
+// With POWER_STOP_MODE=1 (needs configUSE_TICKLESS_IDLE 2) this file is the
+// kernel's tickless hook: when every task is blocked, the panel is OFF and
+// no powerStopHold() is on, the MCU enters STOP with the RTC alarm armed for
+// the next task timeout and the buttons as EXTI wake sources; the kernel
+// tick and millis() are stepped by the RTC time slept. Otherwise the idle
+// stretch is a WFI. No task ever enters STOP itself.
+
+#ifndef POWER_STOP_MODE
+#define POWER_STOP_MODE 0
+#endif
+#ifndef POWER_CONTRAST_ACTIVE
+#define POWER_CONTRAST_ACTIVE 255
+#endif
+#ifndef POWER_CONTRAST_DIM
+#define POWER_CONTRAST_DIM 8
+#endif
+#ifndef POWER_FRAME_MS_DIM
+#define POWER_FRAME_MS_DIM 200
+#endif
+// Longest single block while OFF (keeps the watchdog fed via the monitor)
+#ifndef POWER_OFF_SLICE_MS
+#define POWER_OFF_SLICE_MS 1000
+#endif
+// Alarms that wake the panel when raised (AppData.h ALARM_BIT_*). Door,
+// water, smoke and temperature are demo data in this tree and flip every
+// few seconds, so they are left out.
+#ifndef POWER_WAKE_ALARMS
+#define POWER_WAKE_ALARMS (ALARM_BIT_FANFAULT | ALARM_BIT_AVIATION)
+#endif
+
+// ----- Diagnostics -----
+extern uint8_t  diagPanelOnPct;     // % of uptime with the panel at full contrast
+extern uint16_t diagWakeLatencyMs;  // button edge -> first frame after last wake
+
+void powerInit(U8G2& display);
+
+// Task blocked while OFF; button edges notify it
+void powerSetWakeTask(TaskHandle_t task);
+
+// Call for every user input. Returns true if the input only woke the
+// panel and should not be acted on.
+bool powerNoteActivity(unsigned long now);
+
+// Run state transitions (call every UI loop)
+void powerTick(unsigned long now);
+
+PowerState powerState();
+bool powerDisplayOn();
+uint16_t powerFrameMs(uint16_t activeFrameMs);
+
+// Re-send the current state's power-save/contrast (after a panel re-init)
+void powerRestorePanel();
+
+// Call after a frame has been sent (measures wake-to-first-frame)
+void powerFrameSent(unsigned long now);
+
+// Replaces the fixed vTaskDelay in the UI task
+void powerLoopDelay(TickType_t activeDelay);
+
+// Keep the MCU out of STOP while a peripheral it would halt is in use
+// (hold: a PowerHold bit)
+void powerStopHold(uint8_t hold, bool on);
@@ -0,0 +1,254 @@
+#include "RemoteLink.h"
+#include <STM32FreeRTOS.h>
+#include "AppData.h"
+#include "AlarmLog.h"
+#include "FrameMirror.h"
+#include "HealthMonitor.h"
+#include "MenuUI.h"
+#include "Pins.h"
+#include "RemoteLinkLogic.h"
+#include "SerialWake.h"
+#include "StaticAlloc.h"
+
+#if !defined(USBD_USE_CDC) && defined(SERIAL_UART_INSTANCE) && SERIAL_UART_INSTANCE == 1
+#error "Serial is USART1 on this build: enable USB CDC or move REMOTE_RX_PIN / REMOTE_TX_PIN"
+#endif
+
+static TaskHandle_t linkHandle = nullptr;
+static const uint16_t LINK_STACK_WORDS = 384;
+static const UBaseType_t LINK_PRIORITY = tskIDLE_PRIORITY + 1;   // below UI
+static const TickType_t LINK_POLL = pdMS_TO_TICKS(2);           // frame open: its last edge may be missed
+TASK_MEM(link, LINK_STACK_WORDS);
+
+static HardwareSerial linkPort(REMOTE_RX_PIN, REMOTE_TX_PIN);
+static RemoteRx rx;
+
+static uint16_t teleEveryMs = 0;
+static uint32_t lastTeleMs = 0;
+
+static uint32_t lastMirrorMs = 0;
+
+static RemoteStats stats = {0, 0, 0, 0, 0};
+
+const RemoteStats& remoteStats(){
+  stats.framesOk = rx.framesOk;
+  stats.crcErrors = rx.crcErrors;
+  stats.overruns = rx.overruns;
+  return stats;
+}
+
+// ===== TX =====
+static void sendPayload(const uint8_t* p, uint16_t n){
+  static uint8_t frame[REMOTE_MAX_FRAME];
+  const uint16_t len = remoteFrame(p, n, frame);
+  if (len) linkPort.write(frame, len);
+}
+
+// Little-endian writers into a response buffer
+struct Writer {
+  uint8_t buf[REMOTE_MAX_PAYLOAD];
+  uint16_t n = 0;
+  bool ok = true;
+  void u8(uint8_t v)   { if (n + 1 > REMOTE_MAX_PAYLOAD) { ok = false; return; } buf[n++] = v; }
+  void u16(uint16_t v) { u8((uint8_t)v); u8((uint8_t)(v >> 8)); }
+  void u32(uint32_t v) { u16((uint16_t)v); u16((uint16_t)(v >> 16)); }
+  void f32(float v)    { uint32_t u; memcpy(&u, &v, 4); u32(u); }
+};
+
+static inline uint16_t rd16(const uint8_t* p){ return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const uint8_t* p){ return (uint32_t)rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+
+// ===== Commands =====
+static uint8_t cmdGetFields(const uint8_t* d, uint16_t n, Writer& w){
+  Settings snap;
+  taskENTER_CRITICAL();
+  snap = gLive;
+  taskEXIT_CRITICAL();
+  const uint16_t count = n ? n : (uint16_t)SF_COUNT;
+  for (uint16_t i = 0; i < count; i++) {
+    const uint8_t id = n ? d[i] : (uint8_t)i;
+    int32_t v;
+    if (!settingsGetField(snap, id, v)) return RSTATUS_BAD_VALUE;
+    w.u8(id);
+    w.u32((uint32_t)v);
+  }
+  return w.ok ? RSTATUS_OK : RSTATUS_BAD_LEN;
+}
+
+static uint8_t cmdSetFields(const uint8_t* d, uint16_t n, Writer& w){
+  if (n == 0 || n % 5) return RSTATUS_BAD_LEN;
+  if (!uiSettingsIdle()) return RSTATUS_BUSY;
+
+  Settings next;
+  taskENTER_CRITICAL();
+  next = gLive;
+  taskEXIT_CRITICAL();
+  for (uint16_t i = 0; i < n; i += 5) {
+    if (!settingsSetField(next, d[i], (int32_t)rd32(d + i + 1))) {
+      w.u8(d[i]);
+      return RSTATUS_BAD_VALUE;
+    }
+  }
+
+  // Commit through the staging API; the UI task cannot run in between
+  uint8_t st = RSTATUS_OK;
+  taskENTER_CRITICAL();
+  if (uiSettingsIdle()) {
+    stageBegin();
+    gStage = next;
+    stageApply();
+  } else {
+    st = RSTATUS_BUSY;
+  }
+  taskEXIT_CRITICAL();
+  return st;
+}
+
+static uint8_t cmdAlarmLog(const uint8_t* d, uint16_t n, Writer& w){
+  if (n != 3) return RSTATUS_BAD_LEN;
+  AlarmEvent ev[24];                         // 7 B each: fits REMOTE_MAX_PAYLOAD
+  uint8_t max = d[2];
+  if (max > sizeof(ev) / sizeof(ev[0])) max = sizeof(ev) / sizeof(ev[0]);
+  uint16_t next;
+  const uint8_t cnt = alarmLogRead(rd16(d), ev, max, &next);
+  w.u16(next);
+  w.u8(cnt);
+  for (uint8_t i = 0; i < cnt; i++) {
+    w.u16(ev[i].seq);
+    w.u32(ev[i].ms);
+    w.u8(ev[i].mask);
+  }
+  return RSTATUS_OK;
+}
+
+static void handleFrame(const uint8_t* p, uint16_t n){
+  if (n < 2) return;
+  const uint8_t cmd = p[0], seq = p[1];
+  const uint8_t* d = p + 2;
+  const uint16_t dn = (uint16_t)(n - 2);
+
+  Writer w;
+  w.u8((uint8_t)(cmd | 0x80));
+  w.u8(seq);
+  w.u8(RSTATUS_OK);                          // patched below
+
+  uint8_t st;
+  switch (cmd) {
+    case RCMD_PING:
+      w.u8(REMOTE_PROTO_VERSION);
+      w.u8(SF_COUNT);
+      st = RSTATUS_OK;
+      break;
+    case RCMD_GET_FIELDS: st = cmdGetFields(d, dn, w); break;
+    case RCMD_SET_FIELDS: st = cmdSetFields(d, dn, w); break;
+    case RCMD_SUBSCRIBE:
+      if (dn != 2) { st = RSTATUS_BAD_LEN; break; }
+      teleEveryMs = rd16(d);
+      if (teleEveryMs && teleEveryMs < REMOTE_MIN_PERIOD_MS) teleEveryMs = REMOTE_MIN_PERIOD_MS;
+      lastTeleMs = millis() - teleEveryMs;   // first sample right away
+      st = RSTATUS_OK;
+      break;
+    case RCMD_ALARM_LOG:  st = cmdAlarmLog(d, dn, w); break;
+    case RCMD_MIRROR:
+      if (dn != 1) { st = RSTATUS_BAD_LEN; break; }
+      frameMirrorEnable(d[0] != 0);
+      st = RSTATUS_OK;
+      break;
+    default:              st = RSTATUS_BAD_CMD; break;
+  }
+  if (st != RSTATUS_OK && st != RSTATUS_BAD_VALUE) w.n = 3;   // no data on error
+  w.buf[2] = st;
+  sendPayload(w.buf, w.n);
+}
+
+static void sendTelemetry(uint32_t now){
+  Writer w;
+  w.u8(RCMD_TELEMETRY);
+  w.u8(0);
+  w.u32(now);
+  w.f32(statusTempC);    w.f32(statusVinV);
+  w.f32(fan1Current_mA); w.f32(fan2Current_mA);
+  w.f32(fan1Power_W);    w.f32(fan2Power_W);
+  w.f32(fan1Run_m);      w.f32(fan2Run_m);
+  w.u8(alarmMask());
+  w.u8(Light_Condition ? 1 : 0);
+  sendPayload(w.buf, w.n);
+  stats.telemetrySent++;
+}
+
+static void sendMirror(){
+  static uint8_t pages[MIRROR_MAX_BYTES];
+  uint32_t crc;
+  uint16_t pb;
+  const uint8_t mask = frameMirrorTake(pages, &crc, &pb);
+  if (!mask || 3 + REMOTE_PACKBITS_MAX(pb) > REMOTE_MAX_PAYLOAD) return;
+  for (uint8_t p = 0; p < 8; p++) {
+    if (!(mask & (1u << p))) continue;
+    Writer w;
+    w.u8(RCMD_FRAME_PAGE);
+    w.u8(0);
+    w.u8(p);
+    w.n += remotePackBits(pages + p * pb, pb, w.buf + w.n);
+    sendPayload(w.buf, w.n);
+    stats.mirrorPages++;
+  }
+  Writer w;
+  w.u8(RCMD_FRAME_SYNC);
+  w.u8(0);
+  w.u32(crc);
+  sendPayload(w.buf, w.n);
+}
+
+// ===== Task =====
+// How long to sleep: until the next telemetry or mirror check, and with
+// neither on (no host subscribed) until a byte arrives
+static TickType_t nextWait(uint32_t now){
+  if (rx.len) return LINK_POLL;
+  uint32_t waitMs = UINT32_MAX;
+  if (teleEveryMs) {
+    const uint32_t since = now - lastTeleMs;
+    waitMs = since >= teleEveryMs ? 0 : teleEveryMs - since;
+  }
+  if (frameMirrorEnabled()) {
+    const uint32_t since = now - lastMirrorMs;
+    const uint32_t w = since >= REMOTE_MIRROR_MIN_MS ? 0 : REMOTE_MIRROR_MIN_MS - since;
+    if (w < waitMs) waitMs = w;
+  }
+  if (waitMs == UINT32_MAX) return portMAX_DELAY;
+  return waitMs ? pdMS_TO_TICKS(waitMs) + 1 : 1;
+}
+
+static void linkTask(void*){
+  serialWakeAttach(REMOTE_RX_PIN);
+  for (;;) {
+    // Drain everything that arrived, then sleep until there is work
+    int budget = 512;
+    while (linkPort.available() && budget--) {
+      const uint16_t n = remoteRxByte(rx, (uint8_t)linkPort.read());
+      if (n) handleFrame(rx.buf, n);
+    }
+
+    if (teleEveryMs) {
+      const uint32_t now = millis();
+      if (now - lastTeleMs >= teleEveryMs) {
+        lastTeleMs += teleEveryMs;
+        if (now - lastTeleMs >= teleEveryMs) lastTeleMs = now;   // fell behind
+        sendTelemetry(now);
+      }
+    }
+    if (frameMirrorEnabled() && millis() - lastMirrorMs >= REMOTE_MIRROR_MIN_MS) {
+      lastMirrorMs = millis();
+      sendMirror();
+    }
+    if (linkPort.available()) continue;      // budget ran out
+    serialWakeWait(REMOTE_RX_PIN, nextWait(millis()));
+  }
+}
+
+bool remoteStart(){
+  linkPort.begin(REMOTE_BAUD);
+  if (!TASK_START(linkTask, "LINK", link, LINK_STACK_WORDS,
+                  LINK_PRIORITY, &linkHandle)) return false;
+  healthRegisterTask(linkHandle, LINK_STACK_WORDS);
+  return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <Arduino.h>
+
+// ===== Remote settings / telemetry link =====
+// Binary request/response protocol on its own UART (REMOTE_RX_PIN /
+// REMOTE_TX_PIN in Pins.h, REMOTE_BAUD), served by its own low-priority task
+// so it never holds up the UI. Nothing else writes to that port. The task
+// sleeps on the RX start bit (SerialWake.h) and the next telemetry or
+// mirror slot; with no host subscribed it wakes only for received bytes.
+//
+// Framing (RemoteLinkLogic.h): 0x00, COBS(payload + CRC16-CCITT
+// little-endian), 0x00.
+// Request payload : [cmd][seq][data...]
+// Response payload: [cmd | 0x80][seq][status][data...]
+// Integers are little-endian.
+//
+//  cmd  name          request data                 response data
+//  0x01 PING          -                            [proto u8][fields u8]
+//  0x02 GET_FIELDS    [id]* (none = all)           ([id][value i32])*
+//  0x03 SET_FIELDS    ([id][value i32])+           - (status BAD_VALUE: [id])
+//  0x04 SUBSCRIBE     [period_ms u16] (0 = stop)   -
+//  0x05 ALARM_LOG     [from_seq u16][max u8]       [next_seq u16][n u8]
+//                                                  ([seq u16][ms u32][mask u8])*
+//  0x06 MIRROR        [on u8]                      -
+//  0x90 TELEMETRY     (unsolicited, seq = 0)       [ms u32][temp f32][vin f32]
+//                                                  [f1c f32][f2c f32][f1p f32]
+//                                                  [f2p f32][f1r f32][f2r f32]
+//                                                  [alarms u8][light u8]
+//  0x91 FRAME_PAGE    (unsolicited, seq = 0)       [page u8][PackBits page bytes]
+//  0x92 FRAME_SYNC    (unsolicited, seq = 0)       [crc32 of the whole frame]
+//
+// SET_FIELDS goes through the staging API and is all-or-nothing; it is
+// refused with STATUS_BUSY while someone is editing settings on the panel.
+//
+// MIRROR streams the panel framebuffer (FrameMirror.h): only pages that
+// changed, at most every REMOTE_MIRROR_MIN_MS, each burst closed by a
+// FRAME_SYNC whose CRC lets the host confirm it holds the same frame.
+
+enum RemoteCmd : uint8_t {
+  RCMD_PING = 0x01, RCMD_GET_FIELDS = 0x02, RCMD_SET_FIELDS = 0x03,
+  RCMD_SUBSCRIBE = 0x04, RCMD_ALARM_LOG = 0x05, RCMD_MIRROR = 0x06,
+  RCMD_TELEMETRY = 0x90, RCMD_FRAME_PAGE = 0x91, RCMD_FRAME_SYNC = 0x92
+};
+
+enum RemoteStatus : uint8_t {
+  RSTATUS_OK = 0, RSTATUS_BAD_CMD = 1, RSTATUS_BAD_LEN = 2,
+  RSTATUS_BAD_VALUE = 3, RSTATUS_BUSY = 4
+};
+
+#define REMOTE_PROTO_VERSION 1
+
+#ifndef REMOTE_BAUD
+#define REMOTE_BAUD 115200
+#endif
+#ifndef REMOTE_MIN_PERIOD_MS
+#define REMOTE_MIN_PERIOD_MS 20        // fastest telemetry stream
+#endif
+#ifndef REMOTE_MIRROR_MIN_MS
+#define REMOTE_MIRROR_MIN_MS 100       // fastest framebuffer mirror updates
+#endif
+
+struct RemoteStats {
+  uint32_t framesOk;
+  uint32_t crcErrors;
+  uint32_t overruns;
+  uint32_t telemetrySent;
+  uint32_t mirrorPages;
+};
+const RemoteStats& remoteStats();
+
+// Create the link task; call before the scheduler starts
+bool remoteStart();
@@ -0,0 +1,110 @@
+#include "RemoteLinkLogic.h"
+#include <string.h>
+#include "Crc.h"
+
+// ===== COBS =====
+uint16_t remoteCobsEncode(const uint8_t* in, uint16_t n, uint8_t* out){
+  uint16_t w = 1, code = 0;
+  uint8_t run = 1;
+  for (uint16_t i = 0; i < n; i++) {
+    if (in[i] == 0) {
+      out[code] = run; code = w++; run = 1;
+    } else {
+      out[w++] = in[i];
+      if (++run == 0xFF) { out[code] = run; code = w++; run = 1; }
+    }
+  }
+  out[code] = run;
+  return w;
+}
+
+uint16_t remoteCobsDecode(uint8_t* buf, uint16_t n){
+  uint16_t r = 0, w = 0;
+  while (r < n) {
+    const uint8_t code = buf[r++];
+    if (code == 0 || r + code - 1 > n) return 0;
+    for (uint8_t i = 1; i < code; i++) buf[w++] = buf[r++];
+    if (code != 0xFF && r < n) buf[w++] = 0;
+  }
+  return w;
+}
+
+// ===== PackBits =====
+uint16_t remotePackBits(const uint8_t* in, uint16_t n, uint8_t* out){
+  uint16_t r = 0, w = 0;
+  while (r < n) {
+    uint16_t run = 1;
+    while (r + run < n && run < 128 && in[r + run] == in[r]) run++;
+    if (run >= 2) {
+      out[w++] = (uint8_t)(257 - run);
+      out[w++] = in[r];
+      r += run;
+      continue;
+    }
+    uint16_t lit = 1;
+    while (r + lit < n && lit < 128 && !(r + lit + 1 < n && in[r + lit] == in[r + lit + 1])) lit++;
+    out[w++] = (uint8_t)(lit - 1);
+    memcpy(out + w, in + r, lit);
+    w += lit;
+    r += lit;
+  }
+  return w;
+}
+
+uint16_t remoteUnpackBits(const uint8_t* in, uint16_t n, uint8_t* out, uint16_t outMax){
+  uint16_t r = 0, w = 0;
+  while (r < n) {
+    const uint8_t h = in[r++];
+    if (h < 128) {
+      const uint16_t lit = (uint16_t)(h + 1);
+      if (r + lit > n || w + lit > outMax) return 0;
+      memcpy(out + w, in + r, lit);
+      r += lit;
+      w += lit;
+    } else if (h > 128) {
+      const uint16_t run = (uint16_t)(257 - h);
+      if (r >= n || w + run > outMax) return 0;
+      memset(out + w, in[r++], run);
+      w += run;
+    }                                              // 128: no-op
+  }
+  return w;
+}
+
+// ===== Frames =====
+uint16_t remoteFrame(const uint8_t* payload, uint16_t n, uint8_t* out){
+  static uint8_t raw[REMOTE_MAX_PAYLOAD + 2];    // off the LINK task's stack
+  if (n > REMOTE_MAX_PAYLOAD) return 0;
+  memcpy(raw, payload, n);
+  const uint16_t crc = crc16Ccitt(payload, n);
+  raw[n] = (uint8_t)crc;
+  raw[n + 1] = (uint8_t)(crc >> 8);
+  out[0] = 0;
+  const uint16_t len = remoteCobsEncode(raw, (uint16_t)(n + 2), out + 1);
+  out[len + 1] = 0;
+  return (uint16_t)(len + 2);
+}
+
+uint16_t remoteRxByte(RemoteRx& rx, uint8_t b){
+  if (b != 0) {
+    if (rx.len < sizeof(rx.buf)) rx.buf[rx.len++] = b;
+    else rx.overrun = true;
+    return 0;
+  }
+  // Delimiter: decode what we have (nothing between two delimiters)
+  uint16_t payload = 0;
+  if (rx.overrun) {
+    rx.overruns++;
+  } else if (rx.len) {
+    const uint16_t n = remoteCobsDecode(rx.buf, rx.len);
+    if (n >= 4 && crc16Ccitt(rx.buf, n - 2) == (uint16_t)(rx.buf[n - 2] | (rx.buf[n - 1] << 8))) {
+      rx.framesOk++;
+      payload = (uint16_t)(n - 2);
+    } else {
+      rx.crcErrors++;
+    }
+  }
+  rx.len = 0;
+  rx.overrun = false;
+  return payload;
+}
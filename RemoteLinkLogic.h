@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Remote link framing =====
+// Hardware-free part of the remote link (RemoteLink.h runs it on its UART;
+// tools/remote_link_sim.cpp runs it over a pty pair).
+//
+// On the wire a frame is 0x00, COBS(payload + CRC16-CCITT little-endian),
+// 0x00. The leading delimiter ends whatever the receiver held (line noise,
+// a frame cut short by a reset) so the frame after it is never merged into
+// garbage; back-to-back frames simply see an empty frame in between, which
+// is skipped.
+
+#define REMOTE_MAX_PAYLOAD 240
+// Delimiter + COBS(payload + CRC) + delimiter
+#define REMOTE_MAX_FRAME (1 + REMOTE_MAX_PAYLOAD + 2 + REMOTE_MAX_PAYLOAD / 254 + 1 + 1)
+
+uint16_t remoteCobsEncode(const uint8_t* in, uint16_t n, uint8_t* out);
+// In place (output never overtakes input); returns decoded length, 0 = malformed
+uint16_t remoteCobsDecode(uint8_t* buf, uint16_t n);
+
+// Frame a payload into out (REMOTE_MAX_FRAME bytes). Returns the length,
+// 0 if the payload is longer than REMOTE_MAX_PAYLOAD.
+uint16_t remoteFrame(const uint8_t* payload, uint16_t n, uint8_t* out);
+
+// PackBits (frame mirror pages): [k 0..127] + k+1 literal bytes, or
+// [257-run] + byte for runs 2..128. A literal never swallows a repeated
+// pair, so the worst case is one header per three bytes ("AAB AAB ...").
+#define REMOTE_PACKBITS_MAX(n) ((n) + ((n) + 2) / 3)
+
+// Pack n bytes into out (REMOTE_PACKBITS_MAX(n) bytes); returns the length
+uint16_t remotePackBits(const uint8_t* in, uint16_t n, uint8_t* out);
+// Unpack into out (at most outMax bytes); returns the length, 0 if the
+// input is truncated or would overflow out
+uint16_t remoteUnpackBits(const uint8_t* in, uint16_t n, uint8_t* out, uint16_t outMax);
+
+struct RemoteRx {
+  uint8_t buf[REMOTE_MAX_FRAME];
+  uint16_t len;
+  bool overrun;
+  uint32_t framesOk, crcErrors, overruns;
+};
+
+// Feed one received byte. Returns the payload length (without the CRC,
+// payload in rx.buf) when a delimiter closed a good frame, else 0.
+uint16_t remoteRxByte(RemoteRx& rx, uint8_t b);
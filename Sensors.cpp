@@ -0,0 +1,66 @@
+#include "Sensors.h"
+#include <math.h>
+#include "AviationLight.h"
+#include "Pins.h"
+#include "UiTrace.h"
+
+static_assert(CAL_ADC_BITS == AVI_ADC_BITS, "one ADC resolution for all inputs");
+
+static int32_t ntcPoints[CAL_LUT_POINTS], vinPoints[2];
+static CalLut ntcLut, vinLut;
+static int16_t builtGain, builtVinOffset, builtNtcOffset;   // trims in the tables
+static bool built = false;
+static bool valid = false;
+static unsigned long lastSampleMs = 0;
+
+static float gainOf(int16_t trim){ return 1.0f + trim / 10000.0f; }
+
+static void rebuild(){
+  const int16_t gain = gLive.vinGainTrim, vinOffset = gLive.vinOffsetMv, ntcOffset = gLive.ntcOffsetDc;
+  if (built && gain == builtGain && vinOffset == builtVinOffset && ntcOffset == builtNtcOffset) return;
+  const int32_t fullMv = (int32_t)(SENSOR_VREF_MV * SENSOR_VIN_DIVIDER);
+  vinLut = calBuildLinear(vinPoints, vinOffset, (int32_t)lroundf(fullMv * gainOf(gain)) + vinOffset);
+  if (!built || ntcOffset != builtNtcOffset) ntcLut = calBuildNtc(ntcPoints, CAL_LUT_POINTS, ntcOffset * 10L);
+  builtGain = gain;
+  builtVinOffset = vinOffset;
+  builtNtcOffset = ntcOffset;
+  built = true;
+}
+
+static int32_t readBlock(uint32_t pin, const CalLut& lut){
+  uint16_t raw[SENSOR_BLOCK];
+  for (uint8_t i = 0; i < SENSOR_BLOCK; i++) raw[i] = (uint16_t)analogRead(pin);
+  return calLutMean(lut, raw, SENSOR_BLOCK);
+}
+
+void sensorsSample(unsigned long now){
+#if STATUS_SENSORS
+  if (valid && now - lastSampleMs < SENSOR_PERIOD_MS) return;
+  lastSampleMs = now;
+  rebuild();
+  const int32_t cc = readBlock(SENSOR_NTC_PIN, ntcLut);
+  const int32_t mv = readBlock(SENSOR_VIN_PIN, vinLut);
+  valid = true;
+  // A trace replay scripts these itself
+  if (traceReplaying()) return;
+  statusTempC = cc / 100.0f;
+  statusVinV = mv / 1000.0f;
+#else
+  (void)now;
+#endif
+}
+
+bool sensorsCalibrateVin(float refV, Settings& s){
+  if (!valid || traceReplaying()) return false;
+  // reading = nominal * gain + offset, with the trims of the last build
+  const float nominalMv = (statusVinV * 1000.0f - builtVinOffset) / gainOf(builtGain);
+  if (nominalMv < 100.0f) return false;                  // nothing connected
+  const long trim = lroundf(((refV * 1000.0f - s.vinOffsetMv) / nominalMv - 1.0f) * 10000.0f);
+  return settingsSetField(s, SF_VIN_GAIN, trim);
+}
+
+bool sensorsCalibrateTemp(float refC, Settings& s){
+  if (!valid || traceReplaying()) return false;
+  const float raw = statusTempC - builtNtcOffset / 10.0f;
+  return settingsSetField(s, SF_NTC_OFFSET, lroundf((refC - raw) * 10.0f));
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+#include "AppData.h"
+#include "CalibLogic.h"
+
+// ===== Status sensors =====
+// Enclosure temperature (NTC) and supply voltage (divider) on the Pins.h
+// inputs. Every SENSOR_PERIOD_MS the aviation task - the only task that
+// uses the ADC, so analogRead calls never interleave - reads a block of
+// SENSOR_BLOCK codes per input and converts it through the CalibLogic.h
+// tables; the block means become statusTempC and statusVinV.
+//
+// The per-unit trims (Settings: vinGainTrim, vinOffsetMv, ntcOffsetDc) are
+// folded into the tables, which are rebuilt when gLive changes them. The
+// Calibration menu derives them from a reference reading.
+
+#ifndef STATUS_SENSORS
+#define STATUS_SENSORS 1                // 0: demo data fakes temperature and voltage
+#endif
+#ifndef SENSOR_PERIOD_MS
+#define SENSOR_PERIOD_MS 500UL
+#endif
+#ifndef SENSOR_BLOCK
+#define SENSOR_BLOCK 16                 // codes averaged per reading
+#endif
+#ifndef SENSOR_VREF_MV
+#define SENSOR_VREF_MV 3300UL
+#endif
+#ifndef SENSOR_VIN_DIVIDER
+#define SENSOR_VIN_DIVIDER 11UL         // (R top + R bottom) / R bottom
+#endif
+
+// Sample when due; called by the aviation task every cycle
+void sensorsSample(unsigned long now);
+
+// Trims that make the current reading equal a reference measurement,
+// written into s (normally gStage). False before the first reading or
+// when the trim would be out of range.
+bool sensorsCalibrateVin(float refV, Settings& s);
+bool sensorsCalibrateTemp(float refC, Settings& s);
@@ -0,0 +1,55 @@
+#include "SerialWake.h"
+#include "stm32yyxx_ll_exti.h"
+
+struct WakeLine {
+  uint32_t pin;
+  uint32_t mask;                      // EXTI line = GPIO pin number
+  volatile TaskHandle_t task;
+};
+static WakeLine lines[SERIAL_WAKE_PORTS];
+
+template<uint8_t I>
+static void onStartBit(){
+  LL_EXTI_DisableIT_0_31(lines[I].mask);        // one wake-up per burst
+  if (!lines[I].task) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(lines[I].task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+static_assert(SERIAL_WAKE_PORTS == 2, "one onStartBit<> per port");
+static void (*const EDGE_ISR[SERIAL_WAKE_PORTS])() = { onStartBit<0>, onStartBit<1> };
+
+static int8_t slotOf(uint32_t pin){
+  for (uint8_t i = 0; i < SERIAL_WAKE_PORTS; i++) {
+    if (lines[i].task && lines[i].pin == pin) return (int8_t)i;
+  }
+  return -1;
+}
+
+bool serialWakeAttach(uint32_t rxPin){
+  int8_t i = slotOf(rxPin);
+  for (uint8_t k = 0; i < 0 && k < SERIAL_WAKE_PORTS; k++) {
+    if (!lines[k].task) i = (int8_t)k;
+  }
+  if (i < 0) return false;
+  const PinName pn = digitalPinToPinName(rxPin);
+  lines[i].pin = rxPin;
+  lines[i].mask = digitalPinToBitMask(rxPin);
+  lines[i].task = xTaskGetCurrentTaskHandle();
+  // attachInterrupt() makes the pin a GPIO input; hand it back to the UART
+  attachInterrupt(digitalPinToInterrupt(rxPin), EDGE_ISR[i], FALLING);
+  LL_EXTI_DisableIT_0_31(lines[i].mask);        // armed by the first wait
+  pinmap_pinout(pn, PinMap_UART_RX);
+  return true;
+}
+
+void serialWakeWait(uint32_t rxPin, TickType_t ticks){
+  const int8_t i = slotOf(rxPin);
+  if (i < 0) {
+    vTaskDelay(ticks == portMAX_DELAY ? 1 : ticks);
+    return;
+  }
+  LL_EXTI_EnableIT_0_31(lines[i].mask);
+  ulTaskNotifyTake(pdTRUE, ticks);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <Arduino.h>
+#include <STM32FreeRTOS.h>
+
+// ===== Serial receive wake-up =====
+// HardwareSerial has no receive hook a task can block on, so the task that
+// owns a port sleeps on a notification from an EXTI on its RX pin: the
+// falling edge of a start bit. The pin keeps its UART function (the EXTI
+// taps the input path). The first edge masks the line again - a byte has
+// up to five falling edges - and serialWakeWait() unmasks it, so a burst
+// costs one wake-up.
+//
+// The edge of a byte that started before the wait is not seen again:
+// while a frame is open, wait no longer than the frame's idle gap.
+//
+// The line is an EXTI wake source from STOP (POWER_STOP_MODE); the UART
+// itself is halted there, so the byte that wakes the MCU is lost and the
+// peer's retry is served.
+//
+// RX pins need EXTI lines of their own (the button lines are in use).
+
+#ifndef SERIAL_WAKE_PORTS
+#define SERIAL_WAKE_PORTS 2
+#endif
+
+// Bind rxPin's start-bit edge to the calling task. Call after every
+// begin() of the port (begin() sets the pin up again).
+bool serialWakeAttach(uint32_t rxPin);
+
+// Block the calling task until a start bit on rxPin, another notification
+// or `ticks` (portMAX_DELAY: no timeout)
+void serialWakeWait(uint32_t rxPin, TickType_t ticks);
+
+// Ticks to block for at least us (one more: the current tick is partial)
+inline TickType_t serialWakeTicks(uint32_t us){
+  return (TickType_t)((us + portTICK_PERIOD_MS * 1000UL - 1) / (portTICK_PERIOD_MS * 1000UL)) + 1;
+}
@@ -0,0 +1,64 @@
+// Settings field access by id (AppData.h); no hardware, so the host tools
+// (tools/field_edit_replay.cpp) link it as is.
+#include "AppData.h"
+#include "ModbusLogic.h"
+#include <string.h>
+#include <stddef.h>
+
+// ====== field table (same limits as the menu) ======
+struct FieldDesc {
+  uint8_t offset;
+  uint8_t size;
+  bool    isSigned;
+  int32_t lo, hi;
+};
+
+#define FD(member, lo, hi) { offsetof(Settings, member), sizeof(((Settings*)0)->member), \
+  (decltype(((Settings*)0)->member))(-1) < 0, lo, hi }
+
+static const FieldDesc FIELDS[SF_COUNT] = {
+  FD(tempThrL, -40, 125),      FD(tempThrH, -40, 125),     FD(tempHighThr, -40, 125),
+  FD(togglePeriodMs, 0, 100),  FD(fanProfile, PROF_AUTO, PROF_NORMAL),
+  FD(fan1Model, MODEL_KRUBO, MODEL_CUSTOM), FD(fan2Model, MODEL_KRUBO, MODEL_CUSTOM),
+  FD(fan1nominal, 0, 10000),   FD(fan2nominal, 0, 10000),  FD(fanCurrentUnit, UNIT_mA, UNIT_A),
+  FD(voltLThrV, 0, 300),       FD(voltHighThrV, 0, 300),   FD(LDRThreshold, 1, 247),
+  FD(dimAfterS, 0, 3600),      FD(offAfterS, 0, 7200),
+  FD(baudrate, 9600, 115200),  FD(slaveID, 1, 247),
+  FD(dashRotateS, 0, 600),
+  FD(vinGainTrim, -2000, 2000), FD(vinOffsetMv, -2000, 2000), FD(ntcOffsetDc, -100, 100),
+  FD(modbusMaster, 0, 1),      FD(modbusNodes, 0, MB_MAX_NODES),
+};
+
+bool settingsGetField(const Settings& s, uint8_t id, int32_t& out) {
+  if (id >= SF_COUNT) return false;
+  const FieldDesc& f = FIELDS[id];
+  const uint8_t* p = (const uint8_t*)&s + f.offset;
+  switch (f.size) {
+    case 1: out = f.isSigned ? (int32_t)*(const int8_t*)p  : (int32_t)*p; break;
+    case 2: { int16_t v; memcpy(&v, p, 2); out = f.isSigned ? v : (int32_t)(uint16_t)v; break; }
+    case 4: memcpy(&out, p, 4); break;
+    default: { int64_t v; memcpy(&v, p, 8); out = (int32_t)v; break; }
+  }
+  return true;
+}
+
+bool settingsFieldRange(uint8_t id, int32_t& lo, int32_t& hi) {
+  if (id >= SF_COUNT) return false;
+  lo = FIELDS[id].lo;
+  hi = FIELDS[id].hi;
+  return true;
+}
+
+bool settingsSetField(Settings& s, uint8_t id, int32_t value) {
+  if (id >= SF_COUNT) return false;
+  const FieldDesc& f = FIELDS[id];
+  if (value < f.lo || value > f.hi) return false;
+  uint8_t* p = (uint8_t*)&s + f.offset;
+  switch (f.size) {
+    case 1: *p = (uint8_t)value; break;
+    case 2: { int16_t v = (int16_t)value; memcpy(p, &v, 2); break; }
+    case 4: memcpy(p, &value, 4); break;
+    default: { int64_t v = value; memcpy(p, &v, 8); break; }
+  }
+  return true;
+}
@@ -0,0 +1,97 @@
+#include "Sparkline.h"
+#include <string.h>
+
+Sparkline::Sparkline(U8G2& display, int16_t x, int16_t y, uint8_t w, uint8_t h)
+  : u8g2_(display), x_(x), y_(y),
+    w_(w > SPARKLINE_MAX_W ? SPARKLINE_MAX_W : w), h_(h) {
+  memset(col_, 0xFF, sizeof(col_));
+}
+
+void Sparkline::bind(HistChannel ch, HistRes res) {
+  if (ch == ch_ && res == res_ && valid_) return;
+  ch_ = ch;
+  res_ = res;
+  valid_ = false;
+}
+
+uint8_t Sparkline::toRow(int16_t v) const {
+  // row 0 = top (hi_), row h-1 = bottom (lo_)
+  int32_t span = (int32_t)hi_ - lo_;
+  int32_t r = ((int32_t)(hi_ - v) * (h_ - 1) + span / 2) / span;
+  if (r < 0) r = 0;
+  if (r > h_ - 1) r = h_ - 1;
+  return (uint8_t)r;
+}
+
+void Sparkline::rebuild() {
+  const uint8_t cnt = historyCount(res_);
+  const uint8_t n = cnt < w_ ? cnt : w_;
+  HistBucket b;
+
+  // Scale from the min/max of everything that will be on screen
+  int16_t lo = 32767, hi = -32768;
+  for (uint8_t age = 0; age < n; age++) {
+    historyGet(ch_, res_, age, b);
+    if (b.min < lo) lo = b.min;
+    if (b.max > hi) hi = b.max;
+  }
+  if (n == 0) { lo = 0; hi = 1; }
+  // Pad so a flat trace sits mid-plot and small ripple isn't full height
+  int32_t pad = ((int32_t)hi - lo) / 8;
+  if (pad < 2) pad = 2;
+  const int32_t l = (int32_t)lo - pad, h = (int32_t)hi + pad;
+  lo_ = (int16_t)(l < -32768 ? -32768 : l);
+  hi_ = (int16_t)(h >  32767 ?  32767 : h);
+
+  memset(col_, 0xFF, sizeof(col_));
+  for (uint8_t age = 0; age < n; age++) {
+    historyGet(ch_, res_, age, b);
+    col_[w_ - 1 - age] = toRow(b.avg);
+  }
+  used_ = n;
+  gen_ = historyGeneration(res_);
+  valid_ = true;
+}
+
+void Sparkline::draw() {
+  const uint32_t gen = historyGeneration(res_);
+  const uint32_t added = gen - gen_;
+
+  if (!valid_ || added >= w_) {
+    rebuild();
+  } else if (added > 0) {
+    // Shift the plot left by the new samples; rescale only if they don't fit,
+    // or once per full window so the scale can shrink again.
+    HistBucket fresh[SPARKLINE_MAX_W];
+    bool fits = true;
+    for (uint8_t i = 0; i < added; i++) {
+      historyGet(ch_, res_, (uint8_t)(added - 1 - i), fresh[i]);
+      if (fresh[i].avg < lo_ || fresh[i].avg > hi_) fits = false;
+    }
+    const bool windowWrapped = (gen / w_) != (gen_ / w_);
+    if (!fits || windowWrapped) {
+      rebuild();
+    } else {
+      memmove(col_, col_ + added, w_ - added);
+      for (uint8_t i = 0; i < added; i++) col_[w_ - added + i] = toRow(fresh[i].avg);
+      used_ = (used_ + added > w_) ? w_ : (uint8_t)(used_ + added);
+      gen_ = gen;
+    }
+  }
+
+  // Connected trace: vertical span between neighbouring columns
+  uint8_t prev = 0xFF;
+  for (uint8_t i = w_ - used_; i < w_; i++) {
+    const uint8_t r = col_[i];
+    if (r == 0xFF) { prev = 0xFF; continue; }
+    if (prev == 0xFF || prev == r) {
+      u8g2_.drawPixel(x_ + i, y_ + r);
+    } else {
+      const uint8_t top = prev < r ? prev : r;
+      const uint8_t bot = prev < r ? r : prev;
+      u8g2_.drawVLine(x_ + i, y_ + top, bot - top + 1);
+    }
+    prev = r;
+  }
+  u8g2_.drawHLine(x_, y_ + h_, w_);   // baseline
+}
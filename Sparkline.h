@@ -0,0 +1,46 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "History.h"
+
+#ifndef SPARKLINE_MAX_W
+#define SPARKLINE_MAX_W 64
+#endif
+
+class Sparkline {
+public:
+  Sparkline(U8G2& display, int16_t x, int16_t y, uint8_t w, uint8_t h);
+
+  // Select the channel/resolution to plot (forces a full rebuild)
+  void bind(HistChannel ch, HistRes res);
+
+  // Move the plot (the column cache is position independent)
+  void moveTo(int16_t x, int16_t y) { x_ = x; y_ = y; }
+
+  /**
+   * Draw into the CURRENT U8g2 buffer.
+   * The column cache is only shifted by the number of new samples since the
+   * last call; a full rescale happens only when a value leaves the scale.
+   */
+  void draw();
+
+  // Current scale in channel units (valid after draw())
+  float lo() const { return lo_ / historyScale(ch_); }
+  float hi() const { return hi_ / historyScale(ch_); }
+
+private:
+  void rebuild();
+  uint8_t toRow(int16_t v) const;
+
+  U8G2& u8g2_;
+  int16_t x_, y_;
+  uint8_t w_, h_;
+  HistChannel ch_ = HIST_TEMP;
+  HistRes res_ = HIST_SEC;
+
+  uint8_t col_[SPARKLINE_MAX_W];   // row per column, 0xFF = no data
+  uint8_t used_ = 0;               // valid columns (right-aligned)
+  uint32_t gen_ = 0;
+  int16_t lo_ = 0, hi_ = 0;
+  bool valid_ = false;
+};
@@ -0,0 +1,65 @@
+#include "StaticAlloc.h"
+#if STATIC_ALLOC
+#include <stdlib.h>
+#include <reent.h>
+#endif
+
+bool taskStart(TaskFunction_t fn, const char* name, uint16_t words, UBaseType_t prio,
+               StackType_t* stack, StaticTask_t* tcb, TaskHandle_t* out){
+#if STATIC_ALLOC
+  *out = xTaskCreateStatic(fn, name, words, nullptr, prio, stack, tcb);
+  return *out != nullptr;
+#else
+  (void)stack; (void)tcb;
+  return xTaskCreate(fn, name, words, nullptr, prio, out) == pdPASS;
+#endif
+}
+
+// ===== Heap guard =====
+static volatile bool heapLocked = false;
+static volatile uint32_t allocCount = 0;
+static volatile uint32_t allocBytes = 0;
+
+void heapLock(){ heapLocked = true; }
+uint32_t heapAllocCount(){ return allocCount; }
+uint32_t heapAllocBytes(){ return allocBytes; }
+
+#if STATIC_ALLOC
+// Kernel-owned tasks need memory too once the heap is gone
+extern "C" void vApplicationGetIdleTaskMemory(StaticTask_t** tcb, StackType_t** stack, uint32_t* words){
+  static StaticTask_t idleTcb;
+  static StackType_t idleStack[configMINIMAL_STACK_SIZE];
+  *tcb = &idleTcb;
+  *stack = idleStack;
+  *words = configMINIMAL_STACK_SIZE;
+}
+
+#if configUSE_TIMERS
+extern "C" void vApplicationGetTimerTaskMemory(StaticTask_t** tcb, StackType_t** stack, uint32_t* words){
+  static StaticTask_t timerTcb;
+  static StackType_t timerStack[configTIMER_TASK_STACK_DEPTH];
+  *tcb = &timerTcb;
+  *stack = timerStack;
+  *words = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+static void noteAlloc(size_t n){
+  allocCount++;
+  allocBytes += n;
+  if (heapLocked) {
+    // Runtime allocation: stop here; the watchdog reset is logged at boot
+    taskDISABLE_INTERRUPTS();
+    for (;;) {}
+  }
+}
+
+// The C entry points; newlib's reentrant allocator still does the work.
+// operator new and the FreeRTOS newlib heap both come through here.
+extern "C" {
+void* malloc(size_t n){ noteAlloc(n); return _malloc_r(_REENT, n); }
+void* calloc(size_t n, size_t size){ noteAlloc(n * size); return _calloc_r(_REENT, n, size); }
+void* realloc(void* p, size_t n){ noteAlloc(n); return _realloc_r(_REENT, p, n); }
+void free(void* p){ _free_r(_REENT, p); }
+}
+#endif
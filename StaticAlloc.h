@@ -0,0 +1,71 @@
+#pragma once
+#include <Arduino.h>
+#include <STM32FreeRTOS.h>
+
+// ===== Static allocation mode =====
+// STATIC_ALLOC=1 builds the firmware without a runtime heap:
+//  - every task is created with xTaskCreateStatic from TASK_MEM storage
+//    (needs configSUPPORT_STATIC_ALLOCATION 1 in the FreeRTOS config),
+//  - malloc/calloc/realloc/free (and so operator new and pvPortMalloc) are
+//    counted; after heapLock() any allocation halts the MCU and the
+//    watchdog reset shows up in the boot log.
+// Library objects the UI owns live in one UI_ARENA block either way.
+//
+// STATIC_ALLOC_REPORT=1 prints the size of each STATIC_SIZE_REPORT() item
+// as a compiler warning ("staticSizeReport() [with Bytes = N] is deprecated").
+
+#ifndef STATIC_ALLOC
+#define STATIC_ALLOC 0
+#endif
+#ifndef STATIC_ALLOC_REPORT
+#define STATIC_ALLOC_REPORT 0
+#endif
+
+#if STATIC_ALLOC && !configSUPPORT_STATIC_ALLOCATION
+#error "STATIC_ALLOC needs configSUPPORT_STATIC_ALLOCATION 1 in the FreeRTOS config"
+#endif
+
+// ----- Tasks -----
+// TASK_MEM(link, LINK_STACK_WORDS);   -> linkStack[], linkTcb
+// TASK_START(linkTask, "LINK", link, LINK_STACK_WORDS, prio, &handle)
+#if STATIC_ALLOC
+#define TASK_MEM(mem, words) \
+  static StackType_t mem##Stack[words]; \
+  static StaticTask_t mem##Tcb
+#define TASK_START(fn, name, mem, words, prio, out) \
+  taskStart(fn, name, words, prio, mem##Stack, &mem##Tcb, out)
+#else
+#define TASK_MEM(mem, words) static_assert((words) > 0, "stack words")
+#define TASK_START(fn, name, mem, words, prio, out) \
+  taskStart(fn, name, words, prio, nullptr, nullptr, out)
+#endif
+
+// xTaskCreateStatic with the given stack/TCB, or xTaskCreate when they are null
+bool taskStart(TaskFunction_t fn, const char* name, uint16_t words, UBaseType_t prio,
+               StackType_t* stack, StaticTask_t* tcb, TaskHandle_t* out);
+
+// ----- UI arena -----
+// One zero-initialised block the linker can place on its own (map file
+// symbol in UI_ARENA_SECTION); the section must be cleared at startup.
+#ifndef UI_ARENA_SECTION
+#define UI_ARENA_SECTION ".bss.ui_arena"
+#endif
+#ifndef UI_ARENA_BYTES
+#define UI_ARENA_BYTES 3072
+#endif
+#define UI_ARENA __attribute__((section(UI_ARENA_SECTION), aligned(8)))
+
+// ----- Size report -----
+#if STATIC_ALLOC_REPORT
+template<unsigned long Bytes>
+[[deprecated("static allocation size report")]] constexpr bool staticSizeReport(){ return true; }
+#define STATIC_SIZE_REPORT(what) static_assert(staticSizeReport<sizeof(what)>(), #what)
+#else
+#define STATIC_SIZE_REPORT(what) static_assert(sizeof(what) > 0, #what)
+#endif
+
+// ----- Heap guard -----
+// Allow setup-time allocations (e.g. Wire buffers) and trap everything after
+void heapLock();
+uint32_t heapAllocCount();     // allocations seen so far (0 without STATIC_ALLOC)
+uint32_t heapAllocBytes();
@@ -0,0 +1,77 @@
+#include "Storage.h"
+#include <EEPROM.h>
+#include <STM32FreeRTOS.h>
+#include "Crc.h"
+#include "StaticAlloc.h"
+
+static const uint8_t RECORD_MAGIC = 0xA5;
+static const uint8_t HEADER_BYTES = 4;
+
+struct SlotDef {
+  uint16_t offset;     // byte address of the header
+  uint8_t capacity;    // max data bytes
+};
+
+// Append new slots at the end so existing records keep their place
+static const SlotDef SLOTS[STORE_COUNT] = {
+  {  0, 48 },          // STORE_PASSWORD
+  { 52, 32 },          // STORE_FAN_COUNTERS
+};
+
+// ===== Lock =====
+// One EEPROM buffer shared by every slot: a save must not interleave with
+// another save or a load. Before the scheduler runs there is only setup().
+#if STATIC_ALLOC
+static StaticSemaphore_t lockMem;
+#endif
+static SemaphoreHandle_t lock = nullptr;
+
+struct StorageLock {
+  bool held;
+  StorageLock() : held(lock && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING &&
+                       xSemaphoreTake(lock, portMAX_DELAY) == pdTRUE) {}
+  ~StorageLock(){ if (held) xSemaphoreGive(lock); }
+};
+
+void storageInit(){
+#if STATIC_ALLOC
+  lock = xSemaphoreCreateMutexStatic(&lockMem);
+#else
+  lock = xSemaphoreCreateMutex();
+#endif
+  eeprom_buffer_fill();
+}
+
+bool storageLoad(StorageSlot slot, void* data, uint8_t len){
+  if (slot >= STORE_COUNT || len > SLOTS[slot].capacity) return false;
+  const StorageLock held;
+  const uint16_t a = SLOTS[slot].offset;
+  if (eeprom_buffered_read_byte(a) != RECORD_MAGIC) return false;
+  if (eeprom_buffered_read_byte(a + 1) != len) return false;
+  const uint16_t crc = (uint16_t)(eeprom_buffered_read_byte(a + 2) |
+                                  (eeprom_buffered_read_byte(a + 3) << 8));
+  uint8_t* p = (uint8_t*)data;
+  for (uint8_t i = 0; i < len; i++) p[i] = eeprom_buffered_read_byte(a + HEADER_BYTES + i);
+  return crc16Ccitt(p, len) == crc;
+}
+
+bool storageSave(StorageSlot slot, const void* data, uint8_t len){
+  if (slot >= STORE_COUNT || len > SLOTS[slot].capacity) return false;
+  const uint16_t a = SLOTS[slot].offset;
+  const uint8_t* p = (const uint8_t*)data;
+  const uint16_t crc = crc16Ccitt(p, len);
+  const uint8_t hdr[HEADER_BYTES] = { RECORD_MAGIC, len, (uint8_t)crc, (uint8_t)(crc >> 8) };
+
+  const StorageLock held;
+
+  bool dirty = false;
+  for (uint8_t i = 0; i < HEADER_BYTES + len; i++) {
+    const uint8_t b = i < HEADER_BYTES ? hdr[i] : p[i - HEADER_BYTES];
+    if (eeprom_buffered_read_byte(a + i) != b) {
+      eeprom_buffered_write_byte(a + i, b);
+      dirty = true;
+    }
+  }
+  if (dirty) eeprom_buffer_flush();
+  return true;
+}
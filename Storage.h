@@ -0,0 +1,27 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Persistent storage =====
+// Small CRC-checked records in the flash-emulated EEPROM (STM32duino
+// EEPROM library, buffered API). Each slot has a fixed place and capacity;
+// a record is [magic][len][crc16 lo][crc16 hi][data...].
+//
+// storageSave() only touches flash when the record actually changed, but a
+// flush erases a flash page and stalls the CPU for tens of ms - save rarely.
+// Loads and saves take a mutex once the scheduler runs: call them from
+// tasks, never from an interrupt.
+
+enum StorageSlot : uint8_t {
+  STORE_PASSWORD,
+  STORE_FAN_COUNTERS,
+  STORE_COUNT
+};
+
+// Load the emulated EEPROM into RAM; call once at startup
+void storageInit();
+
+// Copy a slot's record into data. False if blank, corrupt or len differs.
+bool storageLoad(StorageSlot slot, void* data, uint8_t len);
+
+// Write a record (no-op if unchanged). False if it does not fit the slot.
+bool storageSave(StorageSlot slot, const void* data, uint8_t len);
@@ -0,0 +1,57 @@
+#pragma once
+
+// ===== UI string tables =====
+// Every piece of text the panel shows comes from here, as S_* macros so they
+// also work inside the ArduinoMenu MENU/FIELD/OP macros. The language is
+// fixed at compile time (-DUI_LANG=LANG_DE); each Lang_*.h defines the same
+// set of names. Text is Latin-1: non-ASCII characters are written as \x
+// escapes and need the _tf fonts UiFonts.h picks for that language.
+//
+// tools/gen_font_subset.py reads these headers to build per-language font
+// subsets and reports string/font flash per language.
+
+#define LANG_EN 0
+#define LANG_DE 1
+
+#ifndef UI_LANG
+#define UI_LANG LANG_EN
+#endif
+
+// ----- Language independent -----
+#define FW_DEVICE_NAME "SARBS TCU"
+#define FW_VERSION     "1.14"
+#define FW_DATE        "2025-04-01"
+#define FW_INSTALLED   "2025-04-01"
+#define FW_SERIAL      "SARBS_ODCC_1001"
+
+#define S_MODEL_KRUBO  "KRUBO"
+#define S_MODEL_DELTA  "DELTA"
+
+// Units after field values
+#define U_NONE   " "
+#define U_DEG_C  "C"
+#define U_VOLT   "V"
+#define U_MA     "mA"
+#define U_MV     "mV"
+#define U_AMP    "A"
+#define U_WATT   "W"
+#define U_KWH    "kWh"
+#define U_MINUTE "min"
+#define U_RUN_M  "M"
+#define U_SEC    "s"
+#define U_MS     "ms"
+#define U_US     "us"
+#define U_LUX    "LUX"
+#define U_PCT    "%"
+#define U_PCT100 "x.01%"
+#define U_DECI_C "x.1C"
+#define U_WORDS  "w"
+#define U_RPM    "rpm"
+
+#if UI_LANG == LANG_EN
+#include "Lang_en.h"
+#elif UI_LANG == LANG_DE
+#include "Lang_de.h"
+#else
+#error "UI_LANG: no string table for this language"
+#endif
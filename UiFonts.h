@@ -0,0 +1,35 @@
+#pragma once
+#include <U8g2lib.h>
+#include "Strings.h"
+
+// ===== UI font roles =====
+// Screens pick fonts by role, never by name, so the font set can follow the
+// language. English uses the ASCII-only _tr fonts (_tf/_mf where the menu
+// always did); other languages need the Latin-1 _tf variants.
+//
+// With UI_FONT_SUBSET=1 the roles map to per-language subsets generated by
+// tools/gen_font_subset.py (FontSubset.h): only the glyphs the string tables
+// and numeric output can use, so adding a language does not grow flash.
+#ifndef UI_FONT_SUBSET
+#define UI_FONT_SUBSET 0
+#endif
+
+#if UI_FONT_SUBSET
+#include "FontSubset.h"
+#elif UI_LANG == LANG_EN
+#define UI_FONT_TITLE   u8g2_font_7x14_tr    // screen titles
+#define UI_FONT_VALUE   u8g2_font_6x12_tr    // idle page values
+#define UI_FONT_TILE    u8g2_font_5x7_tr     // carousel centre label
+#define UI_FONT_SMALL   u8g2_font_4x6_tr     // side labels, hints, trend scale
+#define UI_FONT_MENU    u8g2_font_6x10_tf    // menu rows, confirm options
+#define UI_FONT_DIALOG  u8g2_font_7x13B_mf   // dialog titles, code digits
+#define UI_FONT_CUSTOM  u8g2_font_5x8_tf     // custom screens
+#else
+#define UI_FONT_TITLE   u8g2_font_7x14_tf
+#define UI_FONT_VALUE   u8g2_font_6x12_tf
+#define UI_FONT_TILE    u8g2_font_5x7_tf
+#define UI_FONT_SMALL   u8g2_font_4x6_tf
+#define UI_FONT_MENU    u8g2_font_6x10_tf
+#define UI_FONT_DIALOG  u8g2_font_7x13B_tf
+#define UI_FONT_CUSTOM  u8g2_font_5x8_tf
+#endif
@@ -0,0 +1,49 @@
+#include "UiFsmLogic.h"
+
+#define T(a, n) { UA_##a, n }
+#define SAME ST_SAME
+#define ANY  ST_ANY
+
+// Columns: UP_CLICK, DOWN_CLICK, ENTER_CLICK, ESC_CLICK, ENTER_DOUBLE, ESC_DOUBLE,
+//          UP_HOLD_START, DOWN_HOLD_START, UP_HOLD, DOWN_HOLD, TIMEOUT
+constexpr UiTransition UI_FSM[ST_COUNT][EV_ALL] = {
+  /* ST_IDLE */ {
+    T(IDLE_NEXT, SAME), T(IDLE_PREV, SAME), T(NONE, SAME), T(NAV_ESC, SAME),
+    T(MENU_OPEN, ST_CAROUSEL), T(NONE, SAME),
+    T(HOLD_START_UP, SAME), T(HOLD_START_DOWN, SAME), T(NONE, SAME), T(NONE, SAME),
+    T(NONE, SAME) },
+  /* ST_CAROUSEL */ {
+    T(TILE_NEXT, SAME), T(TILE_PREV, SAME), T(TILE_OPEN, ANY), T(NAV_ESC, SAME),
+    T(MENU_OPEN, ST_CAROUSEL), T(MENU_LEAVE, ANY),
+    T(HOLD_START_UP, SAME), T(HOLD_START_DOWN, SAME), T(NONE, SAME), T(NONE, SAME),
+    T(TIMEOUT, ST_IDLE) },
+  /* ST_MENU */ {
+    T(NAV_UP, SAME), T(NAV_DOWN, SAME), T(NAV_ENTER, SAME), T(NAV_ESC, SAME),
+    T(MENU_OPEN, ANY), T(MENU_LEAVE, ANY),
+    T(HOLD_START_UP, SAME), T(HOLD_START_DOWN, SAME), T(NONE, SAME), T(NONE, SAME),
+    T(TIMEOUT, ST_IDLE) },
+  /* ST_EDIT */ {
+    T(NAV_UP, SAME), T(NAV_DOWN, SAME), T(NAV_ENTER, SAME), T(NAV_ESC, SAME),
+    T(MENU_OPEN, ANY), T(MENU_LEAVE, ANY),
+    T(HOLD_START_UP, SAME), T(HOLD_START_DOWN, SAME), T(EDIT_HOLD_INC, SAME), T(EDIT_HOLD_DEC, SAME),
+    T(TIMEOUT, ST_IDLE) },
+};
+#undef T
+#undef SAME
+#undef ANY
+
+// A short row leaves UA_UNSET behind; refuse to build
+static constexpr bool fsmComplete(){
+  for (uint8_t st = 0; st < ST_COUNT; st++)
+    for (uint8_t ev = 0; ev < EV_ALL; ev++)
+      if (UI_FSM[st][ev].action == UA_UNSET) return false;
+  return true;
+}
+static_assert(fsmComplete(), "every (state, event) needs a transition");
+
+UiState uiClassify(UIMode mode, uint8_t navLevel){
+  if (mode == UI_IDLE) return ST_IDLE;
+  if (mode == UI_MENU && navLevel == 0) return ST_CAROUSEL;
+  if (mode == UI_SUBMENU && navLevel >= 2) return ST_EDIT;
+  return ST_MENU;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <stdint.h>
+
+// ===== Button input state machine =====
+// Hardware-free part of the MenuUI input path (MenuUI.cpp binds each action
+// to its body; tools/ui_fsm_check.cpp checks the table against the handler
+// functions it replaced).
+//
+// An open dialog flow gets every button event first (ModalLogic.h). Other
+// events are looked up in UI_FSM[state][event]; the state is derived from
+// uiMode and nav depth (uiClassify()). Each entry names the action to run
+// and where the UI is expected to land: ST_SAME, a fixed state, or ST_ANY
+// when the action decides (menu exit may open the confirm dialog).
+
+// Simple UI states
+enum UIMode { UI_IDLE, UI_MENU, UI_SUBMENU };
+
+// Button events (physical buttons and trace replay go through the same path)
+enum UIEvent : uint8_t {
+  EV_UP_CLICK, EV_DOWN_CLICK, EV_ENTER_CLICK, EV_ESC_CLICK,
+  EV_ENTER_DOUBLE, EV_ESC_DOUBLE,
+  EV_UP_HOLD_START, EV_DOWN_HOLD_START,
+  EV_UP_HOLD, EV_DOWN_HOLD,
+  EV_COUNT
+};
+
+// Synthetic event raised by uiLoop, never recorded in traces
+static const uint8_t EV_TIMEOUT = EV_COUNT;
+static const uint8_t EV_ALL = EV_COUNT + 1;
+
+enum UiState : uint8_t {
+  ST_IDLE,          // idle pages
+  ST_CAROUSEL,      // main menu tiles (nav at root)
+  ST_MENU,          // ArduinoMenu list
+  ST_EDIT,          // field editing (nav.level >= 2): holds step the value
+  ST_COUNT,
+  // Dialog flows, outside the table
+  ST_PASSWORD = ST_COUNT,   // digit dialog
+  ST_CONFIRM,       // apply/discard dialog
+  ST_SAME,
+  ST_ANY
+};
+
+enum UiAction : uint8_t {
+  UA_UNSET,         // a short table row; refused at build time
+  UA_NONE,
+  UA_IDLE_NEXT, UA_IDLE_PREV,                 // idle page
+  UA_TILE_NEXT, UA_TILE_PREV, UA_TILE_OPEN,   // main menu carousel
+  UA_NAV_UP, UA_NAV_DOWN, UA_NAV_ENTER, UA_NAV_ESC,   // forwarded to ArduinoMenu
+  UA_MENU_OPEN,     // (re)open the menu with a fresh stage
+  UA_MENU_LEAVE,    // ask when there are staged edits, else go idle
+  UA_TIMEOUT,       // drop staged edits, go idle
+  UA_HOLD_START_UP, UA_HOLD_START_DOWN,
+  UA_EDIT_HOLD_INC, UA_EDIT_HOLD_DEC,         // accelerated field edit
+  UA_COUNT
+};
+
+struct UiTransition {
+  UiAction action;
+  UiState next;
+};
+
+extern const UiTransition UI_FSM[ST_COUNT][EV_ALL];
+
+// Table row for the menu state (no dialog open)
+UiState uiClassify(UIMode mode, uint8_t navLevel);
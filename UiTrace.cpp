@@ -0,0 +1,365 @@
+#include "UiTrace.h"
+#include "AppData.h"
+#include "Boot.h"
+#include "Crc.h"
+#include "I2cBus.h"
+#include "StaticAlloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if UI_TRACE == UI_TRACE_REPLAY
+static bool replaying = false;
+static unsigned long vNow = 0;
+#endif
+
+unsigned long uiMillis(){
+#if UI_TRACE == UI_TRACE_REPLAY
+  if (replaying) return vNow;
+#endif
+  return millis();
+}
+
+#if UI_TRACE != UI_TRACE_OFF
+
+// ===== Shared tables =====
+static const char* const EVENT_NAMES[EV_COUNT] = {
+  "UP_CLICK", "DOWN_CLICK", "ENTER_CLICK", "ESC_CLICK",
+  "ENTER_DOUBLE", "ESC_DOUBLE",
+  "UP_HOLD_START", "DOWN_HOLD_START",
+  "UP_HOLD", "DOWN_HOLD"
+};
+
+struct TeleField { const char* name; float* value; };
+static const TeleField TELE_FIELDS[] = {
+  {"TEMP", &statusTempC},    {"VIN", &statusVinV},
+  {"F1C",  &fan1Current_mA}, {"F2C", &fan2Current_mA},
+  {"F1P",  &fan1Power_W},    {"F2P", &fan2Power_W},
+  {"F1R",  &fan1Run_m},      {"F2R", &fan2Run_m},
+  {"F1S",  &fan1Rpm},        {"F2S", &fan2Rpm},
+};
+static const uint8_t TELE_COUNT = sizeof(TELE_FIELDS) / sizeof(TELE_FIELDS[0]);
+
+static uint32_t frameHash(U8G2& d){
+  const size_t n = (size_t)d.getBufferTileWidth() * d.getBufferTileHeight() * 8;
+  return crc32(d.getBufferPtr(), n);
+}
+
+// Buffer is in panel orientation (before U8G2_R2 rotation is undone)
+static void dumpPbm(U8G2& d){
+  const uint16_t w = d.getBufferTileWidth() * 8;
+  const uint16_t h = d.getBufferTileHeight() * 8;
+  const uint8_t* buf = d.getBufferPtr();
+  Serial.println("TRACE PBM");
+  Serial.println("P1");
+  Serial.print(w); Serial.print(" "); Serial.println(h);
+  char line[8 * 32 + 1];
+  for (uint16_t y = 0; y < h; y++) {
+    uint16_t k = 0;
+    for (uint16_t x = 0; x < w && k < sizeof(line) - 1; x++) {
+      line[k++] = (buf[(y / 8) * w + x] >> (y % 8)) & 1 ? '1' : '0';
+    }
+    line[k] = 0;
+    Serial.println(line);
+  }
+}
+
+#if UI_TRACE == UI_TRACE_RECORD
+// ===== Recorder =====
+static unsigned long recStart = 0;
+static float lastTele[TELE_COUNT];
+static uint8_t lastAlarms = 0xFF;
+static bool lastLight = false;
+static bool checkpointDue = false;
+static unsigned long lastEventMs = 0;
+
+static void recPrefix(){
+  Serial.print("TR ");
+  Serial.print(millis() - recStart);
+  Serial.print(" ");
+}
+
+void traceBegin(){
+  recStart = millis();
+  for (uint8_t i = 0; i < TELE_COUNT; i++) lastTele[i] = -1e30f;
+  lastAlarms = 0xFF;
+  lastLight = !Light_Condition;
+  Serial.println("TRACE record start");
+}
+
+void traceRecordEvent(UIEvent ev){
+  if (ev >= EV_COUNT) return;
+  recPrefix();
+  Serial.print("B ");
+  Serial.println(EVENT_NAMES[ev]);
+  checkpointDue = true;
+  lastEventMs = millis();
+}
+
+bool traceReplaying(){ return false; }
+void traceReplayStep(){}
+
+void traceFrame(U8G2&, uint32_t, uint32_t, uint32_t){
+  for (uint8_t i = 0; i < TELE_COUNT; i++) {
+    if (*TELE_FIELDS[i].value == lastTele[i]) continue;
+    lastTele[i] = *TELE_FIELDS[i].value;
+    recPrefix();
+    Serial.print("T ");
+    Serial.print(TELE_FIELDS[i].name);
+    Serial.print(" ");
+    Serial.println(lastTele[i], 3);
+  }
+  const uint8_t a = alarmMask();
+  if (a != lastAlarms) {
+    lastAlarms = a;
+    recPrefix(); Serial.print("T ALARMS "); Serial.println((unsigned)a);
+  }
+  if (Light_Condition != lastLight) {
+    lastLight = Light_Condition;
+    recPrefix(); Serial.print("T LIGHT "); Serial.println(lastLight ? 1 : 0);
+  }
+  // Checkpoint once the UI has settled after an event
+  if (checkpointDue && millis() - lastEventMs >= 100) {
+    checkpointDue = false;
+    recPrefix(); Serial.println("F ?");
+  }
+}
+
+#else
+// ===== Replayer =====
+#include "UiTraceScript.h"
+#include "UiTraceGolden.h"
+
+struct Step {
+  unsigned long t;
+  char kind;
+  char arg[20];
+  const char* rest;    // remainder of the line (value)
+};
+
+static const char* cursor = nullptr;
+static Step step;
+static bool haveStep = false;
+static unsigned long vStart = 0;
+
+static bool checkDue = false, checkLearn = false, snapDue = false;
+static uint32_t checkExpect = 0;
+
+// Hashes of this run's "F" checkpoints in script order, printed as a new
+// UiTraceGolden.h when the run does not pass
+static uint32_t seen[UI_TRACE_GOLDEN_MAX];
+static uint32_t scriptCrc = 0;
+static bool haveGolden = false, bootWaited = false;
+static uint8_t unchecked = 0;           // "?" checkpoints without a golden hash
+static uint32_t maxFlushUs = 0;         // flushUs budget, from the first frame
+
+static uint32_t frames = 0, failures = 0, checks = 0;
+static uint32_t maxUs = 0, maxFlush = 0, maxBytes = 0;
+static uint64_t sumUs = 0, sumFlush = 0, sumBytes = 0;
+static uint32_t heapAtStart = 0;
+
+static bool loadStep(){
+  while (cursor && *cursor) {
+    const char* line = cursor;
+    const char* eol = strchr(line, '\n');
+    cursor = eol ? eol + 1 : line + strlen(line);
+    if (*line == '#' || *line == '\n') continue;
+
+    char* p;
+    step.t = strtoul(line, &p, 10);
+    while (*p == ' ') p++;
+    step.kind = *p ? *p++ : 'E';
+    while (*p == ' ') p++;
+    uint8_t k = 0;
+    while (*p && *p != ' ' && *p != '\n' && k < sizeof(step.arg) - 1) step.arg[k++] = *p++;
+    step.arg[k] = 0;
+    while (*p == ' ') p++;
+    step.rest = p;
+    return true;
+  }
+  return false;
+}
+
+static void fail(const char* what, uint32_t value){
+  failures++;
+  Serial.print("TRACE FAIL t=");
+  Serial.print(vNow - vStart);
+  Serial.print(" ");
+  Serial.print(what);
+  Serial.print(" ");
+  Serial.println((unsigned long)value);
+}
+
+static void checkGolden(){
+  scriptCrc = crc32((const uint8_t*)UI_TRACE_SCRIPT, sizeof(UI_TRACE_SCRIPT) - 1);
+  haveGolden = scriptCrc == UI_TRACE_GOLDEN_SCRIPT_CRC;
+  Serial.println(haveGolden ? "TRACE golden hashes match the script"
+                            : "TRACE UiTraceGolden.h is for another script");
+}
+
+// Paste over UiTraceGolden.h after checking the frames (S steps, PBM dumps)
+static void printGolden(){
+  const uint32_t n = checks < UI_TRACE_GOLDEN_MAX ? checks : UI_TRACE_GOLDEN_MAX;
+  Serial.println("TRACE golden header");
+  Serial.print("#define UI_TRACE_GOLDEN_SCRIPT_CRC 0x"); Serial.print(scriptCrc, HEX); Serial.println("UL");
+  Serial.print("#define UI_TRACE_GOLDEN_COUNT "); Serial.println(n);
+  Serial.print("static const uint32_t UI_TRACE_GOLDEN[UI_TRACE_GOLDEN_COUNT + 1] = {");
+  for (uint32_t k = 0; k < n; k++) {
+    Serial.print(k % 4 ? " 0x" : "\n  0x"); Serial.print(seen[k], HEX); Serial.print(",");
+  }
+  Serial.println("\n  0 };");
+}
+
+static void applyTelemetry(){
+  const float v = (float)strtod(step.rest, nullptr);
+  for (uint8_t i = 0; i < TELE_COUNT; i++) {
+    if (strcmp(step.arg, TELE_FIELDS[i].name) == 0) { *TELE_FIELDS[i].value = v; return; }
+  }
+  if (strcmp(step.arg, "LIGHT") == 0) { Light_Condition = v != 0; return; }
+  if (strcmp(step.arg, "ALARMS") == 0) {
+    const uint8_t a = (uint8_t)v;
+    alarmDoor = a & 0x01;  alarmWater = a & 0x02;    alarmSmoke = a & 0x04;
+    alarmTemp = a & 0x08;  alarmFanFault = a & 0x10; alarmAviation = a & 0x20;
+  }
+}
+
+static void summary(){
+  Serial.print("TRACE frames=");  Serial.print(frames);
+  Serial.print(" checks=");       Serial.print(checks);
+  Serial.print(" maxUs=");        Serial.print(maxUs);
+  Serial.print(" avgUs=");        Serial.print(frames ? (unsigned long)(sumUs / frames) : 0UL);
+  Serial.print(" maxFlushUs=");   Serial.print(maxFlush);
+  Serial.print(" avgFlushUs=");   Serial.print(frames ? (unsigned long)(sumFlush / frames) : 0UL);
+  Serial.print(" maxBytes=");     Serial.print(maxBytes);
+  Serial.print(" avgBytes=");     Serial.println(frames ? (unsigned long)(sumBytes / frames) : 0UL);
+#if STATIC_ALLOC
+  // A replay must not touch the heap (after heapLock() it would have halted)
+  const uint32_t allocs = heapAllocCount() - heapAtStart;
+  Serial.print("TRACE heapAllocs="); Serial.println(allocs);
+  if (allocs) failures++;
+#endif
+  if (!failures && !unchecked) {
+    Serial.println("TRACE RESULT PASS");
+    return;
+  }
+  Serial.println(failures ? "TRACE RESULT FAIL" : "TRACE RESULT NO GOLDEN");
+  printGolden();
+}
+
+static void applyStep(){
+  switch (step.kind) {
+    case 'B':
+      for (uint8_t e = 0; e < EV_COUNT; e++) {
+        if (strcmp(step.arg, EVENT_NAMES[e]) == 0) { uiHandleEvent((UIEvent)e); return; }
+      }
+      fail("unknown event", 0);
+      break;
+    case 'T':
+      applyTelemetry();
+      break;
+    case 'F':
+      checkDue = true;
+      checkLearn = (step.arg[0] == '?');
+      checkExpect = checkLearn ? 0 : strtoul(step.arg, nullptr, 16);
+      break;
+    case 'S':
+      snapDue = true;
+      break;
+    case 'E':
+    default:
+      summary();
+      replaying = false;
+      haveStep = false;
+      break;
+  }
+}
+
+void traceBegin(){
+  cursor = UI_TRACE_SCRIPT;
+  vNow = 1000;            // non-zero so "last event" timestamps start valid
+  vStart = vNow;
+  frames = failures = checks = 0;
+  maxUs = maxFlush = maxBytes = 0;
+  sumUs = sumFlush = sumBytes = 0;
+  heapAtStart = heapAllocCount();
+  checkDue = snapDue = false;
+  bootWaited = false;
+  checkGolden();
+  unchecked = 0;
+  haveStep = loadStep();
+  replaying = haveStep;
+  Serial.println("TRACE replay start");
+}
+
+// A whole-panel update at I2C_BUS_HZ plus the margin (UiTrace.h)
+static void flushBudget(U8G2& d){
+  const uint32_t full = i2cDisplayFrameUs(d.getBufferTileHeight(), d.getBufferTileWidth() * 8,
+                                          I2C_DISPLAY_CHUNK, I2C_BUS_HZ, UI_TRACE_XFER_OVERHEAD_US);
+  maxFlushUs = full + full * UI_TRACE_FLUSH_MARGIN_PCT / 100;
+}
+
+void traceRecordEvent(UIEvent){}
+
+bool traceReplaying(){ return replaying; }
+
+void traceReplayStep(){
+  if (!replaying) return;
+  // The virtual clock waits for the stored unlock code
+  if (!bootWaited) {
+    if (!bootDone()) return;
+    bootWaited = true;
+  }
+  vNow += UI_TRACE_LOOP_MS;
+  while (replaying && haveStep && step.t <= vNow - vStart) {
+    applyStep();
+    if (replaying) haveStep = loadStep();
+  }
+  if (replaying && !haveStep) { summary(); replaying = false; }
+}
+
+void traceFrame(U8G2& d, uint32_t renderUs, uint32_t flushUs, uint32_t bytesSent){
+  if (!replaying && !checkDue && !snapDue) return;
+  if (!maxFlushUs) flushBudget(d);
+  frames++;
+  sumUs += renderUs;
+  sumFlush += flushUs;
+  sumBytes += bytesSent;
+  if (renderUs > maxUs) maxUs = renderUs;
+  if (flushUs > maxFlush) maxFlush = flushUs;
+  if (bytesSent > maxBytes) maxBytes = bytesSent;
+  if (renderUs > UI_TRACE_MAX_RENDER_US) fail("renderUs", renderUs);
+  if (flushUs > maxFlushUs) fail("flushUs", flushUs);
+  if (bytesSent > UI_TRACE_MAX_FRAME_BYTES) fail("frameBytes", bytesSent);
+
+  if (checkDue) {
+    checkDue = false;
+    checks++;
+    const uint32_t h = frameHash(d);
+    Serial.print("TRACE t=");   Serial.print(vNow - vStart);
+    Serial.print(" frame=");    Serial.print(h, HEX);
+    Serial.print(" us=");       Serial.print(renderUs);
+    Serial.print(" flushUs=");  Serial.print(flushUs);
+    Serial.print(" bytes=");    Serial.println(bytesSent);
+    // Index of this checkpoint among the script's "F" lines
+    const uint32_t k = checks - 1;
+    if (k < UI_TRACE_GOLDEN_MAX) seen[k] = h;
+    else fail("checkpoints over UI_TRACE_GOLDEN_MAX", k);
+    if (checkLearn && haveGolden && k < UI_TRACE_GOLDEN_COUNT) {
+      checkLearn = false;
+      checkExpect = UI_TRACE_GOLDEN[k];
+    }
+    if (checkLearn) unchecked++;
+    if (!checkLearn && h != checkExpect) {
+      fail("frame hash", h);
+      Serial.print("TRACE expected ");
+      Serial.println(checkExpect, HEX);
+      dumpPbm(d);
+    }
+  }
+  if (snapDue) {
+    snapDue = false;
+    dumpPbm(d);
+  }
+}
+#endif // UI_TRACE_REPLAY
+
+#endif // UI_TRACE != UI_TRACE_OFF
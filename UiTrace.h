@@ -0,0 +1,85 @@
+#pragma once
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "MenuUI.h"
+
+// ===== UI trace record / deterministic replay =====
+// UI_TRACE_OFF    : normal firmware, all hooks compile to nothing
+// UI_TRACE_RECORD : every button event and telemetry change is printed as a
+//                   trace line ("TR <t_ms> ...") that can be pasted back into
+//                   a replay script
+// UI_TRACE_REPLAY : buttons and demo data are ignored; the UI runs on a
+//                   virtual clock driven by the script in UiTraceScript.h,
+//                   frames are hashed and checked against golden values
+#define UI_TRACE_OFF    0
+#define UI_TRACE_RECORD 1
+#define UI_TRACE_REPLAY 2
+
+#ifndef UI_TRACE
+#define UI_TRACE UI_TRACE_OFF
+#endif
+
+// Virtual time advanced per uiLoop() call during replay (matches the UI task period)
+#ifndef UI_TRACE_LOOP_MS
+#define UI_TRACE_LOOP_MS 5
+#endif
+
+// Replay fails if any frame exceeds these budgets. Rendering and the
+// flushFrame() transfer are timed apart: the transfer is allowed the bus
+// time of a whole-panel update (i2cDisplayFrameUs at I2C_BUS_HZ in
+// I2C_DISPLAY_CHUNK pieces, UI_TRACE_XFER_OVERHEAD_US each; 27 ms at
+// 400 kHz) plus UI_TRACE_FLUSH_MARGIN_PCT for sensor reads in between, so
+// a full repaint passes and a stalled bus does not.
+#ifndef UI_TRACE_MAX_RENDER_US
+#define UI_TRACE_MAX_RENDER_US 10000UL
+#endif
+#ifndef UI_TRACE_XFER_OVERHEAD_US
+#define UI_TRACE_XFER_OVERHEAD_US 20
+#endif
+#ifndef UI_TRACE_FLUSH_MARGIN_PCT
+#define UI_TRACE_FLUSH_MARGIN_PCT 25
+#endif
+#ifndef UI_TRACE_MAX_FRAME_BYTES
+#define UI_TRACE_MAX_FRAME_BYTES 1100UL
+#endif
+
+// Golden frames: "F ?" checkpoints are checked against UiTraceGolden.h,
+// hashes taken once from a known-good build of the same script and kept
+// in the source. Nothing is learned on the unit: a run without matching
+// hashes ends "RESULT NO GOLDEN" and, like a failed run, prints the
+// UiTraceGolden.h to check in once the frames have been looked at.
+#ifndef UI_TRACE_GOLDEN_MAX
+#define UI_TRACE_GOLDEN_MAX 16          // checkpoints per script
+#endif
+
+/*
+ * Script format, one line per step (times in ms since replay start):
+ *   <t> B <EVENT>         button event: UP_CLICK, ENTER_DOUBLE, UP_HOLD ...
+ *   <t> T <FIELD> <value> telemetry: TEMP VIN F1C F2C F1P F2P F1R F2R
+ *                         LIGHT ALARMS (ALARMS = bitmask door..aviation)
+ *   <t> F <crc32|?>       check the first frame rendered at/after t
+ *                         against crc32, or for "?" against the
+ *                         UiTraceGolden.h hash for this checkpoint
+ *   <t> S                 dump the next frame as an ASCII PBM over Serial
+ *   <t> E                 end of trace, print summary and
+ *                         PASS/FAIL/NO GOLDEN
+ */
+
+// Clock used by all UI timing; virtual while a replay is running
+unsigned long uiMillis();
+
+#if UI_TRACE != UI_TRACE_OFF
+void traceBegin();
+void traceRecordEvent(UIEvent ev);
+bool traceReplaying();
+// Advance the virtual clock by one UI loop period and inject due steps
+void traceReplayStep();
+// Called after every rendered frame: drawing time, flushFrame() time, bytes it sent
+void traceFrame(U8G2& display, uint32_t renderUs, uint32_t flushUs, uint32_t bytesSent);
+#else
+inline void traceBegin() {}
+inline void traceRecordEvent(UIEvent) {}
+inline bool traceReplaying() { return false; }
+inline void traceReplayStep() {}
+inline void traceFrame(U8G2&, uint32_t, uint32_t, uint32_t) {}
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+// Reference frame hashes for the "F ?" checkpoints of UiTraceScript.h, in
+// script order (UiTrace.h). Taken once from a known-good build: run the
+// replay, look at the frames (S steps, the PBM dumps of a failed check),
+// then replace everything below with the block it prints after
+// "TRACE golden header". Redo it when the script or the UI changes on
+// purpose, in the same commit.
+//
+// No reference build has been taken for this script yet: every "?"
+// checkpoint is unchecked and the replay ends "RESULT NO GOLDEN".
+#define UI_TRACE_GOLDEN_SCRIPT_CRC 0xF6104E82UL
+#define UI_TRACE_GOLDEN_COUNT 0
+static const uint32_t UI_TRACE_GOLDEN[UI_TRACE_GOLDEN_COUNT + 1] = {
+  0 };
@@ -0,0 +1,42 @@
+#pragma once
+
+// Default replay script (see UiTrace.h for the format).
+// Walks idle pages, opens Settings from the carousel, fails and then passes
+// the password dialog, edits a field and discards it via the confirm dialog.
+// Assumes the unit still has the default unlock code (PASS_DEFAULT_CODE).
+// "?" checkpoints compare against UiTraceGolden.h, which records this
+// script's CRC: edit the script and the hashes there must be taken again.
+static const char UI_TRACE_SCRIPT[] =
+  "0 T TEMP 27.5\n"
+  "0 T VIN 12.1\n"
+  "0 T ALARMS 0\n"
+  "100 F ?\n"
+  "300 B UP_CLICK\n"
+  "600 B UP_CLICK\n"
+  "700 F ?\n"
+  "1000 B ENTER_DOUBLE\n"
+  "1300 B UP_CLICK\n"
+  "1600 F ?\n"
+  "1800 B ENTER_CLICK\n"
+  "1900 F ?\n"
+  "2100 B ENTER_DOUBLE\n"
+  "2200 F ?\n"
+  "2400 B UP_CLICK\n"
+  "2500 B ENTER_CLICK\n"
+  "2600 B ENTER_CLICK\n"
+  "2700 B ENTER_CLICK\n"
+  "2800 B UP_CLICK\n"
+  "2900 B ENTER_DOUBLE\n"
+  "3100 F ?\n"
+  "3300 B ENTER_CLICK\n"
+  "3500 B ENTER_CLICK\n"
+  "3600 B UP_CLICK\n"
+  "3700 B ENTER_CLICK\n"
+  "3900 F ?\n"
+  "4100 B ESC_DOUBLE\n"
+  "4200 S\n"
+  "4300 B UP_CLICK\n"
+  "4400 B UP_CLICK\n"
+  "4500 B ENTER_CLICK\n"
+  "4700 F ?\n"
+  "4800 E\n";
@@ -4,121 +4,5 @@ const uint8_t bitmap_logo1[] = {
 	0x20, 0x04, 0xe8, 0x13, 0xf4, 0x2f, 0x0a, 0x5f, 0x04, 0x27, 0x03, 0xa7, 0x22, 0xc3, 0xfe, 0x41, 
 	0xbe, 0x40, 0x1e, 0xe3, 0x0d, 0x3f, 0x0c, 0x3f, 0x0a, 0x5c, 0x34, 0x2e, 0xc8, 0x13, 0x60, 0x06
 };
-const uint8_t bitmap_logo2[] = {
-	0x20, 0x04, 0xc8, 0x17, 0xf4, 0x29, 0xfa, 0x51, 0xc4, 0x21, 0x85, 0xe3, 0x03, 0x61, 0x82, 0x61, 
-	0x72, 0x7f, 0x77, 0x7e, 0x3d, 0xbc, 0x3c, 0x30, 0x3a, 0x50, 0x74, 0x2c, 0xc8, 0x13, 0x40, 0x06
-};
-
-const uint8_t bitmap_logo3[] = {
-	0x60, 0x06, 0xc8, 0x13, 0x74, 0x2c, 0x3a, 0x50, 0xfc, 0x30, 0xfc, 0xb0, 0xc7, 0x78, 0x02, 0x7d, 
-	0x82, 0x7f, 0xc3, 0x44, 0xe5, 0xc0, 0xe4, 0x20, 0xfa, 0x50, 0xf4, 0x2f, 0xc8, 0x17, 0x20, 0x04
-};
-
-const uint8_t bitmap_logo4[] = {
-	0x60, 0x02, 0xc8, 0x13, 0x34, 0x2e, 0x0a, 0x5c, 0x0c, 0x3c, 0x3d, 0xbc, 0x7e, 0xee, 0xfe, 0x4e, 
-	0x86, 0x41, 0x86, 0xc0, 0xc7, 0xa1, 0x84, 0x23, 0x8a, 0x5f, 0x94, 0x2f, 0xe8, 0x13, 0x20, 0x04
-};
-
-// 8x8 icons for U8g2 (XBM: LSB first)
-const uint8_t ICON_WATER_16[] = {
-  0x80, 0x01, 0xc0, 0x03, 0x40, 0x02, 0x60, 0x06, 0x30, 0x0c, 0x10, 0x08, 0x18, 0x18, 0x08, 0x10, 
-	0x08, 0x10, 0x0c, 0x34, 0x04, 0x24, 0x0c, 0x36, 0x08, 0x12, 0x18, 0x18, 0x30, 0x0c, 0xc0, 0x03
-}; // droplet
-
-const uint8_t ICON_SMOKE_16[] = {
-	0xc0, 0x00, 0xf0, 0x03, 0x18, 0x06, 0x08, 0x04, 0x08, 0x1c, 0x0c, 0x30, 0x06, 0x20, 0x12, 0x24, 
-	0x22, 0x62, 0xc3, 0xc1, 0x41, 0x81, 0x71, 0xc7, 0x47, 0x61, 0x7c, 0x3f, 0x00, 0x00, 0x00, 0x00
-}; // wispy puffs
-
-const uint8_t ICON_DOOR_16[] = {
-  0xc0, 0x03, 0x7e, 0x0e, 0x42, 0x38, 0x7a, 0x60, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x43, 
-	0x4a, 0x43, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0x4a, 0x40, 0xff, 0xff
-}; // framed door w/ knob
-
-const uint8_t ICON_FIRE_16[] = {
-  0xe0, 0x03, 0x20, 0x02, 0x30, 0x06, 0x90, 0x04, 0x90, 0x04, 0x90, 0x04, 0x90, 0x04, 0x90, 0x04, 
-	0x90, 0x04, 0x90, 0x04, 0x98, 0x0c, 0xc8, 0x09, 0xe8, 0x0b, 0xc8, 0x09, 0x98, 0x0c, 0xf0, 0x07
-}; // flame
-
-const uint8_t ICON_FAN_16[] = {
-	0x80, 0x03, 0xe0, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x60, 0x02, 0xc0, 0x03, 0x40, 0x3e, 
-	0x40, 0x62, 0xfe, 0xc3, 0x02, 0x8f, 0x06, 0x9b, 0x84, 0xb1, 0xfc, 0xe0, 0x00, 0x00, 0x00, 0x00
-}; // 4-blade fan
-
-const uint8_t ICON_LIGHT_16[] = {
-  0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0xc0, 0x03, 0xf0, 0x0f, 
-	0xf8, 0x1f, 0xde, 0x7b, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0xc0, 0x03, 0x00, 0x00, 0x00, 0x00
-}; // light bulb
-
-
-const uint8_t ICON_STATUS_24[] = {
-	0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x10, 0x3c, 0x08, 0x38, 0x3c, 0x1c, 0x7c, 0x3c, 0x3e, 0xf8, 
-	0x3c, 0x1f, 0xf0, 0xbd, 0x0f, 0xe0, 0xbd, 0x07, 0xc0, 0x00, 0x03, 0x00, 0x00, 0x00, 0xfe, 0x00, 
-	0x7f, 0xfe, 0x00, 0x7f, 0xfe, 0x00, 0x7f, 0xfe, 0x00, 0x7f, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x03, 
-	0xe0, 0xbd, 0x07, 0xf0, 0xbd, 0x0f, 0xf8, 0x3c, 0x1f, 0x7c, 0x3c, 0x3e, 0x38, 0x3c, 0x1c, 0x10, 
-	0x3c, 0x08, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00
-};
-
-// 24x24 ALARMS: a bell
-const uint8_t ICON_ALARMS_24[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x3c, 0x00, 0x02, 
-	0x7e, 0x40, 0x0a, 0xff, 0x50, 0x89, 0xff, 0x91, 0x89, 0xff, 0x91, 0x85, 0xff, 0xa1, 0x85, 0xff, 
-	0xa1, 0x85, 0xff, 0xa1, 0x89, 0xff, 0x91, 0x89, 0xff, 0x91, 0x8a, 0xff, 0x51, 0xc2, 0xff, 0x43, 
-	0xc0, 0xff, 0x03, 0xe0, 0xff, 0x07, 0xe0, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 24x24 SETTINGS: a gear
-const uint8_t ICON_SETTINGS_24[] = {
-	0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x3c, 0x00, 0x60, 0x3c, 0x06, 0xf0, 0x7e, 0x0f, 0xf8, 
-	0xff, 0x1f, 0xf8, 0xff, 0x1f, 0xf0, 0xff, 0x0f, 0xe0, 0xff, 0x07, 0xf0, 0xc3, 0x0f, 0xfe, 0x81, 
-	0x7f, 0xfe, 0x81, 0x7f, 0xfe, 0x81, 0x7f, 0xfe, 0x81, 0x7f, 0xf0, 0xc3, 0x0f, 0xe0, 0xff, 0x07, 
-	0xf0, 0xff, 0x0f, 0xf8, 0xff, 0x1f, 0xf8, 0xff, 0x1f, 0xf0, 0x7e, 0x0f, 0x60, 0x3c, 0x06, 0x00, 
-	0x3c, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x00
-};
-
-// 24x24 ABOUT: “i” in a circle
-const uint8_t ICON_ABOUT_24[] = {
-	0x00, 0x3c, 0x00, 0x80, 0xff, 0x01, 0xe0, 0xff, 0x07, 0xf0, 0xff, 0x0f, 0xf8, 0xff, 0x1f, 0xfc, 
-	0xff, 0x3f, 0xfe, 0xe7, 0x7f, 0xfe, 0xe7, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 
-	0xff, 0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xe7, 0xff, 0xfe, 0xe7, 0x7f, 0xfe, 0xe7, 0x7f, 
-	0xfc, 0xff, 0x3f, 0xfc, 0xff, 0x3f, 0xf8, 0xff, 0x1f, 0xf8, 0xff, 0x07, 0xfc, 0xff, 0x03, 0xfe, 
-	0x7f, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-const uint8_t ICON_STATUS_16[] = {
-	0x00, 0x00, 0x80, 0x01, 0x80, 0x01, 0x98, 0x19, 0xb8, 0x1d, 0x30, 0x0c, 0x00, 0x00, 0x1e, 0x78, 
-	0x1e, 0x78, 0x00, 0x00, 0x30, 0x0c, 0xb8, 0x1d, 0x98, 0x19, 0x80, 0x01, 0x80, 0x01, 0x00, 0x00
-};
-
-const uint8_t ICON_ALARMS_16[] = {
-	0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0xc0, 0x03, 0xe1, 0x87, 0xe5, 0xa7, 0xe5, 0xa7, 0xf5, 0xaf, 
-	0xf5, 0xaf, 0xf1, 0x8f, 0xf0, 0x0f, 0xf0, 0x0f, 0xc0, 0x03, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00
-};
-
-const uint8_t ICON_SETTINGS_16[] = {
-	0xc0, 0x03, 0xc8, 0x13, 0xdc, 0x3b, 0xfe, 0x7f, 0xfc, 0x3f, 0xf8, 0x1f, 0x3f, 0xfc, 0x3f, 0xfc, 
-	0x3f, 0xfc, 0x3f, 0xfc, 0xf8, 0x1f, 0xfc, 0x3f, 0xfe, 0x7f, 0xdc, 0x3b, 0xc8, 0x13, 0xc0, 0x03
-};
-
-const uint8_t ICON_ABOUT_16[] = {
-	0xc0, 0x03, 0xf0, 0x0f, 0xfc, 0x3f, 0xfe, 0x7e, 0xfe, 0x7f, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xfe, 
-	0xff, 0xfe, 0xff, 0xfe, 0xfe, 0x7f, 0xfc, 0x3f, 0xfc, 0x3f, 0xfc, 0x0f, 0xff, 0x01, 0x07, 0x00
-};
-
-const uint8_t ICON_SUM_16[] = {
-	0x80, 0x01, 0x86, 0x61, 0x8e, 0x71, 0x0c, 0x30, 0xe0, 0x07, 0x30, 0x0c, 0x10, 0x08, 0x17, 0xe8, 
-	0x17, 0xe8, 0x10, 0x08, 0x30, 0x0c, 0xe0, 0x07, 0x0c, 0x30, 0x8e, 0x71, 0x86, 0x61, 0x80, 0x01
-}      ;
-const uint8_t ICON_MOON_16[] = {
-	0x00, 0x02, 0x00, 0x0c, 0x00, 0x1c, 0x00, 0x3c, 0x00, 0x28, 0x00, 0x68, 0x00, 0x48, 0x00, 0x48, 
-	0x00, 0x4c, 0x01, 0x46, 0x0e, 0x43, 0xfe, 0x61, 0x0c, 0x30, 0x38, 0x18, 0xe0, 0x0f, 0x00, 0x00
-}     ;
-
 
-const uint8_t* images[4] = {
-  bitmap_logo1,
-  bitmap_logo2,
-  bitmap_logo3,
-  bitmap_logo4
-};
\ No newline at end of file
+// UI icons moved to the icon atlas (assets/icons -> IconAtlasData.h)
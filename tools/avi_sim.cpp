@@ -0,0 +1,205 @@
+// Host simulator for the aviation light logic (AviationLogic.cpp).
+//
+// Replays synthetic day/night lux curves (sun elevation, twilight, drifting
+// cloud cover, storms, headlight and lightning spikes, sensor noise) or a
+// recorded "seconds,lux" CSV through aviLogicStep() at the firmware's sample
+// rate, as fast as the host can go, and reports switching times, chatter,
+// self-test results and how long a lamp failure takes to raise the alarm.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/avi_sim.cpp AviationLogic.cpp -o avi_sim
+// Usage: ./avi_sim [--days 30] [--threshold 100] [--seed 1] [--fail-h 200]
+//                  [--stuck-h 300] [--csv lux.csv] [--trace]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "AviationLogic.h"
+
+static const uint32_t STEP_MS = 100;                // AVI_TASK_MS
+static const double DAY_S = 86400.0;
+static const double SENSOR_FULL_LUX = 2000.0;       // AVI_LDR_FULL_LUX
+static const uint16_t LAMP_MA = 120;
+
+struct Options {
+  int days = 30;
+  uint16_t threshold = 100;
+  unsigned seed = 1;
+  double failH = -1;          // lamp goes open-circuit at this hour
+  double stuckH = -1;         // lamp driver sticks on at this hour
+  const char* csv = nullptr;
+  bool trace = false;
+};
+
+// ===== Lux sources =====
+struct Weather {
+  std::mt19937 rng;
+  double cloud = 1.0;         // transmission, drifts every minute
+  double stormLeftS = 0;
+  double spikeLeftS = 0, spikeLux = 0;
+  explicit Weather(unsigned seed) : rng(seed) {}
+
+  double uni(double a, double b){ return std::uniform_real_distribution<double>(a, b)(rng); }
+
+  double clearSky(double tS){
+    // Equinox sun: elevation sine peaks at noon; exponential twilight below 0
+    const double s = std::sin(2 * M_PI * (std::fmod(tS, DAY_S) / DAY_S - 0.25));
+    if (s > 0) return 400.0 + 110000.0 * std::pow(s, 1.2);
+    return 400.0 * std::exp(30.0 * s);
+  }
+
+  double sample(double tS, double dtS){
+    if (std::fmod(tS, 60.0) < dtS) {
+      cloud += uni(-0.08, 0.08);
+      cloud = cloud < 0.2 ? 0.2 : cloud > 1.0 ? 1.0 : cloud;
+      if (stormLeftS <= 0 && uni(0, 1) < 1.0 / (60 * 48)) stormLeftS = uni(600, 2400);
+    }
+    double lux = clearSky(tS) * cloud;
+    if (stormLeftS > 0) { lux *= 0.05; stormLeftS -= dtS; }
+
+    // Headlights (~4/h) and lightning (rare) add short bursts
+    if (spikeLeftS <= 0) {
+      const double p = uni(0, 1);
+      if (p < dtS * 4 / 3600)      { spikeLeftS = uni(0.2, 2.0); spikeLux = uni(300, 1500); }
+      else if (p < dtS * 4.2 / 3600) { spikeLeftS = 0.1;         spikeLux = 2000; }
+    }
+    if (spikeLeftS > 0) { lux += spikeLux; spikeLeftS -= dtS; }
+
+    lux *= 1.0 + uni(-0.03, 0.03);
+    return lux + uni(0, 1);
+  }
+};
+
+struct CsvCurve {
+  std::vector<double> t, lux;
+  bool load(const char* path){
+    FILE* f = std::fopen(path, "r");
+    if (!f) return false;
+    double a, b;
+    char line[128];
+    while (std::fgets(line, sizeof(line), f)) {
+      if (std::sscanf(line, "%lf,%lf", &a, &b) == 2) { t.push_back(a); lux.push_back(b); }
+    }
+    std::fclose(f);
+    return t.size() >= 2;
+  }
+  double span() const { return t.back() - t.front(); }
+  double sample(double tS) const {
+    tS += t.front();
+    size_t i = 1;
+    while (i < t.size() - 1 && t[i] < tS) i++;
+    const double k = (tS - t[i - 1]) / (t[i] - t[i - 1]);
+    return lux[i - 1] + (lux[i] - lux[i - 1]) * (k < 0 ? 0 : k > 1 ? 1 : k);
+  }
+};
+
+// 12-bit ADC over the sensor's range, like AviationLight.cpp reads it
+static uint16_t adcLux(double lux){
+  if (lux < 0) lux = 0;
+  if (lux > SENSOR_FULL_LUX) lux = SENSOR_FULL_LUX;
+  const uint32_t counts = (uint32_t)(lux / SENSOR_FULL_LUX * 4095.0 + 0.5);
+  return (uint16_t)((counts * (uint32_t)SENSOR_FULL_LUX) >> 12);
+}
+
+static void hhmm(char* out, size_t n, double tS){
+  const int m = (int)(std::fmod(tS, DAY_S) / 60);
+  std::snprintf(out, n, "%02d:%02d", m / 60 % 24, m % 60);
+}
+
+static bool parse(int argc, char** argv, Options& o){
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--days") && more)           o.days = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--threshold") && more) o.threshold = (uint16_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--seed") && more)      o.seed = (unsigned)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--fail-h") && more)    o.failH = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--stuck-h") && more)   o.stuckH = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--csv") && more)       o.csv = argv[++i];
+    else if (!std::strcmp(argv[i], "--trace"))             o.trace = true;
+    else return false;
+  }
+  return o.days > 0;
+}
+
+int main(int argc, char** argv){
+  Options o;
+  if (!parse(argc, argv, o)) {
+    std::fprintf(stderr, "usage: %s [--days N] [--threshold LUX] [--seed S] [--fail-h H]"
+                         " [--stuck-h H] [--csv file] [--trace]\n", argv[0]);
+    return 2;
+  }
+  Weather wx(o.seed);
+  CsvCurve csv;
+  if (o.csv && !csv.load(o.csv)) { std::fprintf(stderr, "%s: need >= 2 'seconds,lux' rows\n", o.csv); return 2; }
+  const double endS = o.csv ? csv.span() : o.days * DAY_S;
+  std::mt19937 lampRng(o.seed + 1);
+  std::uniform_int_distribution<int> lampNoise(-5, 5);
+
+  // Starts at 00:00 so the first decision is "night"
+  aviLogicReset(0);
+  const double dtS = STEP_MS / 1000.0;
+  bool lamp = false;
+  AviMode lastMode = AVI_TEST;
+  double lastSwitchS = -1e9, faultAtS = -1, raisedAtS = -1;
+  uint32_t chatter = 0, daySwitches = 0, maxDaySwitches = 0;
+  double onS = -1, offS = -1;
+  std::printf("%-4s %-6s %-6s %-8s %s\n", "day", "on", "off", "switches", "tests ok/fail");
+
+  const auto wall0 = std::chrono::steady_clock::now();
+  uint64_t steps = 0;
+  for (double t = 0; t < endS; t += dtS, steps++) {
+    const double lux = o.csv ? csv.sample(t) : wx.sample(t, dtS);
+    const bool failed = o.failH >= 0 && t >= o.failH * 3600;
+    const bool stuck = o.stuckH >= 0 && t >= o.stuckH * 3600;
+    const bool lit = (lamp || stuck) && !failed;
+    const int ma = lit ? LAMP_MA + lampNoise(lampRng) : 0;
+    if ((failed || stuck) && faultAtS < 0) faultAtS = t;
+
+    lamp = aviLogicStep(adcLux(lux), (uint16_t)ma, o.threshold, (uint32_t)(t * 1000.0 + 0.5));
+    const AviStatus& st = aviLogicStatus();
+    if (st.fault && faultAtS >= 0 && raisedAtS < 0) raisedAtS = t;
+
+    const AviMode dn = st.mode == AVI_NIGHT ? AVI_NIGHT : AVI_DAY;
+    if (dn != lastMode) {
+      if (lastMode != AVI_TEST) {
+        daySwitches++;
+        if (t - lastSwitchS < 1800) chatter++;
+        lastSwitchS = t;
+      }
+      (dn == AVI_NIGHT ? onS : offS) = t;
+      if (o.trace) {
+        char b[8]; hhmm(b, sizeof(b), t);
+        std::printf("  d%-3d %s %s lux=%u\n", (int)(t / DAY_S), b,
+                    dn == AVI_NIGHT ? "ON " : "OFF", st.filteredLux);
+      }
+      lastMode = dn;
+    }
+
+    // Day report at midnight
+    if (std::fmod(t + dtS, DAY_S) < dtS || t + dtS >= endS) {
+      char a[8] = "--:--", b[8] = "--:--";
+      if (offS >= 0) hhmm(a, sizeof(a), offS);
+      if (onS >= 0) hhmm(b, sizeof(b), onS);
+      std::printf("%-4d %-6s %-6s %-8u %u/%u%s\n", (int)(t / DAY_S), b, a, daySwitches,
+                  st.testsPassed, st.testsFailed, st.fault ? "  FAULT" : "");
+      if (daySwitches > maxDaySwitches) maxDaySwitches = daySwitches;
+      daySwitches = 0;
+      onS = offS = -1;
+    }
+  }
+  const double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+
+  const AviStatus& st = aviLogicStatus();
+  std::printf("switches=%u max_per_day=%u chatter(<30min)=%u tests=%u/%u\n",
+              st.switches, maxDaySwitches, chatter, st.testsPassed, st.testsFailed);
+  if (faultAtS >= 0) {
+    if (raisedAtS >= 0) std::printf("lamp fault injected at %.1f h, alarm after %.1f s\n",
+                                    faultAtS / 3600, raisedAtS - faultAtS);
+    else                std::printf("lamp fault injected at %.1f h, alarm NOT raised\n", faultAtS / 3600);
+  }
+  std::printf("simulated %.0f s in %.2f s (%.0fx real time, %llu steps)\n",
+              endS, wallS, wallS > 0 ? endS / wallS : 0.0, (unsigned long long)steps);
+  return raisedAtS < 0 && faultAtS >= 0 ? 1 : 0;
+}
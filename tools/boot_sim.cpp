@@ -0,0 +1,139 @@
+// Host model of the boot timeline (BootPlan.h), legacy against staged.
+//
+// Legacy is the old setup(): wait for a USB serial host, then storage,
+// counters, bus, uiSetup() (begin() = init + a cleared 1 KB frame per
+// panel, password hash), all tasks and the link, then the scheduler; the
+// first frame goes out in the first uiLoop(). Staged is bootRun(): bus and
+// splash first, tasks, then uiSetup() in the UI task, and the DEFERRED
+// steps in the boot task, which only gets the UI's idle share of the CPU.
+//
+// Step costs are BootPlan.h's estimates unless --log gives a capture of the
+// firmware's "BOOT <step> ... dur_us=<d>" lines (measured values win; the
+// measured first_frame/interactive/done line is printed next to the model).
+//
+// Prints first frame, time to interactive (the UI loop runs) and done (all
+// steps finished) for both. Exits 1 if the staged path is not faster to
+// the first frame and to interactive with a host attached at once.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/boot_sim.cpp -o boot_sim
+// Usage: ./boot_sim [--usb-ms 0 | --no-usb] [--ui-load 0.3] [--no-door]
+//                   [--log boot.txt]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "BootPlan.h"
+
+// Costs the plan does not list (400 kHz I2C, 128x64 panel)
+static const double CLEAR_FRAME_US = 24000;   // begin(): clearDisplay() sends a full frame
+static const double FRAME_US = 25000;         // render + send one full frame
+static const double SCHED_US = 200;           // vTaskStartScheduler() to the first task
+static const double NEVER = -1;
+
+struct Options {
+  double usbMs = 0;           // host opens the port after this; NEVER = no USB
+  double uiLoad = 0.3;        // UI task CPU share while the boot task runs
+  bool door = true;           // DISPLAY2_ENABLE
+  const char* log = nullptr;
+};
+
+struct Timeline { double firstFrame, interactive, done; };
+
+static double cost[BOOT_STEP_COUNT];
+
+static double sumCtx(BootCtx c){
+  double t = 0;
+  for (uint8_t i = 0; i < BOOT_STEP_COUNT; i++) if (BOOT_STEP_INFO_TABLE[i].ctx == c) t += cost[i];
+  return t;
+}
+
+static Timeline legacy(const Options& o){
+  if (o.usbMs == NEVER) return { NEVER, NEVER, NEVER };   // while(!Serial) never returns
+  // The splash step's panel init is part of begin(); its frame is not
+  const double splashInit = cost[BOOT_SPLASH] - FRAME_US > 0 ? cost[BOOT_SPLASH] - FRAME_US : 0;
+  double t = o.usbMs * 1000;
+  t += cost[BOOT_STORAGE] + cost[BOOT_COUNTERS] + cost[BOOT_I2C];
+  t += splashInit + CLEAR_FRAME_US + cost[BOOT_UI] + cost[BOOT_PASSWORD];   // uiSetup()
+  if (o.door) t += splashInit + CLEAR_FRAME_US;
+  t += cost[BOOT_TASKS] + cost[BOOT_REMOTE] + SCHED_US;
+  return { t + FRAME_US, t, t };
+}
+
+static Timeline staged(const Options& o){
+  const double firstFrame = cost[BOOT_I2C] + cost[BOOT_SPLASH];
+  const double setup = sumCtx(BOOT_CTX_SETUP);
+  const double interactive = setup + SCHED_US + sumCtx(BOOT_CTX_UI);
+  // The boot task starts with the scheduler but runs only while the UI
+  // task blocks: until interactive it gets nothing, then the idle share
+  const double done = interactive + sumCtx(BOOT_CTX_DEFERRED) / (1.0 - o.uiLoad);
+  return { firstFrame, interactive, done };
+}
+
+static void readLog(const char* path){
+  FILE* f = std::fopen(path, "r");
+  if (!f) {
+    std::fprintf(stderr, "cannot open %s\n", path);
+    std::exit(2);
+  }
+  char line[160], name[32];
+  unsigned long v1, v2, v3;
+  while (std::fgets(line, sizeof(line), f)) {
+    if (std::sscanf(line, "BOOT first_frame_us=%lu interactive_us=%lu done_us=%lu", &v1, &v2, &v3) == 3) {
+      std::printf("measured   first_frame %8.1f ms  interactive %8.1f ms  done %8.1f ms\n",
+                  v1 / 1e3, v2 / 1e3, v3 / 1e3);
+      continue;
+    }
+    if (std::sscanf(line, "BOOT %31s ctx=%*s start_us=%lu dur_us=%lu", name, &v1, &v2) != 3) continue;
+    for (uint8_t i = 0; i < BOOT_STEP_COUNT; i++) {
+      if (!std::strcmp(name, BOOT_STEP_INFO_TABLE[i].name)) cost[i] = (double)v2;
+    }
+  }
+  std::fclose(f);
+}
+
+static void print(const char* name, const Timeline& t){
+  if (t.firstFrame == NEVER) {
+    std::printf("%-10s never boots (no USB host)\n", name);
+    return;
+  }
+  std::printf("%-10s first_frame %8.1f ms  interactive %8.1f ms  done %8.1f ms\n",
+              name, t.firstFrame / 1e3, t.interactive / 1e3, t.done / 1e3);
+}
+
+int main(int argc, char** argv){
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--usb-ms") && more)       o.usbMs = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--no-usb"))          o.usbMs = NEVER;
+    else if (!std::strcmp(argv[i], "--ui-load") && more) o.uiLoad = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--no-door"))         o.door = false;
+    else if (!std::strcmp(argv[i], "--log") && more)     o.log = argv[++i];
+    else {
+      std::fprintf(stderr, "usage: %s [--usb-ms N | --no-usb] [--ui-load F] [--no-door] [--log FILE]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (o.uiLoad < 0) o.uiLoad = 0;
+  if (o.uiLoad > 0.95) o.uiLoad = 0.95;
+
+  for (uint8_t i = 0; i < BOOT_STEP_COUNT; i++) cost[i] = BOOT_STEP_INFO_TABLE[i].estUs;
+  if (o.log) readLog(o.log);
+
+  std::printf("%-9s %-9s %s\n", "step", "ctx", "cost_us");
+  for (uint8_t i = 0; i < BOOT_STEP_COUNT; i++) {
+    std::printf("%-9s %-9s %.0f\n", BOOT_STEP_INFO_TABLE[i].name,
+                bootCtxName(BOOT_STEP_INFO_TABLE[i].ctx), cost[i]);
+  }
+
+  const Timeline l = legacy(o), s = staged(o);
+  print("legacy", l);
+  print("staged", s);
+
+  // The gate compares with a host attached at once: the legacy best case
+  Options now = o;
+  now.usbMs = 0;
+  const Timeline best = legacy(now);
+  const bool ok = s.firstFrame < best.firstFrame && s.interactive < best.interactive;
+  if (!ok) std::printf("FAIL: staged boot is not faster than legacy with a host attached\n");
+  return ok ? 0 : 1;
+}
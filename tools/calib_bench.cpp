@@ -0,0 +1,131 @@
+// Host benchmark for the sensor linearization (CalibLogic.cpp).
+//
+// For every LUT spacing from CAL_LUT_SHIFT up to 8 (build with
+// -DCAL_LUT_SHIFT=4 to also try finer tables) prints the table RAM, the
+// worst error against exact Steinhart-Hart over every ADC code that reads
+// -40..125 C, and the time per sample for a block conversion, next to the
+// per-sample float (logf) and double (log) formula. The divider line is
+// checked the same way against float math.
+//
+// This host has an FPU; the MCU does log() in soft-float, so the speed-up
+// there is larger than shown (time it on target with UI_BENCH-style
+// micros() around calLutConvert if needed).
+//
+// Exits 1 if the default table misses --max-err (C) or the divider is off
+// by more than 1 mV.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/calib_bench.cpp CalibLogic.cpp -o calib_bench
+// Usage: ./calib_bench [--max-err 0.1] [--block 16]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "CalibLogic.h"
+
+static const uint32_t FULL = 1UL << CAL_ADC_BITS;
+static const int REPS = 4000;
+
+struct Options {
+  double maxErr = 0.1;
+  uint16_t block = 16;        // samples per conversion call (Sensors.h: SENSOR_BLOCK)
+};
+
+static std::vector<uint16_t> samples;   // random codes in the -40..125 C span
+static volatile int64_t sink;
+
+template<class F>
+static double nsPerSample(F convert, uint16_t block){
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < REPS; r++) {
+    for (size_t i = 0; i + block <= samples.size(); i += block) convert(&samples[i], block);
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+  return ns / REPS / (samples.size() / block * block);
+}
+
+static double exactC(uint16_t raw){
+  double ratio = (double)raw / FULL;
+  const double lnR = std::log(CAL_NTC_SERIES_OHM * ratio / (1.0 - ratio));
+  return 1.0 / (CAL_NTC_SH_A + CAL_NTC_SH_B * lnR + CAL_NTC_SH_C * lnR * lnR * lnR) - 273.15;
+}
+
+int main(int argc, char** argv){
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--max-err") && more)    o.maxErr = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--block") && more) o.block = (uint16_t)std::atoi(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--max-err C] [--block N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!o.block) o.block = 1;
+
+  // Codes that read inside the rated span
+  uint16_t lo = 1, hi = (uint16_t)(FULL - 1);
+  while (lo < hi && exactC(lo) > 125.0) lo++;
+  while (hi > lo && exactC(hi) < -40.0) hi--;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> code(lo, hi);
+  samples.resize(4096);
+  for (uint16_t& s : samples) s = (uint16_t)code(rng);
+  std::vector<int32_t> out(o.block);
+
+  std::printf("NTC %.0f ohm series, %u-bit ADC, codes %u..%u = 125..-40 C, block %u\n",
+              (double)CAL_NTC_SERIES_OHM, CAL_ADC_BITS, lo, hi, o.block);
+  std::printf("%-10s %-7s %-7s %-11s %s\n", "method", "points", "ram_B", "max_err_C", "ns/sample");
+
+  const double floatNs = nsPerSample([](const uint16_t* r, uint16_t n){
+    float acc = 0;
+    for (uint16_t i = 0; i < n; i++) acc += calNtcCelsius(r[i]);
+    sink += (int64_t)acc;
+  }, o.block);
+  const double doubleNs = nsPerSample([](const uint16_t* r, uint16_t n){
+    double acc = 0;
+    for (uint16_t i = 0; i < n; i++) acc += exactC(r[i]);
+    sink += (int64_t)acc;
+  }, o.block);
+  double floatErr = 0;
+  for (uint32_t r = lo; r <= hi; r++) floatErr = std::fmax(floatErr, std::fabs(calNtcCelsius((float)r) - exactC((uint16_t)r)));
+  std::printf("%-10s %-7s %-7s %-11.4f %.2f\n", "logf", "-", "-", floatErr, floatNs);
+  std::printf("%-10s %-7s %-7s %-11.4f %.2f\n", "log", "-", "-", 0.0, doubleNs);
+
+  int failures = 0;
+  static int32_t points[CAL_LUT_POINTS];
+  CalLut lut;
+  for (uint8_t shift = CAL_LUT_SHIFT; shift <= 8; shift++) {
+    lut = calBuildNtc(points, CAL_LUT_POINTS, 0, shift);
+    double err = 0;
+    for (uint32_t r = lo; r <= hi; r++) {
+      err = std::fmax(err, std::fabs(calLutEval(lut, (uint16_t)r) / 100.0 - exactC((uint16_t)r)));
+    }
+    const double ns = nsPerSample([&](const uint16_t* r, uint16_t n){
+      calLutConvert(lut, r, out.data(), n);
+      sink += out[0];
+    }, o.block);
+    char name[16];
+    std::snprintf(name, sizeof(name), "lut>>%u%s", shift, shift == CAL_LUT_SHIFT ? "*" : "");
+    std::printf("%-10s %-7u %-7u %-11.4f %.2f\n", name, lut.count, (unsigned)(lut.count * sizeof(int32_t)),
+                err, ns);
+    if (shift == CAL_LUT_SHIFT && err > o.maxErr) failures++;
+  }
+
+  // Divider: 0..60 V full scale, against the float line
+  lut = calBuildLinear(points, 120, 60000);
+  double vErr = 0;
+  for (uint32_t r = 0; r < FULL; r++) {
+    const double exact = 120 + (60000.0 - 120) * r / FULL;
+    vErr = std::fmax(vErr, std::fabs(calLutEval(lut, (uint16_t)r) - exact));
+  }
+  const double vNs = nsPerSample([&](const uint16_t* r, uint16_t n){
+    calLutConvert(lut, r, out.data(), n);
+    sink += out[0];
+  }, o.block);
+  std::printf("divider    2       8       %-9.3fmV %.2f\n", vErr, vNs);
+  if (vErr > 1.0) failures++;
+  return failures ? 1 : 0;
+}
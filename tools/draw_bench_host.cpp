@@ -0,0 +1,161 @@
+// Host variant of the UI_BENCH suite (DrawBench.cpp) for the drawing code
+// this tree owns.
+//
+// The primitives that live in U8g2 (drawXBMP, drawStr, drawBox, ...) need
+// the library and its fonts and are only timed on the target. This runs
+// the other cases with the same names and iteration count:
+//   iconDraw_24x24_cached  cache hit of a compressed 24x24 icon
+//   iconDraw_decode        the same six icons in turn, more than the cache
+//                          holds, so every fetch decodes
+//   iconDecode_<icon>      one bit-run decode per compressed icon
+//   fanSprite_frame_16x16  one generated fan frame, ~15 deg per call
+// minus the blit, and prints the JSON document drawBenchRun() prints, with
+// "timer":"chrono" and ns per operation.
+//
+// Also checks the tile cache: a random fetch sequence must return the
+// same bits as a fresh decode every time, and decode exactly when an LRU
+// model of ICON_CACHE_SLOTS slots misses. Exits 1 if not.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/draw_bench_host.cpp IconAtlasLogic.cpp FanSprite.cpp images.cpp -o draw_bench_host
+// Usage: ./draw_bench_host [--iters 200] [--reps 50]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "FanSprite.h"
+#include "IconAtlasLogic.h"
+#include "images.h"
+
+#ifndef UI_BENCH_ITERS
+#define UI_BENCH_ITERS 200
+#endif
+
+static volatile uint32_t sink;
+
+struct BenchCase {
+  const char* name;
+  void (*run)();
+};
+
+// ===== Cases (as in DrawBench.cpp) =====
+static void runIconHit24(){ sink += iconFetch(ICON_ID_ABOUT_24, nullptr)[0]; }
+
+static void runIconMiss(){
+  static const IconId ids[] = {
+    ICON_ID_ABOUT_24, ICON_ID_ALARMS_24, ICON_ID_SETTINGS_24, ICON_ID_STATUS_24,
+    ICON_ID_ABOUT_16, ICON_ID_LIGHT_16
+  };
+  static uint8_t k = 0;
+  sink += iconFetch(ids[k], nullptr)[0];
+  k = (uint8_t)((k + 1) % (sizeof(ids) / sizeof(ids[0])));
+}
+
+static void runFanFrame(){
+  static uint8_t out[32];
+  static uint16_t turn = 0;
+  fanSpriteRotate(bitmap_logo1, 16, 16, turn, FAN_SPRITE_ROTOR_R_16, out);
+  turn += 2731;
+  sink += out[0];
+}
+
+static IconId decodeId;
+static void runDecode(){
+  static uint8_t out[ICON_ATLAS_MAX_TILE_BYTES];
+  iconDecode(decodeId, out);
+  sink += out[0];
+}
+
+// Median of reps runs of iters calls, ns per call
+static double nsPerOp(void (*run)(), uint32_t iters, int reps){
+  run();                                           // warm-up
+  std::vector<double> t;
+  for (int r = 0; r < reps; r++) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iters; i++) run();
+    t.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / iters);
+  }
+  std::nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+  return t[t.size() / 2];
+}
+
+// ===== Cache check =====
+static int checkCache(){
+  std::vector<IconId> packed;
+  for (uint8_t i = 0; i < ICON_ID_COUNT; i++)
+    if (iconCompressed((IconId)i)) packed.push_back((IconId)i);
+
+  std::vector<IconId> lru;                          // most recent first
+  for (IconId id : packed) {                        // empty the cache of other ids
+    iconFetch(id, nullptr);
+    lru.erase(std::remove(lru.begin(), lru.end(), id), lru.end());
+    lru.insert(lru.begin(), id);
+    if (lru.size() > ICON_CACHE_SLOTS) lru.pop_back();
+  }
+
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<size_t> pick(0, packed.size() - 1);
+  uint8_t fresh[ICON_ATLAS_MAX_TILE_BYTES];
+  int bad = 0;
+  for (int n = 0; n < 20000; n++) {
+    // Skewed towards a few icons, as a screen is
+    const IconId id = packed[pick(rng) % (n % 3 ? 3 : packed.size())];
+    const bool hit = std::find(lru.begin(), lru.end(), id) != lru.end();
+    bool decoded;
+    const uint8_t* bits = iconFetch(id, &decoded);
+    lru.erase(std::remove(lru.begin(), lru.end(), id), lru.end());
+    lru.insert(lru.begin(), id);
+    if (lru.size() > ICON_CACHE_SLOTS) lru.pop_back();
+
+    iconDecode(id, fresh);
+    const size_t bytes = (size_t)(iconWidth(id) + 7) / 8 * iconHeight(id);
+    if (decoded == hit || std::memcmp(bits, fresh, bytes) != 0) {
+      if (bad++ < 5)
+        std::fprintf(stderr, "FAIL: fetch %d of icon %u: %s (LRU model: %s), bits %s\n", n, id,
+                     decoded ? "decoded" : "cached", hit ? "hit" : "miss",
+                     std::memcmp(bits, fresh, bytes) ? "differ" : "match");
+    }
+  }
+  return bad;
+}
+
+int main(int argc, char** argv){
+  uint32_t iters = UI_BENCH_ITERS;
+  int reps = 50;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--iters") && more)     iters = (uint32_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--reps") && more) reps = std::atoi(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--iters N] [--reps N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!iters) iters = 1;
+  if (reps < 1) reps = 1;
+
+  const int bad = checkCache();
+
+  static const BenchCase CASES[] = {
+    {"iconDraw_24x24_cached", runIconHit24},
+    {"iconDraw_decode",       runIconMiss},
+    {"fanSprite_frame_16x16", runFanFrame},
+  };
+  std::printf("{\"clock_hz\":0,\"timer\":\"chrono\",\"iters\":%u,\"icon_cache_slots\":%d,\"results\":[",
+              iters, ICON_CACHE_SLOTS);
+  bool first = true;
+  for (const BenchCase& bc : CASES) {
+    std::printf("%s{\"name\":\"%s\",\"ns_per_op\":%.1f}", first ? "" : ",", bc.name, nsPerOp(bc.run, iters, reps));
+    first = false;
+  }
+  for (uint8_t i = 0; i < ICON_ID_COUNT; i++) {
+    if (!iconCompressed((IconId)i)) continue;
+    decodeId = (IconId)i;
+    std::printf(",{\"name\":\"iconDecode_%ux%u_%u\",\"ns_per_op\":%.1f}", iconWidth(decodeId),
+                iconHeight(decodeId), i, nsPerOp(runDecode, iters, reps));
+  }
+  std::printf("],\"cache_check\":\"%s\"}\n", bad ? "FAIL" : "ok");
+  return bad ? 1 : 0;
+}
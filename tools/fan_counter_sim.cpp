@@ -0,0 +1,165 @@
+// Host simulator for the persisted fan counters (FanCounterLogic.cpp).
+//
+// Runs both fans for years of simulated time: on/off periods of hours,
+// a random power level per run with sample noise, read as float watts the
+// way fanCountersService() reads fan1Power_W. Power fails at random; with
+// brown-out detection the PVD commit runs first, then the "reboot" reloads
+// what the last commit stored.
+//
+// Reports run time and energy against an exact reference (and against a
+// naive float kWh accumulator), what the power cuts lost, and the number
+// of commits = flash page erases, with the implied page life. Exits 1 if
+// the stored totals are off by more than the brown-out gap per cut or the
+// commits would wear the page out within --life years.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/fan_counter_sim.cpp FanCounterLogic.cpp -o fan_counter_sim
+// Usage: ./fan_counter_sim [--years 10] [--step-ms 5000] [--cuts 12] [--seed 1]
+//                          [--no-brownout] [--life 10] [--endurance 10000]
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "FanCounterLogic.h"
+
+static const double MS_PER_YEAR = 365.25 * 86400e3;
+
+struct Options {
+  double years = 10;
+  uint32_t stepMs = 5000;     // the firmware samples every UI loop (~25 ms)
+  double cutsPerYear = 12;
+  unsigned seed = 1;
+  bool brownout = true;
+  double lifeYears = 10;
+  uint32_t endurance = 10000; // erase cycles per flash page
+};
+
+struct FanModel {
+  bool on = false;
+  double untilMs = 0;
+  double levelW = 0;
+};
+
+static uint32_t toMw(float w){                      // as FanCounters.cpp
+  return w > 0 ? (uint32_t)std::lround(w * 1000.0f) : 0;
+}
+
+int main(int argc, char** argv){
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--years") && more)          o.years = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--step-ms") && more)   o.stepMs = (uint32_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--cuts") && more)      o.cutsPerYear = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--seed") && more)      o.seed = (unsigned)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--no-brownout"))       o.brownout = false;
+    else if (!std::strcmp(argv[i], "--life") && more)      o.lifeYears = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--endurance") && more) o.endurance = (uint32_t)std::atoi(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--years Y] [--step-ms MS] [--cuts N/yr] [--seed N] "
+                   "[--no-brownout] [--life Y] [--endurance N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!o.stepMs) o.stepMs = 1;
+
+  std::mt19937 rng(o.seed);
+  std::uniform_real_distribution<double> uni(0.0, 1.0);
+  std::exponential_distribution<double> onH(1.0 / 8), offH(1.0 / 4);
+  std::normal_distribution<double> noise(0.0, 0.05);
+  std::exponential_distribution<double> cutGap(o.cutsPerYear > 0 ? o.cutsPerYear / MS_PER_YEAR : 1e-30);
+
+  FanCounters c;
+  fanCountersInit(c, nullptr);
+  FanTotals stored[FAN_COUNTER_FANS] = {};
+  FanModel fans[FAN_COUNTER_FANS];
+
+  // Reference: exactly what the samples say (uJ, ms), and a float kWh sum
+  unsigned __int128 refUj[FAN_COUNTER_FANS] = {};
+  uint64_t refMs[FAN_COUNTER_FANS] = {};
+  float naiveKwh[FAN_COUNTER_FANS] = {};
+
+  const double endMs = o.years * MS_PER_YEAR;
+  double nextCut = cutGap(rng);
+  uint32_t commits[4] = {};
+  uint32_t cuts = 0;
+  double maxGapMs = 0;
+  double sinceCommitMs = 0;
+
+  for (double t = 0; t < endMs;) {
+    const uint32_t dt = (uint32_t)(o.stepMs * (0.9 + 0.2 * uni(rng)));
+    t += dt;
+    uint32_t mw[FAN_COUNTER_FANS];
+    for (uint8_t i = 0; i < FAN_COUNTER_FANS; i++) {
+      FanModel& f = fans[i];
+      while (t >= f.untilMs) {
+        f.on = !f.on;
+        f.untilMs += (f.on ? onH(rng) : offH(rng)) * 3600e3;
+        f.levelW = 8 + 22 * uni(rng);
+      }
+      const float w = f.on ? (float)(f.levelW * (1 + noise(rng))) : 0.1f;
+      mw[i] = toMw(w);
+      if (mw[i] >= FAN_COUNTER_RUN_MW) {
+        refUj[i] += (uint64_t)mw[i] * dt;
+        refMs[i] += dt;
+        naiveKwh[i] += w * (float)dt / 3.6e9f;
+      }
+    }
+    fanCountersStep(c, dt, mw);
+    sinceCommitMs += dt;
+
+    const FanCommitReason r = fanCountersCommitDue(c, false);
+    if (r != FC_NONE) {
+      std::memcpy(stored, c.fan, sizeof(stored));
+      fanCountersCommitted(c);
+      commits[r]++;
+      if (sinceCommitMs > maxGapMs) maxGapMs = sinceCommitMs;
+      sinceCommitMs = 0;
+    }
+
+    if (t >= nextCut) {
+      nextCut = t + cutGap(rng);
+      cuts++;
+      if (o.brownout && fanCountersCommitDue(c, true) == FC_BROWNOUT) {
+        std::memcpy(stored, c.fan, sizeof(stored));
+        fanCountersCommitted(c);
+        commits[FC_BROWNOUT]++;
+        sinceCommitMs = 0;
+      }
+      // Reboot from flash; the reference keeps what really ran
+      fanCountersInit(c, stored);
+    }
+  }
+  std::memcpy(stored, c.fan, sizeof(stored));       // final reading, not a commit
+
+  std::printf("%.1f years, sample %lu ms, %u power cuts, brown-out commit %s\n", o.years,
+              (unsigned long)o.stepMs, cuts, o.brownout ? "on" : "off");
+  std::printf("%-4s %-12s %-12s %-10s %-14s %-14s %-12s %s\n", "fan", "run_h", "lost_run_s",
+              "lost_ppm", "energy_kWh", "lost_kWh", "naive_kWh", "naive_err_%");
+  int failures = 0;
+  // A brown-out commit can be refused for FAN_COUNTER_BROWNOUT_GAP_S after
+  // the previous commit; without brown-out a cut loses up to COMMIT_H
+  const double allowMs = (o.brownout ? FAN_COUNTER_BROWNOUT_GAP_S * 1000.0
+                                     : FAN_COUNTER_COMMIT_H * 3600e3) * (cuts + 1);
+  for (uint8_t i = 0; i < FAN_COUNTER_FANS; i++) {
+    const double refKwh = (double)refUj[i] / 3.6e12;
+    const double gotKwh = (double)stored[i].energyUj / 3.6e12;
+    const double lostS = (double)(refMs[i] - stored[i].runMs) / 1000.0;
+    const double lostPpm = refMs[i] ? lostS * 1e9 / (double)refMs[i] : 0;
+    std::printf("%-4u %-12.1f %-12.1f %-10.1f %-14.4f %-14.6f %-12.4f %.3f\n", i + 1,
+                stored[i].runMs / 3600e3, lostS, lostPpm, gotKwh, refKwh - gotKwh, naiveKwh[i],
+                refKwh > 0 ? 100.0 * (naiveKwh[i] - refKwh) / refKwh : 0.0);
+    if (stored[i].runMs > refMs[i] || stored[i].energyUj > refUj[i]) failures++;
+    if (lostS * 1000.0 > allowMs) failures++;
+  }
+
+  const uint32_t total = commits[FC_DELTA] + commits[FC_TIME] + commits[FC_BROWNOUT];
+  const double perYear = total / o.years;
+  std::printf("commits: %u (delta %u, time %u, brown-out %u), %.0f/year, longest gap %.1f h\n",
+              total, commits[FC_DELTA], commits[FC_TIME], commits[FC_BROWNOUT], perYear,
+              maxGapMs / 3600e3);
+  std::printf("page life at %lu erases: %.1f years (target %.0f)\n", (unsigned long)o.endurance,
+              perYear > 0 ? o.endurance / perYear : 1e9, o.lifeYears);
+  if (perYear * o.lifeYears > o.endurance) failures++;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+// Host report for the procedural fan frames (FanSprite.h).
+//
+// For 4, 8 and 16 frames per cycle: builds the frame set from the master
+// icon (images.cpp) and prints
+//   - RAM for the frame cache vs flash for storing the same frames,
+//   - build time on this host (the target is timed by UI_BENCH),
+//   - pixels changed per frame step on average, and the seam: pixels that
+//     differ between one blade period on and frame 0. A seam well above
+//     the step shows as a jump at the cycle wrap (try --blades 1).
+// --show prints the frames as ASCII art.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/fan_sprite_report.cpp FanSprite.cpp images.cpp -o fan_sprite_report
+// Usage: ./fan_sprite_report [--blades 3] [--rotor 6] [--show]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "FanSprite.h"
+#include "images.h"
+
+static const uint8_t W = 16, H = 16;
+static const uint16_t FRAME_BYTES = (W + 7) / 8 * H;
+static const uint16_t LUT_BYTES = 17 * 2;            // QUARTER_SIN in FanSprite.cpp
+
+struct Options {
+  uint8_t blades = FAN_SPRITE_BLADES;
+  uint8_t rotor = FAN_SPRITE_ROTOR_R_16;
+  bool show = false;
+};
+
+static void show(const uint8_t* const* frames, uint8_t n){
+  for (uint8_t y = 0; y < H; y++) {
+    for (uint8_t i = 0; i < n; i++) {
+      for (uint8_t x = 0; x < W; x++) std::putchar((frames[i][y * 2 + (x >> 3)] >> (x & 7)) & 1 ? '#' : '.');
+      std::putchar(' ');
+    }
+    std::putchar('\n');
+  }
+  std::putchar('\n');
+}
+
+static int pixelDiff(const uint8_t* a, const uint8_t* b){
+  int d = 0;
+  for (uint16_t i = 0; i < FRAME_BYTES; i++) d += __builtin_popcount(a[i] ^ b[i]);
+  return d;
+}
+
+template<uint8_t N>
+static void report(const Options& o){
+  static FanSpriteSet<W, H, N> set;
+  const int reps = 20000;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < reps; r++) {
+    set.build(bitmap_logo1, o.blades, o.rotor);
+    __asm__ volatile("" ::: "memory");
+  }
+  const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+
+  uint8_t wrap[FRAME_BYTES];
+  fanSpriteRotate(bitmap_logo1, W, H, (uint16_t)(65536UL / o.blades), o.rotor, wrap);
+  int steps = 0;
+  for (uint8_t i = 0; i < N; i++) steps += pixelDiff(set.frames[i], i + 1 < N ? set.frames[i + 1] : wrap);
+  const unsigned ram = sizeof(set);
+  std::printf("%-6u %-9.1f %-9u %-13u %-12u %-8.2f %-8.1f %d\n", N, 360.0 / (N * o.blades), ram,
+              FRAME_BYTES + LUT_BYTES, N * FRAME_BYTES, us, (double)steps / N,
+              pixelDiff(wrap, set.frames[0]));
+  if (o.show) show(set.frames, N);
+}
+
+int main(int argc, char** argv){
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--blades") && more)     o.blades = (uint8_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--rotor") && more) o.rotor = (uint8_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--show"))          o.show = true;
+    else {
+      std::fprintf(stderr, "usage: %s [--blades B] [--rotor R] [--show]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!o.blades) o.blades = 1;
+
+  std::printf("%ux%u fan, %u blade period(s) per turn, rotor r=%u px\n", W, H, o.blades, o.rotor);
+  std::printf("(flash: generated = master + sine table, code not counted; stored = N frames)\n");
+  std::printf("%-6s %-9s %-9s %-13s %-12s %-8s %-8s %s\n", "frames", "step_deg", "ram_B",
+              "flash_gen_B", "flash_rom_B", "host_us", "step_px", "seam_px");
+  report<4>(o);
+  report<8>(o);
+  report<16>(o);
+  return 0;
+}
@@ -0,0 +1,237 @@
+// Host check for the fan tach math (FanTachLogic.cpp) and the animation
+// phase accumulator (FanPhase.h).
+//
+// Generates tach pulse trains the way the capture timer would see them
+// (1 us ticks, 32-bit wrap, per-edge jitter, contact-bounce glitches),
+// reads them at UI loop intervals like fanTachService() does and checks:
+//   - steady speeds are measured within --tol percent,
+//   - a spin-down reaches 0 and raises the stall after FAN_TACH_STALL_MS,
+//   - the icon phase after N seconds matches rpm * N / FAN_ANIMATOR_RPM_DIV
+//     cycles to within one frame,
+//   - with the panel OFF (capture windows, the timer halted by STOP in
+//     between, the UI loop every second) the timer runs about
+//     FAN_TACH_OFF_WINDOW_MS / FAN_TACH_OFF_PERIOD_MS of the time, a running
+//     fan reads right in every window, a fan that stops raises the stall
+//     within the next window and keeps it raised (one rising edge) until it
+//     turns again.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/fan_tach_sim.cpp FanTachLogic.cpp -o fan_tach_sim
+// Usage: ./fan_tach_sim [--seed 1] [--jitter-us 40] [--loop-ms 30] [--tol 0.5] [--trace]
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "FanTachLogic.h"
+#include "FanPhase.h"
+
+static const uint8_t FRAMES = 4;                    // fan icon frames
+
+struct Options {
+  unsigned seed = 1;
+  double jitterUs = 40;
+  uint32_t loopMs = 30;
+  double tolPct = 0.5;
+  bool trace = false;
+};
+
+// Pulse source: ideal edges at the true speed, each captured with
+// independent timing noise (slow tach slopes, comparator noise)
+struct TachGen {
+  std::mt19937 rng;
+  double jitterUs;
+  double nextUs;            // ideal time of the next edge
+  explicit TachGen(unsigned seed, double jitter, double startUs)
+    : rng(seed), jitterUs(jitter), nextUs(startUs) {}
+  double gauss(){ return std::normal_distribution<double>(0, 1)(rng); }
+};
+
+struct Rig {
+  TachEdges edges{};
+  TachState state{};
+  uint32_t phase = 0;
+  uint32_t glitchesInjected = 0;
+};
+
+static int failures = 0;
+static void check(bool ok, const char* what, double got, double want){
+  std::printf("%-34s got %10.2f want %10.2f  %s\n", what, got, want, ok ? "ok" : "FAIL");
+  if (!ok) failures++;
+}
+
+// Run for durS seconds; rpmAt(tS) gives the true speed. Returns the rpm
+// reported at the end. The clock starts just below the 32-bit wrap.
+template<class F>
+static uint16_t run(Rig& r, TachGen& g, const Options& o, double& tUs, double durS, F rpmAt,
+                    bool glitches, double* phaseCycles = nullptr){
+  const double endUs = tUs + durS * 1e6;
+  double animCycles = 0;
+  std::uniform_real_distribution<double> uni(0, 1);
+  while (tUs < endUs) {
+    const double loopEnd = tUs + o.loopMs * 1000.0;
+    // Edges within this UI loop go through the "ISR"
+    for (;;) {
+      const double rpm = rpmAt(g.nextUs / 1e6);
+      if (rpm <= 0) { g.nextUs = loopEnd + 1; break; }   // stopped: re-test next loop
+      if (g.nextUs >= loopEnd) break;
+      const double edgeUs = g.nextUs + g.gauss() * g.jitterUs;
+      tachEdge(r.edges, (uint32_t)(uint64_t)edgeUs);
+      if (glitches && uni(g.rng) < 0.02) {            // bounce right after the edge
+        tachEdge(r.edges, (uint32_t)(uint64_t)(edgeUs + 3));
+        r.glitchesInjected++;
+      }
+      g.nextUs += 60e6 / (rpm * FAN_TACH_PPR);
+    }
+    tUs = loopEnd;
+    const uint32_t nowUs = (uint32_t)(uint64_t)tUs;
+    const TachEdges w = tachTake(r.edges);
+    const uint16_t rpm = tachUpdate(r.state, w, nowUs);
+    r.phase = fanPhaseAdvance(r.phase, fanPhaseRateRpm(rpm), o.loopMs);
+    animCycles += (double)fanPhaseRateRpm(rpm) * o.loopMs / 4294967296.0;
+    if (o.trace) std::printf("  t=%9.3f s rpm=%5u stalled=%d frame=%u\n", tUs / 1e6, rpm,
+                             r.state.stalled, fanPhaseFrame(r.phase, FRAMES));
+  }
+  if (phaseCycles) *phaseCycles = animCycles;
+  return r.state.rpm;
+}
+
+static bool parse(int argc, char** argv, Options& o){
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--seed") && more)           o.seed = (unsigned)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--jitter-us") && more) o.jitterUs = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--loop-ms") && more)   o.loopMs = (uint32_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--tol") && more)       o.tolPct = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--trace"))             o.trace = true;
+    else return false;
+  }
+  return o.loopMs > 0;
+}
+
+int main(int argc, char** argv){
+  Options o;
+  if (!parse(argc, argv, o)) {
+    std::fprintf(stderr, "usage: %s [--seed S] [--jitter-us J] [--loop-ms L] [--tol PCT] [--trace]\n", argv[0]);
+    return 2;
+  }
+
+  // ----- Steady speeds, across the 32-bit clock wrap -----
+  static const double SPEEDS[] = { 250, 600, 1200, 2400, 3000, 4800, 9000 };
+  for (double rpm : SPEEDS) {
+    Rig r;
+    double tUs = 4294967296.0 - 2e6;
+    tachReset(r.state, (uint32_t)(uint64_t)tUs);
+    TachGen g(o.seed, o.jitterUs, tUs + 1000);
+    run(r, g, o, tUs, 2.0, [&](double){ return rpm; }, true);  // settle
+    const uint32_t phase0 = r.phase;
+    double cycles = 0;
+    const double durS = 4.0;
+    // Average the reported rpm over the run (what the menu field shows)
+    double sum = 0; int n = 0;
+    const double t0Us = tUs;
+    for (double s = 0; s < durS; s += 0.5) {
+      double c = 0;
+      sum += run(r, g, o, tUs, 0.5, [&](double){ return rpm; }, true, &c);
+      cycles += c; n++;
+    }
+    char what[48];
+    std::snprintf(what, sizeof(what), "rpm %.0f (%u glitches)", rpm, r.glitchesInjected);
+    check(std::fabs(sum / n - rpm) <= rpm * o.tolPct / 100, what, sum / n, rpm);
+
+    // Icon cycles: expected rpm/DIV per minute (runs end on a loop boundary)
+    const double ranS = (tUs - t0Us) / 1e6;
+    const double wantCycles = rpm / FAN_ANIMATOR_RPM_DIV * ranS / 60.0;
+    const double gotFrames = cycles * FRAMES;
+    std::snprintf(what, sizeof(what), "  frames in %.2f s", ranS);
+    check(std::fabs(gotFrames - wantCycles * FRAMES) <= 1.0, what, gotFrames, wantCycles * FRAMES);
+    const uint8_t wantFrame = (uint8_t)((uint64_t)std::floor(
+        ((double)phase0 / 4294967296.0 + cycles) * FRAMES) % FRAMES);
+    check(fanPhaseFrame(r.phase, FRAMES) == wantFrame, "  frame from phase",
+          fanPhaseFrame(r.phase, FRAMES), wantFrame);
+  }
+
+  // ----- Spin-down to a stall -----
+  {
+    Rig r;
+    double tUs = 1e6;
+    tachReset(r.state, (uint32_t)tUs);
+    TachGen g(o.seed + 7, o.jitterUs, tUs + 500);
+    run(r, g, o, tUs, 2.0, [](double){ return 3000.0; }, false);
+    const double offS = tUs / 1e6;
+    // Coasts down over ~4 s, then stops
+    auto coast = [&](double tS){ const double k = 1 - (tS - offS) / 4.0; return k > 0 ? 3000.0 * k : 0.0; };
+    double stopS = -1, stallS = -1;
+    while (tUs / 1e6 < offS + 15) {
+      const uint16_t rpm = run(r, g, o, tUs, o.loopMs / 1000.0, coast, false);
+      if (rpm == 0 && stopS < 0) stopS = tUs / 1e6 - offS;
+      if (r.state.stalled && stallS < 0) stallS = tUs / 1e6 - offS;
+    }
+    // True speed crosses FAN_TACH_MIN_RPM at 4*(1-MIN/3000) s
+    const double slowS = 4.0 * (1 - FAN_TACH_MIN_RPM / 3000.0);
+    check(stopS >= 0 && stopS < 4.5, "spin-down reads 0 after (s)", stopS, 4.0);
+    check(stallS >= 0 && std::fabs(stallS - slowS - FAN_TACH_STALL_MS / 1000.0) < 0.5,
+          "stall raised after (s)", stallS, slowS + FAN_TACH_STALL_MS / 1000.0);
+
+    // Restart clears it
+    run(r, g, o, tUs, 1.0, [](double){ return 1500.0; }, false);
+    check(!r.state.stalled && std::fabs(r.state.rpm - 1500.0) < 1500 * o.tolPct / 100,
+          "restart clears stall, rpm", r.state.rpm, 1500);
+  }
+
+  // ----- Capture windows, panel OFF -----
+  {
+    TachEdges edges{};
+    TachState st{};
+    TachDuty duty;
+    const double stopS = 200, restartS = 400, endS = 600;
+    auto rpmAt = [&](double tS){ return tS >= stopS && tS < restartS ? 0.0 : 1800.0; };
+    std::mt19937 rng(o.seed + 11);
+    std::normal_distribution<double> noise(0, 1);
+    double haltedUs = 0, offRunUs = 0, nextEdgeS = 0.001;
+    uint32_t raised = 0, badReads = 0;
+    double stallS = -1, clearS = -1;
+    bool wasStalled = false, running = true;
+    tachReset(st, 0);
+    tachDutyReset(duty, 0);
+    // Panel on for the first 10 s (UI loop every 30 ms), then OFF (1 s slices)
+    for (double tS = 0; tS < endS;) {
+      const double stepS = tS < 10 ? o.loopMs / 1000.0 : 1.0;
+      const double endStepS = tS + stepS;
+      // Edges over the step; none captured while the timer stands still
+      for (; nextEdgeS < endStepS; ) {
+        const double rpm = rpmAt(nextEdgeS);
+        if (rpm <= 0) { nextEdgeS = endStepS; break; }
+        if (running) tachEdge(edges, (uint32_t)(uint64_t)(nextEdgeS * 1e6 - haltedUs + noise(rng) * o.jitterUs));
+        nextEdgeS += 60.0 / (rpm * FAN_TACH_PPR);
+      }
+      if (!running) haltedUs += stepS * 1e6;
+      else if (tS >= 10) offRunUs += stepS * 1e6;
+      tS = endStepS;
+      const uint32_t nowMs = (uint32_t)(tS * 1000 + 0.5);
+      bool opened;
+      running = tachDutyTick(duty, tS < 10, nowMs, &opened);
+      if (!running) continue;
+      const uint32_t capUs = (uint32_t)(uint64_t)(tS * 1e6 - haltedUs);
+      if (opened) { edges = {}; tachResume(st, capUs); }
+      tachUpdate(st, tachTake(edges), capUs);
+      // A running fan reads right once a window had time for a reading
+      const bool fanOn = rpmAt(tS) > 0 && (tS < stopS || tS > restartS + 1);
+      if (fanOn && nowMs - duty.sinceMs >= 1000 && std::fabs(st.rpm - 1800.0) > 1800 * 2 * o.tolPct / 100) badReads++;
+      if (st.stalled && !wasStalled) { raised++; if (stallS < 0) stallS = tS; }
+      if (!st.stalled && wasStalled && clearS < 0) clearS = tS;
+      wasStalled = st.stalled;
+    }
+    const double wantDuty = (double)FAN_TACH_OFF_WINDOW_MS / FAN_TACH_OFF_PERIOD_MS;
+    const double gotDuty = offRunUs / ((endS - 10) * 1e6);
+    check(std::fabs(gotDuty - wantDuty) < 0.05, "OFF: timer running share", gotDuty, wantDuty);
+    check(badReads == 0, "OFF: wrong rpm in a window", badReads, 0);
+    check(raised == 1, "OFF: stall raised (times)", raised, 1);
+    check(stallS > stopS && stallS <= stopS + FAN_TACH_OFF_PERIOD_MS / 1000.0 + FAN_TACH_OFF_WINDOW_MS / 1000.0,
+          "OFF: stall after stop (s)", stallS - stopS, FAN_TACH_OFF_PERIOD_MS / 1000.0);
+    check(clearS > restartS && clearS <= restartS + FAN_TACH_OFF_PERIOD_MS / 1000.0 + 1,
+          "OFF: stall cleared after restart (s)", clearS - restartS, FAN_TACH_OFF_PERIOD_MS / 1000.0);
+  }
+
+  std::printf("%s\n", failures ? "FAN TACH FAIL" : "FAN TACH PASS");
+  return failures ? 1 : 0;
+}
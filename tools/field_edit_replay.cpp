@@ -0,0 +1,195 @@
+// Host replay of held field edits (FieldEdit.cpp) through the UI timing.
+//
+// For every accelerated field (MenuUI.cpp HOLD_FIELDS) holds Up from the
+// low limit and Down from the high limit the way the UI sees it: press,
+// EV_UP_HOLD_START after the 450 ms press time, then EV_UP_HOLD on every
+// UI loop (OneButton's during-long-press), fieldEditFlush() once per frame,
+// gStage read back after each flush as the panel would show it. Prints the
+// full-range time per field and direction, next to the UI_BENCH figure
+// (fieldEditFullRangeMs, from the hold start) and the old one-nav-command-
+// per-repeat path. Checks:
+//   range     the hold ends exactly on the limit, values move one way
+//   ramp      single base steps for the first FIELD_EDIT_FIRST_DECADE_MS,
+//             no step over a tenth of the range, at most one step a frame
+//   bench     the replay matches the UI_BENCH figure to within a frame
+//   budget    every full-range edit within --budget ms; by default the
+//             time the old path took for the narrowest field (TogglePeriod,
+//             0-100): no field may take longer to sweep than that did
+//   taps      a short hold moves a few base steps; a new hold after a long
+//             one starts again at the base step, from the staged value
+//             (which a remote write may have changed in between)
+//
+// Exits 1 on the first kind of failure it finds (all are counted).
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/field_edit_replay.cpp FieldEdit.cpp SettingsFields.cpp -o field_edit_replay
+// Usage: ./field_edit_replay [--budget MS]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include "AppData.h"
+#include "FieldEdit.h"
+#include "Strings.h"
+
+// What FieldEdit.cpp edits (AppData.cpp on the target)
+Settings gStage;
+
+static const uint16_t LOOP_MS = 5;        // UiTrace.h: UI_TRACE_LOOP_MS
+static const uint16_t FRAME_MS = 25;      // MenuUI.cpp, panel active
+static const uint16_t PRESS_MS = 450;     // MenuUI.cpp: setPressTicks(450)
+
+// MenuUI.cpp HOLD_FIELDS
+struct HoldField { const char* label; uint8_t id; uint16_t base; };
+static const HoldField HOLD_FIELDS[] = {
+  {S_TEMP_THR_LOW,  SF_TEMP_THR_L,    1}, {S_TEMP_THR_HIGH, SF_TEMP_THR_H,    1},
+  {S_TEMP_HIGH_THR, SF_TEMP_HIGH_THR, 1}, {S_VOLT_LOW_THR,  SF_VOLT_L_THR,    1},
+  {S_VOLT_HIGH_THR, SF_VOLT_HIGH_THR, 1}, {S_DIM_AFTER,     SF_DIM_AFTER,    10},
+  {S_OFF_AFTER,     SF_OFF_AFTER,    10}, {S_NOM_FAN1_CURR, SF_FAN1_NOMINAL,  1},
+  {S_NOM_FAN2_CURR, SF_FAN2_NOMINAL,  1}, {S_TOGGLE_PERIOD, SF_TOGGLE_PERIOD, 1},
+  {S_SLAVE_ID,      SF_SLAVE_ID,      1}, {S_AVI_LDR_THR,   SF_LDR_THRESHOLD, 1},
+  {S_PAGE_ROTATE,   SF_DASH_ROTATE,   5}, {S_CAL_VIN_GAIN,  SF_VIN_GAIN,     10},
+  {S_CAL_VIN_OFFSET,SF_VIN_OFFSET,   10}, {S_CAL_NTC_OFFSET,SF_NTC_OFFSET,    1},
+};
+
+// MenuUI.cpp accelInterval(): the repeat of the old nav-command path
+static uint16_t accelInterval(unsigned long heldMs){
+  if (heldMs > 2500) return 30;
+  if (heldMs > 1600) return 50;
+  if (heldMs > 1000) return 80;
+  if (heldMs > 600)  return 120;
+  return 160;
+}
+
+static int failures = 0;
+#define CHECK(c, ...) do { if (!(c)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static int32_t field(uint8_t id){ int32_t v = 0; settingsGetField(gStage, id, v); return v; }
+
+struct Hold {
+  unsigned long doneMs = 0;   // press to the frame that shows the target
+  int32_t maxFrameStep = 0;
+  int32_t maxEarlyStep = 0;   // within FIELD_EDIT_FIRST_DECADE_MS of the hold start
+  bool monotone = true;
+  int frames = 0;
+};
+
+// Hold one button from t0 for holdMs (0: until the target shows); the UI
+// loop runs every LOOP_MS and draws a frame every FRAME_MS
+static Hold replay(const HoldField& f, int8_t dir, unsigned long t0, unsigned long holdMs, int32_t target){
+  Hold h;
+  const unsigned long start = t0 + PRESS_MS;         // EV_*_HOLD_START
+  unsigned long lastFrame = t0;
+  int32_t shown = field(f.id);
+  for (unsigned long t = t0 + LOOP_MS; t < t0 + 600000UL; t += LOOP_MS) {
+    if (holdMs && t - t0 > holdMs) break;
+    if (t > start) fieldEditHold(f.id, f.base, dir, start, t);
+    if (t - lastFrame >= FRAME_MS) {
+      lastFrame = t;
+      fieldEditFlush();
+      const int32_t v = field(f.id);
+      const int32_t d = (v - shown) * dir;
+      if (d < 0) h.monotone = false;
+      if (d > h.maxFrameStep) h.maxFrameStep = d;
+      if (t - start <= FIELD_EDIT_FIRST_DECADE_MS && d > h.maxEarlyStep) h.maxEarlyStep = d;
+      shown = v;
+      h.frames++;
+      if (!holdMs && v == target) { h.doneMs = t - t0; break; }
+    }
+  }
+  fieldEditFlush();
+  return h;
+}
+
+// One nav command per accelerated repeat (what a hold did before the ramp)
+static unsigned long navPathMs(int32_t steps){
+  unsigned long t = 0, last = 0;
+  for (int32_t n = 0; n < steps; ) {
+    t += LOOP_MS;
+    if (t - last >= accelInterval(t)) { last = t; n++; }
+  }
+  return PRESS_MS + t;
+}
+
+int main(int argc, char** argv){
+  unsigned long budget = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--budget") && i + 1 < argc) budget = strtoul(argv[++i], nullptr, 10);
+  }
+  const char* budgetFrom = "--budget";
+  if (!budget) {
+    for (const HoldField& f : HOLD_FIELDS) {
+      int32_t lo, hi;
+      if (!settingsFieldRange(f.id, lo, hi)) continue;
+      const unsigned long nav = navPathMs((hi - lo + f.base - 1) / f.base);
+      if (!budget || nav < budget) { budget = nav; budgetFrom = f.label; }
+    }
+  }
+
+  printf("%-13s %7s %7s %5s  %8s %8s %8s %9s\n", "field", "lo", "hi", "base",
+         "up ms", "down ms", "bench", "nav ms");
+  unsigned long t = 0, worst = 0;
+  const char* worstName = "";
+  for (const HoldField& f : HOLD_FIELDS) {
+    int32_t lo, hi;
+    CHECK(settingsFieldRange(f.id, lo, hi), "%s: no range", f.label);
+    const int32_t limit = (hi - lo) / 10 > f.base ? (hi - lo) / 10 : f.base;
+
+    settingsSetField(gStage, f.id, lo);
+    t += 10000;
+    const Hold up = replay(f, +1, t, 0, hi);
+    CHECK(field(f.id) == hi && up.doneMs, "%s: up hold ended at %ld, not %ld", f.label, (long)field(f.id), (long)hi);
+    t += 10000;
+    const Hold down = replay(f, -1, t, 0, lo);
+    CHECK(field(f.id) == lo && down.doneMs, "%s: down hold ended at %ld, not %ld", f.label, (long)field(f.id), (long)lo);
+
+    for (const Hold* h : { &up, &down }) {
+      const char* dn = h == &up ? "up" : "down";
+      CHECK(h->monotone, "%s %s: value moved backwards", f.label, dn);
+      CHECK(h->maxEarlyStep <= f.base, "%s %s: step %ld in the first %u ms (base %u)",
+            f.label, dn, (long)h->maxEarlyStep, (unsigned)FIELD_EDIT_FIRST_DECADE_MS, f.base);
+      CHECK(h->maxFrameStep <= limit, "%s %s: frame step %ld over a tenth of the range (%ld)",
+            f.label, dn, (long)h->maxFrameStep, (long)limit);
+      CHECK(h->doneMs <= budget, "%s %s: full range takes %lu ms (budget %lu)", f.label, dn, h->doneMs, budget);
+      if (h->doneMs > worst) { worst = h->doneMs; worstName = f.label; }
+    }
+
+    const unsigned long bench = fieldEditFullRangeMs(f.id, f.base, LOOP_MS);
+    const long gap = (long)up.doneMs - (long)(PRESS_MS + bench);
+    CHECK(gap >= 0 && gap <= FRAME_MS, "%s: replay %lu ms vs UI_BENCH %lu ms + press",
+          f.label, up.doneMs, bench);
+
+    printf("%-13s %7ld %7ld %5u  %8lu %8lu %8lu %9lu\n", f.label, (long)lo, (long)hi, f.base,
+           up.doneMs, down.doneMs, bench, navPathMs((hi - lo + f.base - 1) / f.base));
+  }
+
+  // Taps: a short hold moves a few base steps
+  for (const HoldField& f : HOLD_FIELDS) {
+    int32_t lo, hi;
+    settingsFieldRange(f.id, lo, hi);
+    settingsSetField(gStage, f.id, lo);
+    t += 10000;
+    replay(f, +1, t, PRESS_MS + 400, hi);
+    const int32_t moved = field(f.id) - lo;
+    CHECK(moved > 0 && moved <= 3 * f.base, "%s: a 400 ms hold moved %ld", f.label, (long)moved);
+  }
+
+  // A new hold after a long one starts again at the base step
+  {
+    const HoldField& f = HOLD_FIELDS[7];                // S_NOM_FAN1_CURR, the widest
+    settingsSetField(gStage, f.id, 0);
+    t += 10000;
+    replay(f, +1, t, PRESS_MS + 3000, 10000);
+    CHECK(field(f.id) > 1000 && field(f.id) < 10000, "%s: 3 s hold reached %ld", f.label, (long)field(f.id));
+    settingsSetField(gStage, f.id, 123);                 // remote write between the holds
+    t += PRESS_MS + 3000 + 200;
+    const Hold again = replay(f, +1, t, PRESS_MS + 600, 10000);
+    CHECK(again.maxFrameStep <= f.base, "%s: second hold started with step %ld", f.label, (long)again.maxFrameStep);
+    CHECK(field(f.id) > 123 && field(f.id) <= 123 + 5 * f.base, "%s: second hold went from 123 to %ld",
+          f.label, (long)field(f.id));
+  }
+
+  printf("slowest full-range edit: %s, %lu ms (budget %lu ms, %s; %lu%% margin)\n", worstName, worst,
+         budget, budgetFrom, worst < budget ? (budget - worst) * 100 / budget : 0);
+  printf("%s (%d failures)\n", failures ? "FAIL" : "OK", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Build per-language u8g2 font subsets (FontSubset.h) from the string tables.
+
+Reads Strings.h and every Lang_<code>.h next to it, collects the Latin-1
+glyphs each language can put on screen (its S_* strings, the shared FW_* /
+U_* strings, numeric output and ArduinoMenu decorations) and runs u8g2's
+bdfconv once per font role (see UiFonts.h) with just those glyphs. Build the
+firmware with -DUI_FONT_SUBSET=1 to use the result.
+
+Always prints a flash report per language: string table bytes, glyph count
+and, with --u8g2, subset vs full font bytes. Without --u8g2 nothing is
+written. --report measures without writing; --check fails if a string uses a
+glyph the role's BDF lacks.
+
+Needs a u8g2 checkout with tools/font/bdfconv built (make -C
+tools/font/bdfconv) and the BDF sources in tools/font/bdf.
+
+Usage: python3 tools/gen_font_subset.py [--u8g2 ~/u8g2] [--out .] [--report] [--check]
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# role macro -> (BDF file, bdfconv build mode, full font used without subsetting)
+# build mode: 0 = proportional (_t), 2 = monospace (_m)
+ROLES = [
+    ("UI_FONT_TITLE",  "7x14.bdf",  0, {"en": "7x14_tr",  None: "7x14_tf"}),
+    ("UI_FONT_VALUE",  "6x12.bdf",  0, {"en": "6x12_tr",  None: "6x12_tf"}),
+    ("UI_FONT_TILE",   "5x7.bdf",   0, {"en": "5x7_tr",   None: "5x7_tf"}),
+    ("UI_FONT_SMALL",  "4x6.bdf",   0, {"en": "4x6_tr",   None: "4x6_tf"}),
+    ("UI_FONT_MENU",   "6x10.bdf",  0, {"en": "6x10_tf",  None: "6x10_tf"}),
+    ("UI_FONT_DIALOG", "7x13B.bdf", 2, {"en": "7x13B_mf", None: "7x13B_tf"}),
+    ("UI_FONT_CUSTOM", "5x8.bdf",   0, {"en": "5x8_tf",   None: "5x8_tf"}),
+]
+
+# Drawn without going through the string tables
+NUMERIC = "0123456789.-+ "          # print(float), dashFormat, code digits, baud rates
+MENU_DECOR = "<>[]:*"               # ArduinoMenu cursor/edit marks
+
+DEFINE_RE = re.compile(r'^\s*#define\s+([A-Z][A-Z0-9_]*)\s+(.+?)\s*(?://.*)?$')
+TOKEN_RE = re.compile(r'"((?:[^"\\]|\\.)*)"|([A-Za-z_]\w*)')
+PRINTF_RE = re.compile(r'%[-+ 0#]*\d*(?:\.\d+)?(?:l|ll|h)?[diuxXs]')
+
+
+def unescape(body):
+    """C string literal body -> Latin-1 text (\\x and simple escapes only)."""
+    out, i = [], 0
+    while i < len(body):
+        c = body[i]
+        if c != "\\":
+            out.append(c)
+            i += 1
+            continue
+        n = body[i + 1]
+        if n == "x":
+            m = re.match(r"[0-9a-fA-F]+", body[i + 2:])
+            out.append(chr(int(m.group(0), 16)))
+            i += 2 + len(m.group(0))
+        else:
+            out.append({"n": "\n", "t": "\t", "\\": "\\", '"': '"', "'": "'"}.get(n, n))
+            i += 2
+    return "".join(out)
+
+
+def read_defines(path, defs):
+    """Collect string-valued #defines; values may chain literals and names."""
+    for line in open(path, encoding="latin-1"):
+        m = DEFINE_RE.match(line)
+        if not m or '"' not in m.group(2) and m.group(2) not in defs:
+            continue
+        parts = []
+        for lit, name in TOKEN_RE.findall(m.group(2)):
+            if name:
+                if name not in defs:
+                    break               # not a string macro after all
+                parts.append(defs[name])
+            else:
+                parts.append(unescape(lit))
+        else:
+            defs[m.group(1)] = "".join(parts)
+    return defs
+
+
+def language_strings(root, code):
+    shared = read_defines(os.path.join(root, "Strings.h"), {})
+    defs = read_defines(os.path.join(root, "Lang_%s.h" % code), dict(shared))
+    return {k: v for k, v in defs.items() if re.match(r"(S|U|FW)_", k)}
+
+
+def glyphs_for(strings):
+    chars = set(NUMERIC + MENU_DECOR)
+    for text in strings.values():
+        chars.update(PRINTF_RE.sub("", text))
+    bad = sorted(c for c in chars if ord(c) > 255 or ord(c) < 32)
+    if bad:
+        sys.exit("not Latin-1 printable: %r" % bad)
+    return sorted(ord(c) for c in chars)
+
+
+def table_bytes(strings):
+    """Flash for the S_* literals (identical literals are merged by the linker)."""
+    return sum(len(v) + 1 for v in set(v for k, v in strings.items() if k.startswith("S_")))
+
+
+def bdf_encodings(path):
+    return set(int(m) for m in re.findall(r"^ENCODING\s+(\d+)", open(path, encoding="latin-1").read(), re.M))
+
+
+def glyph_map(codes):
+    """bdfconv -m argument: comma separated codes/ranges."""
+    ranges, start = [], None
+    for i, c in enumerate(codes):
+        if start is None:
+            start = c
+        if i + 1 == len(codes) or codes[i + 1] != c + 1:
+            ranges.append(str(start) if start == c else "%d-%d" % (start, c))
+            start = None
+    return ",".join(ranges)
+
+
+def bdfconv(tool, bdf, mode, codes_map, name):
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, name + ".c")
+        subprocess.run([tool, "-f", "1", "-b", str(mode), "-m", codes_map, "-n", name,
+                        "-o", out, bdf], check=True, stdout=subprocess.DEVNULL)
+        text = open(out).read()
+    size = int(re.search(r"\[(\d+)\]", text).group(1))
+    return text, size
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    here = os.path.dirname(os.path.abspath(__file__))
+    ap.add_argument("--root", default=os.path.join(here, ".."))
+    ap.add_argument("--u8g2", help="u8g2 checkout (tools/font/bdfconv/bdfconv, tools/font/bdf)")
+    ap.add_argument("--out", default=os.path.join(here, ".."))
+    ap.add_argument("--report", action="store_true", help="report only, write nothing")
+    ap.add_argument("--check", action="store_true", help="fail on glyphs missing from a BDF")
+    args = ap.parse_args()
+
+    langs = sorted(m.group(1) for m in (re.match(r"Lang_(\w+)\.h$", f) for f in os.listdir(args.root)) if m)
+    if not langs:
+        sys.exit("no Lang_*.h in " + args.root)
+
+    tool = bdf_dir = None
+    if args.u8g2:
+        tool = os.path.join(args.u8g2, "tools", "font", "bdfconv", "bdfconv")
+        bdf_dir = os.path.join(args.u8g2, "tools", "font", "bdf")
+        if not os.access(tool, os.X_OK):
+            sys.exit("%s not built (make -C %s)" % (tool, os.path.dirname(tool)))
+
+    print("%-4s %7s %6s %9s %9s  %s" % ("lang", "strings", "glyphs", "fonts", "full", "non-ASCII"))
+    generated = []
+    missing = 0
+    for code in langs:
+        strings = language_strings(args.root, code)
+        codes = glyphs_for(strings)
+        fonts_b = full_b = 0
+        body = []
+        if bdf_dir:
+            for role, bdf, mode, full in ROLES:
+                path = os.path.join(bdf_dir, bdf)
+                have = bdf_encodings(path)
+                lost = [c for c in codes if c not in have]
+                if lost:
+                    missing += len(lost)
+                    print("  %s %s: %s has no %s" % (code, role, bdf, "".join(map(chr, lost))))
+                name = "u8g2_font_%s_%s" % (role[8:].lower(), code)
+                text, size = bdfconv(tool, path, mode, glyph_map(codes), name)
+                ref = full.get(code, full[None])
+                _, ref_size = bdfconv(tool, path, mode, "32-127" if ref.endswith("r") else "32-255", "ref")
+                fonts_b += size
+                full_b += ref_size
+                body += [text.strip(), "\n#define %s %s\n\n" % (role, name)]
+        print("%-4s %7d %6d %9s %9s  %s" % (
+            code, table_bytes(strings), len(codes),
+            fonts_b or "-", full_b or "-", "".join(chr(c) for c in codes if c > 127).encode("unicode_escape").decode()))
+        generated.append((code, body))
+
+    if args.check and missing:
+        sys.exit("%d glyph(s) missing from the BDF sources" % missing)
+    if not bdf_dir:
+        print("(pass --u8g2 to build the subsets and measure font bytes)")
+        return
+    if args.report:
+        return
+
+    gen = "// Generated by tools/gen_font_subset.py from the Lang_*.h tables - do not edit.\n"
+    for code, body in generated:
+        with open(os.path.join(args.out, "FontSubset_%s.h" % code), "w", encoding="latin-1") as f:
+            f.write(gen + "#pragma once\n#include <U8g2lib.h>\n\n" + "\n".join(body))
+    sel = [gen, "#pragma once\n// Included by UiFonts.h when UI_FONT_SUBSET=1.\n\n"]
+    for i, (code, _) in enumerate(generated):
+        sel.append("%sif UI_LANG == LANG_%s\n#include \"FontSubset_%s.h\"\n"
+                   % ("#" if i == 0 else "#el", code.upper(), code))
+    sel.append("#else\n#error \"FontSubset.h: rerun tools/gen_font_subset.py for this language\"\n#endif\n")
+    with open(os.path.join(args.out, "FontSubset.h"), "w") as f:
+        f.write("".join(sel))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Build the icon atlas (IconAtlasIds.h + IconAtlasData.h) from assets/icons.
+
+Inputs are 1-bit XBM files (GIMP exports XCF to XBM directly) or PNGs
+(thresholded at 50 %, needs Pillow). Each icon is stored raw or bit-run
+coded, whichever is smaller by at least MIN_SAVING bytes; see IconAtlasLogic.cpp
+for the decoder.
+
+Usage: python3 tools/gen_icon_atlas.py [--assets assets/icons] [--out .]
+"""
+import argparse
+import os
+import re
+import sys
+
+MIN_SAVING = 4          # don't pay a cache slot + decode for a few bytes
+CODEC_RAW, CODEC_BITRUN = 0, 1
+INDEX_ENTRY_BYTES = 4   # sizeof(IconEntry): offset16, w8, h7 + codec bit
+
+
+def load_xbm(path):
+    text = open(path).read()
+    w = int(re.search(r"_width\s+(\d+)", text).group(1))
+    h = int(re.search(r"_height\s+(\d+)", text).group(1))
+    body = text[text.index("{") + 1:text.rindex("}")]
+    data = [int(x, 16) for x in re.findall(r"0x[0-9a-fA-F]+", body)]
+    if len(data) != ((w + 7) // 8) * h:
+        sys.exit("%s: expected %d bytes, got %d" % (path, ((w + 7) // 8) * h, len(data)))
+    return w, h, data
+
+
+def load_png(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("%s: Pillow is required for PNG input (pip install pillow)" % path)
+    img = Image.open(path).convert("L")
+    w, h = img.size
+    rb = (w + 7) // 8
+    data = [0] * (rb * h)
+    px = img.load()
+    for y in range(h):
+        for x in range(w):
+            if px[x, y] < 128:          # dark pixel = set
+                data[y * rb + x // 8] |= 1 << (x % 8)
+    return w, h, data
+
+
+def pixels(w, h, data):
+    rb = (w + 7) // 8
+    for y in range(h):
+        for x in range(w):
+            yield (data[y * rb + x // 8] >> (x % 8)) & 1
+
+
+def encode_bitrun(w, h, data):
+    """Alternating run lengths (start colour 0) packed as nibbles, low first.
+    A run longer than 15 is split as 15, 0, rest..."""
+    runs = []
+    colour, n = 0, 0
+    for p in pixels(w, h, data):
+        if p == colour:
+            n += 1
+        else:
+            runs.append(n)
+            colour, n = p, 1
+    runs.append(n)
+    nibbles = []
+    for r in runs:
+        while r > 15:
+            nibbles += [15, 0]
+            r -= 15
+        nibbles.append(r)
+    if len(nibbles) % 2:
+        nibbles.append(0)
+    return [nibbles[i] | (nibbles[i + 1] << 4) for i in range(0, len(nibbles), 2)]
+
+
+def decode_bitrun(w, h, blob):
+    rb = (w + 7) // 8
+    out = [0] * (rb * h)
+    x = y = 0
+    colour = 0
+    for b in blob:
+        for n in (b & 0x0F, b >> 4):
+            for _ in range(n):
+                if colour:
+                    out[y * rb + x // 8] |= 1 << (x % 8)
+                x += 1
+                if x == w:
+                    x, y = 0, y + 1
+            colour ^= 1
+    return out
+
+
+def c_bytes(data, indent="  "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    here = os.path.dirname(os.path.abspath(__file__))
+    ap.add_argument("--assets", default=os.path.join(here, "..", "assets", "icons"))
+    ap.add_argument("--out", default=os.path.join(here, ".."))
+    args = ap.parse_args()
+
+    icons = []
+    for fn in sorted(os.listdir(args.assets)):
+        base, ext = os.path.splitext(fn)
+        path = os.path.join(args.assets, fn)
+        if ext == ".xbm":
+            w, h, data = load_xbm(path)
+        elif ext == ".png":
+            w, h, data = load_png(path)
+        else:
+            continue
+        icons.append((base.upper(), w, h, data))
+    if not icons:
+        sys.exit("no icons found in " + args.assets)
+
+    blob, entries = [], []
+    raw_total = 0
+    max_decoded = 0
+    print("%-14s %5s %5s %s" % ("icon", "raw", "atlas", "codec"))
+    for name, w, h, data in icons:
+        raw_total += len(data)
+        packed = encode_bitrun(w, h, data)
+        assert decode_bitrun(w, h, packed) == data, name
+        if len(packed) + MIN_SAVING <= len(data):
+            codec, payload = CODEC_BITRUN, packed
+            max_decoded = max(max_decoded, len(data))
+        else:
+            codec, payload = CODEC_RAW, data
+        entries.append((name, w, h, codec, len(blob), len(payload)))
+        blob += payload
+        print("%-14s %5d %5d %s" % (name, len(data), len(payload),
+                                    "bitrun" if codec else "raw"))
+
+    atlas_total = len(blob) + len(entries) * INDEX_ENTRY_BYTES
+    print("raw arrays: %d B, atlas blob: %d B + index %d B = %d B (saved %d B)"
+          % (raw_total, len(blob), len(entries) * INDEX_ENTRY_BYTES, atlas_total,
+             raw_total - atlas_total))
+    print("largest decoded tile: %d B" % max_decoded)
+
+    gen = "// Generated by tools/gen_icon_atlas.py from assets/icons - do not edit.\n"
+    ids = [gen, "#pragma once\n#include <stdint.h>\n\n",
+           "enum IconId : uint8_t {\n"]
+    ids += ["  ICON_ID_%s,\n" % e[0] for e in entries]
+    ids += ["  ICON_ID_COUNT\n};\n\n",
+            "// Largest decoded size of a compressed icon (cache slot size)\n",
+            "#define ICON_ATLAS_MAX_TILE_BYTES %d\n" % max(max_decoded, 1)]
+    with open(os.path.join(args.out, "IconAtlasIds.h"), "w") as f:
+        f.write("".join(ids))
+
+    data_h = [gen, "#pragma once\n// Included by IconAtlasLogic.cpp only.\n\n",
+              "static const uint8_t ICON_BLOB[%d] = {\n" % len(blob),
+              c_bytes(blob), "\n};\n\n",
+              "static const IconEntry ICON_INDEX[ICON_ID_COUNT] = {\n"]
+    for name, w, h, codec, off, size in entries:
+        if h > 127:
+            sys.exit("%s: height %d does not fit the index" % (name, h))
+        data_h.append("  {%4d, %2d, %2d%s},  // %s, %d B\n"
+                      % (off, w, h, " | ICON_CODEC_BITRUN" if codec else "", name, size))
+    data_h.append("};\n")
+    with open(os.path.join(args.out, "IconAtlasData.h"), "w") as f:
+        f.write("".join(data_h))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,205 @@
+// Host run of the task health monitor (HealthLogic.cpp) against a stubbed
+// FreeRTOS kernel and watchdog.
+//
+// The stub plays what HealthMonitor.cpp gets from the target on a 1 ms
+// tick: the UI task's loop (busy time, then vTaskDelay(5), so the next
+// loop starts on a tick), the monitor waking every HEALTH_SAMPLE_MS by
+// vTaskDelayUntil, stack high-water marks and run-time counters per task,
+// and an independent watchdog that resets HEALTH_WDT_TIMEOUT_MS after the
+// last reload. Scenarios:
+//   steady     0.7 ms of work per loop
+//   frames     a 9 ms frame render every 5th loop
+//   stall      one 1.5 s blocking transfer (below HEALTH_UI_STALL_MS)
+//   hang       a transfer that never returns from 10 s on
+// For every sample window the loop figures are compared with exact ones
+// from the stub's own record; the watchdog must never fire except in
+// "hang", and there between the stall limit + the watchdog timeout and
+// one sample period later. Registration (HEALTH_MAX_TASKS, null handles),
+// the stack figures and per-task CPU are checked on a task table the stub
+// fills.
+//
+// Exits 1 on any mismatch.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/health_sim.cpp HealthLogic.cpp -o health_sim
+// Usage: ./health_sim [--seconds 60] [--verbose]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "HealthLogic.h"
+
+// As in HealthMonitor.h
+static const uint32_t SAMPLE_MS = 500;
+static const uint32_t STALL_MS = 2000;
+static const uint32_t WDT_MS = 4000;
+static const uint32_t TICK_US = 1000;
+static const uint32_t UI_DELAY_TICKS = 5;
+
+static bool verbose = false;
+static int failures = 0;
+
+static void check(bool ok, const char* scenario, const char* what, double got, double want){
+  if (ok) return;
+  if (failures++ < 12) std::printf("FAIL: %s: %s = %.1f, want %.1f\n", scenario, what, got, want);
+}
+
+// ===== Stub kernel: UI loop + monitor + watchdog =====
+struct Scenario {
+  const char* name;
+  uint32_t frameEvery;          // every Nth loop renders a frame (0 = never)
+  uint32_t hangAtMs, hangMs;    // blocking transfer (hangMs 0 = none, ~0 = forever)
+  bool expectReset;
+};
+
+static uint32_t busyFor(const Scenario& s, uint64_t startUs, uint32_t loop){
+  const uint64_t hangUs = (uint64_t)s.hangAtMs * 1000;
+  if (s.hangMs && startUs <= hangUs && startUs + 10000 > hangUs) {
+    if (s.hangMs == ~0u) return ~0u;
+    return (uint32_t)(hangUs - startUs) + s.hangMs * 1000;
+  }
+  return s.frameEvery && loop % s.frameEvery == 0 ? 9000 : 700;
+}
+
+static void run(const Scenario& s, double seconds){
+  HealthLoop l = {};
+  const uint64_t endUs = (uint64_t)(seconds * 1e6);
+  uint64_t ui = 3 * TICK_US;                 // next loop start
+  uint64_t mon = SAMPLE_MS * 1000;           // next monitor wake
+  uint64_t lastTake = 0, lastFeedUs = 0, lastBeatUs = 0;
+  uint64_t resetUs = 0;
+  uint32_t loop = 0;
+  bool hung = false;
+
+  // The stub's own record of the current window
+  std::vector<uint32_t> periods;
+  uint64_t busySum = 0, prevStart = 0;
+  uint32_t windows = 0, worstMax = 0;
+
+  while (!resetUs) {
+    const uint64_t now = !hung && ui < mon ? ui : mon;
+    if (now >= endUs) break;
+    if (now - lastFeedUs >= (uint64_t)WDT_MS * 1000) { resetUs = lastFeedUs + WDT_MS * 1000; break; }
+
+    if (!hung && now == ui) {
+      healthLoopMark(l, (uint32_t)now);
+      lastBeatUs = now;
+      if (prevStart) periods.push_back((uint32_t)(now - prevStart));
+      prevStart = now;
+      const uint32_t busy = busyFor(s, now, loop++);
+      if (busy == ~0u) { hung = true; continue; }
+      // Done inside this event: the monitor cannot run in between, it
+      // is below the UI priority
+      healthLoopDone(l, (uint32_t)(now + busy));
+      busySum += busy;
+      ui = ((now + busy) / TICK_US + UI_DELAY_TICKS) * TICK_US;
+      continue;
+    }
+
+    // Monitor wake
+    const HealthWindow w = healthLoopTake(l, (uint32_t)(now - lastTake));
+    lastTake = now;
+    windows++;
+    uint64_t sum = 0;
+    uint32_t mx = 0;
+    for (uint32_t p : periods) { sum += p; if (p > mx) mx = p; }
+    if (mx > worstMax) worstMax = mx;
+    check(w.count == periods.size(), s.name, "loops in window", w.count, (double)periods.size());
+    if (!periods.empty()) check(w.avgUs == sum / periods.size(), s.name, "avg period us", w.avgUs, (double)(sum / periods.size()));
+    check(w.maxUs == mx, s.name, "max period us", w.maxUs, mx);
+    const uint64_t pct = busySum * 100 / (SAMPLE_MS * 1000);
+    check(w.busyPct == (pct > 100 ? 100 : pct), s.name, "busy %", w.busyPct, (double)pct);
+    if (!s.frameEvery && !s.hangMs && windows > 1)
+      check(w.jitterUs == 0, s.name, "jitter us (constant period)", w.jitterUs, 0);
+    if (s.frameEvery == 5 && !s.hangMs && windows > 2)
+      check(w.jitterUs > 2000 && w.jitterUs < 9000, s.name, "jitter us (5 + 14 ms periods)", w.jitterUs, 3600);
+    if (verbose)
+      std::printf("  %-7s t=%6.1f s loops %3u avg %6u us jitter %5u us max %8u us busy %3u%%\n", s.name,
+                  now / 1e6, w.count, w.avgUs, w.jitterUs, w.maxUs, w.busyPct);
+    periods.clear();
+    busySum = 0;
+
+    if (healthUiAlive((uint32_t)(now / 1000), (uint32_t)(lastBeatUs / 1000), STALL_MS)) lastFeedUs = now;
+    mon += SAMPLE_MS * 1000;
+  }
+
+  const double t = resetUs / 1e6;
+  if (s.expectReset) {
+    const double hang = s.hangAtMs / 1e3;
+    const double lo = hang + (STALL_MS + WDT_MS) / 1e3 - SAMPLE_MS / 1e3;
+    const double hi = hang + (STALL_MS + WDT_MS + SAMPLE_MS) / 1e3;
+    check(resetUs && t >= lo && t <= hi, s.name, "watchdog reset at s", t, hang + (STALL_MS + WDT_MS) / 1e3);
+  } else {
+    check(!resetUs, s.name, "watchdog reset at s", t, 0);
+  }
+  if (s.hangMs && !s.expectReset)
+    check(worstMax >= s.hangMs * 1000, s.name, "worst period us", worstMax, s.hangMs * 1000.0);
+  std::printf("%-7s %3u windows, worst period %8.1f ms, %s\n", s.name, windows, worstMax / 1e3,
+              resetUs ? "watchdog reset" : "no reset");
+  if (resetUs) std::printf("        reset %.2f s after the transfer hung\n", t - s.hangAtMs / 1e3);
+}
+
+// ===== Stub kernel: task table =====
+static uint16_t stubUsed[8];
+static uint16_t stubDepth[8];
+static uint16_t stubFree(void* handle){
+  const uintptr_t i = (uintptr_t)handle - 1;
+  return (uint16_t)(stubDepth[i] - stubUsed[i]);
+}
+
+static void checkTasks(){
+  HealthTasks t = {};
+  const uint16_t depth[8] = { 2048, 256, 256, 384, 256, 256, 128, 128 };   // UI, MON, AVI, BOOT ...
+  check(!healthTaskAdd(t, nullptr, 100), "tasks", "null handle accepted", 1, 0);
+  uint8_t added = 0;
+  for (uintptr_t i = 0; i < 8; i++) {
+    stubDepth[i] = depth[i];
+    added += healthTaskAdd(t, (void*)(i + 1), depth[i]);
+  }
+  check(added == HEALTH_MAX_TASKS && t.count == HEALTH_MAX_TASKS, "tasks", "registered", added, HEALTH_MAX_TASKS);
+
+  // High-water marks only grow; the table shows the latest
+  const uint16_t use1[8] = { 900, 120, 140, 300, 90, 60, 50, 50 };
+  const uint16_t use2[8] = { 1450, 120, 200, 300, 90, 61, 50, 50 };
+  for (const uint16_t* use : { use1, use2 }) {
+    std::memcpy(stubUsed, use, sizeof(stubUsed));
+    healthTaskStacks(t, stubFree);
+    for (uint8_t i = 0; i < t.count; i++)
+      check(t.task[i].freeWords == depth[i] - use[i], "tasks", "free words", t.task[i].freeWords, depth[i] - use[i]);
+  }
+  check(t.task[0].stackWords == 2048 && t.task[0].freeWords == 598, "tasks", "UI (slot 0) free words",
+        t.task[0].freeWords, 598);
+
+  // Run-time counters over two periods of 10000 counts
+  const uint32_t run1[HEALTH_MAX_TASKS] = { 3000, 200, 150, 0, 10, 5 };
+  const uint32_t run2[HEALTH_MAX_TASKS] = { 7500, 400, 300, 0, 10, 5 };
+  for (uint8_t i = 0; i < t.count; i++) healthTaskRun(t, t.task[i].handle, run1[i], 10000);
+  for (uint8_t i = 0; i < t.count; i++) healthTaskRun(t, t.task[i].handle, run2[i], 10000);
+  const uint8_t want[HEALTH_MAX_TASKS] = { 45, 2, 1, 0, 0, 0 };
+  for (uint8_t i = 0; i < t.count; i++)
+    check(t.task[i].cpu == want[i], "tasks", "cpu %", t.task[i].cpu, want[i]);
+  check(healthPercent(150, 100) == 100 && healthPercent(5, 0) == 0, "tasks", "percent clamps", 0, 0);
+  std::printf("tasks   %u of 8 registered, UI stack %u/%u words free, UI cpu %u%%\n", t.count,
+              t.task[0].freeWords, t.task[0].stackWords, t.task[0].cpu);
+}
+
+int main(int argc, char** argv){
+  double seconds = 60;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--verbose")) verbose = true;
+    else {
+      std::fprintf(stderr, "usage: %s [--seconds S] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (seconds < 20) seconds = 20;
+  const Scenario scenarios[] = {
+    {"steady", 0, 0, 0, false},
+    {"frames", 5, 0, 0, false},
+    {"stall",  5, 10000, 1500, false},
+    {"hang",   5, 10000, ~0u, true},
+  };
+  for (const Scenario& s : scenarios) run(s, seconds);
+  checkTasks();
+  return failures ? 1 : 0;
+}
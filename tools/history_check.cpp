@@ -0,0 +1,182 @@
+// Host check of the trend store (History.cpp).
+//
+// Pushes 26 simulated hours of 1 s samples (a slow ramp per channel with a
+// spike now and then) and, at every push, compares each ring against a
+// model built from the full sample list:
+//   ring      count, capacity, newest-first ages and the end of the ring
+//   rollups   each 1 min bucket is min / max / truncated mean of its 60
+//             seconds, each 1 h bucket the same over its 60 minutes
+//   scaling   values rounded to channel units * historyScale(), clamped
+//             to int16
+// and checks the generation counters. Then drives historyTick() with a
+// scripted clock: one push per second, catch-up of a short stall (at most
+// 5 samples), resync after a long one.
+//
+// Exits 1 on the first kind of mismatch it finds (all are counted).
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/history_check.cpp History.cpp -o history_check
+// Usage: ./history_check [--hours 26] [--seed 1]
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "AppData.h"
+#include "History.h"
+
+// The live values historyTick() samples (AppData.cpp on the target)
+float statusTempC = 0, statusVinV = 0, fan1Current_mA = 0, fan2Current_mA = 0;
+
+static int failures = 0;
+
+static void fail(const char* what, HistChannel ch, HistRes res, unsigned age, int got, int want){
+  if (failures++ < 10)
+    std::printf("FAIL: %s ch %u res %u age %u: got %d, want %d\n", what, ch, res, age, got, want);
+}
+
+static int16_t fixedRef(double v, double scale){
+  const double s = std::round(v * scale);
+  return (int16_t)(s > 32767 ? 32767 : s < -32768 ? -32768 : s);
+}
+
+// ===== Model =====
+struct Model {
+  std::vector<HistBucket> res[HIST_RES_COUNT][HIST_CHANNELS];   // oldest first
+
+  void push(const int16_t (&v)[HIST_CHANNELS]){
+    for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+      res[HIST_SEC][c].push_back({v[c], v[c], v[c]});
+      roll(HIST_SEC, HIST_MIN, c);
+    }
+  }
+
+  // Every 60 buckets at `from` make one at `to`
+  void roll(HistRes from, HistRes to, uint8_t c){
+    const std::vector<HistBucket>& src = res[from][c];
+    if (src.size() % 60) return;
+    HistBucket b = {INT16_MAX, INT16_MIN, 0};
+    int32_t sum = 0;
+    for (size_t i = src.size() - 60; i < src.size(); i++) {
+      if (src[i].min < b.min) b.min = src[i].min;
+      if (src[i].max > b.max) b.max = src[i].max;
+      sum += src[i].avg;
+    }
+    b.avg = (int16_t)(sum / 60);
+    res[to][c].push_back(b);
+    if (to == HIST_MIN) roll(HIST_MIN, HIST_HOUR, c);
+  }
+};
+
+static void compare(const Model& m){
+  for (uint8_t r = 0; r < HIST_RES_COUNT; r++) {
+    const HistRes res = (HistRes)r;
+    const uint8_t cap = historyCapacity(res);
+    const size_t total = m.res[r][0].size();
+    const uint8_t want = (uint8_t)(total < cap ? total : cap);
+    if (historyCount(res) != want) fail("count", HIST_TEMP, res, 0, historyCount(res), want);
+    if (historyGeneration(res) != total) fail("generation", HIST_TEMP, res, 0, (int)historyGeneration(res), (int)total);
+    for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+      const HistChannel ch = (HistChannel)c;
+      HistBucket b;
+      for (uint8_t age = 0; age < want; age++) {
+        const HistBucket& e = m.res[r][c][total - 1 - age];
+        if (!historyGet(ch, res, age, b)) { fail("missing", ch, res, age, 0, 1); continue; }
+        if (b.min != e.min) fail("min", ch, res, age, b.min, e.min);
+        if (b.max != e.max) fail("max", ch, res, age, b.max, e.max);
+        if (b.avg != e.avg) fail("avg", ch, res, age, b.avg, e.avg);
+      }
+      if (historyGet(ch, res, want, b)) fail("past the end", ch, res, want, 1, 0);
+    }
+  }
+}
+
+// ===== historyTick() clock =====
+static void checkTick(){
+  historyInit();
+  statusTempC = 21.5f;
+  struct Step { unsigned long now; uint32_t pushes; const char* what; };
+  const Step steps[] = {
+    {    5000, 0, "first call only starts" },
+    {    5999, 0, "under a second" },
+    {    6000, 1, "one second" },
+    {    9500, 3, "stall of 3.5 s caught up" },
+    {   30000, 5, "long stall: 5 samples, then resync" },
+    {   30999, 0, "resynced to the stall's end" },
+    {   31000, 1, "next second after resync" },
+  };
+  uint32_t gen = historyGeneration(HIST_SEC);
+  for (const Step& s : steps) {
+    historyTick(s.now);
+    const uint32_t got = historyGeneration(HIST_SEC) - gen;
+    gen = historyGeneration(HIST_SEC);
+    if (got != s.pushes) {
+      std::printf("FAIL: historyTick(%lu) %s: %u pushes, want %u\n", s.now, s.what, got, s.pushes);
+      failures++;
+    }
+  }
+  HistBucket b;
+  if (!historyGet(HIST_TEMP, HIST_SEC, 0, b) || b.avg != 215) {
+    std::printf("FAIL: historyTick sampled statusTempC as %d, want 215\n", b.avg);
+    failures++;
+  }
+}
+
+int main(int argc, char** argv){
+  double hours = 26;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--hours") && more)     hours = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--seed") && more) seed = (unsigned)std::atoi(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--hours H] [--seed N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::uniform_int_distribution<int> spike(0, 999);
+  historyInit();
+  Model m;
+  const uint32_t seconds = (uint32_t)(hours * 3600);
+  for (uint32_t t = 0; t < seconds; t++) {
+    const double ramp = std::sin(t / 5000.0);
+    float v[HIST_CHANNELS] = {
+      (float)(25 + 15 * ramp + 0.3 * noise(rng)),                 // C
+      (float)(24 + 0.5 * ramp + 0.05 * noise(rng)),               // V
+      (float)(250 + 40 * ramp + 3 * noise(rng)),                  // mA
+      (float)(spike(rng) == 0 ? 40000 : 250 + 3 * noise(rng)),    // mA, clamps
+    };
+    int16_t fixed[HIST_CHANNELS];
+    for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+      // Round on the same grid as the store so the model sees its values
+      fixed[c] = fixedRef(v[c], historyScale((HistChannel)c));
+      v[c] = (float)(fixed[c] / (double)historyScale((HistChannel)c));
+    }
+    historyPush(v);
+    m.push(fixed);
+    // Every push while a ring fills, then around the rollups
+    if (t < 200 || t % 60 == 59 || t % 3600 < 2) compare(m);
+  }
+  compare(m);
+  std::printf("%u s pushed: %u / %u / %u buckets kept (1 s / 1 min / 1 h), %zu bytes\n", seconds,
+              historyCount(HIST_SEC), historyCount(HIST_MIN), historyCount(HIST_HOUR),
+              historyMemoryBytes());
+
+  // Clamping: beyond int16 after scaling
+  historyInit();
+  const float big[HIST_CHANNELS] = { 5000.0f, -5000.0f, 40000.0f, -40000.0f };
+  historyPush(big);
+  const int16_t clamp[HIST_CHANNELS] = { 32767, -32768, 32767, -32768 };
+  for (uint8_t c = 0; c < HIST_CHANNELS; c++) {
+    HistBucket b;
+    historyGet((HistChannel)c, HIST_SEC, 0, b);
+    if (b.avg != clamp[c]) fail("clamp", (HistChannel)c, HIST_SEC, 0, b.avg, clamp[c]);
+  }
+
+  checkTick();
+  std::printf("%s\n", failures ? "history: FAILED" : "history: ok");
+  return failures ? 1 : 0;
+}
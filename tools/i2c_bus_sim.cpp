@@ -0,0 +1,326 @@
+// Host simulator for the shared I2C bus scheduling (I2cBusLogic.cpp).
+//
+// A panel streams full frames (8 pages: a command transfer, then 0x40 + 128
+// data bytes, through the same chunker the U8g2 byte callback uses) while
+// two sensors poll at their own rates with random phase. The bus serves the
+// queue exactly as the bus task does, charging each transaction its wire
+// time (i2cXferUs) plus a fixed task switch / driver overhead.
+//
+// For each bus clock it compares the old arrangement (the UI owns Wire for
+// a whole frame, so a sensor waits behind it) with display chunks of 32 and
+// 16 bytes, and prints worst and mean sensor latency (queued to done) and
+// the frame time, with sensors and with the bus to itself. Exits 1 if any
+// chunked run breaks the bound
+//   one display chunk + every sensor transfer, each with its overhead,
+// or if i2cDisplayFrameUs() (the UI_TRACE flush budget) disagrees with the
+// frame it simulates.
+//
+// Recovery: runs i2cBusRecover() against a slave stuck at every bit of a
+// read byte, for every byte value, with malloc counted (the way
+// STATIC_ALLOC counts it after heapLock()). Exits 1 unless every case frees
+// SDA within I2C_RECOVER_CLOCKS pulses, ends on a STOP and allocates
+// nothing. The same pins through Wire.end()/begin() (modelled on STM32duino,
+// which frees and reallocates its buffers) are printed for comparison.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/i2c_bus_sim.cpp I2cBusLogic.cpp -o i2c_bus_sim
+// Usage: ./i2c_bus_sim [--seconds 60] [--seed 1] [--overhead 20]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "I2cBusLogic.h"
+
+// ===== Allocation count =====
+// glibc's own entry points do the work; everything else comes through here
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void __libc_free(void*);
+static bool counting = false;
+static unsigned allocs = 0;
+extern "C" {
+void* malloc(size_t n){ if (counting) allocs++; return __libc_malloc(n); }
+void* calloc(size_t n, size_t size){ if (counting) allocs++; return __libc_calloc(n, size); }
+void* realloc(void* p, size_t n){ if (counting) allocs++; return __libc_realloc(p, n); }
+void free(void* p){ __libc_free(p); }
+}
+
+static const uint8_t PANEL_ADDR = 0x3C;
+static const uint32_t FRAME_PERIOD_US = 25000;      // UI_FRAME_MS
+static const uint8_t PAGES = 8, PAGE_BYTES = 128;
+
+struct Options {
+  double seconds = 60;
+  unsigned seed = 1;
+  uint32_t overheadUs = 20;   // bus task wake-up + Wire setup per transaction
+};
+
+struct Sensor {
+  const char* name;
+  uint8_t addr;
+  uint8_t txLen, rxLen;
+  uint32_t periodUs;
+};
+static const Sensor SENSORS[] = {
+  {"env", 0x76, 1, 6, 10000},
+  {"imu", 0x68, 1, 12, 50000},
+};
+static const uint8_t SENSOR_COUNT = sizeof(SENSORS) / sizeof(SENSORS[0]);
+
+// ===== Display traffic =====
+// The transactions one frame turns into, in order
+static std::vector<uint16_t> frameLens;
+static bool recordChunk(void*, const uint8_t*, uint8_t len){
+  frameLens.push_back(len);
+  return true;
+}
+
+static void buildFrame(uint8_t chunk){
+  frameLens.clear();
+  if (!chunk) {                                     // old: one Wire session per frame
+    frameLens.push_back((uint16_t)(PAGES * (4 + 1 + PAGE_BYTES)));
+    return;
+  }
+  static I2cChunker c;
+  uint8_t data[PAGE_BYTES] = {};
+  for (uint8_t p = 0; p < PAGES; p++) {
+    const uint8_t cmd[] = {0x00, (uint8_t)(0xB0 | p), 0x00, 0x10};
+    i2cChunkStart(c, chunk);
+    i2cChunkAppend(c, cmd, sizeof(cmd), recordChunk, nullptr);
+    i2cChunkEnd(c, recordChunk, nullptr);
+    const uint8_t ctl = 0x40;
+    i2cChunkStart(c, chunk);
+    i2cChunkAppend(c, &ctl, 1, recordChunk, nullptr);
+    i2cChunkAppend(c, data, PAGE_BYTES, recordChunk, nullptr);
+    i2cChunkEnd(c, recordChunk, nullptr);
+  }
+}
+
+// ===== Simulation =====
+struct Result {
+  uint32_t worstUs = 0;
+  double meanUs = 0;
+  double frameMs = 0;
+  uint32_t boundUs = 0;
+};
+
+static Result run(const Options& o, uint32_t hz, uint8_t chunk){
+  buildFrame(chunk);
+  std::mt19937 rng(o.seed);
+  std::uniform_int_distribution<uint32_t> jitter(0, 999);
+  const uint64_t endUs = (uint64_t)(o.seconds * 1e6);
+
+  I2cQueue queue = {};
+  I2cXfer* busy = nullptr;
+  uint64_t busyUntil = 0;
+
+  // Display client: issues frameLens[step], waits, issues the next
+  I2cXfer disp = {};
+  size_t step = 0;
+  uint64_t dispNext = 0, frameStart = 0, frameSum = 0, frames = 0;
+  bool dispWaiting = false;
+
+  I2cXfer sens[SENSOR_COUNT] = {};
+  uint64_t sensNext[SENSOR_COUNT];
+  bool sensWaiting[SENSOR_COUNT] = {};
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) sensNext[i] = jitter(rng) * SENSORS[i].periodUs / 1000;
+
+  uint64_t latSum = 0, latN = 0;
+  uint32_t worst = 0;
+  const uint64_t NEVER = ~0ULL;
+
+  for (;;) {
+    uint64_t now = busy ? busyUntil : NEVER;
+    if (!dispWaiting && dispNext < now) now = dispNext;
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) if (!sensWaiting[i] && sensNext[i] < now) now = sensNext[i];
+    if (now >= endUs) break;
+
+    // Completion
+    if (busy && busyUntil == now) {
+      busy->result = I2C_OK;
+      if (busy == &disp) {
+        dispWaiting = false;
+        if (++step == frameLens.size()) {
+          frameSum += now - frameStart;
+          frames++;
+          step = 0;
+          const uint64_t due = frameStart + FRAME_PERIOD_US;
+          dispNext = due > now ? due : now;
+        } else {
+          dispNext = now + o.overheadUs;
+        }
+      } else {
+        const uint8_t i = (uint8_t)(busy - sens);
+        const uint32_t us = (uint32_t)(now - busy->queuedUs);
+        if (us > worst) worst = us;
+        latSum += us;
+        latN++;
+        sensWaiting[i] = false;
+        const uint64_t due = busy->queuedUs + SENSORS[i].periodUs;   // overran: go again now
+        sensNext[i] = due > now ? due : now;
+      }
+      busy = nullptr;
+    }
+
+    // Clients
+    if (!dispWaiting && dispNext == now) {
+      if (step == 0) frameStart = now;
+      disp = {PANEL_ADDR, I2C_PRIO_DISPLAY, nullptr, frameLens[step], nullptr, 0,
+              I2C_PENDING, (uint32_t)now, nullptr, nullptr};
+      i2cQueuePush(queue, &disp);
+      dispWaiting = true;
+    }
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+      if (sensWaiting[i] || sensNext[i] != now) continue;
+      const Sensor& s = SENSORS[i];
+      sens[i] = {s.addr, I2C_PRIO_SENSOR, nullptr, s.txLen, nullptr, s.rxLen,
+                 I2C_PENDING, (uint32_t)now, nullptr, nullptr};
+      i2cQueuePush(queue, &sens[i]);
+      sensWaiting[i] = true;
+    }
+
+    // Bus task
+    if (!busy && (busy = i2cQueuePop(queue)) != nullptr)
+      busyUntil = now + o.overheadUs + i2cXferUs(*busy, hz);
+  }
+
+  Result r;
+  r.worstUs = worst;
+  r.meanUs = latN ? (double)latSum / latN : 0;
+  r.frameMs = frames ? frameSum / 1000.0 / frames : 0;
+  I2cXfer piece = {PANEL_ADDR, I2C_PRIO_DISPLAY, nullptr, chunk, nullptr, 0, I2C_PENDING, 0, nullptr, nullptr};
+  r.boundUs = o.overheadUs + i2cXferUs(piece, hz);
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    I2cXfer x = {SENSORS[i].addr, I2C_PRIO_SENSOR, nullptr, SENSORS[i].txLen, nullptr,
+                 SENSORS[i].rxLen, I2C_PENDING, 0, nullptr, nullptr};
+    r.boundUs += o.overheadUs + i2cXferUs(x, hz);
+  }
+  return r;
+}
+
+// ===== Recovery =====
+// Open-drain lines; a slave reset mid-read still owns SDA for the rest of
+// its byte plus the ACK slot, shifting a bit on every SCL fall. A START or
+// STOP (SDA moving while SCL is high) resets it.
+struct StuckBus {
+  bool scl = true, sda = true;      // master side
+  uint8_t byte = 0, bitsLeft = 0;   // slave: bits still to shift (incl. ACK)
+  bool periphOn = true;
+  bool stopSeen = false;
+  bool slaveSda() const { return bitsLeft <= 1 || ((byte >> (bitsLeft - 2)) & 1); }
+  bool line() const { return sda && slaveSda(); }
+};
+
+// STM32duino TwoWire: begin() allocates the buffers, end() frees them
+struct WireModel {
+  uint8_t* rx = nullptr;
+  uint8_t* tx = nullptr;
+  void begin(){ rx = (uint8_t*)malloc(32); tx = (uint8_t*)malloc(32); }
+  void end(){ free(rx); free(tx); rx = tx = nullptr; }
+};
+static WireModel wire;
+static StuckBus bus;
+
+static void busRelease(void*){ bus.periphOn = false; bus.scl = bus.sda = true; }
+static void wireRelease(void*){ wire.end(); busRelease(nullptr); }
+static bool busSdaHigh(void*){ return bus.line(); }
+static void busDrive(void*, bool scl, bool high){
+  if (scl) {
+    if (bus.scl && !high && bus.bitsLeft) bus.bitsLeft--;       // falling edge
+    bus.scl = high;
+    return;
+  }
+  const bool before = bus.line();
+  bus.sda = high;
+  if (bus.scl && before != bus.line()) {                        // START or STOP
+    bus.bitsLeft = 0;
+    if (high) bus.stopSeen = true;
+  }
+}
+static void busRestore(void*){ bus.periphOn = true; }
+static void wireRestore(void*){ wire.begin(); busRestore(nullptr); }
+
+static const I2cRecoverPins PERIPH_PINS = { nullptr, busRelease, busSdaHigh, busDrive, busRestore };
+static const I2cRecoverPins WIRE_PINS = { nullptr, wireRelease, busSdaHigh, busDrive, wireRestore };
+
+// Every byte value, stuck at every bit; returns failures
+static int recoverCases(const I2cRecoverPins& pins, const char* name, bool strict){
+  int bad = 0;
+  unsigned cases = 0, worstClocks = 0;
+  allocs = 0;
+  for (unsigned v = 0; v < 256; v++) {
+    for (uint8_t left = 0; left <= 9; left++) {
+      bus = StuckBus();
+      bus.byte = (uint8_t)v;
+      bus.bitsLeft = left;
+      uint8_t* const rx = wire.rx;
+      counting = true;
+      const uint8_t clocks = i2cBusRecover(pins);
+      counting = false;
+      cases++;
+      if (clocks > worstClocks) worstClocks = clocks;
+      const bool ok = bus.line() && bus.scl && bus.stopSeen && bus.periphOn && bus.bitsLeft == 0 &&
+                      clocks <= I2C_RECOVER_CLOCKS && (!strict || wire.rx == rx);
+      if (!ok && bad++ < 5)
+        std::printf("FAIL: %s byte 0x%02X stuck %u bits from the end: sda %d stop %d after %u clocks\n",
+                    name, v, left, bus.line(), bus.stopSeen, clocks);
+    }
+  }
+  if (strict && allocs) {
+    std::printf("FAIL: %s allocated %u times\n", name, allocs);
+    bad++;
+  }
+  std::printf("recovery %-13s %u cases, worst %u clocks, %u allocations%s\n", name, cases, worstClocks,
+              allocs, strict ? "" : " (would halt after heapLock)");
+  return bad;
+}
+
+int main(int argc, char** argv){
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--seconds") && more)       o.seconds = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--seed") && more)     o.seed = (unsigned)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--overhead") && more) o.overheadUs = (uint32_t)std::atoi(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--seconds S] [--seed N] [--overhead US]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::printf("%.0f s, frame every %lu ms, %u sensors, %lu us overhead per transaction\n",
+              o.seconds, (unsigned long)(FRAME_PERIOD_US / 1000), SENSOR_COUNT,
+              (unsigned long)o.overheadUs);
+  std::printf("%-8s %-7s %-9s %-9s %-9s %-9s %-9s %s\n", "bus_hz", "chunk", "xfers/fr", "worst_us",
+              "mean_us", "bound_us", "frame_ms", "alone_ms");
+  int failures = 0;
+  const uint32_t clocks[] = {100000, 400000};
+  const uint8_t chunks[] = {0, 32, 16};
+  for (uint32_t hz : clocks) {
+    for (uint8_t chunk : chunks) {
+      const Result r = run(o, hz, chunk);
+      // A frame with the bus to itself, as UI_TRACE budgets the flush
+      uint32_t aloneUs = 0;
+      for (uint16_t len : frameLens) {
+        const I2cXfer x = {PANEL_ADDR, I2C_PRIO_DISPLAY, nullptr, len, nullptr, 0, I2C_OK, 0, nullptr, nullptr};
+        aloneUs += o.overheadUs + i2cXferUs(x, hz);
+      }
+      const bool badAlone = chunk && aloneUs != i2cDisplayFrameUs(PAGES, PAGE_BYTES, chunk, hz, o.overheadUs);
+      const bool bad = (chunk && r.worstUs > r.boundUs) || badAlone;
+      failures += bad;
+      const std::string label = chunk ? std::to_string(chunk) : "frame";
+      std::printf("%-8lu %-7s %-9zu %-9lu %-9.0f %-9s %-9.2f %.2f%s\n", (unsigned long)hz, label.c_str(),
+                  frameLens.size(), (unsigned long)r.worstUs, r.meanUs,
+                  chunk ? std::to_string(r.boundUs).c_str() : "-", r.frameMs, aloneUs / 1000.0,
+                  badAlone ? "  FAIL (i2cDisplayFrameUs)" : bad ? "  FAIL" : "");
+    }
+  }
+
+  wire.begin();                                   // setup(), before heapLock()
+  failures += recoverCases(PERIPH_PINS, "peripheral", true);
+  recoverCases(WIRE_PINS, "Wire end/begin", false);
+  wire.end();
+  return failures ? 1 : 0;
+}
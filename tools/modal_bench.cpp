@@ -0,0 +1,267 @@
+// Host benchmark for the dialog flows (ModalLogic.cpp) against the flag
+// dispatch they replaced.
+//
+// Both versions implement the password dialog (unlock with a hash job that
+// takes a few polls, wrong code, lockout-free retry) and the exit confirm
+// dialog over the same event script: the flag version as the old
+// classify() + FSM[state][event] actions on passwordVisible/confirmVisible,
+// the flow version as sequential code resumed by modalFeed(). After every
+// event and poll the visible state (open dialog, digits, cursor, wrong,
+// busy, result) must match whenever neither hash job runs (the flow takes
+// its first slice at submit, so it finishes one loop earlier).
+//
+// Global operator new is counted: opening, resuming and closing flows
+// must not allocate. Prints ns per dispatched event for both.
+// Exits 1 on any allocation or state mismatch.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/modal_bench.cpp ModalLogic.cpp -o modal_bench
+// Usage: ./modal_bench [--rounds 200000]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "ModalLogic.h"
+
+static size_t allocs = 0;
+void* operator new(size_t n){ allocs++; if (void* p = std::malloc(n ? n : 1)) return p; throw std::bad_alloc(); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+enum Ev : uint8_t {
+  EV_UP_CLICK, EV_DOWN_CLICK, EV_ENTER_CLICK, EV_ESC_CLICK,
+  EV_ENTER_DOUBLE, EV_ESC_DOUBLE, EV_COUNT,
+  EV_OPEN_PASS = 100, EV_OPEN_CONFIRM, EV_LOOP        // script only
+};
+
+static const uint8_t LEN = 4;
+static const uint8_t CODE[LEN] = { 1, 2, 3, 4 };
+static const uint8_t HASH_POLLS = 3;                    // Password.cpp: slices per check
+
+// Stand-in hash job shared by both versions (one instance each)
+enum Result : uint8_t { R_IDLE, R_BUSY, R_OK, R_WRONG };
+struct Job {
+  uint8_t left = 0;
+  bool ok = false;
+  bool start(const uint8_t* d){ left = HASH_POLLS; ok = !std::memcmp(d, CODE, LEN); return true; }
+  Result poll(){
+    if (!left) return R_IDLE;
+    return --left ? R_BUSY : (ok ? R_OK : R_WRONG);
+  }
+};
+
+struct View {
+  uint8_t open;                // 0 none, 1 password, 2 confirm
+  uint8_t digits[LEN], index, confirmIdx;
+  bool wrong, busy, unlocked;
+  uint8_t applied;
+  bool operator!=(const View& o) const { return std::memcmp(this, &o, sizeof(View)) != 0; }
+};
+
+// ----- Flag version (as MenuUI.cpp had it) -----
+namespace flags {
+  static Job job;
+  static bool passwordVisible, confirmVisible, passWrong, passBusy, unlocked;
+  static uint8_t passDigits[LEN], passIndex, confirmIdx, applied;
+
+  enum St : uint8_t { ST_IDLE, ST_PASSWORD, ST_CONFIRM, ST_COUNT };
+  static St classify(){
+    if (passwordVisible) return ST_PASSWORD;
+    if (confirmVisible) return ST_CONFIRM;
+    return ST_IDLE;
+  }
+  static void reset(){ std::memset(passDigits, 0, LEN); passIndex = 0; passWrong = false; }
+  static void aNone(){}
+  static void aInc(){ passWrong = false; passDigits[passIndex] = (uint8_t)((passDigits[passIndex] + 1) % 10); }
+  static void aDec(){ passWrong = false; passDigits[passIndex] = (uint8_t)((passDigits[passIndex] + 9) % 10); }
+  static void aNext(){ passWrong = false; passIndex = (uint8_t)((passIndex + 1) % LEN); }
+  static void aPrev(){ passWrong = false; passIndex = (uint8_t)((passIndex + LEN - 1) % LEN); }
+  static void aSubmit(){ if (passBusy) return; passWrong = false; passBusy = job.start(passDigits); }
+  static void aCancel(){ if (passBusy) return; passwordVisible = false; reset(); }
+  static void aCInc(){ if (confirmIdx < 3) confirmIdx++; }
+  static void aCDec(){ if (confirmIdx > 0) confirmIdx--; }
+  static void aCClose(){ confirmVisible = false; }
+  static void aCChoose(){ if (confirmIdx < 2) applied++; confirmVisible = false; }
+  static void aCAgain(){ confirmIdx = 0; }
+  typedef void (*Action)();
+  static const Action FSM[ST_COUNT][EV_COUNT] = {
+    { aNone, aNone, aNone, aNone, aNone, aNone },
+    { aInc, aDec, aNext, aPrev, aSubmit, aCancel },
+    { aCInc, aCDec, aCChoose, aCClose, aCClose, aCAgain },
+  };
+  static void open(uint8_t which){
+    if (which == EV_OPEN_PASS) { passwordVisible = true; reset(); }
+    else { confirmVisible = true; confirmIdx = 0; }
+  }
+  static void dispatch(uint8_t ev){ FSM[classify()][ev](); }
+  static void service(){
+    const Result r = job.poll();
+    if (r == R_IDLE || r == R_BUSY) return;
+    passBusy = false;
+    if (!passwordVisible) return;
+    if (r == R_OK) { unlocked = true; passwordVisible = false; reset(); }
+    else { unlocked = false; passWrong = true; }
+  }
+  static View view(){
+    View v = {};
+    v.open = passwordVisible ? 1 : confirmVisible ? 2 : 0;
+    std::memcpy(v.digits, passDigits, LEN);
+    v.index = passIndex; v.confirmIdx = confirmVisible ? confirmIdx : 0;
+    v.wrong = passWrong; v.busy = passBusy; v.unlocked = unlocked; v.applied = applied;
+    return v;
+  }
+}
+
+// ----- Flow version (as MenuUI.cpp has it now) -----
+namespace flow {
+  static Job job;
+  static bool unlocked;
+  static uint8_t applied;
+  struct PassFrame { ModalFrame co; uint8_t digits[LEN], index; bool wrong, busy; Result result; };
+  struct ConfirmFrame { ModalFrame co; uint8_t idx; };
+  static PassFrame pass;
+  static ConfirmFrame confirm;
+  static ModalRunner modal;
+
+  static void reset(){ std::memset(pass.digits, 0, LEN); pass.index = 0; pass.wrong = false; }
+  static void edit(uint8_t ev){
+    pass.wrong = false;
+    if (ev == EV_UP_CLICK)        pass.digits[pass.index] = (uint8_t)((pass.digits[pass.index] + 1) % 10);
+    else if (ev == EV_DOWN_CLICK) pass.digits[pass.index] = (uint8_t)((pass.digits[pass.index] + 9) % 10);
+    else if (ev == EV_ENTER_CLICK) pass.index = (uint8_t)((pass.index + 1) % LEN);
+    else if (ev == EV_ESC_CLICK)   pass.index = (uint8_t)((pass.index + LEN - 1) % LEN);
+  }
+  static ModalStatus passFlow(uint8_t ev){
+    MODAL_BEGIN(pass.co);
+    reset();
+    pass.busy = false;
+    for (;;) {
+      MODAL_AWAIT_EVENT(pass.co, ev);
+      if (ev == EV_ESC_DOUBLE) { reset(); break; }
+      if (ev != EV_ENTER_DOUBLE) { edit(ev); continue; }
+      pass.wrong = false;
+      pass.busy = job.start(pass.digits);
+      MODAL_AWAIT(pass.co, (pass.result = job.poll()) != R_BUSY);
+      pass.busy = false;
+      if (pass.result == R_OK) { unlocked = true; reset(); break; }
+      unlocked = false;
+      pass.wrong = true;
+    }
+    MODAL_END(pass.co);
+  }
+  static ModalStatus confirmFlow(uint8_t ev){
+    MODAL_BEGIN(confirm.co);
+    confirm.idx = 0;
+    for (;;) {
+      MODAL_AWAIT_EVENT(confirm.co, ev);
+      if (ev == EV_UP_CLICK) { if (confirm.idx < 3) confirm.idx++; continue; }
+      if (ev == EV_DOWN_CLICK) { if (confirm.idx > 0) confirm.idx--; continue; }
+      if (ev == EV_ESC_DOUBLE) { confirm.idx = 0; continue; }
+      if (ev == EV_ENTER_CLICK && confirm.idx < 2) applied++;
+      break;
+    }
+    MODAL_END(confirm.co);
+  }
+  static void drawNone(){}
+  static const ModalFlow PASS = { &pass.co, passFlow, drawNone };
+  static const ModalFlow CONFIRM = { &confirm.co, confirmFlow, drawNone };
+
+  static void open(uint8_t which){ modalOpen(modal, which == EV_OPEN_PASS ? PASS : CONFIRM); }
+  static void dispatch(uint8_t ev){ modalFeed(modal, ev); }
+  static void service(){ modalFeed(modal, MODAL_POLL); }
+  static View view(){
+    View v = {};
+    v.open = modalIs(modal, PASS) ? 1 : modalIs(modal, CONFIRM) ? 2 : 0;
+    if (v.open == 1) {
+      std::memcpy(v.digits, pass.digits, LEN);
+      v.index = pass.index; v.wrong = pass.wrong; v.busy = pass.busy;
+    }
+    v.confirmIdx = v.open == 2 ? confirm.idx : 0;
+    v.unlocked = unlocked; v.applied = applied;
+    return v;
+  }
+}
+
+// Unlock attempt with a wrong code, then the right one; then the confirm
+// dialog: move, ask again, apply. Polls between events like the UI loop.
+static std::vector<uint8_t> script(){
+  std::vector<uint8_t> s = { EV_OPEN_PASS };
+  auto digit = [&](uint8_t d){ for (uint8_t i = 0; i < d; i++) s.push_back(EV_UP_CLICK); s.push_back(EV_ENTER_CLICK); };
+  for (uint8_t d : { 1, 2, 3, 5 }) digit(d);
+  s.push_back(EV_ENTER_DOUBLE);
+  for (int i = 0; i < 4; i++) s.push_back(EV_LOOP);
+  s.push_back(EV_ESC_CLICK);                 // back to the last digit
+  s.push_back(EV_DOWN_CLICK);                // 5 -> 4
+  s.push_back(EV_ENTER_DOUBLE);
+  for (int i = 0; i < 4; i++) s.push_back(EV_LOOP);
+  s.push_back(EV_OPEN_CONFIRM);
+  for (uint8_t e : { EV_UP_CLICK, EV_UP_CLICK, EV_UP_CLICK, EV_UP_CLICK, EV_DOWN_CLICK, EV_ESC_DOUBLE,
+                     EV_UP_CLICK, EV_ENTER_CLICK }) {
+    s.push_back(e);
+    s.push_back(EV_LOOP);
+  }
+  s.push_back(EV_OPEN_PASS);
+  s.push_back(EV_UP_CLICK);
+  s.push_back(EV_ESC_DOUBLE);                // cancel
+  return s;
+}
+
+template<class Open, class Dispatch, class Service>
+static double run(const std::vector<uint8_t>& s, uint32_t rounds, Open open, Dispatch dispatch, Service service){
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < rounds; r++) {
+    for (uint8_t e : s) {
+      if (e == EV_LOOP) service();
+      else if (e >= EV_OPEN_PASS) open(e);
+      else dispatch(e);
+    }
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+  return ns / rounds / s.size();
+}
+
+int main(int argc, char** argv){
+  uint32_t rounds = 200000;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--rounds") && i + 1 < argc) rounds = (uint32_t)std::atol(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--rounds N]\n", argv[0]);
+      return 2;
+    }
+  }
+  const std::vector<uint8_t> s = script();
+  int failures = 0;
+
+  // Step both in lockstep and compare what the dialogs would draw
+  for (size_t i = 0; i < s.size(); i++) {
+    const uint8_t e = s[i];
+    if (e == EV_LOOP) { flags::service(); flow::service(); }
+    else if (e >= EV_OPEN_PASS) { flags::open(e); flow::open(e); }
+    else { flags::dispatch(e); flow::dispatch(e); }
+    if (!flags::job.left && !flow::job.left && flags::view() != flow::view()) {
+      std::printf("FAIL: state differs after step %zu (event %u)\n", i, e);
+      failures++;
+    }
+  }
+  const View end = flow::view();
+  if (!end.unlocked || end.applied != 1 || end.open) {
+    std::printf("FAIL: session ended unlocked=%d applied=%u open=%u\n", end.unlocked, end.applied, end.open);
+    failures++;
+  }
+
+  const size_t before = allocs;
+  const double flagNs = run(s, rounds, flags::open, flags::dispatch, flags::service);
+  const double flowNs = run(s, rounds, flow::open, flow::dispatch, flow::service);
+  const size_t flowAllocs = allocs - before;
+
+  std::printf("frames: password %zu B, confirm %zu B, runner %zu B (static)\n",
+              sizeof(flow::PassFrame), sizeof(flow::ConfirmFrame), sizeof(ModalRunner));
+  std::printf("script %zu steps x %u rounds\n", s.size(), rounds);
+  std::printf("%-8s %s\n", "dispatch", "ns/step");
+  std::printf("%-8s %.2f\n", "flags", flagNs);
+  std::printf("%-8s %.2f\n", "flows", flowNs);
+  std::printf("heap allocations while running: %zu\n", flowAllocs);
+  if (flowAllocs) failures++;
+  return failures ? 1 : 0;
+}
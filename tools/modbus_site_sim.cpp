@@ -0,0 +1,260 @@
+// Host run of the Modbus site master (ModbusLogic.cpp) against simulated
+// units over a pty pair.
+//
+// A bus thread on one end of the pty plays up to 16 downstream units at
+// addresses 2..17: each answers through mbServe() after its own turnaround
+// (1..3 ms plus jitter) and the reply's wire time at --baud, and every
+// fifth one (index 2, 7, 12) is switched off. The master on the other end
+// polls the first N of them, N = 1, 2, 4, 8, 16, two ways:
+//   naive      fixed 100 ms reply timeout, end of reply by line silence,
+//              a fixed 10 ms pause between polls, dead units polled every
+//              cycle - the usual first Modbus master loop
+//   pipelined  the ModbusLogic schedule: next request one frame gap after
+//              the known reply length, per-node adaptive timeout, dead
+//              units probed every MB_PROBE_CYCLES cycles
+// RS-485 is half duplex, so "pipelined" means no idle line between polls,
+// not several requests in flight.
+//
+// Prints mean / worst poll-cycle time per node count after a warm-up.
+// Exits 1 if the pipelined schedule is not faster at every node count, a
+// live unit ever goes offline, or a cached register differs from what the
+// unit served.
+//
+// Build: g++ -O2 -std=gnu++17 -pthread -I. tools/modbus_site_sim.cpp ModbusLogic.cpp Crc.cpp -o modbus_site_sim
+// Usage: ./modbus_site_sim [--baud 19200] [--cycles 8] [--verbose]
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <random>
+#include <termios.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include "ModbusLogic.h"
+
+static const uint8_t FIRST_ADDR = 2;
+static const uint8_t SIM_UNITS = 16;
+static const uint32_t NAIVE_TIMEOUT_US = 100000;
+static const uint32_t NAIVE_PAUSE_US = 10000;
+static const int WARMUP_CYCLES = 4;             // > MB_DEAD_AFTER: dead units found
+
+static uint32_t baud = 19200;
+static bool verbose = false;
+
+static uint32_t nowUs(){
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+static void sleepUs(uint32_t us){
+  const uint32_t end = nowUs() + us;
+  if (us > 200) usleep(us - 200);
+  while ((int32_t)(end - nowUs()) > 0) {}
+}
+
+static bool unitAlive(uint8_t i){ return i % 5 != 2; }
+static uint16_t unitTemp(uint8_t addr){ return (uint16_t)(180 + addr * 7); }          // 0.1 C
+static uint16_t unitAlarms(uint8_t addr){ return addr % 6 == 3 ? 0x08 : 0; }
+
+// ===== Simulated units =====
+static std::atomic<bool> busStop{false};
+
+static void busThread(int fd){
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> jitter(-200, 200);
+  uint8_t req[MB_FRAME_MAX], out[MB_FRAME_MAX];
+  uint16_t len = 0;
+  while (!busStop) {
+    pollfd p = { fd, POLLIN, 0 };
+    const int gapMs = (int)(mbFrameGapUs(baud) / 1000) + 1;
+    if (poll(&p, 1, len ? gapMs : 20) <= 0) { len = 0; continue; }  // silence ends a runt
+    const ssize_t n = read(fd, req + len, sizeof(req) - len);
+    if (n <= 0) continue;
+    len = (uint16_t)(len + n);
+    if (len < 8) continue;
+
+    for (uint8_t i = 0; i < SIM_UNITS; i++) {
+      const uint8_t addr = (uint8_t)(FIRST_ADDR + i);
+      uint16_t regs[MB_REG_COUNT] = {};
+      regs[MB_REG_TEMP] = unitTemp(addr);
+      regs[MB_REG_ALARMS] = unitAlarms(addr);
+      regs[MB_REG_FAN1_RPM] = (uint16_t)(1200 + addr);
+      const uint16_t r = mbServe(req, 8, addr, regs, MB_REG_COUNT, out);
+      if (!r || !unitAlive(i)) continue;
+      sleepUs((uint32_t)(1000 + (addr * 337) % 2000 + jitter(rng)));   // turnaround
+      sleepUs(r * mbCharUs(baud));                                    // on the wire
+      if (write(fd, out, r) != r) perror("bus write");
+    }
+    len = 0;
+  }
+}
+
+// ===== Master side =====
+static void drain(int fd){
+  uint8_t junk[64];
+  while (read(fd, junk, sizeof(junk)) > 0) {}
+}
+
+static void sendRequest(int fd, uint8_t addr){
+  uint8_t req[8];
+  const uint8_t n = mbBuildRead(req, addr, 0, MB_REG_COUNT);
+  drain(fd);
+  if (write(fd, req, n) != n) perror("master write");
+  sleepUs(n * mbCharUs(baud));              // like HardwareSerial::flush()
+}
+
+// Bytes until `want` arrived (want = 0: until a frame gap of silence after
+// the first byte) or the timeout ran out
+static uint16_t readReply(int fd, uint8_t* buf, uint16_t want, uint32_t timeoutUs){
+  const uint32_t start = nowUs();
+  uint16_t len = 0;
+  for (;;) {
+    int32_t left = (int32_t)(start + timeoutUs - nowUs());
+    if (want == 0 && len) left = (int32_t)mbFrameGapUs(baud);
+    if (left <= 0) break;
+    pollfd p = { fd, POLLIN, 0 };
+    const timespec ts = { 0, (long)left * 1000 };
+    if (ppoll(&p, 1, &ts, nullptr) <= 0) break;
+    const ssize_t n = read(fd, buf + len, MB_FRAME_MAX - len);
+    if (n > 0) len = (uint16_t)(len + n);
+    if (want && len >= want) break;
+    if (len >= 5 && (buf[1] & 0x80)) break;
+  }
+  return len;
+}
+
+struct Stats {
+  double sumMs = 0, maxMs = 0;
+  int cycles = 0;
+  uint32_t timeouts = 0;
+  bool lostLive = false, badValue = false;
+  void add(uint32_t us){
+    const double ms = us / 1000.0;
+    sumMs += ms;
+    if (ms > maxMs) maxMs = ms;
+    cycles++;
+  }
+};
+
+static bool checkRegs(uint8_t addr, const uint16_t* regs){
+  return regs[MB_REG_TEMP] == unitTemp(addr) && regs[MB_REG_ALARMS] == unitAlarms(addr) &&
+         regs[MB_REG_FAN1_RPM] == 1200 + addr;
+}
+
+static Stats runNaive(int fd, uint8_t nodes, int cycles){
+  Stats st;
+  uint8_t buf[MB_FRAME_MAX];
+  uint16_t regs[MB_REG_COUNT];
+  for (int c = 0; c < WARMUP_CYCLES + cycles; c++) {
+    const uint32_t t0 = nowUs();
+    for (uint8_t i = 0; i < nodes; i++) {
+      const uint8_t addr = (uint8_t)(FIRST_ADDR + i);
+      sendRequest(fd, addr);
+      const uint16_t len = readReply(fd, buf, 0, NAIVE_TIMEOUT_US);
+      const MbResult r = len ? mbParseRead(buf, len, addr, MB_REG_COUNT, regs, nullptr) : MB_TIMEOUT;
+      if (c >= WARMUP_CYCLES && unitAlive(i)) {
+        if (r != MB_OK) st.timeouts++;
+        else if (!checkRegs(addr, regs)) st.badValue = true;
+      }
+      sleepUs(NAIVE_PAUSE_US);
+    }
+    if (c >= WARMUP_CYCLES) st.add(nowUs() - t0);
+  }
+  return st;
+}
+
+static Stats runPipelined(int fd, uint8_t nodes, int cycles){
+  Stats st;
+  MbMaster m;
+  mbMasterInit(m, FIRST_ADDR, nodes, baud);
+  uint8_t buf[MB_FRAME_MAX];
+  uint16_t regs[MB_REG_COUNT];
+  const uint32_t total = (uint32_t)(WARMUP_CYCLES + cycles);
+  for (uint32_t seen = 0;;) {
+    const int8_t i = mbMasterNext(m, nowUs());
+    if (m.cycles != seen) {                 // a cycle closed
+      seen = m.cycles;
+      if (seen > WARMUP_CYCLES + 1) st.add(m.lastCycleUs);
+    }
+    if (m.cycles > total) break;
+    if (i < 0) continue;
+    const uint8_t addr = m.node[i].addr;
+    const uint32_t timeoutUs = mbMasterTimeoutUs(m, (uint8_t)i);
+    sendRequest(fd, addr);
+    const uint32_t sent = nowUs();
+    const uint16_t len = readReply(fd, buf, mbReadReplyLen(MB_REG_COUNT), timeoutUs);
+    const uint32_t rtt = nowUs() - sent;
+    const MbResult r = len ? mbParseRead(buf, len, addr, MB_REG_COUNT, regs, nullptr) : MB_TIMEOUT;
+    mbMasterDone(m, (uint8_t)i, r, rtt, regs, nowUs() / 1000);
+    if (unitAlive((uint8_t)i)) {
+      if (m.cycles > WARMUP_CYCLES && r != MB_OK) st.timeouts++;
+      if (m.cycles > 1 && !m.node[i].online) st.lostLive = true;
+      if (r == MB_OK && !checkRegs(addr, regs)) st.badValue = true;
+    }
+    if (verbose)
+      printf("  cycle %u addr %u %s rtt %.2f ms timeout %.2f ms\n", (unsigned)m.cycles, addr,
+             r == MB_OK ? "ok" : r == MB_TIMEOUT ? "timeout" : "error", rtt / 1000.0, timeoutUs / 1000.0);
+    sleepUs(mbFrameGapUs(baud));
+  }
+  return st;
+}
+
+static int openBus(int& slaveFd){
+  const int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0 || grantpt(fd) || unlockpt(fd)) return -1;
+  slaveFd = open(ptsname(fd), O_RDWR | O_NOCTTY);
+  if (slaveFd < 0) return -1;
+  termios t;
+  tcgetattr(slaveFd, &t);
+  cfmakeraw(&t);
+  tcsetattr(slaveFd, TCSANOW, &t);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return fd;
+}
+
+int main(int argc, char** argv){
+  int cycles = 8;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--baud") && i + 1 < argc) baud = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--cycles") && i + 1 < argc) cycles = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--verbose")) verbose = true;
+    else { fprintf(stderr, "usage: %s [--baud 19200] [--cycles 8] [--verbose]\n", argv[0]); return 1; }
+  }
+  if (baud < 1200 || cycles < 1) { fprintf(stderr, "bad --baud / --cycles\n"); return 1; }
+
+  int unitFd;
+  const int fd = openBus(unitFd);
+  if (fd < 0) { perror("pty"); return 1; }
+  std::thread bus(busThread, unitFd);
+
+  printf("baud %u, char %u us, frame gap %u us, reply %u bytes, %d cycles after %d warm-up\n",
+         (unsigned)baud, (unsigned)mbCharUs(baud), (unsigned)mbFrameGapUs(baud),
+         (unsigned)mbReadReplyLen(MB_REG_COUNT), cycles, WARMUP_CYCLES);
+  printf("%5s %4s | %9s %9s | %9s %9s | %7s %8s\n", "nodes", "dead", "naive avg", "max",
+         "pipe avg", "max", "speedup", "timeouts");
+  bool fail = false;
+  static const uint8_t COUNTS[] = { 1, 2, 4, 8, 16 };
+  for (uint8_t nodes : COUNTS) {
+    uint8_t dead = 0;
+    for (uint8_t i = 0; i < nodes; i++) dead += !unitAlive(i);
+    const Stats nv = runNaive(fd, nodes, cycles);
+    const Stats pp = runPipelined(fd, nodes, cycles);
+    const double nAvg = nv.sumMs / nv.cycles, pAvg = pp.sumMs / pp.cycles;
+    printf("%5u %4u | %6.1f ms %6.1f ms | %6.1f ms %6.1f ms | %6.2fx %4u/%-3u\n", nodes, dead,
+           nAvg, nv.maxMs, pAvg, pp.maxMs, nAvg / pAvg, (unsigned)nv.timeouts, (unsigned)pp.timeouts);
+    if (pAvg >= nAvg) { printf("  FAIL: pipelined not faster\n"); fail = true; }
+    if (pp.lostLive) { printf("  FAIL: a live unit went offline\n"); fail = true; }
+    if (nv.badValue || pp.badValue) { printf("  FAIL: cached registers differ\n"); fail = true; }
+  }
+  printf("(timeouts: naive/pipelined polls of live units without a good reply)\n");
+
+  busStop = true;
+  bus.join();
+  close(fd);
+  close(unitFd);
+  return fail ? 1 : 0;
+}
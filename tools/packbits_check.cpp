@@ -0,0 +1,133 @@
+// Host check of the frame mirror's PackBits coder (RemoteLinkLogic.cpp).
+//
+//   exhaustive  every buffer of up to 12 bytes over a 3-symbol alphabet:
+//               unpack(pack(x)) == x and the packed size stays within
+//               REMOTE_PACKBITS_MAX(n), which some input reaches
+//   random      buffers up to 1024 bytes of noise, short and long runs
+//               (over the 128 run limit), sparse display pages and the
+//               "AAB" worst case: round trip and size bound
+//   malformed   every truncation of a packed buffer is rejected, as is an
+//               output buffer one byte short
+//   mirror      a 128-byte page (128x64 panel) plus the 3-byte FRAME_PAGE
+//               header fits REMOTE_MAX_PAYLOAD at its worst
+// Prints the worst and typical packed sizes.
+//
+// Exits 1 on the first kind of failure it finds (all are counted).
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/packbits_check.cpp RemoteLinkLogic.cpp Crc.cpp -o packbits_check
+// Usage: ./packbits_check [--buffers 200000] [--seed 1]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "RemoteLinkLogic.h"
+
+static const uint16_t PAGE_BYTES = 128;       // FrameMirror: 128x64 panel, 8 pages
+static const uint16_t MAX_N = 1024;
+
+static int failures = 0;
+#define CHECK(c, ...) do { if (!(c)) { if (failures++ < 20) { printf("FAIL: " __VA_ARGS__); printf("\n"); } } } while (0)
+
+static uint8_t packed[REMOTE_PACKBITS_MAX(MAX_N) + 8];
+static uint8_t back[MAX_N + 8];
+
+// Round trip one buffer; returns the packed size
+static uint16_t roundTrip(const uint8_t* in, uint16_t n, const char* what){
+  const uint16_t p = remotePackBits(in, n, packed);
+  CHECK(p <= REMOTE_PACKBITS_MAX(n), "%s n=%u: packed %u > bound %u", what, n, p, REMOTE_PACKBITS_MAX(n));
+  const uint16_t u = remoteUnpackBits(packed, p, back, n);
+  CHECK(u == n && memcmp(in, back, n) == 0, "%s n=%u: round trip gave %u bytes%s", what, n, u,
+        u == n ? " that differ" : "");
+  return p;
+}
+
+int main(int argc, char** argv){
+  long buffers = 200000;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--buffers") && i + 1 < argc) buffers = atol(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = (unsigned)atoi(argv[++i]);
+  }
+
+  // ----- Exhaustive, small -----
+  uint8_t in[MAX_N];
+  long cases = 0;
+  for (uint16_t n = 0; n <= 12; n++) {
+    long total = 1;
+    for (uint16_t i = 0; i < n; i++) total *= 3;
+    uint16_t worst = 0;
+    for (long c = 0; c < total; c++) {
+      long x = c;
+      for (uint16_t i = 0; i < n; i++) { in[i] = (uint8_t)(x % 3); x /= 3; }
+      const uint16_t p = roundTrip(in, n, "exhaustive");
+      if (p > worst) worst = p;
+      cases++;
+    }
+    CHECK(worst == REMOTE_PACKBITS_MAX(n), "n=%u: worst case %u, bound %u is not tight", n, worst,
+          REMOTE_PACKBITS_MAX(n));
+  }
+  printf("exhaustive %ld buffers up to 12 bytes, bound tight at every length\n", cases);
+
+  // ----- Random -----
+  std::mt19937 rng(seed);
+  auto rnd = [&](uint32_t n){ return (uint32_t)(rng() % n); };
+  static const char* const KINDS[] = { "noise", "short runs", "long runs", "sparse page", "AAB" };
+  uint64_t inBytes[5] = {0}, outBytes[5] = {0};
+  uint16_t worstPage = 0;
+  for (long b = 0; b < buffers; b++) {
+    const int kind = (int)(b % 5);
+    const uint16_t n = kind == 3 ? PAGE_BYTES : (uint16_t)rnd(MAX_N + 1);
+    uint16_t i = 0;
+    while (i < n) {
+      uint16_t len = 1;
+      uint8_t v = (uint8_t)rng();
+      switch (kind) {
+        case 0: break;
+        case 1: len = (uint16_t)(1 + rnd(4)); v = (uint8_t)rnd(4); break;
+        case 2: len = (uint16_t)(1 + rnd(400)); break;
+        case 3: len = (uint16_t)(1 + rnd(40)); v = rnd(3) ? 0x00 : (uint8_t)(1u << rnd(8)); break;
+        case 4: in[i++] = 0xAA; if (i < n) in[i++] = 0xAA; len = 1; v = 0xBB; break;
+      }
+      while (len-- && i < n) in[i++] = v;
+    }
+    const uint16_t p = roundTrip(in, n, KINDS[kind]);
+    inBytes[kind] += n;
+    outBytes[kind] += p;
+    if (n == PAGE_BYTES && p > worstPage) worstPage = p;
+  }
+  printf("random     %ld buffers (seed %u), packed/raw:", buffers, seed);
+  for (int k = 0; k < 5; k++) printf(" %s %.2f%s", KINDS[k], inBytes[k] ? (double)outBytes[k] / inBytes[k] : 0.0,
+                                      k < 4 ? "," : "\n");
+
+  // ----- Malformed -----
+  long rejected = 0;
+  for (uint16_t n = 1; n <= 300; n += 7) {
+    for (uint16_t i = 0; i < n; i++) in[i] = (uint8_t)((i / (1 + i % 5)) * 37);
+    const uint16_t p = remotePackBits(in, n, packed);
+    for (uint16_t cut = 1; cut < p; cut++) {
+      const uint16_t u = remoteUnpackBits(packed, cut, back, n);
+      // A cut on a token boundary is a valid shorter stream, anything else must fail
+      CHECK(u < n && (u == 0 || memcmp(in, back, u) == 0), "n=%u cut to %u: unpacked %u", n, cut, u);
+      rejected++;
+    }
+    CHECK(remoteUnpackBits(packed, p, back, (uint16_t)(n - 1)) == 0, "n=%u: overflowed a short output", n);
+  }
+  const uint8_t bare[] = { 0xFE };                           // run header without its byte
+  CHECK(remoteUnpackBits(bare, 1, back, 8) == 0, "run header without its byte accepted");
+  const uint8_t nop[] = { 0x80, 0x00, 0x42 };                // 128 is a no-op header
+  CHECK(remoteUnpackBits(nop, 3, back, 8) == 1 && back[0] == 0x42, "no-op header mishandled");
+  printf("malformed  %ld truncations rejected or short\n", rejected);
+
+  // ----- Mirror page -----
+  // "AB" then "AAB" repeated: one header per three bytes from the first byte
+  in[0] = 0xAA; in[1] = 0xBB;
+  for (uint16_t i = 2; i < PAGE_BYTES; i++) in[i] = (uint8_t)((i - 2) % 3 == 2 ? 0xBB : 0xAA);
+  const uint16_t aab = roundTrip(in, PAGE_BYTES, "AAB page");
+  CHECK(aab == REMOTE_PACKBITS_MAX(PAGE_BYTES), "AAB page packed to %u, bound %u", aab, REMOTE_PACKBITS_MAX(PAGE_BYTES));
+  CHECK(3 + REMOTE_PACKBITS_MAX(PAGE_BYTES) <= REMOTE_MAX_PAYLOAD, "a worst-case page does not fit a payload");
+  printf("mirror     %u-byte page: worst %u (+3 header, payload limit %u), worst random page %u\n",
+         PAGE_BYTES, REMOTE_PACKBITS_MAX(PAGE_BYTES), REMOTE_MAX_PAYLOAD, worstPage);
+
+  printf("%s (%d failures)\n", failures ? "FAIL" : "OK", failures);
+  return failures ? 1 : 0;
+}
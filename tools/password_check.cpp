@@ -0,0 +1,249 @@
+// Host check of the unlock code logic (PasswordLogic.cpp).
+//
+//   sha256     single-block test vectors ("", "abc", 55 x 'a') and the
+//              stored chain against a straight re-computation
+//   slices     every check (any length, any digits, right or wrong) takes
+//              the same number of PASS_ROUNDS_PER_POLL slices
+//   compare    passDigestEqual() against memcmp for a difference in every
+//              bit of the digest; a code that is a prefix or an extension
+//              of the stored one is wrong
+//   timing     median time of passDigestEqual() with the first byte wrong,
+//              the last byte wrong and all equal; fails when the spread is
+//              over --spread percent (an early exit shows up as ~30x)
+//   lockout    0, 0, then 5 s doubling per failure up to 10 min; checks
+//              refused while locked; the right code clears the count;
+//              the lockout survives a reboot from the stored record; all
+//              of it across the 32-bit millis() wrap
+//
+// Exits 1 on the first kind of failure it finds (all are counted).
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/password_check.cpp PasswordLogic.cpp -o password_check
+// Usage: ./password_check [--spread 25]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "PasswordLogic.h"
+
+// Password.h's slice size
+static const uint16_t ROUNDS_PER_POLL = 32;
+
+static int failures = 0;
+#define CHECK(c, ...) do { if (!(c)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while (0)
+
+static void hex(const char* s, uint8_t* out){
+  for (int i = 0; i < 32; i++) sscanf(s + 2 * i, "%2hhx", &out[i]);
+}
+
+// Polls until done; returns the result and the number of slices
+static PassResult run(PassState& s, uint32_t now, int* slices, bool* saved){
+  PassResult r;
+  bool save;
+  *slices = 0;
+  *saved = false;
+  while ((r = passStep(s, now, ROUNDS_PER_POLL, &save)) == PASS_BUSY) (*slices)++;
+  (*slices)++;
+  *saved = save;
+  return r;
+}
+
+static void setCode(PassState& s, const char* code){
+  uint8_t d[PASS_MAX_LEN];
+  const uint8_t n = (uint8_t)strlen(code);
+  for (uint8_t i = 0; i < n; i++) d[i] = (uint8_t)(code[i] - '0');
+  passSetDefault(s, d, n);
+}
+
+static bool startCheck(PassState& s, const char* code, uint32_t now){
+  uint8_t d[PASS_MAX_LEN];
+  const uint8_t n = (uint8_t)strlen(code);
+  for (uint8_t i = 0; i < n; i++) d[i] = (uint8_t)(code[i] - '0');
+  return passStartCheck(s, d, n, now);
+}
+
+static PassResult check(PassState& s, const char* code, uint32_t now, int* slices = nullptr, bool* saved = nullptr){
+  int sl; bool sv;
+  if (!startCheck(s, code, now)) return PASS_IDLE;
+  const PassResult r = run(s, now, &sl, &sv);
+  if (slices) *slices = sl;
+  if (saved) *saved = sv;
+  return r;
+}
+
+static void testSha(){
+  struct { const char* msg; const char* digest; } vec[] = {
+    { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+    { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+      "9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318" },
+  };
+  for (auto& v : vec) {
+    uint8_t got[32], want[32];
+    passSha256Short((const uint8_t*)v.msg, (uint8_t)strlen(v.msg), got);
+    hex(v.digest, want);
+    CHECK(memcmp(got, want, 32) == 0, "sha256(\"%.8s...\", %zu bytes)", v.msg, strlen(v.msg));
+  }
+
+  // The chain, by hand: h0 = H(salt | len | digits), h(i+1) = H(h(i) | salt)
+  PassState s{};
+  setCode(s, "1001");
+  uint8_t msg[40] = {0};
+  const uint8_t first[13] = {0, 0, 0, 0, 0, 0, 0, 0, 4, 1, 0, 0, 1};
+  uint8_t h[32];
+  passSha256Short(first, sizeof(first), h);
+  for (int i = 1; i < PASS_HASH_ROUNDS; i++) {
+    memcpy(msg, h, 32);
+    memset(msg + 32, 0, 8);
+    passSha256Short(msg, 40, h);
+  }
+  CHECK(memcmp(h, s.rec.hash, 32) == 0, "stored chain differs from a straight re-computation");
+  printf("sha256    3 vectors, %d-round chain checked\n", PASS_HASH_ROUNDS);
+}
+
+static void testSlices(){
+  PassState s{};
+  const uint8_t salt[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  const uint8_t code[6] = {3, 1, 4, 1, 5, 9};
+  passStartChange(s, code, sizeof(code), salt);
+  int sl; bool saved;
+  CHECK(run(s, 0, &sl, &saved) == PASS_CHANGED && saved, "change did not store");
+  const int expect = sl;
+  int checks = 0;
+  char buf[PASS_MAX_LEN + 1];
+  for (int len = 0; len <= PASS_MAX_LEN; len++) {
+    for (int k = 0; k < 20; k++) {
+      for (int i = 0; i < len; i++) buf[i] = (char)('0' + (k * 7 + i * 3) % 10);
+      buf[len] = 0;
+      if (k == 0 && len == 6) strcpy(buf, "314159");
+      const PassResult r = check(s, buf, 0, &sl, &saved);
+      checks++;
+      CHECK(sl == expect, "check \"%s\" took %d slices, change took %d", buf, sl, expect);
+      CHECK(r == (strcmp(buf, "314159") == 0 ? PASS_OK : PASS_WRONG), "check \"%s\" gave %d", buf, r);
+      s.rec.fails = 0;           // keep the lockout out of this test
+      s.lockLenMs = 0;
+    }
+  }
+  printf("slices    %d checks, all %d slices of %d rounds\n", checks, expect, ROUNDS_PER_POLL);
+}
+
+static void testCompare(){
+  uint8_t a[32], b[32];
+  for (int i = 0; i < 32; i++) a[i] = (uint8_t)(i * 37 + 11);
+  memcpy(b, a, 32);
+  CHECK(passDigestEqual(a, b, 32), "equal digests compare unequal");
+  int n = 0;
+  for (int i = 0; i < 32; i++)
+    for (int bit = 0; bit < 8; bit++) {
+      b[i] ^= (uint8_t)(1 << bit);
+      CHECK(!passDigestEqual(a, b, 32), "difference in byte %d bit %d missed", i, bit);
+      b[i] ^= (uint8_t)(1 << bit);
+      n++;
+    }
+
+  PassState s{};
+  setCode(s, "1001");
+  CHECK(check(s, "1001", 0) == PASS_OK, "right code refused");
+  CHECK(check(s, "100", 0) == PASS_WRONG, "prefix of the code accepted");
+  s.rec.fails = 0;
+  CHECK(check(s, "10010", 0) == PASS_WRONG, "extension of the code accepted");
+  s.rec.fails = 0;
+  CHECK(check(s, "", 0) == PASS_WRONG, "empty code accepted");
+  printf("compare   %d single-bit differences, prefix/extension/empty codes\n", n);
+}
+
+static double medianNs(const uint8_t* a, const uint8_t* b, int reps){
+  using clk = std::chrono::steady_clock;
+  const int CALLS = 20000;
+  std::vector<double> t;
+  volatile bool sink = false;
+  for (int r = 0; r < reps; r++) {
+    const auto t0 = clk::now();
+    for (int i = 0; i < CALLS; i++) sink = sink ^ passDigestEqual(a, b, 32);
+    t.push_back(std::chrono::duration<double, std::nano>(clk::now() - t0).count() / CALLS);
+  }
+  std::sort(t.begin(), t.end());
+  return t[t.size() / 2];
+}
+
+static void testTiming(double maxSpread){
+  uint8_t a[32], first[32], last[32];
+  for (int i = 0; i < 32; i++) a[i] = (uint8_t)(i * 91 + 5);
+  memcpy(first, a, 32); first[0] ^= 0x80;
+  memcpy(last, a, 32);  last[31] ^= 0x01;
+  // Interleave the three cases so drift hits them alike; median of medians
+  std::vector<double> tf, tl, te;
+  for (int round = 0; round < 15; round++) {
+    tf.push_back(medianNs(a, first, 9));
+    tl.push_back(medianNs(a, last, 9));
+    te.push_back(medianNs(a, a, 9));
+  }
+  auto med = [](std::vector<double>& v){ std::sort(v.begin(), v.end()); return v[v.size() / 2]; };
+  const double f = med(tf), l = med(tl), e = med(te);
+  const double lo = std::min({f, l, e}), hi = std::max({f, l, e});
+  const double spread = 100.0 * (hi - lo) / lo;
+  printf("timing    first byte wrong %.1f ns, last byte wrong %.1f ns, equal %.1f ns: spread %.0f %%\n",
+         f, l, e, spread);
+  CHECK(spread <= maxSpread, "compare time depends on where the digests differ (%.0f %% > %.0f %%)",
+        spread, maxSpread);
+}
+
+static void testLockout(uint32_t t0){
+  PassState s{};
+  setCode(s, "2468");
+  passRestore(s, t0);
+  CHECK(passLockedMs(s, t0) == 0, "fresh state locked");
+
+  uint32_t now = t0;
+  uint32_t expect = 0;
+  bool saved;
+  for (int fail = 1; fail <= 12; fail++) {
+    int sl;
+    const PassResult r = check(s, "1357", now, &sl, &saved);
+    CHECK(r == PASS_WRONG, "t0 %u: failure %d gave %d", t0, fail, r);
+    expect = fail < PASS_FREE_TRIES ? 0 : PASS_LOCK_BASE_MS << (fail - PASS_FREE_TRIES);
+    if (expect > PASS_LOCK_MAX_MS) expect = PASS_LOCK_MAX_MS;
+    CHECK(passLockDuration((uint8_t)fail) == expect, "lock after %d failures %u, want %u",
+          fail, passLockDuration((uint8_t)fail), expect);
+    CHECK(passLockedMs(s, now) == expect, "t0 %u: locked %u ms after failure %d, want %u",
+          t0, passLockedMs(s, now), fail, expect);
+    CHECK(saved == (fail >= PASS_FREE_TRIES), "failure %d: persisted %d", fail, saved);
+    if (expect) {
+      // Refused while locked, even with the right code, and without cost
+      CHECK(!startCheck(s, "2468", now + expect - 1), "check allowed 1 ms before the lock ends");
+      CHECK(passLockedMs(s, now + expect - 1) == 1, "lock does not count down");
+      // A reboot mid-lock restores the whole lock from the stored record
+      PassState b{};
+      b.rec = s.rec;
+      passRestore(b, now + 1234);
+      CHECK(passLockedMs(b, now + 1234) == expect, "reboot: locked %u ms, want %u",
+            passLockedMs(b, now + 1234), expect);
+    }
+    now += expect;                   // wait out the lock exactly
+  }
+  CHECK(passLockDuration(255) == PASS_LOCK_MAX_MS, "lock after 255 failures not capped");
+
+  // The right code clears the count (persisted, as it was persisted)
+  CHECK(check(s, "2468", now, nullptr, &saved) == PASS_OK, "right code refused after the lock");
+  CHECK(saved && s.rec.fails == 0, "right code did not clear the persisted count");
+  CHECK(check(s, "1357", now, nullptr, &saved) == PASS_WRONG && !saved && passLockedMs(s, now) == 0,
+        "count restarted wrong after a good code");
+}
+
+int main(int argc, char** argv){
+  double spread = 25;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--spread") && i + 1 < argc) spread = atof(argv[++i]);
+  }
+  testSha();
+  testSlices();
+  testCompare();
+  testTiming(spread);
+  testLockout(1000);
+  testLockout(0xFFFFFFFFu - 20000);     // millis() wraps during the locks
+  printf("lockout   %u ms doubling to %u ms, reboot and millis() wrap checked\n",
+         (unsigned)PASS_LOCK_BASE_MS, (unsigned)PASS_LOCK_MAX_MS);
+  printf("%s (%d failures)\n", failures ? "FAIL" : "OK", failures);
+  return failures ? 1 : 0;
+}
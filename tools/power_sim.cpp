@@ -0,0 +1,329 @@
+// Host simulation of the power manager (PowerLogic.cpp) on a simulated
+// FreeRTOS tick: projected duty cycle and wake-to-first-frame latency.
+//
+// One CPU, tasks run to completion in time order:
+//   UI    0.7 ms a loop, plus a frame every FRAME_MS (DIM: 200 ms) while
+//         the panel is on; vTaskDelay 5 ms (DIM 20 ms), OFF blocks until a
+//         button edge or POWER_OFF_SLICE_MS (as PowerManager.cpp)
+//   MON   every 500 ms        AVI  every 100 ms
+//   FAN   fan current blocks: a sample every tick for 256 ticks every 2 s
+//   LINK  remote link: blocks on RX, no host traffic in the script
+//   MBUS  Modbus slave: RX wait times out every MB_TASK_IDLE_MS (500 ms)
+// and the tach capture timer as a STOP hold, either always on or in capture
+// windows while OFF (tachDutyTick(), run by the UI loop as fanTachService()
+// does). A "+rx polling" set keeps the old 2 ms / 5 ms LINK and MBUS polls
+// for comparison. When every task is blocked the
+// idle hook asks powerSleepPlan() with the time to the next task timeout,
+// as vPortSuppressTicksAndSleep() does: STOP ends at the RTC alarm or at a
+// button edge and costs POWER_STOP_WAKE_MS of clock restart. Presses come
+// in sessions (3-30 presses 0.4-4 s apart, a session every 40 min on
+// average); a wake alarm is raised every 6 h on average for 10 min.
+//
+// Prints, for task sets from the bare UI to the full tree, the time in each
+// panel state, the MCU's run / WFI / STOP shares, a projected supply
+// current (the figures below; edit them for the board) and the
+// wake-to-first-frame latency. Checks, and exits 1 on a mismatch, that:
+// DIM and OFF come on time after the last input; the press that woke the
+// panel is swallowed and no other; an alarm wakes it; the panel-on share
+// and latencies the logic reports match the simulation; STOP only ever
+// happens while OFF, without holds, and ends before the next task timeout;
+// the sets without a permanent hold or fast polls (the full tree among
+// them) spend some time in STOP.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/power_sim.cpp PowerLogic.cpp FanTachLogic.cpp -o power_sim
+// Usage: ./power_sim [--hours 24] [--seed 1] [--frame-us 9000] [--dim-s 60] [--off-s 300]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "FanTachLogic.h"
+#include "PowerLogic.h"
+
+// As in MenuUI.cpp / MenuUsingOLED.ino / PowerManager.h
+static const uint32_t FRAME_MS = 25;
+static const uint32_t FRAME_MS_DIM = 200;
+static const uint32_t UI_DELAY_MS = 5;
+static const uint32_t OFF_SLICE_MS = 1000;
+static const uint32_t UI_LOOP_US = 700;
+
+// Rough supply currents, mA: STM32F103 at 72 MHz (run, WFI with the
+// peripherals clocked, STOP), SSD1306 128x64 with about a third lit
+static const double MCU_RUN_MA = 30, MCU_WFI_MA = 12, MCU_STOP_MA = 0.03;
+static const double PANEL_ACTIVE_MA = 12, PANEL_DIM_MA = 3, PANEL_OFF_MA = 0.01;
+
+static uint32_t frameUs = 9000;         // a dirty-span frame; a full repaint is ~28.7 ms
+static uint16_t dimAfterS = 60, offAfterS = 300;
+static int failures = 0;
+
+static void fail(const char* set, const char* what, double t, double got, double want){
+  if (failures++ < 12) std::printf("FAIL: %s: %s at %.3f s: %.1f, want %.1f\n", set, what, t / 1e6, got, want);
+}
+
+// ===== Script =====
+struct Script {
+  std::vector<uint64_t> presses;                 // us
+  std::vector<std::pair<uint64_t, uint64_t>> alarms;   // raised, cleared (us)
+};
+
+static Script makeScript(double hours, unsigned seed){
+  std::mt19937 rng(seed);
+  std::exponential_distribution<double> sessionGap(1.0 / (40 * 60.0)), alarmGap(1.0 / (6 * 3600.0));
+  std::uniform_int_distribution<int> count(3, 30);
+  std::uniform_real_distribution<double> pressGap(0.4, 4.0);
+  const double end = hours * 3600;
+  Script s;
+  for (double t = 2 + sessionGap(rng); t < end; t += sessionGap(rng)) {
+    for (int n = count(rng); n-- && t < end; t += pressGap(rng)) s.presses.push_back((uint64_t)(t * 1e6));
+  }
+  for (double t = alarmGap(rng); t < end; t += 600 + alarmGap(rng))
+    s.alarms.push_back({(uint64_t)(t * 1e6), (uint64_t)((t + 600) * 1e6)});
+  return s;
+}
+
+// ===== Kernel =====
+struct Periodic {
+  uint32_t periodUs, costUs;
+  uint32_t burst, burstGapUs;           // burst > 1: that many wakes burstGapUs apart per period
+  uint64_t next;
+  uint32_t done;
+};
+
+enum TachHold : uint8_t { TACH_NONE, TACH_HELD, TACH_WINDOWS };
+
+struct TaskSet {
+  const char* name;
+  bool fanBlocks;
+  TachHold tach;
+  uint32_t linkWakeMs, mbusWakeMs;      // 0: blocked on RX, no wakes
+  bool wantStop;                        // must spend time in STOP
+};
+
+struct Result {
+  uint64_t stateUs[3], runUs, wfiUs, stopUs;
+  uint32_t wakes, pressCount, swallowed, alarmWakes;
+  uint32_t latCount, latMin, latMax;
+  uint64_t latSum;
+};
+
+static uint64_t tickAfter(uint64_t us, uint32_t ms){ return (us / 1000 + ms) * 1000; }
+
+static Result run(const TaskSet& set, const Script& sc, double hours){
+  Result r = {};
+  r.latMin = ~0u;
+  std::vector<Periodic> tasks = {
+    {500000, 60, 1, 0, 500000, 0},                          // MON
+    {100000, 200, 1, 0, 100000, 0},                         // AVI
+  };
+  if (set.fanBlocks) tasks.push_back({2000000, 30, 256, 1000, 2000000, 0});
+  if (set.linkWakeMs) tasks.push_back({set.linkWakeMs * 1000, 15, 1, 0, set.linkWakeMs * 1000, 0});
+  if (set.mbusWakeMs) tasks.push_back({set.mbusWakeMs * 1000, 15, 1, 0, set.mbusWakeMs * 1000, 0});
+  uint8_t holds = set.tach != TACH_NONE ? POWER_HOLD_TACH : 0;
+  TachDuty duty;
+  tachDutyReset(duty, 0);
+
+  PowerLogic p;
+  powerLogicReset(p, 0);
+  PowerState shown = PWR_ACTIVE;
+  bool wakeEdge = false;
+  uint32_t wakeEdgeMs = 0;
+  uint64_t edgeUs = 0;                  // sim's own record of the waking edge / alarm
+  bool edgeOpen = false;
+
+  const uint64_t endUs = (uint64_t)(hours * 3600e6);
+  uint64_t cpuFree = 0, uiNext = 1000, stateSince = 0, lastInputUs = 0;
+  uint32_t lastFrameMs = 0;
+  size_t pressIdx = 0, pressSeen = 0, alarmIdx = 0;
+  bool swallowDue = false;              // sim: the next press woke the panel
+
+  auto setShown = [&](PowerState s, uint64_t t){
+    if (s == shown) return;
+    r.stateUs[shown] += t - stateSince;
+    stateSince = t;
+    const double idle = (double)(t - lastInputUs);
+    if (s == PWR_DIM && (idle < dimAfterS * 1e6 || idle > dimAfterS * 1e6 + 100e3))
+      fail(set.name, "DIM after input (ms)", (double)t, idle / 1e3, dimAfterS * 1e3);
+    if (s == PWR_OFF && (idle < offAfterS * 1e6 || idle > offAfterS * 1e6 + 100e3))
+      fail(set.name, "OFF after input (ms)", (double)t, idle / 1e3, offAfterS * 1e3);
+    shown = s;
+  };
+
+  for (;;) {
+    uint64_t nextTimed = uiNext;
+    for (const Periodic& k : tasks) if (k.next < nextTimed) nextTimed = k.next;
+    const uint64_t nextPress = pressIdx < sc.presses.size() ? sc.presses[pressIdx] : ~0ull;
+    const uint64_t next = nextTimed < nextPress ? nextTimed : nextPress;
+    if (next >= endUs) break;
+
+    // ----- Idle: every task blocked until nextTimed -----
+    if (cpuFree < next) {
+      const PowerSleep plan = powerSleepPlan(shown, (uint32_t)((nextTimed - cpuFree) / 1000), holds);
+      if (plan.mode == POWER_SLEEP_STOP) {
+        if (shown != PWR_OFF || holds) fail(set.name, "STOP while panel on / held", (double)cpuFree, 1, 0);
+        const uint64_t alarmAt = cpuFree + (uint64_t)plan.ms * 1000;
+        if (alarmAt + POWER_STOP_WAKE_MS * 1000 > nextTimed)
+          fail(set.name, "STOP ends after the next timeout (us)", (double)cpuFree,
+               (double)(alarmAt + POWER_STOP_WAKE_MS * 1000), (double)nextTimed);
+        const uint64_t woke = alarmAt < nextPress ? alarmAt : nextPress;
+        r.stopUs += woke - cpuFree;
+        r.runUs += POWER_STOP_WAKE_MS * 1000;
+        r.wakes++;
+        cpuFree = woke + POWER_STOP_WAKE_MS * 1000;
+        continue;
+      }
+      r.wfiUs += next - cpuFree;
+      cpuFree = next;
+    }
+    const uint64_t t = cpuFree;
+
+    // ----- Button edge (EXTI) -----
+    if (nextPress <= nextTimed && nextPress <= t) {
+      pressIdx++;
+      if (shown == PWR_OFF) {
+        if (!wakeEdge) { wakeEdgeMs = (uint32_t)(nextPress / 1000); edgeUs = nextPress; edgeOpen = true; }
+        wakeEdge = true;
+        swallowDue = true;
+        if (uiNext > t) uiNext = t;     // task notification
+      }
+      continue;
+    }
+
+    // ----- Periodic tasks -----
+    bool ran = false;
+    for (Periodic& k : tasks) {
+      if (k.next > t || k.next != nextTimed) continue;
+      r.runUs += k.costUs;
+      cpuFree = t + k.costUs;
+      if (k.burst > 1 && ++k.done < k.burst) {
+        k.next += k.burstGapUs;
+      } else {
+        k.next += k.periodUs - (uint64_t)(k.burst > 1 ? k.burst - 1 : 0) * k.burstGapUs;
+        k.done = 0;
+      }
+      ran = true;
+      break;
+    }
+    if (ran) continue;
+
+    // ----- UI loop -----
+    const uint32_t now = (uint32_t)(t / 1000);
+    uint64_t busy = UI_LOOP_US;
+    while (pressSeen < pressIdx) {       // inputs the buttons reported
+      pressSeen++;
+      r.pressCount++;
+      if (wakeEdge) {
+        wakeEdge = false;
+        powerLogicWake(p, wakeEdgeMs, now);
+      }
+      const bool swallow = powerLogicActivity(p, now);
+      if (swallow != swallowDue)
+        fail(set.name, swallowDue ? "waking press acted on" : "press swallowed", (double)t, swallow, swallowDue);
+      r.swallowed += swallow;
+      swallowDue = false;
+      lastInputUs = t;
+      setShown(p.state, t);
+    }
+    while (alarmIdx < sc.alarms.size() && sc.alarms[alarmIdx].second <= t) alarmIdx++;
+    const bool alarmOn = alarmIdx < sc.alarms.size() && sc.alarms[alarmIdx].first <= t;
+    if (wakeEdge) {
+      wakeEdge = false;
+      powerLogicWake(p, wakeEdgeMs, now);
+    } else {
+      const PowerState before = p.state;
+      powerLogicTick(p, now, dimAfterS, offAfterS, alarmOn ? 0x10 : 0);
+      if (before != PWR_ACTIVE && p.state == PWR_ACTIVE) {
+        r.alarmWakes++;
+        lastInputUs = t;
+        if (before == PWR_OFF) { edgeUs = t; edgeOpen = true; }
+      }
+    }
+    setShown(p.state, t);
+    if (set.tach == TACH_WINDOWS) {
+      bool opened;
+      holds = tachDutyTick(duty, shown != PWR_OFF, now, &opened) ? POWER_HOLD_TACH : 0;
+    }
+
+    if (shown != PWR_OFF && now - lastFrameMs >= (shown == PWR_DIM ? FRAME_MS_DIM : FRAME_MS)) {
+      lastFrameMs = now;
+      busy += frameUs;
+      const uint64_t sent = t + busy;
+      uint32_t lat;
+      if (powerLogicFrameSent(p, (uint32_t)(sent / 1000), &lat)) {
+        const double want = (double)(sent - edgeUs) / 1e3;
+        if (!edgeOpen || lat + 1.0 < want || lat > want + 1.0) fail(set.name, "wake latency (ms)", (double)t, lat, want);
+        edgeOpen = false;
+        if (lat < r.latMin) r.latMin = lat;
+        if (lat > r.latMax) r.latMax = lat;
+        r.latSum += lat;
+        r.latCount++;
+      } else if (edgeOpen) {
+        fail(set.name, "first frame after wake not reported", (double)t, 0, 1);
+      }
+    }
+    r.runUs += busy;
+    cpuFree = t + busy;
+    uiNext = tickAfter(cpuFree, shown == PWR_ACTIVE ? UI_DELAY_MS
+                              : shown == PWR_DIM ? UI_DELAY_MS * 4 : OFF_SLICE_MS);
+  }
+  r.stateUs[shown] += endUs - stateSince;
+  if (cpuFree < endUs) r.wfiUs += endUs - cpuFree;
+
+  const double total = (double)(r.stateUs[0] + r.stateUs[1] + r.stateUs[2]);
+  const double onPct = r.stateUs[PWR_ACTIVE] * 100.0 / total;
+  if (onPct - powerLogicOnPct(p) > 1.5 || powerLogicOnPct(p) - onPct > 1.5)
+    fail(set.name, "panel-on share (%)", (double)endUs, powerLogicOnPct(p), onPct);
+  if (!sc.alarms.empty() && !r.alarmWakes) fail(set.name, "alarm wakes", (double)endUs, 0, 1);
+  return r;
+}
+
+int main(int argc, char** argv){
+  double hours = 24;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--hours") && more)         hours = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--seed") && more)     seed = (unsigned)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--frame-us") && more) frameUs = (uint32_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--dim-s") && more)    dimAfterS = (uint16_t)std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--off-s") && more)    offAfterS = (uint16_t)std::atoi(argv[++i]);
+    else {
+      std::fprintf(stderr, "usage: %s [--hours H] [--seed N] [--frame-us US] [--dim-s S] [--off-s S]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (hours < 1) hours = 1;
+  if (!dimAfterS || offAfterS <= dimAfterS) {
+    std::fprintf(stderr, "need 0 < --dim-s < --off-s\n");
+    return 2;
+  }
+
+  const Script sc = makeScript(hours, seed);
+  const TaskSet sets[] = {
+    {"ui only",       false, TACH_NONE,    0, 0,   true},
+    {"+fan blocks",   true,  TACH_NONE,    0, 0,   true},
+    {"+tach held",    true,  TACH_HELD,    0, 0,   false},
+    {"+tach windows", true,  TACH_WINDOWS, 0, 0,   true},
+    {"+rx polling",   true,  TACH_WINDOWS, 2, 5,   false},
+    {"full tree",     true,  TACH_WINDOWS, 0, 500, true},
+  };
+  std::printf("%.0f h, %zu presses, %zu alarms, dim %u s, off %u s, frame %.1f ms\n", hours,
+              sc.presses.size(), sc.alarms.size(), dimAfterS, offAfterS, frameUs / 1e3);
+  std::printf("%-14s %7s %7s %7s | %6s %6s %6s | %8s | %s\n", "tasks", "active", "dim", "off",
+              "run", "wfi", "stop", "mA", "wake latency ms (min/avg/max)");
+  for (const TaskSet& set : sets) {
+    const Result r = run(set, sc, hours);
+    const double total = (double)(r.stateUs[0] + r.stateUs[1] + r.stateUs[2]);
+    const double cpu = (double)(r.runUs + r.wfiUs + r.stopUs);
+    const double mA = (r.runUs * MCU_RUN_MA + r.wfiUs * MCU_WFI_MA + r.stopUs * MCU_STOP_MA) / cpu +
+                      (r.stateUs[PWR_ACTIVE] * PANEL_ACTIVE_MA + r.stateUs[PWR_DIM] * PANEL_DIM_MA +
+                       r.stateUs[PWR_OFF] * PANEL_OFF_MA) / total;
+    std::printf("%-14s %6.2f%% %6.2f%% %6.2f%% | %5.2f%% %5.2f%% %5.2f%% | %8.2f | ", set.name,
+                r.stateUs[0] * 100 / total, r.stateUs[1] * 100 / total, r.stateUs[2] * 100 / total,
+                r.runUs * 100 / cpu, r.wfiUs * 100 / cpu, r.stopUs * 100 / cpu, mA);
+    if (r.latCount) std::printf("%u / %.1f / %u (%u wakes)\n", r.latMin, (double)r.latSum / r.latCount, r.latMax, r.latCount);
+    else std::printf("-\n");
+    if (cpu < hours * 3600e6) fail(set.name, "CPU time accounted (s)", 0, cpu / 1e6, hours * 3600);
+    if (set.wantStop && !r.stopUs) fail(set.name, "STOP share (%)", 0, 0, r.stateUs[PWR_OFF] * 100 / total);
+  }
+  return failures ? 1 : 0;
+}
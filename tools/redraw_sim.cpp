@@ -0,0 +1,202 @@
+// Host replay of a settings-editing session through the dirty-tile flush
+// (FrameDiffLogic.cpp).
+//
+// Renders a 5-row submenu the way the panel shows it (7x12 px cells, the
+// cursor row inverted, values right-aligned, a live read-only row) into a
+// 128x64 page-layout buffer every 25 ms frame, while a script scrolls,
+// edits a value click by click and with hold acceleration, and backs out.
+// Each frame goes through frameDiffScan() (with the periodic full resend);
+// the spans are applied to a model of the panel RAM, which must match the
+// buffer after every frame.
+//
+// Prints frames, menu rows whose pixels changed ("rows drawn"), tiles and
+// bytes on the bus for the dirty flush against today's full sendBuffer(),
+// plus the bus time at 400 kHz. Exits 1 if the panel ever differs from the
+// buffer or the flush does not save at least --min-save percent.
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/redraw_sim.cpp FrameDiffLogic.cpp -o redraw_sim
+// Usage: ./redraw_sim [--min-save 50] [--verbose]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "FrameDiffLogic.h"
+
+static const uint8_t TILE_W = 16, TILE_H = 8;        // 128x64
+static const int W = TILE_W * 8, H = TILE_H * 8;
+static const int CELL_W = 7, CELL_H = 12, ROWS = 5;  // MenuUI.cpp: fontX, fontY, MENU_ROWS
+static const int COLS = W / CELL_W;
+static const uint32_t FRAME_MS = 25;
+static const uint32_t FULL_FLUSH_MS = 10000;          // MenuUI.cpp: UI_FULL_FLUSH_MS
+static const uint32_t FULL_BYTES = TILE_W * TILE_H * 8;
+static const double BUS_HZ = 400000;
+
+static uint8_t buf[FULL_BYTES], panel[FULL_BYTES];
+
+static void setPixel(int x, int y, bool on){
+  if (x < 0 || x >= W || y < 0 || y >= H) return;
+  uint8_t& b = buf[(y / 8) * W + x];
+  const uint8_t m = (uint8_t)(1u << (y & 7));
+  b = on ? (uint8_t)(b | m) : (uint8_t)(b & ~m);
+}
+
+// A stand-in 5x7 glyph: fixed per character, different between characters
+static void drawChar(int x, int y, char c, bool inverse){
+  uint32_t h = 2166136261UL ^ (uint8_t)c;
+  for (int i = 0; i < 4; i++) h = (h ^ (uint8_t)c) * 16777619UL;
+  for (int gy = 0; gy < 7; gy++) {
+    for (int gx = 0; gx < 5; gx++) {
+      const bool ink = c != ' ' && ((h >> ((gy * 5 + gx) % 32)) & 1);
+      setPixel(x + gx, y + 2 + gy, ink != inverse);
+    }
+  }
+}
+
+struct Item {
+  std::string label;
+  int value;                 // shown as value/10 with one decimal
+  bool field, readOnly;
+};
+
+struct Menu {
+  std::vector<Item> items;
+  int cursor = 0, top = 0;
+  bool editing = false;
+};
+
+static void render(const Menu& m){
+  std::memset(buf, 0, sizeof(buf));
+  for (int r = 0; r < ROWS && m.top + r < (int)m.items.size(); r++) {
+    const Item& it = m.items[m.top + r];
+    const bool sel = m.top + r == m.cursor;
+    const int y = r * CELL_H;
+    if (sel) for (int yy = y; yy < y + CELL_H; yy++) for (int x = 0; x < W; x++) setPixel(x, yy, true);
+    std::string text = (sel && m.editing ? ":" : " ") + it.label;
+    if (it.field) {
+      char v[16];
+      std::snprintf(v, sizeof(v), "%d.%d", it.value / 10, std::abs(it.value % 10));
+      while ((int)(text.size() + std::strlen(v)) < COLS) text += ' ';
+      text += v;
+    }
+    for (int c = 0; c < (int)text.size() && c < COLS; c++) drawChar(c * CELL_W, y, text[c], sel);
+  }
+}
+
+// Rows of the menu window whose pixels were sent
+static int rowsDrawn(const FrameDiffSpan* spans){
+  int rows = 0;
+  for (int r = 0; r < ROWS; r++) {
+    bool drawn = false;
+    for (int p = r * CELL_H / 8; p <= (r * CELL_H + CELL_H - 1) / 8; p++) drawn |= spans[p].w != 0;
+    rows += drawn;
+  }
+  return rows;
+}
+
+enum Key { K_UP, K_DOWN, K_ENTER, K_ESC };
+struct Step { uint32_t t; Key key; };
+
+static void press(Menu& m, Key k){
+  Item& it = m.items[m.cursor];
+  if (m.editing) {
+    if (k == K_UP) it.value++;
+    else if (k == K_DOWN) it.value--;
+    else m.editing = false;
+    return;
+  }
+  if (k == K_DOWN && m.cursor + 1 < (int)m.items.size()) m.cursor++;
+  if (k == K_UP && m.cursor > 0) m.cursor--;
+  if (k == K_ENTER && it.field && !it.readOnly) m.editing = true;
+  if (m.cursor < m.top) m.top = m.cursor;
+  if (m.cursor >= m.top + ROWS) m.top = m.cursor - ROWS + 1;
+}
+
+int main(int argc, char** argv){
+  double minSave = 50;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--min-save") && i + 1 < argc) minSave = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--verbose")) verbose = true;
+    else {
+      std::fprintf(stderr, "usage: %s [--min-save PCT] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  Menu m;
+  m.items = {
+    {"Temperature", 231, true, true},          // live ROFIELD
+    {"Fan on", 300, true, false},
+    {"Fan off", 260, true, false},
+    {"Alarm high", 450, true, false},
+    {"Alarm low", 50, true, false},
+    {"Hysteresis", 20, true, false},
+    {"Heater on", 50, true, false},
+    {"Back", 0, false, false},
+  };
+
+  // A typical session: scroll to a setpoint, click it up, hold it down,
+  // confirm, scroll on past the window edge, edit another, back out
+  std::vector<Step> script;
+  uint32_t t = 300;
+  auto add = [&](Key k, int n, uint32_t gap){ for (int i = 0; i < n; i++) { script.push_back({t, k}); t += gap; } };
+  add(K_DOWN, 3, 350);
+  add(K_ENTER, 1, 500);
+  add(K_UP, 6, 250);                            // clicks
+  add(K_DOWN, 20, 60);                          // hold: FieldEdit acceleration
+  add(K_ENTER, 1, 600);
+  add(K_DOWN, 3, 350);                          // past the bottom: the window scrolls
+  add(K_ENTER, 1, 500);
+  add(K_UP, 4, 300);
+  add(K_ENTER, 1, 800);
+  add(K_UP, 6, 300);                            // back to the top
+  const uint32_t end = t + 3000;                // then watch the live value
+
+  FrameDiff diff = {};
+  FrameDiffSpan spans[TILE_H];
+  uint64_t frames = 0, rowsNew = 0, tilesNew = 0, bytesNew = 0, idleFrames = 0;
+  uint32_t worstBytes = 0;
+  size_t next = 0;
+  bool mismatch = false;
+
+  for (uint32_t now = 0; now <= end; now += FRAME_MS) {
+    bool input = false;
+    while (next < script.size() && script[next].t <= now) { press(m, script[next++].key); input = true; }
+    if (now % 500 == 0) m.items[0].value += (now / 500) % 3 == 0 ? -1 : 1;   // live reading
+    render(m);
+    const bool full = now % FULL_FLUSH_MS == 0;
+    if (full) frameDiffInvalidate(diff);
+
+    const uint16_t tiles = frameDiffScan(diff, buf, TILE_W, TILE_H, spans);
+    const uint32_t bytes = frameDiffBytes(spans, TILE_H);
+    for (uint8_t p = 0; p < TILE_H; p++) {
+      if (spans[p].w) std::memcpy(panel + p * W + spans[p].x0 * 8, buf + p * W + spans[p].x0 * 8, spans[p].w * 8);
+    }
+    if (std::memcmp(panel, buf, sizeof(buf)) != 0) {
+      std::printf("FAIL: panel differs from the buffer at t=%u ms\n", now);
+      mismatch = true;
+    }
+    frames++;
+    if (!tiles) idleFrames++;
+    rowsNew += rowsDrawn(spans);
+    tilesNew += tiles;
+    bytesNew += bytes;
+    if (!full && bytes > worstBytes) worstBytes = bytes;
+    if (verbose && (tiles || input)) {
+      std::printf("t=%5u rows=%d tiles=%3u bytes=%4u%s\n", now, rowsDrawn(spans), tiles, bytes, input ? " (key)" : "");
+    }
+  }
+
+  const uint64_t bytesOld = frames * FULL_BYTES;
+  const double save = 100.0 * (1.0 - (double)bytesNew / bytesOld);
+  std::printf("session %.1f s, %llu frames (%llu with nothing to send), %zu key events\n",
+              end / 1000.0, (unsigned long long)frames, (unsigned long long)idleFrames, script.size());
+  std::printf("%-8s %-10s %-10s %-11s %s\n", "flush", "rows", "tiles", "bytes", "bus_ms");
+  std::printf("%-8s %-10llu %-10llu %-11llu %.0f\n", "full", (unsigned long long)(frames * ROWS),
+              (unsigned long long)(frames * TILE_W * TILE_H), (unsigned long long)bytesOld, bytesOld * 9 / BUS_HZ * 1e3);
+  std::printf("%-8s %-10llu %-10llu %-11llu %.0f\n", "dirty", (unsigned long long)rowsNew,
+              (unsigned long long)tilesNew, (unsigned long long)bytesNew, bytesNew * 9 / BUS_HZ * 1e3);
+  std::printf("saved %.1f%% of the bytes; worst partial frame %u B (full %u B)\n", save, worstBytes, FULL_BYTES);
+  return mismatch || save < minSave ? 1 : 0;
+}
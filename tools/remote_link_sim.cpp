@@ -0,0 +1,357 @@
+// Host run of the remote link framing (RemoteLinkLogic.cpp) over a pty
+// pair: commands per second and recovery from line noise.
+//
+// A device thread on one end plays the LINK task: it sleeps until bytes
+// arrive (the RX start-bit wake-up), the next telemetry slot or, while a
+// frame is open, --poll-ms; then drains what arrived (at most 512 bytes, as
+// RemoteLink.cpp), answers PING,
+// GET_FIELDS and SET_FIELDS from a table of 16 fields (0..10000) and, when
+// subscribed, streams TELEMETRY. The host on the other end sends a mix of
+// commands (GET 40 %, SET 40 %, one in ten with a bad value, PING 20 %) and
+// checks every response against its own copy of the table. Phases:
+//   serial     one command in flight
+//   window 8   up to 8 in flight
+//   telemetry  window 8 with a 20 ms TELEMETRY stream interleaved
+//   noise      window 8, and 1-40 bytes of non-zero line noise before
+//              every third frame in both directions
+//   idle       nothing sent, nothing subscribed for a second: the device
+//              must not wake at all (an unplugged link keeps no MCU awake)
+// Both ends pace their writes at --baud (10 bits a byte). Prints
+// commands/s per phase next to the wire limit (the busier direction's mean
+// frame length at --baud; the UART is full duplex). Noise must cost no frame: the leading 0x00 of
+// each frame ends the garbage before it.
+//
+// Exits 1 on a lost, corrupt or wrong response, a device frame count that
+// does not match, or a wake-up while idle.
+//
+// Build: g++ -O2 -std=gnu++17 -pthread -I. tools/remote_link_sim.cpp RemoteLinkLogic.cpp Crc.cpp -o remote_link_sim
+// Usage: ./remote_link_sim [--commands 1000] [--poll-ms 2] [--baud 115200] [--seed 1]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <deque>
+#include <poll.h>
+#include <random>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "RemoteLinkLogic.h"
+
+// As in RemoteLink.h
+enum : uint8_t { PING = 0x01, GET_FIELDS = 0x02, SET_FIELDS = 0x03, SUBSCRIBE = 0x04, TELEMETRY = 0x90 };
+enum : uint8_t { ST_OK = 0, ST_BAD_CMD = 1, ST_BAD_LEN = 2, ST_BAD_VALUE = 3 };
+static const uint8_t FIELDS = 16;
+static const int32_t FIELD_MAX = 10000;
+
+static uint32_t pollMs = 2;
+static uint32_t baud = 115200;
+
+static uint32_t rd32(const uint8_t* p){ return (uint32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24)); }
+static void wr32(std::vector<uint8_t>& v, uint32_t x){ for (int i = 0; i < 4; i++) v.push_back((uint8_t)(x >> (8 * i))); }
+
+// Paced at --baud, as the UART would send it
+static void writeAll(int fd, const uint8_t* p, size_t n){
+  const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(n * 10000000ULL / baud);
+  while (n) {
+    const ssize_t w = write(fd, p, n);
+    if (w > 0) { p += w; n -= (size_t)w; continue; }
+    pollfd q = { fd, POLLOUT, 0 };
+    poll(&q, 1, 10);
+  }
+  std::this_thread::sleep_until(end);
+}
+
+static void noise(int fd, std::mt19937& rng){
+  uint8_t junk[40];
+  const int n = 1 + (int)(rng() % sizeof(junk));
+  for (int i = 0; i < n; i++) junk[i] = (uint8_t)(1 + rng() % 255);
+  writeAll(fd, junk, (size_t)n);
+}
+
+static void sendFrame(int fd, const std::vector<uint8_t>& payload){
+  uint8_t f[REMOTE_MAX_FRAME];
+  const uint16_t n = remoteFrame(payload.data(), (uint16_t)payload.size(), f);
+  writeAll(fd, f, n);
+}
+
+// ===== Device (the LINK task) =====
+static std::atomic<bool> devStop{false};
+static std::atomic<bool> devNoise{false};
+static std::atomic<uint32_t> devFrames{0}, devCrc{0};
+static std::atomic<uint32_t> devWakes{0};
+
+static void deviceThread(int fd){
+  RemoteRx rx = {};
+  int32_t fields[FIELDS] = {};
+  uint32_t teleEvery = 0;
+  auto lastTele = std::chrono::steady_clock::now();
+  std::mt19937 rng(11);
+  uint32_t sent = 0;
+
+  auto reply = [&](const std::vector<uint8_t>& p){
+    if (devNoise && ++sent % 3 == 0) noise(fd, rng);
+    sendFrame(fd, p);
+  };
+
+  while (!devStop) {
+    // RemoteLink.cpp nextWait(): a frame open, the telemetry slot, else
+    // bytes only (the 200 ms here just lets the thread see devStop)
+    int waitMs = 200;
+    bool idle = true;
+    if (rx.len) { waitMs = (int)pollMs; idle = false; }
+    else if (teleEvery) {
+      const auto since = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - lastTele).count();
+      waitMs = since >= (long)teleEvery ? 0 : (int)(teleEvery - since) + 1;
+      idle = false;
+    }
+    pollfd q = { fd, POLLIN, 0 };
+    if (poll(&q, 1, waitMs) <= 0 && idle) continue;
+    devWakes++;
+    uint8_t in[512];
+    const ssize_t got = read(fd, in, sizeof(in));
+    for (ssize_t i = 0; i < got; i++) {
+      const uint16_t n = remoteRxByte(rx, in[i]);
+      if (n < 2) continue;
+      const uint8_t cmd = rx.buf[0], seq = rx.buf[1];
+      const uint8_t* d = rx.buf + 2;
+      const uint16_t dn = (uint16_t)(n - 2);
+      std::vector<uint8_t> out = { (uint8_t)(cmd | 0x80), seq, ST_OK };
+      switch (cmd) {
+        case PING: out.push_back(1); out.push_back(FIELDS); break;
+        case GET_FIELDS:
+          for (uint16_t k = 0; k < dn && out[2] == ST_OK; k++) {
+            if (d[k] >= FIELDS) { out[2] = ST_BAD_VALUE; break; }
+            out.push_back(d[k]);
+            wr32(out, (uint32_t)fields[d[k]]);
+          }
+          if (out[2] != ST_OK) out.resize(3);
+          break;
+        case SET_FIELDS: {
+          if (!dn || dn % 5) { out[2] = ST_BAD_LEN; break; }
+          int32_t next[FIELDS];
+          memcpy(next, fields, sizeof(next));
+          for (uint16_t k = 0; k < dn; k += 5) {
+            const int32_t v = (int32_t)rd32(d + k + 1);
+            if (d[k] >= FIELDS || v < 0 || v > FIELD_MAX) { out[2] = ST_BAD_VALUE; out.push_back(d[k]); break; }
+            next[d[k]] = v;
+          }
+          if (out[2] == ST_OK) memcpy(fields, next, sizeof(next));
+          break;
+        }
+        case SUBSCRIBE:
+          if (dn != 2) { out[2] = ST_BAD_LEN; break; }
+          teleEvery = (uint32_t)(d[0] | (d[1] << 8));
+          break;
+        default: out[2] = ST_BAD_CMD; break;
+      }
+      reply(out);
+    }
+    devFrames = rx.framesOk;
+    devCrc = rx.crcErrors;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (teleEvery && now - lastTele >= std::chrono::milliseconds(teleEvery)) {
+      lastTele = now;
+      std::vector<uint8_t> t = { TELEMETRY, 0 };
+      t.resize(2 + 4 + 8 * 4 + 2, 0x5A);     // [ms][8 floats][alarms][light]
+      reply(t);
+    }
+  }
+}
+
+// ===== Host =====
+struct Phase {
+  const char* name;
+  uint8_t window;
+  bool telemetry, noise;
+};
+
+struct Pending {
+  uint8_t seq;
+  std::vector<uint8_t> expect;          // whole response payload
+};
+
+struct Result {
+  double seconds;
+  uint32_t done, lost, wrong, telemetry, bursts;
+  uint64_t reqBytes, respBytes;
+};
+
+static std::vector<uint8_t> makeCommand(std::mt19937& rng, uint8_t seq, int32_t* model, std::vector<uint8_t>& expect){
+  std::vector<uint8_t> req;
+  const uint32_t pick = rng() % 10;
+  if (pick < 2) {
+    req = { PING, seq };
+    expect = { PING | 0x80, seq, ST_OK, 1, FIELDS };
+  } else if (pick < 6) {
+    req = { GET_FIELDS, seq };
+    expect = { GET_FIELDS | 0x80, seq, ST_OK };
+    const uint32_t n = 1 + rng() % 8;
+    for (uint32_t i = 0; i < n; i++) {
+      const uint8_t id = (uint8_t)(rng() % FIELDS);
+      req.push_back(id);
+      expect.push_back(id);
+      wr32(expect, (uint32_t)model[id]);
+    }
+  } else {
+    req = { SET_FIELDS, seq };
+    const uint32_t n = 1 + rng() % 4;
+    const bool bad = rng() % 10 == 0;
+    int32_t next[FIELDS];
+    memcpy(next, model, sizeof(next));
+    int badId = -1;
+    for (uint32_t i = 0; i < n; i++) {
+      const uint8_t id = (uint8_t)(rng() % FIELDS);
+      int32_t v = (int32_t)(rng() % (FIELD_MAX + 1));
+      if (bad && i == n - 1) { v = FIELD_MAX + 1 + (int32_t)(rng() % 100); badId = id; }
+      req.push_back(id);
+      wr32(req, (uint32_t)v);
+      if (badId < 0) next[id] = v;
+    }
+    expect = { SET_FIELDS | 0x80, seq, (uint8_t)(badId < 0 ? ST_OK : ST_BAD_VALUE) };
+    if (badId >= 0) expect.push_back((uint8_t)badId);
+    else memcpy(model, next, sizeof(next));
+  }
+  return req;
+}
+
+static Result runPhase(int fd, const Phase& ph, uint32_t commands, std::mt19937& rng, int32_t* model){
+  Result r = {};
+  RemoteRx rx = {};
+  std::deque<Pending> inflight;        // oldest first; answers come in order
+  uint8_t seq = 0;
+  uint32_t issued = 0, sentFrames = 0;
+  devNoise = ph.noise;
+  if (ph.telemetry) sendFrame(fd, { SUBSCRIBE, 0, 20, 0 });
+
+  const auto t0 = std::chrono::steady_clock::now();
+  while (issued < commands || !inflight.empty()) {
+    while (issued < commands && inflight.size() < ph.window) {
+      seq = (uint8_t)(seq + 1 ? seq + 1 : 1);
+      std::vector<uint8_t> expect;
+      const std::vector<uint8_t> req = makeCommand(rng, seq, model, expect);
+      if (ph.noise && ++sentFrames % 3 == 0) { noise(fd, rng); r.bursts++; }
+      sendFrame(fd, req);
+      uint8_t f[REMOTE_MAX_FRAME];
+      r.reqBytes += remoteFrame(req.data(), (uint16_t)req.size(), f);
+      r.respBytes += remoteFrame(expect.data(), (uint16_t)expect.size(), f);
+      inflight.push_back({ seq, expect });
+      issued++;
+    }
+    pollfd q = { fd, POLLIN, 0 };
+    if (poll(&q, 1, 500) <= 0) {           // nothing for 500 ms: what is in flight is lost
+      r.lost += (uint32_t)inflight.size();
+      inflight.clear();
+      continue;
+    }
+    uint8_t in[512];
+    const ssize_t got = read(fd, in, sizeof(in));
+    for (ssize_t i = 0; i < got; i++) {
+      const uint16_t n = remoteRxByte(rx, in[i]);
+      if (n < 2) continue;
+      if (rx.buf[0] == TELEMETRY) { r.telemetry++; continue; }
+      if (rx.buf[0] == (SUBSCRIBE | 0x80)) continue;
+      bool known = false;
+      for (const Pending& q : inflight) known |= q.seq == rx.buf[1];
+      if (!known) { r.wrong++; continue; }
+      // Older requests without an answer are lost
+      for (; inflight.front().seq != rx.buf[1]; inflight.pop_front()) r.lost++;
+      const std::vector<uint8_t>& e = inflight.front().expect;
+      if (e.size() != n || memcmp(e.data(), rx.buf, n)) r.wrong++;
+      else r.done++;
+      inflight.pop_front();
+    }
+  }
+  r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  if (ph.telemetry) sendFrame(fd, { SUBSCRIBE, 0, 0, 0 });
+  // Let the device go quiet (stop the stream, drain)
+  for (pollfd q = { fd, POLLIN, 0 }; poll(&q, 1, 50 + 2 * (int)pollMs) > 0;) {
+    uint8_t in[512];
+    if (read(fd, in, sizeof(in)) <= 0) break;
+  }
+  devNoise = false;
+  return r;
+}
+
+static int openPty(int& slaveFd){
+  const int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0 || grantpt(fd) || unlockpt(fd)) return -1;
+  slaveFd = open(ptsname(fd), O_RDWR | O_NOCTTY);
+  if (slaveFd < 0) return -1;
+  termios t;
+  tcgetattr(slaveFd, &t);
+  cfmakeraw(&t);
+  tcsetattr(slaveFd, TCSANOW, &t);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  fcntl(slaveFd, F_SETFL, fcntl(slaveFd, F_GETFL) | O_NONBLOCK);
+  return fd;
+}
+
+int main(int argc, char** argv){
+  uint32_t commands = 1000;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    const bool more = i + 1 < argc;
+    if (!strcmp(argv[i], "--commands") && more)     commands = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--poll-ms") && more) pollMs = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--baud") && more)    baud = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && more)    seed = (unsigned)atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--commands N] [--poll-ms MS] [--baud B] [--seed N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!commands || baud < 1200) { fprintf(stderr, "bad --commands / --baud\n"); return 2; }
+
+  int devFd;
+  const int fd = openPty(devFd);
+  if (fd < 0) { perror("pty"); return 1; }
+  std::thread dev(deviceThread, devFd);
+
+  static const Phase PHASES[] = {
+    {"serial",    1, false, false},
+    {"window 8",  8, false, false},
+    {"telemetry", 8, true,  false},
+    {"noise",     8, false, true},
+  };
+  std::mt19937 rng(seed);
+  int32_t model[FIELDS] = {};
+  bool fail = false;
+  uint32_t framesSent = 0, bursts = 0;
+  printf("%u commands per phase, device wait %u ms with a frame open, wire %u baud\n", commands, pollMs, baud);
+  printf("%-10s | %10s | %11s | %5s %5s | %s\n", "phase", "cmds/s", "wire cmds/s", "lost", "wrong", "telemetry");
+  for (const Phase& ph : PHASES) {
+    const Result r = runPhase(fd, ph, commands, rng, model);
+    framesSent += commands + (ph.telemetry ? 2 : 0);
+    bursts += r.bursts;
+    const uint64_t busier = r.reqBytes > r.respBytes ? r.reqBytes : r.respBytes;   // full duplex
+    const double wire = baud / 10.0 / ((double)busier / commands);
+    printf("%-10s | %10.0f | %11.0f | %5u %5u | %u\n", ph.name, r.done / r.seconds, wire, r.lost, r.wrong,
+           r.telemetry);
+    if (r.lost || r.wrong) { printf("  FAIL: responses lost or wrong\n"); fail = true; }
+    if (ph.telemetry && r.telemetry == 0) { printf("  FAIL: no telemetry\n"); fail = true; }
+  }
+  // Idle: no host traffic, nothing subscribed
+  const uint32_t wakes0 = devWakes;
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  const uint32_t idleWakes = devWakes - wakes0;
+  printf("%-10s | device woke %u times in 1 s\n", "idle", idleWakes);
+  if (idleWakes) { printf("  FAIL: the link task wakes with nothing to do\n"); fail = true; }
+
+  devStop = true;
+  dev.join();
+  // Each noise burst ends as one bad frame at the next leading 0x00
+  if (devFrames != framesSent || devCrc != bursts) {
+    printf("FAIL: device saw %u good frames and %u bad ones, want %u and %u\n", (unsigned)devFrames,
+           (unsigned)devCrc, framesSent, bursts);
+    fail = true;
+  }
+  close(fd);
+  close(devFd);
+  return fail ? 1 : 0;
+}
@@ -0,0 +1,271 @@
+// Host check of the button state machine (UiFsmLogic.cpp) against the
+// handler functions it replaced (onUpClick() ... sendLeftIfEditing() and
+// the menu timeout in uiLoop(), as they were before the table).
+//
+// The UI is modelled by what the handlers read and write: uiMode, nav
+// level, settingsDirty(), mainIdx, the idle page and the confirm dialog,
+// plus a log of side effects (commands pushed to ArduinoMenu, tile opened,
+// stage begun/discarded, goIdle(), hold starts and hold steps).
+//   equivalence  every combination of those (mode x level x dirty x tile x
+//                page) x every event, old handlers vs uiClassify() +
+//                UI_FSM + the MenuUI bindings: same state, same effects
+//   landing      from the power-on state, every reachable state x event
+//                lands where the table's next column says (what
+//                UI_FSM_CHECK=1 checks on the target)
+//   coverage     every table cell is reached
+// Dialog handling moved to the flows in ModalLogic.h; tools/modal_bench.cpp
+// checks those. The action bodies here mirror the ACTIONS bindings in
+// MenuUI.cpp one line each.
+//
+// Exits 1 on the first kind of mismatch it finds (all are counted).
+//
+// Build: g++ -O2 -std=gnu++17 -I. tools/ui_fsm_check.cpp UiFsmLogic.cpp -o ui_fsm_check
+// Usage: ./ui_fsm_check [-v]
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <set>
+#include <string>
+#include <tuple>
+#include "UiFsmLogic.h"
+
+static const uint8_t MAIN_COUNT = 4;     // MenuUI.cpp
+static const uint8_t PAGES = 5;          // idle pages (MaxDataPage, later dash.pageCount())
+static const uint8_t MAX_LEVEL = 3;      // deepest nav level in the menus
+
+struct Ui {
+  uint8_t mode = UI_IDLE, level = 0, mainIdx = 0, idleIdx = 0;
+  bool dirty = false, confirm = false;
+  bool input = false;          // lastInputMs was set
+  std::string log;
+
+  auto key() const { return std::make_tuple(mode, level, mainIdx, idleIdx, dirty, confirm, input); }
+  bool operator<(const Ui& o) const { return key() < o.key(); }
+  bool same(const Ui& o) const { return key() == o.key() && log == o.log; }
+};
+
+static const char* const EV_NAMES[EV_ALL] = {
+  "UP_CLICK", "DOWN_CLICK", "ENTER_CLICK", "ESC_CLICK", "ENTER_DOUBLE", "ESC_DOUBLE",
+  "UP_HOLD_START", "DOWN_HOLD_START", "UP_HOLD", "DOWN_HOLD", "TIMEOUT"
+};
+static const char* const ST_NAMES[] = { "IDLE", "CAROUSEL", "MENU", "EDIT", "PASSWORD", "CONFIRM" };
+
+// ===== Side effects shared by both versions =====
+static void push(Ui& u, const char* cmd){ u.log += "push:"; u.log += cmd; u.log += ' '; }
+static void note(Ui& u, const char* what){ u.log += what; u.log += ' '; }
+static bool atRoot(const Ui& u){ return u.level == 0; }
+static void goIdle(Ui& u){ u.confirm = false; u.mode = UI_IDLE; u.level = 0; u.mainIdx = 0; note(u, "goIdle"); }
+static void openMain(Ui& u, uint8_t idx){
+  u.mode = UI_MENU; u.level = 1;
+  u.log += "open:" + std::to_string(idx) + ' ';
+}
+
+// ===== The handlers as they were =====
+static void onUpClick(Ui& u){
+  u.input = true;
+  if (u.mode == UI_MENU && atRoot(u)) { u.mainIdx = (uint8_t)((u.mainIdx + 1) % MAIN_COUNT); return; }
+  if (u.mode == UI_IDLE) { u.idleIdx = (uint8_t)((u.idleIdx + 1) % PAGES); return; }
+  if (u.mode == UI_MENU || u.mode == UI_SUBMENU) push(u, "up");
+}
+static void onDownClick(Ui& u){
+  u.input = true;
+  if (u.mode == UI_MENU && atRoot(u)) { u.mainIdx = (uint8_t)((u.mainIdx + MAIN_COUNT - 1) % MAIN_COUNT); return; }
+  if (u.mode == UI_IDLE) { u.idleIdx = (uint8_t)((u.idleIdx + PAGES - 1) % PAGES); return; }
+  if (u.mode == UI_MENU || u.mode == UI_SUBMENU) push(u, "down");
+}
+static void onEnterClick(Ui& u){
+  u.input = true;
+  if (u.mode == UI_MENU && atRoot(u)) { openMain(u, (uint8_t)(MAIN_COUNT - u.mainIdx - 1)); return; }
+  if (u.mode == UI_MENU || u.mode == UI_SUBMENU) push(u, "enter");
+}
+static void onEscClick(Ui& u){
+  u.input = true;
+  if (!atRoot(u)) push(u, "esc");
+}
+static void onEnterDouble(Ui& u){
+  u.input = true;
+  u.confirm = false; u.mode = UI_MENU; note(u, "stageBegin");
+}
+static void onEscDouble(Ui& u){
+  u.input = true;
+  if (u.mode == UI_MENU || u.mode == UI_SUBMENU) {
+    if (u.dirty) u.confirm = true;
+    else goIdle(u);
+  }
+}
+static void onHoldStart(Ui& u, const char* which){ note(u, which); u.input = true; }
+static void sendIfEditing(Ui& u, const char* step){
+  u.input = true;
+  if (!u.confirm && u.mode == UI_SUBMENU && u.level >= 2) note(u, step);
+}
+// uiLoop(), after nav.doInput() set uiMode from the level
+static void oldTimeout(Ui& u){
+  if (u.mode == UI_MENU || u.mode == UI_SUBMENU) { note(u, "stageDiscard"); goIdle(u); }
+}
+
+static void oldHandle(Ui& u, uint8_t ev){
+  switch (ev) {
+    case EV_UP_CLICK:        onUpClick(u); break;
+    case EV_DOWN_CLICK:      onDownClick(u); break;
+    case EV_ENTER_CLICK:     onEnterClick(u); break;
+    case EV_ESC_CLICK:       onEscClick(u); break;
+    case EV_ENTER_DOUBLE:    onEnterDouble(u); break;
+    case EV_ESC_DOUBLE:      onEscDouble(u); break;
+    case EV_UP_HOLD_START:   onHoldStart(u, "holdUp"); break;
+    case EV_DOWN_HOLD_START: onHoldStart(u, "holdDown"); break;
+    case EV_UP_HOLD:         sendIfEditing(u, "editInc"); break;
+    case EV_DOWN_HOLD:       sendIfEditing(u, "editDec"); break;
+    case EV_TIMEOUT:         oldTimeout(u); break;
+  }
+}
+
+// ===== The table and MenuUI's bindings =====
+static void runAction(Ui& u, UiAction a){
+  switch (a) {
+    case UA_UNSET:           note(u, "UNSET"); break;
+    case UA_NONE:            break;
+    case UA_IDLE_NEXT:       u.idleIdx = (uint8_t)((u.idleIdx + 1) % PAGES); break;
+    case UA_IDLE_PREV:       u.idleIdx = (uint8_t)((u.idleIdx + PAGES - 1) % PAGES); break;
+    case UA_TILE_NEXT:       u.mainIdx = (uint8_t)((u.mainIdx + 1) % MAIN_COUNT); break;
+    case UA_TILE_PREV:       u.mainIdx = (uint8_t)((u.mainIdx + MAIN_COUNT - 1) % MAIN_COUNT); break;
+    case UA_TILE_OPEN:       openMain(u, (uint8_t)(MAIN_COUNT - u.mainIdx - 1)); break;
+    case UA_NAV_UP:          push(u, "up"); break;
+    case UA_NAV_DOWN:        push(u, "down"); break;
+    case UA_NAV_ENTER:       push(u, "enter"); break;
+    case UA_NAV_ESC:         if (!atRoot(u)) push(u, "esc"); break;
+    case UA_MENU_OPEN:       u.mode = UI_MENU; note(u, "stageBegin"); break;
+    case UA_MENU_LEAVE:      if (u.dirty) u.confirm = true; else goIdle(u); break;
+    case UA_TIMEOUT:         note(u, "stageDiscard"); goIdle(u); break;
+    case UA_HOLD_START_UP:   note(u, "holdUp"); break;
+    case UA_HOLD_START_DOWN: note(u, "holdDown"); break;
+    case UA_EDIT_HOLD_INC:   note(u, "editInc"); break;
+    case UA_EDIT_HOLD_DEC:   note(u, "editDec"); break;
+    case UA_COUNT:           note(u, "COUNT"); break;
+  }
+}
+
+static UiState classify(const Ui& u){
+  return u.confirm ? ST_CONFIRM : uiClassify((UIMode)u.mode, u.level);
+}
+
+static bool cellSeen[ST_COUNT][EV_ALL];
+
+// uiHandleEvent() / uiLoop() -> uiDispatch(); returns the landing mismatch, if any
+static bool newHandle(Ui& u, uint8_t ev, UiState* from, UiState* want){
+  if (ev != EV_TIMEOUT) u.input = true;        // uiHandleEvent: lastInputMs
+  const UiState s = classify(u);
+  const UiTransition& t = UI_FSM[s][ev];
+  cellSeen[s][ev] = true;
+  runAction(u, t.action);
+  *from = s;
+  *want = t.next == ST_SAME ? s : t.next;
+  return *want != ST_ANY && classify(u) != *want;
+}
+
+// uiLoop() before a timeout: nav.doInput() sets uiMode from the level
+static void settle(Ui& u){
+  if (u.mode != UI_IDLE) u.mode = u.level == 0 ? UI_MENU : UI_SUBMENU;
+}
+
+static std::string describe(const Ui& u){
+  static const char* const MODES[] = { "IDLE", "MENU", "SUBMENU" };
+  char b[96];
+  snprintf(b, sizeof(b), "%s level %u dirty %d tile %u page %u%s", MODES[u.mode], u.level,
+           u.dirty, u.mainIdx, u.idleIdx, u.confirm ? " confirm" : "");
+  return b;
+}
+
+// ArduinoMenu running the pushed commands (next uiLoop)
+static void menuRuns(Ui& u){
+  size_t p = 0;
+  while ((p = u.log.find("push:", p)) != std::string::npos) {
+    p += 5;
+    if (!u.log.compare(p, 5, "enter") && u.level < MAX_LEVEL) u.level++;
+    if (!u.log.compare(p, 3, "esc") && u.level > 0) u.level--;
+  }
+  if (u.log.find("stageBegin") != std::string::npos || u.log.find("goIdle") != std::string::npos) u.dirty = false;
+  u.log.clear();
+  u.input = false;
+  settle(u);
+}
+
+int main(int argc, char** argv){
+  const bool verbose = argc > 1 && !strcmp(argv[1], "-v");
+  int failures = 0;
+
+  // ----- Equivalence over every combination -----
+  int cases = 0;
+  for (uint8_t mode = 0; mode < 3; mode++)
+    for (uint8_t level = 0; level <= MAX_LEVEL; level++)
+      for (uint8_t dirty = 0; dirty < 2; dirty++)
+        for (uint8_t tile = 0; tile < MAIN_COUNT; tile++)
+          for (uint8_t page = 0; page < PAGES; page++)
+            for (uint8_t ev = 0; ev < EV_ALL; ev++) {
+              Ui u;
+              u.mode = mode; u.level = level; u.dirty = dirty; u.mainIdx = tile; u.idleIdx = page;
+              if (ev == EV_TIMEOUT) settle(u);
+              Ui a = u, b = u;
+              oldHandle(a, ev);
+              UiState from, want;
+              newHandle(b, ev, &from, &want);
+              cases++;
+              if (!a.same(b)) {
+                if (failures++ < 20 || verbose)
+                  printf("FAIL: %s + %s: old -> %s [%s], table -> %s [%s]\n", describe(u).c_str(), EV_NAMES[ev],
+                         describe(a).c_str(), a.log.c_str(), describe(b).c_str(), b.log.c_str());
+              }
+            }
+  printf("equivalence  %d state x event cases\n", cases);
+
+  // ----- Landings over the reachable states -----
+  memset(cellSeen, 0, sizeof(cellSeen));
+  std::set<Ui> seen;
+  std::deque<Ui> todo;
+  todo.push_back(Ui());
+  seen.insert(Ui());
+  int landings = 0;
+  auto visit = [&](Ui n){
+    menuRuns(n);
+    if (seen.insert(n).second) todo.push_back(n);
+  };
+  while (!todo.empty()) {
+    const Ui u = todo.front();
+    todo.pop_front();
+    if (u.confirm) {
+      // The confirm flow: close (Cancel, or Apply and stay), or leave
+      Ui n = u; n.confirm = false; visit(n);
+      n.dirty = false; visit(n);
+      n = u; goIdle(n); visit(n);
+      continue;
+    }
+    // Editing a field stages a change
+    if (u.mode == UI_SUBMENU && u.level >= 2 && !u.dirty) { Ui n = u; n.dirty = true; visit(n); }
+    for (uint8_t ev = 0; ev < EV_ALL; ev++) {
+      if (ev == EV_TIMEOUT && u.mode == UI_IDLE) continue;    // uiLoop only times out the menu
+      Ui n = u;
+      if (ev == EV_TIMEOUT) settle(n);
+      UiState from, want;
+      landings++;
+      if (newHandle(n, ev, &from, &want)) {
+        if (failures++ < 40 || verbose)
+          printf("FAIL: %s + %s: landed %s, table says %s\n", describe(u).c_str(), EV_NAMES[ev],
+                 ST_NAMES[classify(n)], ST_NAMES[want]);
+      }
+      visit(n);
+    }
+  }
+  printf("landing      %zu reachable states, %d transitions\n", seen.size(), landings);
+
+  int cells = 0;
+  for (uint8_t st = 0; st < ST_COUNT; st++)
+    for (uint8_t ev = 0; ev < EV_ALL; ev++) {
+      if (st == ST_IDLE && ev == EV_TIMEOUT) { cells++; continue; }   // never dispatched
+      if (cellSeen[st][ev]) { cells++; continue; }
+      failures++;
+      printf("FAIL: cell %s x %s never reached\n", ST_NAMES[st], EV_NAMES[ev]);
+    }
+  printf("coverage     %d of %d cells\n", cells, ST_COUNT * EV_ALL);
+
+  printf("%s (%d failures)\n", failures ? "FAIL" : "OK", failures);
+  return failures ? 1 : 0;
+}